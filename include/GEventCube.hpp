@@ -67,6 +67,9 @@ public:
     virtual int         number(void) const = 0;
     virtual std::string print(const GChatter& chatter = NORMAL) const = 0;
 
+    // Other methods
+    virtual bool        thread_safe(void) const;
+
 protected:
     // Protected methods
     void         init_members(void);
@@ -77,6 +80,23 @@ protected:
 };
 
 
+/***********************************************************************//**
+ * @brief Signals if event bins can be accessed from several threads
+ *
+ * @return True if event bins can be accessed from several threads.
+ *
+ * Accessing an event bin through the access operator may modify the event
+ * cube. By default, an event cube therefore can not be shared by several
+ * threads. Derived classes that provide one event bin per thread should
+ * overload this method and return true.
+ ***************************************************************************/
+inline
+bool GEventCube::thread_safe(void) const
+{
+    return false;
+}
+
+
 /***********************************************************************//**
  * @brief Set energies (dummy method)
  ***************************************************************************/
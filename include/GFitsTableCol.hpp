@@ -69,6 +69,14 @@ public:
     virtual void            remove(const int& row, const int& nrows) = 0;
     virtual bool            is_loaded(void) const = 0;
 
+    // Virtual methods
+    virtual void            read_range(const int& row, const int& nrows,
+                                       double* values) const;
+    virtual void            read_range(const int& row, const int& nrows,
+                                       float* values) const;
+    virtual void            read_range(const int& row, const int& nrows,
+                                       long long* values) const;
+
     // Other methods
     void                    name(const std::string& name);
     const std::string&      name(void) const;
@@ -103,6 +111,13 @@ protected:
     void        copy_members(const GFitsTableCol& column);
     void        free_members(void);
     void        connect(void* vptr);
+    void        check_range(const std::string& origin, const int& row,
+                            const int& nrows) const;
+    bool        read_rows(const std::string& origin, const int& row,
+                          const int& nrows, const int& type,
+                          void* values) const;
+    template <class T, class U>
+    static void copy_range(const T* data, const int& num, U* values);
 
     // Protected pure virtual methods
     virtual void        alloc_data(void) = 0;
@@ -486,4 +501,25 @@ const int& GFitsTableCol::anynul(void) const
     return m_anynul;
 }
 
+
+/***********************************************************************//**
+ * @brief Copy and convert a contiguous block of column elements
+ *
+ * @param[in] data Pointer to first column element.
+ * @param[in] num Number of elements.
+ * @param[out] values Pointer to output array (at least @p num elements).
+ ***************************************************************************/
+template <class T, class U>
+inline
+void GFitsTableCol::copy_range(const T* data, const int& num, U* values)
+{
+    // Copy elements
+    for (int i = 0; i < num; ++i) {
+        values[i] = (U)data[i];
+    }
+
+    // Return
+    return;
+}
+
 #endif /* GFITSTABLECOL_HPP */
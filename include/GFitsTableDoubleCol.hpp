@@ -63,9 +63,16 @@ public:
     virtual void                 insert(const int& row, const int& nrows);
     virtual void                 remove(const int& row, const int& nrows);
     virtual bool                 is_loaded(void) const;
+    virtual void                 read_range(const int& row, const int& nrows,
+                                            double* values) const;
+    virtual void                 read_range(const int& row, const int& nrows,
+                                            float* values) const;
+    virtual void                 read_range(const int& row, const int& nrows,
+                                            long long* values) const;
     
     // Other methods
     double* data(void);
+    const double* data(void) const;
     double* nulval(void);
     void    nulval(const double* value);
 
@@ -116,6 +123,22 @@ double* GFitsTableDoubleCol::data(void)
 }
 
 
+/***********************************************************************//**
+ * @brief Returns pointer to column data
+ *
+ * @return Pointer to column data.
+ *
+ * Returns a pointer to the column data without copying them. If the column
+ * data are not yet loaded they are loaded now.
+ ***************************************************************************/
+inline
+const double* GFitsTableDoubleCol::data(void) const
+{
+    if (m_data == NULL) fetch_data();
+    return m_data;
+}
+
+
 /***********************************************************************//**
  * @brief Returns pointer to nul value
  *
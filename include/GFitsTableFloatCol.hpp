@@ -63,9 +63,16 @@ public:
     virtual void                insert(const int& row, const int& nrows);
     virtual void                remove(const int& row, const int& nrows);
     virtual bool                is_loaded(void) const;
+    virtual void                read_range(const int& row, const int& nrows,
+                                           double* values) const;
+    virtual void                read_range(const int& row, const int& nrows,
+                                           float* values) const;
+    virtual void                read_range(const int& row, const int& nrows,
+                                           long long* values) const;
     
     // Other methods
     float* data(void);
+    const float* data(void) const;
     float* nulval(void);
     void   nulval(const float* value);
 
@@ -116,6 +123,22 @@ float* GFitsTableFloatCol::data(void)
 }
 
 
+/***********************************************************************//**
+ * @brief Returns pointer to column data
+ *
+ * @return Pointer to column data.
+ *
+ * Returns a pointer to the column data without copying them. If the column
+ * data are not yet loaded they are loaded now.
+ ***************************************************************************/
+inline
+const float* GFitsTableFloatCol::data(void) const
+{
+    if (m_data == NULL) fetch_data();
+    return m_data;
+}
+
+
 /***********************************************************************//**
  * @brief Returns pointer to nul value
  *
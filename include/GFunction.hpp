@@ -40,6 +40,11 @@
  * of derivatives. This class has no members. The only pure virtual method
  * that needs to be implemented by the derived class is the eval() method
  * that provides function evaluation at a given value x, e.g. y=eval(x).
+ *
+ * The eval(x,y,n) method evaluates the function for an array of values.
+ * By default it calls eval() for each value, but derived classes may
+ * implement it to evaluate many values at once. Classes that implement
+ * it need to declare both eval() methods.
  ***************************************************************************/
 class GFunction {
 
@@ -55,6 +60,7 @@ public:
 
     // Methods
     virtual double eval(const double& x) = 0;
+    virtual void   eval(const double* x, double* y, const int& n);
 
 protected:
     // Protected methods
@@ -28,6 +28,7 @@
 #define GHEALPIX_HPP
 
 /* __ Includes ___________________________________________________________ */
+#include <vector>
 #include "GSkyProjection.hpp"
 #include "GFitsHDU.hpp"
 #include "GSkyDir.hpp"
@@ -42,6 +43,10 @@
  * The HealPix projection class has been implemented by adapting code from
  * the HealPix library (version 2.1). For more information about HEALPix, see
  * http://healpix.jpl.nasa.gov
+ *
+ * The methods for neighbour queries, disc queries, pixel interpolation and
+ * the conversion between ring and nested pixel indices have been adapted
+ * from the pixelisation methods of the HealPix C++ library (version 3).
  ***************************************************************************/
 class GHealpix : public GSkyProjection {
 
@@ -71,11 +76,29 @@ public:
     virtual GSkyPixel   dir2pix(const GSkyDir& dir) const;
     virtual std::string print(const GChatter& chatter = NORMAL) const;
 
+    // Implemented virtual base class methods
+    virtual void        pix2dir(const double* x, const double* y,
+                                const int& n,
+                                double* lon, double* lat) const;
+    virtual void        dir2pix(const double* lon, const double* lat,
+                                const int& n,
+                                double* x, double* y) const;
+
     // Other methods
-    const int&   npix(void) const;
-    const int&   nside(void) const;
-    std::string  ordering(void) const;
-    void         ordering(const std::string& ordering);
+    const int&       npix(void) const;
+    const int&       nside(void) const;
+    std::string      ordering(void) const;
+    void             ordering(const std::string& ordering);
+    int              nest2ring(const int& ipix) const;
+    int              ring2nest(const int& ipix) const;
+    std::vector<int> neighbours(const GSkyPixel& pixel) const;
+    std::vector<int> query_disc(const GSkyDir& dir,
+                                const double&  radius,
+                                const bool&    inclusive = false) const;
+    void             interpolator(const GSkyDir& dir,
+                                  int*           index,
+                                  double*        weight) const;
+    double           max_pixrad(void) const;
 
 private:
     // Private methods
@@ -91,6 +114,15 @@ private:
     int          ang2pix_z_phi_ring(double z, double phi) const;
     int          ang2pix_z_phi_nest(double z, double phi) const;
     unsigned int isqrt(unsigned int arg) const;
+    void         dir2ang(const GSkyDir& dir, double* theta, double* phi) const;
+    void         nest2xyf(const int& ipix, int* ix, int* iy, int* face) const;
+    int          xyf2nest(const int& ix, const int& iy, const int& face) const;
+    void         ring2xyf(const int& ipix, int* ix, int* iy, int* face) const;
+    int          xyf2ring(const int& ix, const int& iy, const int& face) const;
+    int          ring_above(const double& z) const;
+    double       ring2z(const int& ring) const;
+    void         get_ring_info(const int& ring, int* startpix, int* ringpix,
+                               bool* shifted, double* theta = NULL) const;
 
     // Private data area
     int      m_nside;        //!< Number of divisions of each base pixel (1-8192)
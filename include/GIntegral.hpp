@@ -61,6 +61,8 @@ public:
     void             eps(const double& eps);
     void             silent(const bool& silent);
     const int&       iter(void) const;
+    const int&       calls(void) const;
+    const double&    error(void) const;
     const int&       max_iter(void) const;
     const double&    eps(void) const;
     const bool&      silent(void) const;
@@ -69,6 +71,9 @@ public:
     double           romb(const double& a, const double& b, const int& k = 5);
     double           trapzd(const double& a, const double& b, const int& n = 1,
                             double result = 0.0);
+    double           gauss_kronrod(const double& a, const double& b);
+    double           gauss_legendre(const double& a, const double& b,
+                                    const int& n = 16);
     std::string      print(const GChatter& chatter = NORMAL) const;
 
 protected:
@@ -77,12 +82,15 @@ protected:
     void   copy_members(const GIntegral& integral);
     void   free_members(void);
     double polint(double* xa, double* ya, int n, double x, double *dy);
+    double gk15(const double& a, const double& b, double* error);
 
     // Protected data area
     GFunction* m_kernel;       //!< Pointer to function kernel
     double     m_eps;          //!< Integration precision
     int        m_max_iter;     //!< Maximum number of iterations
     int        m_iter;         //!< Number of iterations used
+    int        m_calls;        //!< Number of kernel calls used
+    double     m_error;        //!< Error estimate of integral
     bool       m_silent;       //!< Suppress integration warnings
 };
 
@@ -99,6 +107,31 @@ const int& GIntegral::iter(void) const
 }
 
 
+/***********************************************************************//**
+ * @brief Return number of kernel calls
+ *
+ * @return Number of kernel calls used by the last integration.
+ ***************************************************************************/
+inline
+const int& GIntegral::calls(void) const
+{
+    return m_calls;
+}
+
+
+/***********************************************************************//**
+ * @brief Return error estimate
+ *
+ * @return Absolute error estimate of the last integration (zero for
+ *         gauss_legendre()).
+ ***************************************************************************/
+inline
+const double& GIntegral::error(void) const
+{
+    return m_error;
+}
+
+
 /***********************************************************************//**
  * @brief Set maximum number of iterations
  *
@@ -123,6 +123,10 @@ public:
     GMatrixSymmetric cholesky_decompose(const bool& compress = true) const;
     GVector          cholesky_solver(const GVector& vector, const bool& compress = true) const;
     GMatrixSymmetric cholesky_invert(const bool& compress = true) const;
+    void             add_outer_product(const double& factor,
+                                       const double* vector,
+                                       const int*    inx,
+                                       const int&    number);
 
 private:
     // Private methods
@@ -29,6 +29,7 @@
 
 /* __ Includes ___________________________________________________________ */
 #include <string>
+#include <vector>
 #include "GModel.hpp"
 #include "GModelPar.hpp"
 #include "GModelSpatial.hpp"
@@ -105,7 +106,16 @@ class GObservation;
  * (method integrate_dir()).
  *
  * The npred() method returns the integral over the model for a given
- * observed energy and time.
+ * observed energy and time. The npred_kernel() method implements the
+ * integrand and in addition provides the gradient of the integrand with
+ * respect to a spectral parameter.
+ *
+ * The spectral_cache() method pre-computes the spectral model values and
+ * gradients for an array of energies using the batch evaluation interface
+ * of the spectral model. As long as the spectral parameters are not
+ * changed, the cached values are used by the model evaluation for these
+ * energies. This speeds up the evaluation of binned data, where many
+ * events share the same energy.
  *
  * The read() and write() methods allow reading of model information from
  * and writing to an XML element. The type() method returns the model type
@@ -169,6 +179,13 @@ public:
                            const GEnergy& emin, const GEnergy& emax,
                            const GTime& tmin, const GTime& tmax,
                            GRan& ran) const;
+    double              npred_kernel(const GEnergy& srcEng,
+                                     const GTime& srcTime,
+                                     const GObservation& obs,
+                                     const int& ipar,
+                                     double* npred_spatial) const;
+    void                spectral_cache(const std::vector<double>& logE);
+    void                clear_spectral_cache(void);
 
 protected:
     // Protected methods
@@ -193,12 +210,20 @@ protected:
                                   const GObservation& obs,
                                   bool grad) const;
     bool            valid_model(void) const;
+    int             spectral_cache_index(const GEnergy& srcEng) const;
 
     // Proteced data members
     std::string     m_type;       //!< Model type
     GModelSpatial*  m_spatial;    //!< Spatial model
     GModelSpectral* m_spectral;   //!< Spectral model
     GModelTemporal* m_temporal;   //!< Temporal model
+
+    // Spectral cache
+    std::vector<double> m_cache_logE;   //!< Cached energies (log10 MeV)
+    std::vector<double> m_cache_pars;   //!< Cached parameter values
+    std::vector<double> m_cache_values; //!< Cached spectral values
+    std::vector<double> m_cache_grads;  //!< Cached spectral gradients
+    mutable int         m_cache_index;  //!< Index of last cache hit
 };
 
 
@@ -29,7 +29,9 @@
 
 /* __ Includes ___________________________________________________________ */
 #include <string>
+#include <vector>
 #include "GModelSpatial.hpp"
+#include "GSkymap.hpp"
 #include "GPhoton.hpp"
 #include "GSkyDir.hpp"
 #include "GEnergy.hpp"
@@ -37,6 +39,9 @@
 #include "GXmlElement.hpp"
 #include "GRan.hpp"
 
+/* __ Forward declarations _______________________________________________ */
+class GObservation;
+
 
 /***********************************************************************//**
  * @class GModelSpatialDiffuse
@@ -45,6 +50,13 @@
  *
  * This class defines the interface for a diffuse model as spatial component
  * of the factorized source model.
+ *
+ * The class also implements a cache of sky map pixel weights for diffuse
+ * models that are based on sky maps. The cache holds for each observation
+ * and each event index the pixel indices and bi-linear interpolation
+ * weights of the event direction, so that the sky projection is only
+ * performed once per event. The cache is bounded in size, guarded by a
+ * critical section, and not copied when the model is copied.
  ***************************************************************************/
 class GModelSpatialDiffuse : public GModelSpatial {
 
@@ -74,6 +86,19 @@ protected:
     void init_members(void);
     void copy_members(const GModelSpatialDiffuse& model);
     void free_members(void);
+    GSkymap::weights lookup(const GSkymap& map, const GSkyDir& dir,
+                            const GObservation* obs,
+                            const int& index) const;
+    void             clear_lookup_cache(void);
+    int              lookup_slot(const GObservation* obs) const;
+
+    // Protected members
+    mutable std::vector<std::string>                   m_lookup_ids;  //!< Observation identifiers
+    mutable std::vector<std::vector<GSkymap::weights> > m_lookup_wgts; //!< Cached weights
+    mutable std::vector<std::vector<double> >           m_lookup_dirs; //!< Cached RA/Dec
+    mutable const GObservation*                        m_lookup_obs;  //!< Last observation
+    mutable int                                        m_lookup_slot; //!< Cache of last observation
+    mutable int                                        m_lookup_size; //!< Number of cached events
 };
 
 #endif /* GMODELSPATIALDIFFUSE_HPP */
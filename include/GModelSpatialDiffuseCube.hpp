@@ -82,6 +82,12 @@ public:
     virtual std::string               print(const GChatter& chatter = NORMAL) const;
 
     // Other methods
+    double                     eval(const GPhoton&      photon,
+                                    const GObservation* obs,
+                                    const int&          index) const;
+    double                     eval_gradients(const GPhoton&      photon,
+                                              const GObservation* obs,
+                                              const int&          index) const;
     int                        maps(void) const;
     int                        pixels(void) const;
     void                       load(const std::string& filename);
@@ -243,6 +249,8 @@ inline
 void GModelSpatialDiffuseCube::cube(const GSkymap& cube)
 {
     m_cube = cube;
+    m_cube.shared_pixels(true);
+    clear_lookup_cache();
     update_mc_cache();
     return;
 }
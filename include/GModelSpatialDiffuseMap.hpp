@@ -75,6 +75,12 @@ public:
     virtual std::string              print(const GChatter& chatter = NORMAL) const;
 
     // Other methods
+    double             eval(const GPhoton&      photon,
+                            const GObservation* obs,
+                            const int&          index) const;
+    double             eval_gradients(const GPhoton&      photon,
+                                      const GObservation* obs,
+                                      const int&          index) const;
     double             value(void) const;
     void               value(const double& value);
     const std::string& filename(void) const;
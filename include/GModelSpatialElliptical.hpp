@@ -48,6 +48,16 @@
  * This class defines the interface for an elliptical model as spatial
  * component of the factorized source model. Typical examples of elliptical
  * components are elliptical Disk, Gaussian or Shell shaped sources.
+ *
+ * Derived classes implement analytical gradients in the
+ * eval_gradients(theta,posangle,energy,time) method. Besides setting the
+ * gradients of their shape parameters, they store the derivatives of the
+ * model with respect to theta and posangle (in radians), which are returned
+ * by theta_gradient() and posang_gradient(). The eval_gradients(photon)
+ * method converts these derivatives into the gradients of the model centre.
+ *
+ * The Right Ascension, Declination and Position Angle are always the first
+ * three model parameters.
  ***************************************************************************/
 class GModelSpatialElliptical : public GModelSpatial {
 
@@ -94,6 +104,8 @@ public:
     void    posangle(const double& posangle);
     GSkyDir dir(void) const;
     void    dir(const GSkyDir& dir);
+    const double& theta_gradient(void) const;
+    const double& posang_gradient(void) const;
 
 protected:
     // Protected methods
@@ -105,6 +117,8 @@ protected:
     GModelPar m_ra;       //!< Right Ascension (deg)
     GModelPar m_dec;      //!< Declination (deg)
     GModelPar m_posangle; //!< Position angle from North, counterclockwise (deg)
+    double    m_theta_grad;  //!< Model derivative with respect to theta
+    double    m_posang_grad; //!< Model derivative with respect to posangle
 };
 
 
@@ -196,4 +210,36 @@ void GModelSpatialElliptical::posangle(const double& posangle)
     return;
 }
 
+
+/***********************************************************************//**
+ * @brief Return model derivative with respect to theta
+ *
+ * @return Model derivative with respect to theta (per radian).
+ *
+ * Returns the derivative of the model with respect to the angular distance
+ * theta from the model centre, as computed by the last call of
+ * eval_gradients(theta,posangle,energy,time).
+ ***************************************************************************/
+inline
+const double& GModelSpatialElliptical::theta_gradient(void) const
+{
+    return (m_theta_grad);
+}
+
+
+/***********************************************************************//**
+ * @brief Return model derivative with respect to position angle
+ *
+ * @return Model derivative with respect to position angle (per radian).
+ *
+ * Returns the derivative of the model with respect to the position angle
+ * of the photon direction with respect to the model centre, as computed by
+ * the last call of eval_gradients(theta,posangle,energy,time).
+ ***************************************************************************/
+inline
+const double& GModelSpatialElliptical::posang_gradient(void) const
+{
+    return (m_posang_grad);
+}
+
 #endif /* GMODELSPATIALELLIPTICAL_HPP */
@@ -48,6 +48,16 @@
  * This class defines the interface for a radial model as spatial component
  * of the factorized source model. Typical examples of radial components are
  * axisymmetric Disk, Gaussian or Shell sources.
+ *
+ * Derived classes implement analytical gradients in the
+ * eval_gradients(theta,energy,time) method. Besides setting the gradients
+ * of their shape parameters, they store the derivative of the model with
+ * respect to theta (in radians), which is returned by theta_gradient().
+ * The eval_gradients(photon) method converts this derivative into the
+ * gradients of the model centre.
+ *
+ * The Right Ascension and Declination are always the first two model
+ * parameters.
  ***************************************************************************/
 class GModelSpatialRadial : public GModelSpatial {
 
@@ -90,6 +100,7 @@ public:
     void    dec(const double& dec);
     GSkyDir dir(void) const;
     void    dir(const GSkyDir& dir);
+    const double& theta_gradient(void) const;
 
 protected:
     // Protected methods
@@ -100,6 +111,7 @@ protected:
     // Proteced members
     GModelPar m_ra;    //!< Right Ascension (deg)
     GModelPar m_dec;   //!< Declination (deg)
+    double    m_theta_grad; //!< Model derivative with respect to theta
 };
 
 
@@ -160,4 +172,20 @@ void GModelSpatialRadial::dec(const double& dec)
     return;
 }
 
+
+/***********************************************************************//**
+ * @brief Return model derivative with respect to theta
+ *
+ * @return Model derivative with respect to theta (per radian).
+ *
+ * Returns the derivative of the model with respect to the angular distance
+ * theta from the model centre, as computed by the last call of
+ * eval_gradients(theta,energy,time).
+ ***************************************************************************/
+inline
+const double& GModelSpatialRadial::theta_gradient(void) const
+{
+    return (m_theta_grad);
+}
+
 #endif /* GMODELSPATIALRADIAL_HPP */
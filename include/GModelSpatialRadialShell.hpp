@@ -104,6 +104,7 @@ protected:
     void          update(void) const;
     static double f1(double x);
     static double f2(double x);
+    double        norm_gradient(const double& theta, const double& sign) const;
 
     // Protected members
     GModelPar       m_radius;        //!< Inner shell radius (deg)
@@ -62,6 +62,13 @@
  * for all \f$t\f$, where \f$\Phi\f$ is the spatially and spectrally
  * integrated total source flux. The spectral component does not impact
  * the temporal properties of the integrated flux \f$\Phi\f$.
+ *
+ * Besides the evaluation for a single energy, the class provides a batch
+ * interface that evaluates the model and its parameter gradients for an
+ * array of energies in a single call. The base class implements the batch
+ * interface by calling eval_gradients() for each energy, derived classes
+ * may override the method with an implementation that avoids the per-point
+ * overhead.
  ***************************************************************************/
 class GModelSpectral : public GBase {
 
@@ -96,6 +103,12 @@ public:
     virtual void            write(GXmlElement& xml) const = 0;
     virtual std::string     print(const GChatter& chatter = NORMAL) const = 0;
 
+    // Virtual methods
+    virtual void            eval(const double* logE, const int& n,
+                                 double* values,
+                                 double* gradients = NULL) const;
+    virtual int             norm_index(void) const;
+
     // Methods
     int  size(void) const;
     void autoscale(void);
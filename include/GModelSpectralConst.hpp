@@ -82,6 +82,7 @@ public:
     virtual void                 read(const GXmlElement& xml);
     virtual void                 write(GXmlElement& xml) const;
     virtual std::string          print(const GChatter& chatter = NORMAL) const;
+    virtual int                  norm_index(void) const;
 
     // Other methods
     double value(void) const;
@@ -112,6 +113,16 @@ std::string GModelSpectralConst::type(void) const
 }
 
 
+/***********************************************************************//**
+ * @brief Return index of normalization parameter (0)
+ ***************************************************************************/
+inline
+int GModelSpectralConst::norm_index(void) const
+{
+    return 0;
+}
+
+
 /***********************************************************************//**
  * @brief Return model value
  *
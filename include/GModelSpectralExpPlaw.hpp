@@ -80,6 +80,9 @@ public:
                                         const GTime&   srcTime) const;
     virtual double                 eval_gradients(const GEnergy& srcEng,
                                                   const GTime&   srcTime);
+    virtual void                   eval(const double* logE, const int& n,
+                                        double* values,
+                                        double* gradients = NULL) const;
     virtual double                 flux(const GEnergy& emin,
                                         const GEnergy& emax) const;
     virtual double                 eflux(const GEnergy& emin,
@@ -91,6 +94,7 @@ public:
     virtual void                   read(const GXmlElement& xml);
     virtual void                   write(GXmlElement& xml) const;
     virtual std::string            print(const GChatter& chatter = NORMAL) const;
+    virtual int                    norm_index(void) const;
 
     // Other methods
     double  prefactor(void) const;
@@ -184,6 +188,16 @@ std::string GModelSpectralExpPlaw::type(void) const
 }
 
 
+/***********************************************************************//**
+ * @brief Return index of normalization parameter (0)
+ ***************************************************************************/
+inline
+int GModelSpectralExpPlaw::norm_index(void) const
+{
+    return 0;
+}
+
+
 /***********************************************************************//**
  * @brief Return pre factor
  *
@@ -74,6 +74,9 @@ public:
                                      const GTime&   srcTime) const;
     virtual double              eval_gradients(const GEnergy& srcEng,
                                                const GTime&   srcTime);
+    virtual void                eval(const double* logE, const int& n,
+                                     double* values,
+                                     double* gradients = NULL) const;
     virtual double              flux(const GEnergy& emin,
                                      const GEnergy& emax) const;
     virtual double              eflux(const GEnergy& emin,
@@ -85,6 +88,7 @@ public:
     virtual void                read(const GXmlElement& xml);
     virtual void                write(GXmlElement& xml) const;
     virtual std::string         print(const GChatter& chatter = NORMAL) const;
+    virtual int                 norm_index(void) const;
 
     // Other methods
     const std::string& filename(void) const;
@@ -140,6 +144,16 @@ std::string GModelSpectralFunc::type(void) const
 }
 
 
+/***********************************************************************//**
+ * @brief Return index of normalization parameter (0)
+ ***************************************************************************/
+inline
+int GModelSpectralFunc::norm_index(void) const
+{
+    return 0;
+}
+
+
 /***********************************************************************//**
  * @brief Return normalization factor
  *
@@ -88,6 +88,7 @@ public:
     virtual void                 read(const GXmlElement& xml);
     virtual void                 write(GXmlElement& xml) const;
     virtual std::string          print(const GChatter& chatter = NORMAL) const;
+    virtual int                  norm_index(void) const;
 
     // Other methods
     double  norm(void) const;
@@ -141,6 +142,16 @@ std::string GModelSpectralGauss::type(void) const
 }
 
 
+/***********************************************************************//**
+ * @brief Return index of normalization parameter (0)
+ ***************************************************************************/
+inline
+int GModelSpectralGauss::norm_index(void) const
+{
+    return 0;
+}
+
+
 /***********************************************************************//**
  * @brief Return normalization
  *
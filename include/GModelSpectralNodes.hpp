@@ -96,6 +96,9 @@ public:
                                       const GTime&   srcTime) const;
     virtual double               eval_gradients(const GEnergy& srcEng,
                                                 const GTime&   srcTime);
+    virtual void                 eval(const double* logE, const int& n,
+                                      double* values,
+                                      double* gradients = NULL) const;
     virtual double               flux(const GEnergy& emin,
                                       const GEnergy& emax) const;
     virtual double               eflux(const GEnergy& emin,
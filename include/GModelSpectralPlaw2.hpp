@@ -101,6 +101,7 @@ public:
     virtual void                 read(const GXmlElement& xml);
     virtual void                 write(GXmlElement& xml) const;
     virtual std::string          print(const GChatter& chatter = NORMAL) const;
+    virtual int                  norm_index(void) const;
 
     // Other methods
     double  integral(void) const;
@@ -158,6 +159,16 @@ std::string GModelSpectralPlaw2::type(void) const
 }
 
 
+/***********************************************************************//**
+ * @brief Return index of normalization parameter (0)
+ ***************************************************************************/
+inline
+int GModelSpectralPlaw2::norm_index(void) const
+{
+    return 0;
+}
+
+
 /***********************************************************************//**
  * @brief Return integral flux
  *
@@ -51,10 +51,26 @@
  * weighting factors can be recovered using inx_left(), inx_right(),
  * wgt_left() and wgt_right().
  * If the nodes are equally spaced, interpolation is more rapid.
+ *
+ * The lookup() methods return the node indices and weighting factors
+ * without storing them in the node array. They are re-entrant and can be
+ * used by several threads that share the same node array. The batched
+ * lookup() method determines the indices and weighting factors for an
+ * array of values in a single pass.
  ***************************************************************************/
 class GNodeArray : public GContainer {
 
 public:
+    /**
+     * @brief Node indices and weighting factors for linear interpolation
+     */
+    struct weights {
+        int    inx_left;   //!< Index of left node
+        int    inx_right;  //!< Index of right node
+        double wgt_left;   //!< Weight of left node
+        double wgt_right;  //!< Weight of right node
+    };
+
     // Constructors and destructors
     GNodeArray(void);
     explicit GNodeArray(const int& num, const double* array);
@@ -86,6 +102,12 @@ public:
     double        interpolate(const double& value,
                               const std::vector<double>& vector) const;
     void          set_value(const double& value) const;
+    weights       lookup(const double& value) const;
+    void          lookup(const int&    num,
+                         const double* values,
+                         int*          inx_left,
+                         double*       wgt_left,
+                         double*       wgt_right) const;
     const int&    inx_left(void) const;
     const int&    inx_right(void) const;
     const double& wgt_left(void) const;
@@ -98,6 +120,8 @@ private:
     void copy_members(const GNodeArray& array);
     void free_members(void);
     void setup(void) const;
+    void check_setup(void) const;
+    int  left_index(const double& value) const;
     
     // Node values
     std::vector<double> m_node;                   //!< Array of nodes
@@ -129,7 +153,7 @@ private:
 inline
 double& GNodeArray::operator[](const int& index)
 {
-    m_need_setup = false;
+    m_need_setup = true;
     return (m_node[index]);
 }
 
@@ -146,7 +170,6 @@ double& GNodeArray::operator[](const int& index)
 inline
 const double& GNodeArray::operator[](const int& index) const
 {
-    m_need_setup = false;
     return (m_node[index]);
 }
 
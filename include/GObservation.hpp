@@ -29,6 +29,8 @@
 
 /* __ Includes ___________________________________________________________ */
 #include <string>
+#include <vector>
+#include <map>
 #include "GBase.hpp"
 #include "GEvents.hpp"
 #include "GResponse.hpp"
@@ -38,6 +40,10 @@
 #include "GFunction.hpp"
 #include "GVector.hpp"
 #include "GMatrixSparse.hpp"
+#include "GMatrixSymmetric.hpp"
+
+/* __ Forward declarations _______________________________________________ */
+class GModelSky;
 
 
 /***********************************************************************//**
@@ -107,6 +113,10 @@ public:
     const std::string& id(void) const;
     const GEvents*     events(void) const;
     const std::string& statistics(void) const;
+    void               use_npred_cache(const bool& use);
+    const bool&        use_npred_cache(void) const;
+    void               keep_workspaces(const bool& keep);
+    const bool&        keep_workspaces(void) const;
 
 protected:
     // Protected methods
@@ -114,15 +124,59 @@ protected:
     void copy_members(const GObservation& obs);
     void free_members(void);
 
+    // Parallel processing methods
+    int           nchunks(const int& nevents) const;
+    GObservation* clone_for_thread(const bool& share_events) const;
+    void          free_thread_clone(GObservation* obs,
+                                    const bool&   share_events) const;
+    void          prepare_chunks(const GModels& models,
+                                 const int&     nchunks,
+                                 const int&     npars,
+                                 const bool&    share_events) const;
+    bool          chunks_valid(const GModels& models,
+                               const int&     nchunks,
+                               const int&     npars,
+                               const bool&    share_events) const;
+    void          free_chunks(void) const;
+
+    // Spectral cache methods
+    void set_spectral_caches(const GModels& models) const;
+    void clear_spectral_caches(const GModels& models) const;
+
+    // Curvature accumulation methods
+    GMatrixSymmetric* dense_curvature(const GModels& models,
+                                      const int&     npars) const;
+    void              accumulate_dense_curvature(const double&  factor,
+                                                 const GVector& grad,
+                                                 const int*     inx,
+                                                 const int&     number) const;
+    void              add_dense_curvature(GMatrixSymmetric* dense,
+                                          GMatrixSparse*    curvature) const;
+    void              free_dense_curvature(void) const;
+
     // Likelihood methods
     virtual double likelihood_poisson_unbinned(const GModels& models,
                                                GVector*       gradient,
                                                GMatrixSparse* curvature,
                                                double*        npred) const;
+    virtual double likelihood_poisson_unbinned(const GModels& models,
+                                               GVector*       gradient,
+                                               GMatrixSparse* curvature,
+                                               const int&     ifirst,
+                                               const int&     ilast) const;
+    double         likelihood_poisson_events(const GModels& models,
+                                             GVector*       gradient,
+                                             GMatrixSparse* curvature) const;
     virtual double likelihood_poisson_binned(const GModels& models,
                                              GVector*       gradient,
                                              GMatrixSparse* curvature,
                                              double*        npred) const;
+    virtual double likelihood_poisson_binned(const GModels& models,
+                                             GVector*       gradient,
+                                             GMatrixSparse* curvature,
+                                             double*        npred,
+                                             const int&     ifirst,
+                                             const int&     ilast) const;
     virtual double likelihood_gaussian_binned(const GModels& models,
                                               GVector*       gradient,
                                               GMatrixSparse* curvature,
@@ -148,8 +202,16 @@ protected:
     };
 
     // Npred methods
+    double         npred_cached(const GModel& model, GVector* gradient,
+                                const int& igrad) const;
+    double         npred_gradients(const GModel& model, GVector* gradient,
+                                   const int& igrad) const;
     virtual double npred_temp(const GModel& model) const;
     virtual double npred_spec(const GModel& model, const GTime& obsTime) const;
+    double         npred_spec_grad(const GModelSky&     model,
+                                   const GTime&         obsTime,
+                                   std::vector<double>& gradients,
+                                   std::vector<bool>&   analytic) const;
 
     // Npred kernel classes
     class npred_temp_kern : public GFunction {
@@ -179,6 +241,27 @@ protected:
         const GTime*        m_time;   //!< Pointer to time
     };
 
+    class npred_spec_grad_kern : public GFunction {
+    public:
+        npred_spec_grad_kern(const GObservation*      parent,
+                             const GModelSky*         model,
+                             const GTime*             obsTime,
+                             int                      ipar,
+                             std::map<double,double>* spatial) :
+                             m_parent(parent),
+                             m_model(model),
+                             m_time(obsTime),
+                             m_ipar(ipar),
+                             m_spatial(spatial) { }
+        double eval(const double& x);
+    protected:
+        const GObservation*      m_parent;  //!< Pointer to parent
+        const GModelSky*         m_model;   //!< Pointer to sky model
+        const GTime*             m_time;    //!< Pointer to time
+        int                      m_ipar;    //!< Spectral parameter (-1=value)
+        std::map<double,double>* m_spatial; //!< Spatial Npred per node
+    };
+
     // Npred gradient kernel classes
     class npred_func : public GFunction {
     public:
@@ -200,6 +283,28 @@ protected:
     std::string m_id;          //!< Observation identifier
     std::string m_statistics;  //!< Optimizer statistics (default=Poisson)
     GEvents*    m_events;      //!< Pointer to event container
+
+    // Npred cache
+    bool                                      m_use_npred_cache; //!< Use cache
+    mutable std::vector<std::string>          m_npred_names;  //!< Model names
+    mutable std::vector<std::vector<double> > m_npred_pars;   //!< Parameters
+    mutable std::vector<double>               m_npred_values; //!< Unit Npred
+    mutable std::vector<std::vector<double> > m_npred_grads;  //!< Unit grads
+
+    // Chunk workspaces of parallel likelihood evaluation
+    bool                                 m_keep_chunks;     //!< Keep workspaces
+    mutable bool                         m_chunk_share;     //!< Copies share events
+    mutable const GEvents*               m_chunk_events;    //!< Events of workspaces
+    mutable std::vector<const GModel*>   m_chunk_keys;      //!< Models of workspaces
+    mutable std::vector<GModels*>        m_chunk_models;    //!< Model copies
+    mutable std::vector<GObservation*>   m_chunk_obs;       //!< Observation copies
+    mutable std::vector<GVector*>        m_chunk_grad;      //!< Gradients
+    mutable std::vector<GMatrixSparse*>  m_chunk_curvature; //!< Curvature matrices
+
+    // Dense curvature accumulator
+    mutable GMatrixSymmetric             m_dense_curv;      //!< Accumulator
+    mutable std::vector<bool>            m_dense_used;      //!< Parameter updated?
+    mutable std::vector<int>             m_dense_inx;       //!< Updated parameters
 };
 
 
@@ -283,4 +388,28 @@ const std::string& GObservation::statistics(void) const
     return (m_statistics);
 }
 
+
+/***********************************************************************//**
+ * @brief Signals whether the Npred cache is used
+ *
+ * @return True if the Npred cache is used.
+ ***************************************************************************/
+inline
+const bool& GObservation::use_npred_cache(void) const
+{
+    return (m_use_npred_cache);
+}
+
+
+/***********************************************************************//**
+ * @brief Signals if chunk workspaces are kept between likelihood evaluations
+ *
+ * @return True if chunk workspaces are kept.
+ ***************************************************************************/
+inline
+const bool& GObservation::keep_workspaces(void) const
+{
+    return (m_keep_chunks);
+}
+
 #endif /* GOBSERVATION_HPP */
@@ -148,12 +148,17 @@ public:
         // Other methods
         void set(GObservations* obs);
         void eval(const GOptimizerPars& pars);
+        void keep_workspaces(const bool& keep);
 
     protected:
         // Protected methods
         void           init_members(void);
         void           copy_members(const likelihood& fct);
         void           free_members(void);
+        void           alloc_workspaces(const int& number, const int& npars);
+        void           free_workspaces(void);
+        bool           workspaces_valid(const int& number,
+                                        const int& npars) const;
 
         // Protected data members
         double         m_value;       //!< Function value
@@ -161,6 +166,15 @@ public:
         GVector*       m_gradient;    //!< Pointer to gradient vector
         GMatrixSparse* m_curvature;   //!< Pointer to curvature matrix
         GObservations* m_this;        //!< Pointer to GObservations object
+
+        // Workspaces for parallel likelihood evaluation
+        bool                        m_keep_wrk;      //!< Keep workspaces
+        std::vector<const GModel*>  m_wrk_keys;      //!< Models of workspaces
+        std::vector<GModels*>       m_wrk_models;    //!< Model copies
+        std::vector<GVector*>       m_wrk_gradient;  //!< Gradients
+        std::vector<GMatrixSparse*> m_wrk_curvature; //!< Curvature matrices
+        std::vector<double>         m_wrk_value;     //!< Function values
+        std::vector<double>         m_wrk_npred;     //!< Predicted events
     };
 
     // Optimizer function access method
@@ -174,6 +188,19 @@ protected:
     int  get_index(const std::string& instrument,
                    const std::string& id) const;
 
+    // Fit state guard. Prepares the likelihood function for repeated
+    // evaluations during optimize() and restores its state on exit,
+    // also if the optimizer throws an exception.
+    class optimize_guard {
+    public:
+        explicit optimize_guard(GObservations* obs);
+        ~optimize_guard(void);
+    private:
+        optimize_guard(const optimize_guard& guard);
+        optimize_guard& operator=(const optimize_guard& guard);
+        GObservations* m_this;   //!< Pointer to GObservations object
+    };
+
     // Protected members
     std::vector<GObservation*> m_obs;    //!< List of observations
     GModels                    m_models; //!< List of models
@@ -42,6 +42,7 @@
 
 /* __ Forward declarations _______________________________________________ */
 class GObservation;
+class GModels;
 
 
 /***********************************************************************//**
@@ -82,18 +83,22 @@ public:
     virtual std::string print(const GChatter& chatter = NORMAL) const = 0;
 
     // Virtual methods
+    virtual bool   has_irf_gradients(void) const;
     virtual double irf(const GEvent&       event,
                        const GSource&      source,
-                       const GObservation& obs) const;
+                       const GObservation& obs,
+                       const bool&         grad = false) const;
     virtual double irf_ptsrc(const GEvent&       event,
                              const GSource&      source,
                              const GObservation& obs) const;
     virtual double irf_radial(const GEvent&       event,
                               const GSource&      source,
-                              const GObservation& obs) const;
+                              const GObservation& obs,
+                              const bool&         grad = false) const;
     virtual double irf_elliptical(const GEvent&       event,
                                   const GSource&      source,
-                                  const GObservation& obs) const;
+                                  const GObservation& obs,
+                                  const bool&         grad = false) const;
     virtual double irf_diffuse(const GEvent&       event,
                                const GSource&      source,
                                const GObservation& obs) const;
@@ -107,6 +112,9 @@ public:
                                     const GObservation& obs) const;
     virtual double npred_diffuse(const GSource&      source,
                                  const GObservation& obs) const;
+    virtual void   set_source_caches(const GObservation& obs,
+                                     const GModels&      models) const;
+    virtual void   clear_source_caches(const GObservation& obs) const;
 
 protected:
     // Protected methods
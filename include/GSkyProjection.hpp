@@ -43,6 +43,14 @@
  * This class defines an abstract projection from sky coordinates into
  * pixel coordinates. Sky coordinates are implemented using the GSkyDir
  * class, pixel coordinates are implemented using the GSkyPixel class.
+ *
+ * In addition to the transformation of individual sky directions and
+ * pixels, the class provides batched transformations that operate on
+ * arrays of coordinates. Sky coordinates are given in degrees in the
+ * coordinate system of the projection, pixel coordinates follow the
+ * GSkyPixel convention. The base class implements the batched
+ * transformations using the individual transformations, derived classes
+ * may implement them natively.
  ***************************************************************************/
 class GSkyProjection : public GBase {
 
@@ -75,6 +83,12 @@ public:
     // Virtual methods
     virtual std::string coordsys(void) const;
     virtual void        coordsys(const std::string& coordsys);
+    virtual void        pix2dir(const double* x, const double* y,
+                                const int& n,
+                                double* lon, double* lat) const;
+    virtual void        dir2pix(const double* lon, const double* lat,
+                                const int& n,
+                                double* x, double* y) const;
 
 protected:
     // Protected methods
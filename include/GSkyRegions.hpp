@@ -34,6 +34,7 @@
 #include "GSkyRegion.hpp"
 #include "GException.hpp"
 #include "GSkyDir.hpp"
+#include "GHealpix.hpp"
 
 /***********************************************************************//**
  * @class GSkyRegions
@@ -49,6 +50,14 @@
  * The object can be initialised from a DS9 region file, and has load and 
  * save methods from/to a DS9 region file.
  *
+ * For containers with many regions, the contains(const GSkyDir&) method
+ * uses a spatial index that is built on the first call. The index assigns
+ * each circular region to the HEALPix pixels it overlaps with, so that only
+ * the few regions that are listed for the pixel of a sky direction need to
+ * be tested. The contains(const std::vector<GSkyDir>&) method tests a set
+ * of sky directions in a single call. The index is rebuilt after the
+ * container has been modified or a region has been accessed through a
+ * non-const pointer.
  ***************************************************************************/
 class GSkyRegions : public GContainer {
 
@@ -84,6 +93,7 @@ public:
     void               extend(const GSkyRegions& regions);
     bool               contains(const std::string& name) const;
     bool               contains(const GSkyDir& dir) const;
+    std::vector<bool>  contains(const std::vector<GSkyDir>& dirs) const;
     bool               overlaps(const GSkyRegion& reg) const;
     void               load(const std::string& filename);
     void               save(const std::string& filename) const;
@@ -96,10 +106,20 @@ protected:
     void copy_members(const GSkyRegions& regions);
     void free_members(void);
     int  get_index(const std::string& name) const;
+    void build_index(void) const;
+    void update_index(void) const;
+    bool index_contains(const GSkyDir& dir) const;
 
     // Protected members
     mutable std::string      m_filename;   //!< Filename of origin
     std::vector<GSkyRegion*> m_regions;    //!< List of regions
+
+    // Spatial index
+    mutable bool             m_index_valid;   //!< Spatial index is valid
+    mutable GHealpix         m_index_proj;    //!< Index pixelisation
+    mutable std::vector<int> m_index_start;   //!< First entry per pixel
+    mutable std::vector<int> m_index_regions; //!< Region indices per pixel
+    mutable std::vector<int> m_index_other;   //!< Regions tested always
 };
 
 
@@ -108,11 +128,14 @@ protected:
  *
  * @param[in] index region index [0,...,size()-1].
  *
- * Returns a pointer to the region with the specified @p index.
+ * Returns a pointer to the region with the specified @p index. Since the
+ * region may be modified through the pointer, the spatial index is rebuilt
+ * on the next containment test.
  ***************************************************************************/
 inline
 GSkyRegion* GSkyRegions::operator[](const int& index)
 {
+    m_index_valid = false;
     return (m_regions[index]);
 }
 
@@ -29,6 +29,7 @@
 
 /* __ Includes ___________________________________________________________ */
 #include <string>
+#include <vector>
 #include "GBase.hpp"
 #include "GSkyDir.hpp"
 #include "GSkyPixel.hpp"
@@ -74,11 +75,48 @@
  *     int       index = map.pix2inx(pixel);   // Pixel to index
  *     int       index = map.dir2inx(dir);     // Sky direction to index
  *     GSkyPixel pixel = map.dir2pix(dir);     // Sky direction to pixel
+ *
+ * The pix2dir(), dir2inx() and dir2pix() methods also exist for vectors
+ * of pixels or sky directions. They transform all elements in a single
+ * batched call of the sky projection, which is considerably faster than
+ * transforming the elements one by one.
+ *
+ * The bi-linear interpolation of the sky direction access operator is
+ * split into the lookup() method, which determines the indices and
+ * weighting factors of the four neighbouring pixels, and an access
+ * operator that applies these weights to a given map. Clients that
+ * evaluate the same sky direction several times, for example in all maps
+ * of a map cube, can thus perform the sky projection only once:
+ *
+ *     GSkymap::weights wgt = map.lookup(dir);
+ *     double value1 = map(wgt, 0);
+ *     double value2 = map(wgt, 1);
+ *
+ * Sky map pixels are by default stored in double precision, and each copy
+ * of a sky map holds its own pixels. Large sky maps that are only read,
+ * such as diffuse model templates, may use a more economic storage:
+ *
+ *     map.float_pixels(true);   // Store pixels in single precision
+ *     map.shared_pixels(true);  // Share pixels between copies
+ *
+ * Copies of a sky map with shared pixels reference the pixels of the
+ * original sky map instead of copying them. The pixels are only copied
+ * when a sky map that shares its pixels is modified (copy-on-write).
+ * Single precision pixels are converted back into double precision when
+ * the sky map is modified.
  *  
  ***************************************************************************/
 class GSkymap : public GBase {
 
 public:
+    /**
+     * @brief Pixel indices and weighting factors for bi-linear interpolation
+     */
+    struct weights {
+        int    inx[4];  //!< Indices of neighbouring pixels
+        double wgt[4];  //!< Weights of neighbouring pixels
+    };
+
     // Constructors and destructors
     GSkymap(void);
     explicit GSkymap(const std::string& filename);
@@ -101,10 +139,11 @@ public:
     // Operators
     GSkymap&      operator=(const GSkymap& map);
     double&       operator()(const int& index, const int& map = 0);
-    const double& operator()(const int& index, const int& map = 0) const;
+    double        operator()(const int& index, const int& map = 0) const;
     double&       operator()(const GSkyPixel& pixel, const int& map = 0);
-    const double& operator()(const GSkyPixel& pixel, const int& map = 0) const;
+    double        operator()(const GSkyPixel& pixel, const int& map = 0) const;
     double        operator()(const GSkyDir& dir, const int& map = 0) const;
+    double        operator()(const weights& wgt, const int& map = 0) const;
 
     // Methods
     void                  clear(void);
@@ -119,6 +158,10 @@ public:
     int                   pix2inx(const GSkyPixel& pixel) const;
     int                   dir2inx(const GSkyDir& dir) const;
     GSkyPixel             dir2pix(const GSkyDir& dir) const;
+    weights               lookup(const GSkyDir& dir) const;
+    std::vector<GSkyDir>  pix2dir(const std::vector<GSkyPixel>& pixels) const;
+    std::vector<int>      dir2inx(const std::vector<GSkyDir>& dirs) const;
+    std::vector<GSkyPixel> dir2pix(const std::vector<GSkyDir>& dirs) const;
     double                solidangle(const int& index) const;
     double                solidangle(const GSkyPixel& pixel) const;
     bool                  contains(const GSkyDir& dir) const;
@@ -126,6 +169,10 @@ public:
     const GSkyProjection* projection(void) const;
     void                  projection(const GSkyProjection& proj);
     const double*         pixels(void) const;
+    void                  float_pixels(const bool& use_float);
+    bool                  float_pixels(void) const;
+    void                  shared_pixels(const bool& share);
+    bool                  shared_pixels(void) const;
     void                  load(const std::string& filename);
     void                  save(const std::string& filename, bool clobber = false) const;
     void                  read(const GFitsHDU& hdu);
@@ -138,6 +185,8 @@ private:
     void              alloc_pixels(void);
     void              copy_members(const GSkymap& map);
     void              free_members(void);
+    void              release_pixels(void);
+    void              unshare_pixels(void);
     void              set_wcs(const std::string& wcs, const std::string& coords,
                               const double& crval1, const double& crval2,
                               const double& crpix1, const double& crpix2,
@@ -156,6 +205,8 @@ private:
     int             m_num_y;      //!< Number of pixels in y direction (only 2D)
     GSkyProjection* m_proj;       //!< Pointer to sky projection
     double*         m_pixels;     //!< Pointer to skymap pixels
+    float*          m_fpixels;    //!< Pointer to single precision pixels
+    int*            m_refs;       //!< Number of references to shared pixels
 };
 
 
@@ -230,14 +281,26 @@ const GSkyProjection* GSkymap::projection(void) const
 
 
 /***********************************************************************//**
- * @brief Returns pointer to pixel data
+ * @brief Signals if pixels are stored in single precision
+ *
+ * @return True if pixels are stored in single precision.
+ ***************************************************************************/
+inline
+bool GSkymap::float_pixels(void) const
+{
+    return (m_fpixels != NULL);
+}
+
+
+/***********************************************************************//**
+ * @brief Signals if pixels are shared between copies
  *
- * @return Pointer to pixel data.
+ * @return True if pixels are shared between copies of the sky map.
  ***************************************************************************/
 inline
-const double* GSkymap::pixels(void) const
+bool GSkymap::shared_pixels(void) const
 {
-    return m_pixels;
+    return (m_refs != NULL);
 }
 
 #endif /* GSKYMAP_HPP */
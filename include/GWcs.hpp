@@ -73,6 +73,12 @@ public:
     virtual double      solidangle(const GSkyPixel& pixel) const;
     virtual GSkyDir     pix2dir(const GSkyPixel& pixel) const;
     virtual GSkyPixel   dir2pix(const GSkyDir& dir) const;
+    virtual void        pix2dir(const double* x, const double* y,
+                                const int& n,
+                                double* lon, double* lat) const;
+    virtual void        dir2pix(const double* lon, const double* lat,
+                                const int& n,
+                                double* x, double* y) const;
 
     // Other methods
     void   set(const std::string& coords,
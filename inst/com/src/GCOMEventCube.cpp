@@ -109,8 +109,12 @@ GCOMEventCube::GCOMEventCube(const GSkymap& map, const GEbounds& ebds,
     // Initialise members
     init_members();
 
-    // Set sky map, energy boundaries and GTI
+    // Set sky map, energy boundaries and GTI. The event bin references the
+    // sky map pixels, hence the event cube needs its own double precision
+    // pixels.
     m_map = map;
+    m_map.shared_pixels(false);
+    m_map.float_pixels(false);
     this->ebounds(ebds);
     this->gti(gti);
 
@@ -533,8 +537,11 @@ int GCOMEventCube::number(void) const
 void GCOMEventCube::map(const GSkymap& map, const double& phimin,
                         const double& dphi)
 {
-    // Store sky map
+    // Store sky map. The event bin references the sky map pixels, hence
+    // the event cube needs its own double precision pixels.
     m_map = map;
+    m_map.shared_pixels(false);
+    m_map.float_pixels(false);
 
     // Compute sky directions
     set_scatter_directions();
@@ -285,12 +285,12 @@ double GCOMModelDRBFitting::eval(const GEvent&       event,
             // Update evaluation cache
             update_cache();
 
-            // Set node array for linear interpolation
-            m_nodes.set_value(phibar);
+            // Get indices and weights for linear interpolation
+            GNodeArray::weights w = m_nodes.lookup(phibar);
 
             // Get scale factor
-            scale = m_values[m_nodes.inx_left()].value()  * m_nodes.wgt_left() +
-                    m_values[m_nodes.inx_right()].value() * m_nodes.wgt_right();
+            scale = m_values[w.inx_left].value()  * w.wgt_left +
+                    m_values[w.inx_right].value() * w.wgt_right;
 
         } // endelse: performed linear interpolation
 
@@ -391,14 +391,12 @@ double GCOMModelDRBFitting::eval_gradients(const GEvent&       event,
             // Update evaluation cache
             update_cache();
 
-            // Set node array for linear interpolation
-            m_nodes.set_value(phibar);
-
             // Get indices and weights for interpolation
-            int    inx_left  = m_nodes.inx_left();
-            int    inx_right = m_nodes.inx_right();
-            double wgt_left  = m_nodes.wgt_left();
-            double wgt_right = m_nodes.wgt_right();
+            GNodeArray::weights w = m_nodes.lookup(phibar);
+            int    inx_left  = w.inx_left;
+            int    inx_right = w.inx_right;
+            double wgt_left  = w.wgt_left;
+            double wgt_right = w.wgt_right;
 
             // Get scale factor
             scale = m_values[inx_left].value()  * wgt_left +
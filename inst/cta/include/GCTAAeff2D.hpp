@@ -68,7 +68,9 @@ public:
     std::string print(const GChatter& chatter = NORMAL) const;
 
     // Methods
-    void read(const GFits& file);
+    void                     read(const GFits& file);
+    void                     compile(const int& nlogE, const int& ntheta);
+    const GCTAResponseTable& table(void) const;
     
 private:
     // Methods
@@ -81,4 +83,16 @@ private:
     GCTAResponseTable m_aeff;      //!< Aeff response table
 };
 
+
+/***********************************************************************//**
+ * @brief Return effective area response table
+ *
+ * @return Effective area response table.
+ ***************************************************************************/
+inline
+const GCTAResponseTable& GCTAAeff2D::table(void) const
+{
+    return m_aeff;
+}
+
 #endif /* GCTAAEFF2D_HPP */
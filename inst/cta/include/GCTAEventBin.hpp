@@ -79,6 +79,7 @@ public:
     const double&  solidangle(void) const;
     const GEnergy& ewidth(void) const;
     const double&  ontime(void) const;
+    const int&     index(void) const;
 
 protected:
     // Protected methods
@@ -94,6 +95,7 @@ protected:
     double*      m_solidangle;  //!< Pointer to solid angle of pixel (sr)
     GEnergy*     m_ewidth;      //!< Pointer to energy width of bin
     double*      m_ontime;      //!< Pointer to ontime of bin (seconds)
+    int          m_index;       //!< Index of bin in event cube
 };
 
 #endif /* GCTAEVENTBIN_HPP */
@@ -30,6 +30,7 @@
 /* __ Includes ___________________________________________________________ */
 #include <string>
 #include <vector>
+#include <map>
 #include "GEventCube.hpp"
 #include "GCTAEventBin.hpp"
 #include "GSkymap.hpp"
@@ -41,6 +42,9 @@
 #include "GFitsTable.hpp"
 #include "GFitsImage.hpp"
 
+/* __ Forward declarations _______________________________________________ */
+class GCTAEventList;
+
 
 /***********************************************************************//**
  * @class GCTAEventCube
@@ -48,6 +52,29 @@
  * @brief CTA event bin container class
  *
  * This class is a container class for CTA event bins.
+ *
+ * The class holds one event bin per thread, hence event bins can be
+ * accessed from several threads. Threads of nested parallel regions and
+ * threads beyond the number of threads at construction use event bins
+ * that are created on first use.
+ *
+ * The class also holds a cache of IRF values for each event bin that is
+ * used by GCTAResponse in binned analyses. The cache holds one value per
+ * event bin and model, and the values of a model are reset if the model
+ * parameters on which they depend change. Access to the cache is through
+ * a handle that is obtained using irf_cache_handle(). The cache is not
+ * cleared automatically if the response or the pointing of the
+ * observation is changed; use irf_cache_clear() in that case.
+ *
+ * The cache methods lock the cache so that it can be used from several
+ * threads. The response obtains the handles of all models once per model
+ * evaluation and allocates their values using irf_cache_prepare().
+ * The values of the individual event bins are then accessed through
+ * irf_cache_value(), which does not lock the cache. Together with the
+ * values, the gradients of the IRF with respect to the model parameters
+ * are stored and retrieved using irf_cache_gradients(). Since every thread
+ * processes its own range of event bins, the threads write different
+ * elements of the preallocated values.
  ***************************************************************************/
 class GCTAEventCube : public GEventCube {
 
@@ -76,6 +103,7 @@ public:
     virtual void           write(GFits& file) const;
     virtual int            number(void) const;
     virtual std::string    print(const GChatter& chatter = NORMAL) const;
+    virtual bool           thread_safe(void) const;
 
     // Other methods
     void                   map(const GSkymap& map);
@@ -84,32 +112,174 @@ public:
     int                    ny(void) const;
     int                    npix(void) const;
     int                    ebins(void) const;
+    void                   fill(const GCTAEventList& events);
+    int                    irf_cache_handle(const std::string&         name,
+                                            const std::vector<double>& pars) const;
+    double                 irf_cache(const int& handle, const int& index) const;
+    void                   irf_cache(const int& handle, const int& index,
+                                     const double& irf) const;
+    void                   irf_cache_prepare(const int& handle) const;
+    double                 irf_cache_value(const int& handle,
+                                           const int& index) const;
+    void                   irf_cache_value(const int& handle, const int& index,
+                                           const double& irf) const;
+    bool                   irf_cache_gradients(const int&           handle,
+                                               const int&           index,
+                                               std::vector<double>* grads) const;
+    void                   irf_cache_gradients(const int&                 handle,
+                                               const int&                 index,
+                                               const std::vector<double>& grads) const;
+    void                   irf_cache_clear(void);
 
 protected:
     // Protected methods
-    void         init_members(void);
-    void         copy_members(const GCTAEventCube& cube);
-    void         free_members(void);
-    void         read_cntmap(const GFitsImage& hdu);
-    void         read_ebds(const GFitsTable& hdu);
-    void         read_gti(const GFitsTable& hdu);
-    void         set_directions(void);
-    virtual void set_energies(void);
-    virtual void set_times(void);
-    void         set_bin(const int& index);
+    void          init_members(void);
+    void          copy_members(const GCTAEventCube& cube);
+    void          free_members(void);
+    void          read_cntmap(const GFitsImage& hdu);
+    void          read_ebds(const GFitsTable& hdu);
+    void          read_gti(const GFitsTable& hdu);
+    void          set_directions(void);
+    virtual void  set_energies(void);
+    virtual void  set_times(void);
+    GCTAEventBin* set_bin(const int& index);
+    GCTAEventBin* thread_bin(void);
+    void          init_bins(void);
 
     // Protected members
-    GSkymap                  m_map;        //!< Counts map stored as sky map
-    GCTAEventBin             m_bin;        //!< Actual event bin
-    GTime                    m_time;       //!< Event cube mean time
-    std::vector<GCTAInstDir> m_dirs;       //!< Array of event directions
-    std::vector<double>      m_solidangle; //!< Array of solid angles (sr)
-    std::vector<GEnergy>     m_energies;   //!< Array of log mean energies
-    std::vector<GEnergy>     m_ewidth;     //!< Array of energy bin widths
-    double                   m_ontime;     //!< Event cube ontime (sec)
+    GSkymap                   m_map;        //!< Counts map stored as sky map
+    std::vector<GCTAEventBin> m_bins;       //!< Actual event bins (one per thread)
+    std::map<std::vector<int>,GCTAEventBin> m_bins_nested; //!< Nested event bins
+    GTime                     m_time;       //!< Event cube mean time
+    std::vector<GCTAInstDir>  m_dirs;       //!< Array of event directions
+    std::vector<double>       m_solidangle; //!< Array of solid angles (sr)
+    std::vector<GEnergy>      m_energies;   //!< Array of log mean energies
+    std::vector<GEnergy>      m_ewidth;     //!< Array of energy bin widths
+    double                    m_ontime;     //!< Event cube ontime (sec)
+
+    // IRF cache
+    mutable std::map<std::string,int>         m_irf_handles; //!< Handles
+    mutable std::vector<std::vector<double> > m_irf_pars;    //!< Model parameters
+    mutable std::vector<std::vector<double> > m_irf_values;  //!< IRF values
+    mutable std::vector<std::vector<double> > m_irf_grads;   //!< IRF gradients
 };
 
 
+/***********************************************************************//**
+ * @brief Get prepared cache IRF value
+ *
+ * @param[in] handle IRF cache handle.
+ * @param[in] index Event bin index [0,...,size()-1].
+ * @return IRF value (-1 if no cache value found).
+ *
+ * Returns a cache IRF value without locking the cache. The values of the
+ * model need to be allocated before using irf_cache_prepare().
+ ***************************************************************************/
+inline
+double GCTAEventCube::irf_cache_value(const int& handle,
+                                      const int& index) const
+{
+    double irf = -1.0;
+    if (handle >= 0 && handle < m_irf_values.size() &&
+        index  >= 0 && index  < m_irf_values[handle].size()) {
+        irf = (m_irf_values[handle])[index];
+    }
+    return irf;
+}
+
+
+/***********************************************************************//**
+ * @brief Set prepared cache IRF value
+ *
+ * @param[in] handle IRF cache handle.
+ * @param[in] index Event bin index [0,...,size()-1].
+ * @param[in] irf IRF value.
+ *
+ * Stores a cache IRF value without locking the cache. The value is only
+ * stored if the values of the model were allocated using
+ * irf_cache_prepare().
+ ***************************************************************************/
+inline
+void GCTAEventCube::irf_cache_value(const int& handle, const int& index,
+                                    const double& irf) const
+{
+    if (handle >= 0 && handle < m_irf_values.size() &&
+        index  >= 0 && index  < m_irf_values[handle].size()) {
+        (m_irf_values[handle])[index] = irf;
+    }
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Get prepared cache IRF gradients
+ *
+ * @param[in] handle IRF cache handle.
+ * @param[in] index Event bin index [0,...,size()-1].
+ * @param[out] grads IRF gradients (at least one per model parameter).
+ * @return True if gradients were found.
+ *
+ * Copies the cache IRF gradients of an event bin into @p grads without
+ * locking the cache. The gradients of the model need to be allocated
+ * before using irf_cache_prepare().
+ ***************************************************************************/
+inline
+bool GCTAEventCube::irf_cache_gradients(const int&           handle,
+                                        const int&           index,
+                                        std::vector<double>* grads) const
+{
+    bool found = false;
+    if (handle >= 0 && handle < m_irf_grads.size() && index >= 0) {
+        int npars = m_irf_pars[handle].size();
+        if (npars == 0) {
+            found = true;
+        }
+        else if (npars <= grads->size() &&
+                 (index+1) * (npars+1) <= m_irf_grads[handle].size()) {
+            const double* ptr = &((m_irf_grads[handle])[index * (npars+1)]);
+            if (ptr[0] != 0.0) {
+                for (int i = 0; i < npars; ++i) {
+                    (*grads)[i] = ptr[i+1];
+                }
+                found = true;
+            }
+        }
+    }
+    return found;
+}
+
+
+/***********************************************************************//**
+ * @brief Set prepared cache IRF gradients
+ *
+ * @param[in] handle IRF cache handle.
+ * @param[in] index Event bin index [0,...,size()-1].
+ * @param[in] grads IRF gradients (one per model parameter).
+ *
+ * Stores the cache IRF gradients of an event bin without locking the
+ * cache. The gradients are only stored if they were allocated using
+ * irf_cache_prepare().
+ ***************************************************************************/
+inline
+void GCTAEventCube::irf_cache_gradients(const int&                 handle,
+                                        const int&                 index,
+                                        const std::vector<double>& grads) const
+{
+    if (handle >= 0 && handle < m_irf_grads.size() && index >= 0) {
+        int npars = m_irf_pars[handle].size();
+        if (npars > 0 && npars <= grads.size() &&
+            (index+1) * (npars+1) <= m_irf_grads[handle].size()) {
+            double* ptr = &((m_irf_grads[handle])[index * (npars+1)]);
+            ptr[0] = 1.0;
+            for (int i = 0; i < npars; ++i) {
+                ptr[i+1] = grads[i];
+            }
+        }
+    }
+    return;
+}
+
+
 /***********************************************************************//**
  * @brief Return event cube sky map
  *
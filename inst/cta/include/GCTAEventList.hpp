@@ -30,12 +30,14 @@
 /* __ Includes ___________________________________________________________ */
 #include <string>
 #include <vector>
+#include <map>
 #include "GEventList.hpp"
 #include "GCTAEventAtom.hpp"
 #include "GCTARoi.hpp"
 #include "GFitsHDU.hpp"
 #include "GFitsTable.hpp"
 #include "GFitsBinTable.hpp"
+#include "GFitsTableCol.hpp"
 
 
 /***********************************************************************//**
@@ -44,9 +46,62 @@
  * @brief CTA event atom container class
  *
  * This class is a container class for CTA event atoms.
+ *
+ * The class also holds a cache of IRF values for each event that is used
+ * by the CTA response for models that require numerical integration. The
+ * cache stores one IRF value per event and source. Sources are identified
+ * by an integer handle that is obtained once from the source name using
+ * irf_cache_handle(). The values can be stored in single or double
+ * precision. A memory ceiling can be specified, and if storing the values
+ * of a new source would exceed the ceiling, the sources that were least
+ * recently used are removed from the cache. The number of cache hits and
+ * misses is recorded.
+ *
+ * All these cache methods are protected by a critical region so that the
+ * cache can be used from several threads. For likelihood evaluations the
+ * response resolves the handles of all sources once using
+ * irf_cache_handle() and irf_cache_prepare(), and then accesses the values
+ * of the individual events through irf_cache_value(), which does not lock
+ * and does not allocate. The hits and misses of such an evaluation are
+ * added using irf_cache_count(). Together with the values, the gradients
+ * of the IRF with respect to the model parameters can be stored and
+ * retrieved without locking using irf_cache_gradients(), so that a cache
+ * hit restores the gradients that were computed with the value.
+ *
+ * In addition, the class holds a cache of event geometry quantities that
+ * do not depend on the source models (e.g. the offset angle of each event
+ * from the pointing direction). The cache is filled by the CTA response
+ * for all events at once and is identified by a key that specifies the
+ * quantities on which the values depend (see geometry()). Once the key has
+ * been validated using has_geometry(), the values of the individual events
+ * can be accessed without locking through geometry_values(). The cache is
+ * cleared by any non-const event access, since the events may be modified.
+ *
+ * The events are by default stored as a vector of event atoms. Optionally,
+ * the events can be stored in columnar form by calling columnar(true)
+ * before loading or after filling the event list. In columnar mode, the
+ * information that is needed for a likelihood analysis (Right Ascension,
+ * Declination, log10 of the energy, time and index) is stored in
+ * contiguous arrays. All
+ * other event information (e.g. shower parameters) is held in auxiliary
+ * columns that are only unpacked when they are requested through the
+ * column() method. Read access to individual events through the const
+ * operator[] is still possible in columnar mode; the operator then returns
+ * a view on the event that is valid until the next access from the same
+ * thread. Events can not be modified in columnar mode, hence the non-const
+ * operator[] converts the events into event atoms.
+ *
+ * A column projection can be specified using projection() or the load()
+ * and read() methods that take a list of column names. Only the columns
+ * needed for a likelihood analysis and the auxiliary columns in the
+ * projection are then read from the event file. All other auxiliary
+ * columns are read from the file when they are first requested.
  ***************************************************************************/
 class GCTAEventList : public GEventList {
 
+    // Friend classes
+    friend class GCTAEventStream;
+
 public:
     // Constructors and destructors
     GCTAEventList(void);
@@ -73,11 +128,64 @@ public:
     std::string            print(const GChatter& chatter = NORMAL) const;
 
     // Implement other methods
-    void   append(const GCTAEventAtom& event);
-    void   reserve(const int& number);
-    double irf_cache(const std::string& name, const int& index) const;
-    void   irf_cache(const std::string& name, const int& index,
-                     const double& irf) const;
+    void                 load(const std::string&              filename,
+                              const std::vector<std::string>& columns);
+    void                 read(const GFits&                    file,
+                              const std::vector<std::string>& columns);
+    void                 projection(const std::vector<std::string>& columns);
+    const std::vector<std::string>& projection(void) const;
+    const bool&          projected(void) const;
+    void                 append(const GCTAEventAtom& event);
+    void                 reserve(const int& number);
+    void                 columnar(const bool& columnar);
+    const bool&          columnar(void) const;
+    const std::vector<double>& ra(void) const;
+    const std::vector<double>& dec(void) const;
+    const std::vector<double>& log10TeV(void) const;
+    const std::vector<double>& times(void) const;
+    const std::vector<int>&    indices(void) const;
+    const std::vector<double>& column(const std::string& name) const;
+    void                 reserve_views(void) const;
+    int                  irf_cache_handle(const std::string& name) const;
+    int                  irf_cache_handle(const std::string&         name,
+                                          const std::vector<double>& pars) const;
+    double               irf_cache(const int& handle, const int& index) const;
+    void                 irf_cache(const int& handle, const int& index,
+                                   const double& irf) const;
+    double               irf_cache(const std::string& name,
+                                   const int&         index) const;
+    void                 irf_cache(const std::string& name, const int& index,
+                                   const double& irf) const;
+    void                 irf_cache_prepare(const int& handle) const;
+    double               irf_cache_value(const int& handle,
+                                         const int& index) const;
+    void                 irf_cache_value(const int& handle, const int& index,
+                                         const double& irf) const;
+    bool                 irf_cache_gradients(const int&           handle,
+                                             const int&           index,
+                                             std::vector<double>* grads) const;
+    void                 irf_cache_gradients(const int&                 handle,
+                                             const int&                 index,
+                                             const std::vector<double>& grads) const;
+    void                 irf_cache_count(const unsigned long& hits,
+                                         const unsigned long& misses) const;
+    void                 irf_cache_clear(void);
+    void                 irf_cache_max_memory(const double& mbytes);
+    const double&        irf_cache_max_memory(void) const;
+    void                 irf_cache_float(const bool& use_float);
+    const bool&          irf_cache_float(void) const;
+    double               irf_cache_memory(void) const;
+    const unsigned long& irf_cache_hits(void) const;
+    const unsigned long& irf_cache_misses(void) const;
+    bool                 has_geometry(const std::vector<double>& key) const;
+    bool                 geometry(const std::vector<double>& key,
+                                  const int&                 index,
+                                  double*                    values) const;
+    void                 geometry(const std::vector<double>& key,
+                                  const std::vector<double>& values,
+                                  const int&                 stride) const;
+    const double*        geometry_values(const int& index) const;
+    void                 geometry_clear(void);
 
 protected:
     // Protected methods
@@ -86,27 +194,226 @@ protected:
     void         free_members(void);
     virtual void set_energies(void) { return; }
     virtual void set_times(void) { return; }
+    void         read_header(const GFits& fits);
     void         read_events(const GFitsTable& hdu);
-    void         read_events_v0(const GFitsTable& hdu);
-    void         read_events_v1(const GFitsTable& hdu);
-    void         read_events_hillas(const GFitsTable& hdu);
+    void         read_events_atoms(const GFitsTable& hdu);
+    void         read_events_atoms(const GFitsTable& hdu, const int& row,
+                                   const int& nrows);
+    void         select_events(const GCTARoi& roi, const GEbounds& ebounds);
     void         read_ds_ebounds(const GFitsHDU& hdu);
     void         read_ds_roi(const GFitsHDU& hdu);
     void         write_events(GFitsBinTable& hdu) const;
     void         write_ds_keys(GFitsHDU& hdu) const;
-    int          irf_cache_init(const std::string& name) const;
-    int          irf_cache_index(const std::string& name) const;
+    void         irf_cache_alloc(const int& handle) const;
+    void         irf_cache_reset(const int& handle) const;
+    void         irf_cache_free(const int& handle) const;
+    double       irf_cache_mbytes(const int& handle) const;
+    void         read_events_columnar(const GFitsTable& table);
+    void         init_views(void);
+    void         grow_views(const int& num) const;
+    void         set_view(GCTAEventAtom& atom, const int& index) const;
+    GCTAEventAtom& thread_view(void) const;
+    void         load_column(const int& column) const;
+    void         fetch_column(const int& column) const;
+    void         load_columns(void) const;
+    double       aux_value(const GCTAEventAtom& atom, const int& column) const;
+    void         aux_value(GCTAEventAtom& atom, const int& column,
+                           const double& value) const;
+    void         aux_value(GCTAEventAtom& atom, const int& column,
+                           const long long& value) const;
 
     // Protected members
     GCTARoi                    m_roi;     //!< Region of interest
     std::vector<GCTAEventAtom> m_events;  //!< Events
 
-    // IRF cache for diffuse models
-    mutable std::vector<std::string>          m_irf_names;  //!< Model names
-    mutable std::vector<std::vector<double> > m_irf_values; //!< IRF values
+    // Columnar event storage
+    bool                                      m_columnar;    //!< Columnar storage
+    std::vector<double>                       m_col_ra;      //!< Right Ascension (rad)
+    std::vector<double>                       m_col_dec;     //!< Declination (rad)
+    std::vector<double>                       m_col_logE;    //!< log10 of energy (TeV)
+    std::vector<double>                       m_col_time;    //!< Time (native seconds)
+    std::vector<int>                          m_col_index;   //!< Event index
+    mutable std::vector<std::vector<double> > m_aux;         //!< Unpacked auxiliary columns
+    mutable std::vector<GFitsTableCol*>       m_aux_cols;    //!< Packed auxiliary columns
+    mutable std::vector<bool>                 m_aux_lazy;    //!< Column not yet read from file
+    std::string                               m_filename;    //!< Event file name
+    std::vector<std::string>                  m_projection;  //!< Projected auxiliary columns
+    bool                                      m_projected;   //!< Column projection active
+    mutable std::vector<GCTAEventAtom>        m_views;       //!< Event views (one per thread)
+    mutable std::map<std::vector<int>,GCTAEventAtom> m_views_nested; //!< Event views of nested threads
+
+    // IRF cache
+    mutable std::map<std::string,int>         m_irf_handles; //!< Handles
+    mutable std::vector<std::string>          m_irf_names;   //!< Model names
+    mutable std::vector<std::vector<double> > m_irf_pars;    //!< Model parameters
+    mutable std::vector<std::vector<double> > m_irf_values;  //!< IRF values
+    mutable std::vector<std::vector<float> >  m_irf_fvalues; //!< Float IRF values
+    mutable std::vector<std::vector<double> > m_irf_grads;   //!< IRF gradients
+    mutable std::vector<unsigned long>        m_irf_used;    //!< Last use
+    mutable unsigned long                     m_irf_clock;   //!< Use counter
+    mutable unsigned long                     m_irf_hits;    //!< Cache hits
+    mutable unsigned long                     m_irf_misses;  //!< Cache misses
+    mutable double                            m_irf_memory;  //!< Used memory (MB)
+    double                                    m_irf_max_memory; //!< Max. memory (MB)
+    bool                                      m_irf_float;   //!< Use floats
+
+    // Event geometry cache
+    mutable std::vector<double>               m_geo_key;     //!< Geometry key
+    mutable std::vector<double>               m_geo_values;  //!< Geometry values
+    mutable int                               m_geo_stride;  //!< Values per event
 };
 
 
+/***********************************************************************//**
+ * @brief Get prepared cache IRF value
+ *
+ * @param[in] handle IRF cache handle.
+ * @param[in] index Event index [0,...,size()-1].
+ * @return IRF value (-1 if no cache value found).
+ *
+ * Returns a cache IRF value without locking the cache. The method may be
+ * called concurrently by several threads as long as the cache is not
+ * modified through any of the other cache methods, hence the handle needs
+ * to be prepared before using irf_cache_prepare().
+ ***************************************************************************/
+inline
+double GCTAEventList::irf_cache_value(const int& handle,
+                                      const int& index) const
+{
+    double irf = -1.0;
+    if (handle >= 0 && handle < m_irf_names.size() && index >= 0) {
+        if (m_irf_float) {
+            if (index < m_irf_fvalues[handle].size()) {
+                irf = (m_irf_fvalues[handle])[index];
+            }
+        }
+        else if (index < m_irf_values[handle].size()) {
+            irf = (m_irf_values[handle])[index];
+        }
+    }
+    return irf;
+}
+
+
+/***********************************************************************//**
+ * @brief Set prepared cache IRF value
+ *
+ * @param[in] handle IRF cache handle.
+ * @param[in] index Event index [0,...,size()-1].
+ * @param[in] irf IRF value.
+ *
+ * Stores a cache IRF value without locking the cache. The value is only
+ * stored if memory was allocated by irf_cache_prepare(). Several threads
+ * may store values concurrently as long as they store different events.
+ ***************************************************************************/
+inline
+void GCTAEventList::irf_cache_value(const int& handle, const int& index,
+                                    const double& irf) const
+{
+    if (handle >= 0 && handle < m_irf_names.size() && index >= 0) {
+        if (m_irf_float) {
+            if (index < m_irf_fvalues[handle].size()) {
+                (m_irf_fvalues[handle])[index] = float(irf);
+            }
+        }
+        else if (index < m_irf_values[handle].size()) {
+            (m_irf_values[handle])[index] = irf;
+        }
+    }
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Get prepared cache IRF gradients
+ *
+ * @param[in] handle IRF cache handle.
+ * @param[in] index Event index [0,...,size()-1].
+ * @param[out] grads IRF gradients (at least one per model parameter).
+ * @return True if gradients were found.
+ *
+ * Copies the cache IRF gradients of an event into @p grads without locking
+ * the cache. The same conditions as for irf_cache_value() apply.
+ ***************************************************************************/
+inline
+bool GCTAEventList::irf_cache_gradients(const int&           handle,
+                                        const int&           index,
+                                        std::vector<double>* grads) const
+{
+    bool found = false;
+    if (handle >= 0 && handle < m_irf_names.size() && index >= 0) {
+        int npars = m_irf_pars[handle].size();
+        if (npars == 0) {
+            found = true;
+        }
+        else if (npars <= grads->size() &&
+                 (index+1) * (npars+1) <= m_irf_grads[handle].size()) {
+            const double* ptr = &((m_irf_grads[handle])[index * (npars+1)]);
+            if (ptr[0] != 0.0) {
+                for (int i = 0; i < npars; ++i) {
+                    (*grads)[i] = ptr[i+1];
+                }
+                found = true;
+            }
+        }
+    }
+    return found;
+}
+
+
+/***********************************************************************//**
+ * @brief Set prepared cache IRF gradients
+ *
+ * @param[in] handle IRF cache handle.
+ * @param[in] index Event index [0,...,size()-1].
+ * @param[in] grads IRF gradients (one per model parameter).
+ *
+ * Stores the cache IRF gradients of an event without locking the cache.
+ * The same conditions as for irf_cache_value() apply.
+ ***************************************************************************/
+inline
+void GCTAEventList::irf_cache_gradients(const int&                 handle,
+                                        const int&                 index,
+                                        const std::vector<double>& grads) const
+{
+    if (handle >= 0 && handle < m_irf_names.size() && index >= 0) {
+        int npars = m_irf_pars[handle].size();
+        if (npars > 0 && npars <= grads.size() &&
+            (index+1) * (npars+1) <= m_irf_grads[handle].size()) {
+            double* ptr = &((m_irf_grads[handle])[index * (npars+1)]);
+            ptr[0] = 1.0;
+            for (int i = 0; i < npars; ++i) {
+                ptr[i+1] = grads[i];
+            }
+        }
+    }
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Return event geometry values without locking
+ *
+ * @param[in] index Event index [0,...,size()-1].
+ * @return Pointer to geometry values (NULL if no values exist).
+ *
+ * Returns a pointer to the geometry values of an event without locking the
+ * cache. The method may be called concurrently by several threads as long
+ * as the cache is not modified, hence the key needs to be validated before
+ * using has_geometry().
+ ***************************************************************************/
+inline
+const double* GCTAEventList::geometry_values(const int& index) const
+{
+    const double* values = NULL;
+    if (m_geo_stride > 0 && index >= 0 &&
+        (index+1) * m_geo_stride <= m_geo_values.size()) {
+        values = &(m_geo_values[index * m_geo_stride]);
+    }
+    return values;
+}
+
+
 /***********************************************************************//**
  * @brief Return number of events in list
  *
@@ -115,7 +422,7 @@ protected:
 inline
 int GCTAEventList::size(void) const
 {
-    return (m_events.size());
+    return ((m_columnar) ? m_col_index.size() : m_events.size());
 }
 
 
@@ -127,7 +434,7 @@ int GCTAEventList::size(void) const
 inline
 int GCTAEventList::number(void) const
 {
-    return (m_events.size());
+    return (size());
 }
 
 
@@ -144,17 +451,168 @@ const GCTARoi& GCTAEventList::roi(void) const
 
 
 /***********************************************************************//**
- * @brief Reserves space for events
+ * @brief Signals if events are stored in columnar form
  *
- * @param[in] number Number of events.
+ * @return True if events are stored in columnar form.
+ ***************************************************************************/
+inline
+const bool& GCTAEventList::columnar(void) const
+{
+    return (m_columnar);
+}
+
+
+/***********************************************************************//**
+ * @brief Return column projection
  *
- * Reserves space for number events in the event list.
+ * @return Names of auxiliary columns that are read from the event file.
  ***************************************************************************/
 inline
-void GCTAEventList::reserve(const int& number)
+const std::vector<std::string>& GCTAEventList::projection(void) const
 {
-    m_events.reserve(number);
-    return;
+    return (m_projection);
+}
+
+
+/***********************************************************************//**
+ * @brief Signals if a column projection is active
+ *
+ * @return True if a column projection is active.
+ ***************************************************************************/
+inline
+const bool& GCTAEventList::projected(void) const
+{
+    return (m_projected);
+}
+
+
+/***********************************************************************//**
+ * @brief Return Right Ascension column
+ *
+ * @return Right Ascension of events (radians).
+ *
+ * The column is only filled in columnar mode.
+ ***************************************************************************/
+inline
+const std::vector<double>& GCTAEventList::ra(void) const
+{
+    return (m_col_ra);
+}
+
+
+/***********************************************************************//**
+ * @brief Return Declination column
+ *
+ * @return Declination of events (radians).
+ *
+ * The column is only filled in columnar mode.
+ ***************************************************************************/
+inline
+const std::vector<double>& GCTAEventList::dec(void) const
+{
+    return (m_col_dec);
+}
+
+
+/***********************************************************************//**
+ * @brief Return log10 energy column
+ *
+ * @return log10 of event energies in TeV.
+ *
+ * The column is only filled in columnar mode.
+ ***************************************************************************/
+inline
+const std::vector<double>& GCTAEventList::log10TeV(void) const
+{
+    return (m_col_logE);
+}
+
+
+/***********************************************************************//**
+ * @brief Return time column
+ *
+ * @return Event times in seconds with respect to the native time reference.
+ *
+ * The column is only filled in columnar mode.
+ ***************************************************************************/
+inline
+const std::vector<double>& GCTAEventList::times(void) const
+{
+    return (m_col_time);
+}
+
+
+/***********************************************************************//**
+ * @brief Return index column
+ *
+ * @return Event indices.
+ *
+ * The column is only filled in columnar mode.
+ ***************************************************************************/
+inline
+const std::vector<int>& GCTAEventList::indices(void) const
+{
+    return (m_col_index);
+}
+
+
+/***********************************************************************//**
+ * @brief Return IRF cache memory ceiling
+ *
+ * @return Memory ceiling (MB). A value of 0 means no ceiling.
+ ***************************************************************************/
+inline
+const double& GCTAEventList::irf_cache_max_memory(void) const
+{
+    return (m_irf_max_memory);
+}
+
+
+/***********************************************************************//**
+ * @brief Signals if IRF cache values are stored in single precision
+ *
+ * @return True if IRF cache values are stored as floats.
+ ***************************************************************************/
+inline
+const bool& GCTAEventList::irf_cache_float(void) const
+{
+    return (m_irf_float);
+}
+
+
+/***********************************************************************//**
+ * @brief Return memory used by IRF cache
+ *
+ * @return Memory used by IRF cache (MB).
+ ***************************************************************************/
+inline
+double GCTAEventList::irf_cache_memory(void) const
+{
+    return (m_irf_memory);
+}
+
+
+/***********************************************************************//**
+ * @brief Return number of IRF cache hits
+ *
+ * @return Number of IRF cache hits.
+ ***************************************************************************/
+inline
+const unsigned long& GCTAEventList::irf_cache_hits(void) const
+{
+    return (m_irf_hits);
+}
+
+
+/***********************************************************************//**
+ * @brief Return number of IRF cache misses
+ *
+ * @return Number of IRF cache misses.
+ ***************************************************************************/
+inline
+const unsigned long& GCTAEventList::irf_cache_misses(void) const
+{
+    return (m_irf_misses);
 }
 
 #endif /* GCTAEVENTLIST_HPP */
@@ -0,0 +1,241 @@
+/***************************************************************************
+ *            GCTAEventStream.hpp - CTA event stream class                 *
+ * ----------------------------------------------------------------------- *
+ *  copyright (C) 2013 by Juergen Knoedlseder                              *
+ * ----------------------------------------------------------------------- *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.  *
+ *                                                                         *
+ ***************************************************************************/
+/**
+ * @file GCTAEventStream.hpp
+ * @brief CTA event stream class interface definition
+ * @author Juergen Knoedlseder
+ */
+
+#ifndef GCTAEVENTSTREAM_HPP
+#define GCTAEVENTSTREAM_HPP
+
+/* __ Includes ___________________________________________________________ */
+#include <string>
+#include "GBase.hpp"
+#include "GFits.hpp"
+#include "GEbounds.hpp"
+#include "GCTARoi.hpp"
+#include "GCTAEventList.hpp"
+
+
+/***********************************************************************//**
+ * @class GCTAEventStream
+ *
+ * @brief CTA event stream class
+ *
+ * This class provides sequential access to the events of a CTA event file
+ * in chunks of a fixed number of rows. Each call of next() reads the next
+ * chunk of rows from the EVENTS extension into an event list, so that only
+ * a single chunk of events is held in memory at any time. This allows
+ * processing event files that do not fit into memory in a single pass.
+ *
+ * The event list that is filled by next() carries the Good Time Intervals,
+ * the region of interest and the energy boundaries of the event file. If a
+ * region of interest or energy boundaries are specified for the stream,
+ * only events that fall within them are kept, and the event list carries
+ * the selection region of interest and energy boundaries instead.
+ *
+ * The FITS file is opened when the first chunk is read. Copies of an event
+ * stream open their own file handle when they first read events.
+ ***************************************************************************/
+class GCTAEventStream : public GBase {
+
+public:
+    // Constructors and destructors
+    GCTAEventStream(void);
+    explicit GCTAEventStream(const std::string& filename,
+                             const int&         chunk_size = 100000);
+    GCTAEventStream(const GCTAEventStream& stream);
+    virtual ~GCTAEventStream(void);
+
+    // Operators
+    GCTAEventStream& operator=(const GCTAEventStream& stream);
+
+    // Implemented pure virtual base class methods
+    virtual void             clear(void);
+    virtual GCTAEventStream* clone(void) const;
+    virtual std::string      print(const GChatter& chatter = NORMAL) const;
+
+    // Other methods
+    void                 open(const std::string& filename);
+    void                 close(void);
+    bool                 is_open(void) const;
+    void                 rewind(void);
+    bool                 next(GCTAEventList& events);
+    int                  size(void) const;
+    const int&           row(void) const;
+    void                 chunk_size(const int& chunk_size);
+    const int&           chunk_size(void) const;
+    void                 roi(const GCTARoi& roi);
+    const GCTARoi&       roi(void) const;
+    void                 ebounds(const GEbounds& ebounds);
+    const GEbounds&      ebounds(void) const;
+    const std::string&   filename(void) const;
+    const GCTAEventList& header(void) const;
+
+protected:
+    // Protected methods
+    void init_members(void);
+    void copy_members(const GCTAEventStream& stream);
+    void free_members(void);
+    void open_file(void);
+
+    // Protected members
+    std::string   m_filename;   //!< Event file name
+    GFits         m_fits;       //!< Event file (opened on first read)
+    int           m_chunk_size; //!< Number of rows per chunk
+    int           m_row;        //!< Next row to read
+    int           m_nrows;      //!< Number of rows in event file
+    GCTARoi       m_roi;        //!< Selection region of interest
+    GEbounds      m_ebounds;    //!< Selection energy boundaries
+    GCTAEventList m_header;     //!< Event list header (without events)
+};
+
+
+/***********************************************************************//**
+ * @brief Signals if event stream is associated with an event file
+ *
+ * @return True if event stream is associated with an event file.
+ ***************************************************************************/
+inline
+bool GCTAEventStream::is_open(void) const
+{
+    return (!m_filename.empty());
+}
+
+
+/***********************************************************************//**
+ * @brief Return number of rows in event file
+ *
+ * @return Number of rows in event file.
+ ***************************************************************************/
+inline
+int GCTAEventStream::size(void) const
+{
+    return (m_nrows);
+}
+
+
+/***********************************************************************//**
+ * @brief Return next row to read
+ *
+ * @return Index of next row that will be read from event file.
+ ***************************************************************************/
+inline
+const int& GCTAEventStream::row(void) const
+{
+    return (m_row);
+}
+
+
+/***********************************************************************//**
+ * @brief Return chunk size
+ *
+ * @return Number of rows that are read per chunk.
+ ***************************************************************************/
+inline
+const int& GCTAEventStream::chunk_size(void) const
+{
+    return (m_chunk_size);
+}
+
+
+/***********************************************************************//**
+ * @brief Return selection region of interest
+ *
+ * @return Selection region of interest.
+ ***************************************************************************/
+inline
+const GCTARoi& GCTAEventStream::roi(void) const
+{
+    return (m_roi);
+}
+
+
+/***********************************************************************//**
+ * @brief Set selection region of interest
+ *
+ * @param[in] roi Selection region of interest.
+ *
+ * Sets the region of interest that is used for event selection. A region
+ * of interest with a radius that is not positive disables the selection.
+ ***************************************************************************/
+inline
+void GCTAEventStream::roi(const GCTARoi& roi)
+{
+    m_roi = roi;
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Return selection energy boundaries
+ *
+ * @return Selection energy boundaries.
+ ***************************************************************************/
+inline
+const GEbounds& GCTAEventStream::ebounds(void) const
+{
+    return (m_ebounds);
+}
+
+
+/***********************************************************************//**
+ * @brief Set selection energy boundaries
+ *
+ * @param[in] ebounds Selection energy boundaries.
+ *
+ * Sets the energy boundaries that are used for event selection. Empty
+ * energy boundaries disable the selection.
+ ***************************************************************************/
+inline
+void GCTAEventStream::ebounds(const GEbounds& ebounds)
+{
+    m_ebounds = ebounds;
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Return event file name
+ *
+ * @return Event file name.
+ ***************************************************************************/
+inline
+const std::string& GCTAEventStream::filename(void) const
+{
+    return (m_filename);
+}
+
+
+/***********************************************************************//**
+ * @brief Return event list header
+ *
+ * @return Event list holding the Good Time Intervals, region of interest
+ *         and energy boundaries of the event file, but no events.
+ ***************************************************************************/
+inline
+const GCTAEventList& GCTAEventStream::header(void) const
+{
+    return (m_header);
+}
+
+#endif /* GCTAEVENTSTREAM_HPP */
@@ -36,6 +36,7 @@
 #include "GCTAOnOffObservation.hpp"
 #include "GCTAOnOffObservations.hpp"
 #include "GCTAEventList.hpp"
+#include "GCTAEventStream.hpp"
 #include "GCTAEventAtom.hpp"
 #include "GCTAEventCube.hpp"
 #include "GCTAEventBin.hpp"
@@ -92,6 +92,10 @@ protected:
     void            free_members(void);
     void            set_pointers(void);
     bool            valid_model(void) const;
+    double          eval_spatial(const GPhoton&      photon,
+                                 const GEvent&       event,
+                                 const GObservation& obs,
+                                 const bool&         gradients) const;
     GModelSpatial*  xml_spatial(const GXmlElement& spatial) const;
     GModelSpectral* xml_spectral(const GXmlElement& spectral) const;
     GModelTemporal* xml_temporal(const GXmlElement& temporal) const;
@@ -29,9 +29,11 @@
 
 /* __ Includes ___________________________________________________________ */
 #include <string>
+#include <vector>
 #include "GObservation.hpp"
 #include "GCTAResponse.hpp"
 #include "GCTAPointing.hpp"
+#include "GCTAEventStream.hpp"
 
 /* __ Forward declarations _______________________________________________ */
 class GTime;
@@ -74,6 +76,10 @@ public:
 
     // Other methods
     void                load_unbinned(const std::string& filename);
+    void                load_unbinned(const std::string&              filename,
+                                      const std::vector<std::string>& columns);
+    void                stream_unbinned(const std::string& filename,
+                                        const int&         chunk_size = 100000);
     void                load_binned(const std::string& filename);
     void                save(const std::string& filename,
                              const bool& clobber = false) const;
@@ -92,6 +98,7 @@ public:
     void                deadc(const double& deadc);
     void                eventfile(const std::string& filename);
     const std::string&  eventfile(void) const;
+    const GCTAEventStream& stream(void) const;
 
 protected:
     // Protected methods
@@ -101,17 +108,24 @@ protected:
     void read_attributes(const GFitsHDU& hdu);
     void write_attributes(GFitsHDU& hdu) const;
 
+    // Likelihood methods
+    virtual double likelihood_poisson_unbinned(const GModels& models,
+                                               GVector*       gradient,
+                                               GMatrixSparse* curvature,
+                                               double*        npred) const;
+
     // Protected members
-    std::string  m_instrument;   //!< Instrument name
-    std::string  m_eventfile;    //!< Event filename
-    GCTAResponse m_response;     //!< Instrument response functions
-    GCTAPointing m_pointing;     //!< Pointing direction
-    int          m_obs_id;       //!< Observation ID
-    double       m_ontime;       //!< Ontime
-    double       m_livetime;     //!< Livetime
-    double       m_deadc;        //!< Deadtime correction
-    double       m_ra_obj;       //!< Right Ascension of object
-    double       m_dec_obj;      //!< Declination of object
+    std::string     m_instrument;   //!< Instrument name
+    std::string     m_eventfile;    //!< Event filename
+    GCTAResponse    m_response;     //!< Instrument response functions
+    GCTAPointing    m_pointing;     //!< Pointing direction
+    int             m_obs_id;       //!< Observation ID
+    double          m_ontime;       //!< Ontime
+    double          m_livetime;     //!< Livetime
+    double          m_deadc;        //!< Deadtime correction
+    double          m_ra_obj;       //!< Right Ascension of object
+    double          m_dec_obj;      //!< Declination of object
+    GCTAEventStream m_stream;       //!< Event stream (optional)
 };
 
 
@@ -326,4 +340,19 @@ const std::string& GCTAObservation::eventfile(void) const
     return m_eventfile;
 }
 
+
+/***********************************************************************//**
+ * @brief Return event stream
+ *
+ * @return Event stream.
+ *
+ * The event stream is only open if the observation was set up using
+ * stream_unbinned().
+ ***************************************************************************/
+inline
+const GCTAEventStream& GCTAObservation::stream(void) const
+{
+    return m_stream;
+}
+
 #endif /* GCTAOBSERVATION_HPP */
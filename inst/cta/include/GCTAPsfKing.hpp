@@ -82,6 +82,10 @@ public:
                            const bool&   etrue = true) const;
     std::string  print(const GChatter& chatter = NORMAL) const;
 
+    // Other methods
+    void                     compile(const int& nlogE, const int& ntheta);
+    const GCTAResponseTable& table(void) const;
+
 
 private:
     // Methods
@@ -117,4 +121,16 @@ std::string GCTAPsfKing::filename(void) const
     return m_filename;
 }
 
+
+/***********************************************************************//**
+ * @brief Return point spread function response table
+ *
+ * @return Point spread function response table.
+ ***************************************************************************/
+inline
+const GCTAResponseTable& GCTAPsfKing::table(void) const
+{
+    return m_psf;
+}
+
 #endif /* GCTAPsfKing_HPP */
@@ -42,9 +42,13 @@ class GPhoton;
 class GEbounds;
 class GEvent;
 class GObservation;
+class GModels;
+class GModelSpatial;
 class GCTAObservation;
 class GCTAPointing;
 class GCTAEventAtom;
+class GCTAEventList;
+class GCTAEventCube;
 class GCTARoi;
 class GCTAInstDir;
 class GCTAAeff;
@@ -82,12 +86,19 @@ public:
     virtual std::string   print(const GChatter& chatter = NORMAL) const;
 
     // Overload virtual base class methods
+    virtual bool   has_irf_gradients(void) const;
+    virtual double irf(const GEvent&       event,
+                       const GSource&      source,
+                       const GObservation& obs,
+                       const bool&         grad = false) const;
     virtual double irf_radial(const GEvent&       event,
                               const GSource&      source,
-                              const GObservation& obs) const;
+                              const GObservation& obs,
+                              const bool&         grad = false) const;
     virtual double irf_elliptical(const GEvent&       event,
                                   const GSource&      source,
-                                  const GObservation& obs) const;
+                                  const GObservation& obs,
+                                  const bool&         grad = false) const;
     virtual double irf_diffuse(const GEvent&       event,
                                const GSource&      source,
                                const GObservation& obs) const;
@@ -97,6 +108,9 @@ public:
                                     const GObservation& obs) const;
     virtual double npred_diffuse(const GSource&      source,
                                  const GObservation& obs) const;
+    virtual void   set_source_caches(const GObservation& obs,
+                                     const GModels&      models) const;
+    virtual void   clear_source_caches(const GObservation& obs) const;
 
     // Other Methods
     GCTAEventAtom*     mc(const double& area, const GPhoton& photon,
@@ -110,6 +124,7 @@ public:
     void               load_aeff(const std::string& filename);
     void               load_psf(const std::string& filename);
     void               load_edisp(const std::string& filename);
+    void               compile(const int& nlogE, const int& ntheta);
     void               offset_sigma(const double& sigma);
     double             offset_sigma(void) const;
     const GCTAAeff*    aeff(void) const;
@@ -166,6 +181,39 @@ private:
                                         const GObservation& obs) const;
     const GCTAInstDir&     retrieve_dir(const std::string& origin,
                                         const GEvent&      event) const;
+    int                    irf_cache_handle(const GCTAEventList& list,
+                                            const GEvent&        event,
+                                            const GSource&       source) const;
+    bool                   irf_cache_pars(const GEvent&        event,
+                                          const GSource&       source,
+                                          std::vector<double>* pars) const;
+    bool                   irf_cache_pars(const GModelSpatial&  model,
+                                          std::vector<double>* pars) const;
+    int                    source_cache_handle(const GSource& source) const;
+    double                 irf_cache_value(const GCTAEventList& list,
+                                           const int&           handle,
+                                           const int&           index) const;
+    void                   irf_cache_value(const GCTAEventList& list,
+                                           const int&           handle,
+                                           const int&           index,
+                                           const double&        irf) const;
+    void                   compile_irfs(void);
+    void                   event_geometry(const GEvent&       event,
+                                          const GCTAInstDir&  dir,
+                                          const GCTAPointing& pnt,
+                                          const GObservation& obs,
+                                          double*             geo) const;
+    std::vector<double>    geometry_key(const GCTAEventList& list,
+                                        const GCTAPointing&  pnt) const;
+    void                   list_geometry(const GCTAEventList&       list,
+                                         const GCTAPointing&        pnt,
+                                         const std::vector<double>& key) const;
+    void                   compute_geometry(const GSkyDir&      dir,
+                                            const double&       obsLogEng,
+                                            const double&       index,
+                                            const GCTAPointing& pnt,
+                                            double*             geo) const;
+    void                   set_psf_id(void);
 
     // Private data members
     std::string         m_caldb;    //!< Name of or path to the calibration database
@@ -175,12 +223,23 @@ private:
     GCTAAeff*           m_aeff;     //!< Effective area
     GCTAPsf*            m_psf;      //!< Point spread function
     GCTAEdisp*          m_edisp;    //!< Energy dispersion
+    int                 m_grid_nlogE;  //!< Compiled grid energies (0=none)
+    int                 m_grid_ntheta; //!< Compiled grid offset angles
+    unsigned long       m_psf_id;   //!< Point spread function identifier
 
     // Npred cache
     mutable std::vector<std::string> m_npred_names;    //!< Model names
     mutable std::vector<GEnergy>     m_npred_energies; //!< Model energy
     mutable std::vector<GTime>       m_npred_times;    //!< Model time
     mutable std::vector<double>      m_npred_values;   //!< Model values
+
+    // Source caches of current model evaluation (see set_source_caches())
+    mutable bool                              m_src_set;     //!< Caches set
+    mutable bool                              m_geo_set;     //!< Geometry validated
+    mutable std::vector<const GModelSpatial*> m_src_models;  //!< Spatial models
+    mutable std::vector<int>                  m_src_handles; //!< IRF cache handles
+    mutable unsigned long                     m_src_hits;    //!< IRF cache hits
+    mutable unsigned long                     m_src_misses;  //!< IRF cache misses
 };
 
 
@@ -208,6 +267,18 @@ bool GCTAResponse::has_tdisp(void) const
 }
 
 
+/***********************************************************************//**
+ * @brief Signal if response computes spatial model parameter gradients
+ *
+ * @return True.
+ ***************************************************************************/
+inline
+bool GCTAResponse::has_irf_gradients(void) const
+{
+    return true;
+}
+
+
 /***********************************************************************//**
  * @brief Return calibration database
  *
@@ -315,6 +386,7 @@ inline
 void GCTAResponse::psf(GCTAPsf* psf)
 {
     m_psf = psf;
+    set_psf_id();
     return;
 }
 
@@ -42,6 +42,12 @@
  *
  * A response table contains response parameters in multi-dimensional vector
  * column format. Each dimension is described by axes columns. 
+ *
+ * Two-dimensional tables may be compiled onto a regular grid using the
+ * compile() method. The interpolation of a compiled table then reduces to
+ * index arithmetic on the regular grid, avoiding the bisection of the axis
+ * nodes. Values outside the grid are still computed from the original
+ * table.
  ***************************************************************************/
 class GCTAResponseTable : public GBase {
 
@@ -73,6 +79,9 @@ public:
     void               axis_log10(const int& index);
     void               axis_radians(const int& index);
     void               scale(const int& index, const double& scale);
+    void               compile(const int& n1, const int& n2);
+    bool               is_compiled(void) const;
+    double             compile_error(const int& index) const;
     void               read(const GFitsTable& hdu);
     void               write(GFitsTable& hdu) const;
     std::string        print(const GChatter& chatter = NORMAL) const;
@@ -85,8 +94,12 @@ private:
     void read_colnames(const GFitsTable& hdu);
     void read_axes(const GFitsTable& hdu);
     void read_pars(const GFitsTable& hdu);
-    void update(const double& arg) const;
-    void update(const double& arg1, const double& arg2) const;
+    void weights(const double& arg, int* inx, double* wgt) const;
+    void weights(const double& arg1, const double& arg2,
+                 int* inx, double* wgt) const;
+    bool grid_weights(const double& arg1, const double& arg2,
+                      int* inx, double* wgt) const;
+    void free_grid(void);
 
     // Table information
     int                               m_naxes;       //!< Number of axes
@@ -100,21 +113,17 @@ private:
     std::vector<GNodeArray>           m_axis_nodes;  //!< Axes node arrays
     std::vector<std::vector<double> > m_pars;        //!< Parameters
 
-    // Response table computation cache for 1D access
-    mutable int    m_inx_left;                       //!< Index of left node
-    mutable int    m_inx_right;                      //!< Index of right node
-    mutable double m_wgt_left;                       //!< Weight of left node
-    mutable double m_wgt_right;                      //!< Weight of right node
-
-    // Response table computation cache for 2D access
-    mutable int    m_inx1;                           //!< Index of upper left node
-    mutable int    m_inx2;                           //!< Index of lower left node
-    mutable int    m_inx3;                           //!< Index of upper right node
-    mutable int    m_inx4;                           //!< Index of lower right node
-    mutable double m_wgt1;                           //!< Weight of upper left node
-    mutable double m_wgt2;                           //!< Weight of lower left node
-    mutable double m_wgt3;                           //!< Weight of upper right node
-    mutable double m_wgt4;                           //!< Weight of lower right node
+    // Compiled grid
+    int                               m_grid_n1;     //!< Grid size in first axis (0=none)
+    int                               m_grid_n2;     //!< Grid size in second axis
+    double                            m_grid_min1;   //!< First axis grid minimum
+    double                            m_grid_max1;   //!< First axis grid maximum
+    double                            m_grid_min2;   //!< Second axis grid minimum
+    double                            m_grid_max2;   //!< Second axis grid maximum
+    double                            m_grid_scale1; //!< First axis nodes per unit
+    double                            m_grid_scale2; //!< Second axis nodes per unit
+    std::vector<std::vector<double> > m_grid;        //!< Grid parameters
+    std::vector<double>               m_grid_error;  //!< Maximum relative grid error
 };
 
 
@@ -160,4 +169,16 @@ const int& GCTAResponseTable::axes(void) const
     return m_naxes;
 }
 
+
+/***********************************************************************//**
+ * @brief Signals whether response table has been compiled
+ *
+ * @return True if response table has been compiled onto a regular grid.
+ ***************************************************************************/
+inline
+bool GCTAResponseTable::is_compiled(void) const
+{
+    return (m_grid_n1 > 0);
+}
+
 #endif /* GCTARESPONSETABLE_HPP */
@@ -60,6 +60,7 @@ public:
     const double&  solidangle(void) const;
     const GEnergy& ewidth(void) const;
     const double&  ontime(void) const;
+    const int&     index(void) const;
 };
 
 
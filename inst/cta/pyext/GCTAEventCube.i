@@ -54,6 +54,7 @@ public:
     virtual void           read(const GFits& file);
     virtual void           write(GFits& file) const;
     virtual int            number(void) const;
+    virtual bool           thread_safe(void) const;
 
     // Other methods
     void                   map(const GSkymap& map);
@@ -62,6 +63,13 @@ public:
     int                    ny(void) const;
     int                    npix(void) const;
     int                    ebins(void) const;
+    void                   fill(const GCTAEventList& events);
+    int                    irf_cache_handle(const std::string&         name,
+                                            const std::vector<double>& pars) const;
+    double                 irf_cache(const int& handle, const int& index) const;
+    void                   irf_cache(const int& handle, const int& index,
+                                     const double& irf) const;
+    void                   irf_cache_clear(void);
 };
 
 
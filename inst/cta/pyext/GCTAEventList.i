@@ -56,11 +56,41 @@ public:
     virtual const GCTARoi& roi(void) const;
 
     // Implement other methods
-    void   append(const GCTAEventAtom& event);
-    void   reserve(const int& number);
-    double irf_cache(const std::string& name, const int& index) const;
-    void   irf_cache(const std::string& name, const int& index,
-                     const double& irf) const;
+    void                 load(const std::string&              filename,
+                              const std::vector<std::string>& columns);
+    void                 read(const GFits&                    file,
+                              const std::vector<std::string>& columns);
+    void                 projection(const std::vector<std::string>& columns);
+    const std::vector<std::string>& projection(void) const;
+    const bool&          projected(void) const;
+    void                 append(const GCTAEventAtom& event);
+    void                 reserve(const int& number);
+    void                 columnar(const bool& columnar);
+    const bool&          columnar(void) const;
+    const std::vector<double>& ra(void) const;
+    const std::vector<double>& dec(void) const;
+    const std::vector<double>& log10TeV(void) const;
+    const std::vector<double>& times(void) const;
+    const std::vector<int>&    indices(void) const;
+    const std::vector<double>& column(const std::string& name) const;
+    int                  irf_cache_handle(const std::string& name) const;
+    int                  irf_cache_handle(const std::string&         name,
+                                          const std::vector<double>& pars) const;
+    double               irf_cache(const int& handle, const int& index) const;
+    void                 irf_cache(const int& handle, const int& index,
+                                   const double& irf) const;
+    double               irf_cache(const std::string& name,
+                                   const int&         index) const;
+    void                 irf_cache(const std::string& name, const int& index,
+                                   const double& irf) const;
+    void                 irf_cache_clear(void);
+    void                 irf_cache_max_memory(const double& mbytes);
+    const double&        irf_cache_max_memory(void) const;
+    void                 irf_cache_float(const bool& use_float);
+    const bool&          irf_cache_float(void) const;
+    double               irf_cache_memory(void) const;
+    const unsigned long& irf_cache_hits(void) const;
+    const unsigned long& irf_cache_misses(void) const;
 };
 
 
@@ -73,7 +103,7 @@ public:
     }
     GCTAEventAtom* __getitem__(int index) {
         if (index >= 0 && index < self->size())
-            return (*self)[index];
+            return const_cast<GCTAEventAtom*>((*(const GCTAEventList*)self)[index]);
         else
             throw GException::out_of_range("__getitem__(int)", index, self->size());
     }
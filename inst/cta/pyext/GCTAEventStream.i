@@ -0,0 +1,77 @@
+/***************************************************************************
+ *             GCTAEventStream.i - CTA event stream class                  *
+ * ----------------------------------------------------------------------- *
+ *  copyright (C) 2013 by Juergen Knoedlseder                              *
+ * ----------------------------------------------------------------------- *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.  *
+ *                                                                         *
+ ***************************************************************************/
+/**
+ * @file GCTAEventStream.i
+ * @brief CTA event stream class interface definition
+ * @author Juergen Knoedlseder
+ */
+%{
+/* Put headers and other declarations here that are needed for compilation */
+#include "GCTAEventStream.hpp"
+%}
+
+
+/***********************************************************************//**
+ * @class GCTAEventStream
+ *
+ * @brief CTA event stream class
+ ***************************************************************************/
+class GCTAEventStream : public GBase {
+
+public:
+    // Constructors and destructors
+    GCTAEventStream(void);
+    explicit GCTAEventStream(const std::string& filename,
+                             const int&         chunk_size = 100000);
+    GCTAEventStream(const GCTAEventStream& stream);
+    virtual ~GCTAEventStream(void);
+
+    // Implemented pure virtual base class methods
+    virtual void             clear(void);
+    virtual GCTAEventStream* clone(void) const;
+
+    // Other methods
+    void                 open(const std::string& filename);
+    void                 close(void);
+    bool                 is_open(void) const;
+    void                 rewind(void);
+    bool                 next(GCTAEventList& events);
+    int                  size(void) const;
+    const int&           row(void) const;
+    void                 chunk_size(const int& chunk_size);
+    const int&           chunk_size(void) const;
+    void                 roi(const GCTARoi& roi);
+    const GCTARoi&       roi(void) const;
+    void                 ebounds(const GEbounds& ebounds);
+    const GEbounds&      ebounds(void) const;
+    const std::string&   filename(void) const;
+    const GCTAEventList& header(void) const;
+};
+
+
+/***********************************************************************//**
+ * @brief GCTAEventStream class extension
+ ***************************************************************************/
+%extend GCTAEventStream {
+    GCTAEventStream copy() {
+        return (*self);
+    }
+};
@@ -56,6 +56,10 @@ public:
 
     // Other methods
     void                load_unbinned(const std::string& filename);
+    void                load_unbinned(const std::string&              filename,
+                                      const std::vector<std::string>& columns);
+    void                stream_unbinned(const std::string& filename,
+                                        const int&         chunk_size = 100000);
     void                load_binned(const std::string& filename);
     void                save(const std::string& filename,
                              const bool& clobber = false) const;
@@ -74,6 +78,7 @@ public:
     void                deadc(const double& deadc);
     void                eventfile(const std::string& filename);
     const std::string&  eventfile(void) const;
+    const GCTAEventStream& stream(void) const;
 };
 
 
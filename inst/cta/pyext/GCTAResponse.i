@@ -54,9 +54,19 @@ public:
                                 const GObservation& obs) const;
 
     // Overload virtual base class methods
+    virtual bool   has_irf_gradients(void) const;
+    virtual double irf(const GEvent&       event,
+                       const GSource&      source,
+                       const GObservation& obs,
+                       const bool&         grad = false) const;
     virtual double irf_radial(const GEvent&       event,
                               const GSource&      source,
-                              const GObservation& obs) const;
+                              const GObservation& obs,
+                              const bool&         grad = false) const;
+    virtual double irf_elliptical(const GEvent&       event,
+                                  const GSource&      source,
+                                  const GObservation& obs,
+                                  const bool&         grad = false) const;
     virtual double irf_diffuse(const GEvent&       event,
                                const GSource&      source,
                                const GObservation& obs) const;
@@ -67,6 +67,7 @@
 %include "GCTAOnOffObservations.i"
 %include "GCTAEventCube.i"
 %include "GCTAEventList.i"
+%include "GCTAEventStream.i"
 %include "GCTAEventBin.i"
 %include "GCTAEventAtom.i"
 %include "GCTAPointing.i"
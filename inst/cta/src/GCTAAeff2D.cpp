@@ -303,6 +303,27 @@ void GCTAAeff2D::read(const GFits& fits)
 }
 
 
+/***********************************************************************//**
+ * @brief Compile effective area onto a regular grid
+ *
+ * @param[in] nlogE Number of grid nodes in log10 energy (>=2).
+ * @param[in] ntheta Number of grid nodes in offset angle (>=2).
+ *
+ * Compiles the effective area response table onto a regular grid in log10
+ * energy and offset angle (see GCTAResponseTable::compile()). The maximum
+ * interpolation error of the grid can be retrieved from the response table
+ * using table().compile_error().
+ ***************************************************************************/
+void GCTAAeff2D::compile(const int& nlogE, const int& ntheta)
+{
+    // Compile response table
+    m_aeff.compile(nlogE, ntheta);
+
+    // Return
+    return;
+}
+
+
 /***********************************************************************//**
  * @brief Print effective area information
  *
@@ -338,6 +359,10 @@ std::string GCTAAeff2D::print(const GChatter& chatter) const
         result.append(gammalib::str(emin)+" - "+gammalib::str(emax)+" TeV");
         result.append("\n"+gammalib::parformat("Offset angle range"));
         result.append(gammalib::str(omin)+" - "+gammalib::str(omax)+" deg");
+        if (m_aeff.is_compiled()) {
+            result.append("\n"+gammalib::parformat("Max. grid error"));
+            result.append(gammalib::str(m_aeff.compile_error(0)));
+        }
 
     } // endif: chatter was not silent
 
@@ -404,6 +404,22 @@ const double& GCTAEventBin::ontime(void) const
 }
 
 
+/***********************************************************************//**
+ * @brief Return index of event bin
+ *
+ * @return Index of event bin in event cube (-1 if bin is not part of a
+ *         cube).
+ *
+ * Returns the index of the event bin in the event cube that was used to
+ * set up the bin.
+ ***************************************************************************/
+const int& GCTAEventBin::index(void) const
+{
+    // Return index
+    return m_index;
+}
+
+
 /***********************************************************************//**
  * @brief Print event information
  *
@@ -447,6 +463,7 @@ void GCTAEventBin::init_members(void)
     m_solidangle = NULL;
     m_ewidth     = NULL;
     m_ontime     = NULL;
+    m_index      = -1;
 
     // Return
     return;
@@ -468,6 +485,7 @@ void GCTAEventBin::copy_members(const GCTAEventBin& bin)
     m_solidangle = bin.m_solidangle;
     m_ewidth     = bin.m_ewidth;
     m_ontime     = bin.m_ontime;
+    m_index      = bin.m_index;
 
     // Return
     return;
@@ -28,10 +28,18 @@
 #ifdef HAVE_CONFIG_H
 #include <config.h>
 #endif
+#include <algorithm>
+#include "GException.hpp"
 #include "GTools.hpp"
 #include "GFits.hpp"
 #include "GCTAException.hpp"
 #include "GCTAEventCube.hpp"
+#include "GCTAEventList.hpp"
+
+/* __ OpenMP section _____________________________________________________ */
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 /* __ Method name definitions ____________________________________________ */
 #define G_NAXIS                                   "GCTAEventCube::naxis(int)"
@@ -83,8 +91,12 @@ GCTAEventCube::GCTAEventCube(const GSkymap& map, const GEbounds& ebds,
     // Initialise members
     init_members();
 
-    // Set sky map, energy boundaries and GTI
+    // Set sky map, energy boundaries and GTI. The event bins reference the
+    // sky map pixels, hence the event cube needs its own double precision
+    // pixels.
     m_map = map;
+    m_map.shared_pixels(false);
+    m_map.float_pixels(false);
     this->ebounds(ebds);
     this->gti(gti);
 
@@ -174,15 +186,14 @@ GCTAEventCube& GCTAEventCube::operator=(const GCTAEventCube& cube)
  *
  * @param[in] index Event index [0,...,size()-1].
  *
- * Returns pointer to an event bin.
+ * Returns pointer to an event bin. The pointer refers to the event bin of
+ * the calling thread and is valid until the next access from the same
+ * thread.
  ***************************************************************************/
 GCTAEventBin* GCTAEventCube::operator[](const int& index)
 {
-    // Set event bin
-    set_bin(index);
-
-    // Return pointer
-    return (&m_bin);
+    // Set event bin and return pointer
+    return (set_bin(index));
 }
 
 
@@ -191,15 +202,14 @@ GCTAEventBin* GCTAEventCube::operator[](const int& index)
  *
  * @param[in] index Event index [0,...,size()-1].
  *
- * Returns pointer to an event bin.
+ * Returns pointer to an event bin. The pointer refers to the event bin of
+ * the calling thread and is valid until the next access from the same
+ * thread.
  ***************************************************************************/
 const GCTAEventBin* GCTAEventCube::operator[](const int& index) const
 {
-    // Set event bin (circumvent const correctness)
-    (const_cast<GCTAEventCube*>(this))->set_bin(index);
-
-    // Return pointer
-    return (&m_bin);
+    // Set event bin and return pointer (circumvent const correctness)
+    return ((const_cast<GCTAEventCube*>(this))->set_bin(index));
 }
 
 
@@ -437,13 +447,31 @@ int GCTAEventCube::number(void) const
 }
 
 
+/***********************************************************************//**
+ * @brief Signals if event bins can be accessed from several threads
+ *
+ * @return True if event bins can be accessed from several threads.
+ *
+ * Returns true since the event cube provides an event bin for each thread
+ * that accesses the event cube (see thread_bin()).
+ ***************************************************************************/
+bool GCTAEventCube::thread_safe(void) const
+{
+    // Return flag
+    return true;
+}
+
+
 /***********************************************************************//**
  * @brief Set event cube from sky map
  ***************************************************************************/
 void GCTAEventCube::map(const GSkymap& map)
 {
-    // Store sky map
+    // Store sky map. The event bins reference the sky map pixels, hence
+    // the event cube needs its own double precision pixels.
     m_map = map;
+    m_map.shared_pixels(false);
+    m_map.float_pixels(false);
 
     // Compute sky directions
     set_directions();
@@ -453,6 +481,232 @@ void GCTAEventCube::map(const GSkymap& map)
 }
 
 
+/***********************************************************************//**
+ * @brief Fill events into event cube
+ *
+ * @param[in] events Event list.
+ *
+ * Adds all events of the event list that fall within the sky map, the
+ * energy boundaries and the Good Time Intervals of the event cube to the
+ * counts of the event cube. The counts are not reset, hence an event file
+ * can be binned in a single pass by filling the chunks of an event stream
+ * one after the other (see GCTAEventStream).
+ *
+ * The sky map pixels of all selected events are determined in a single
+ * batched transformation.
+ ***************************************************************************/
+void GCTAEventCube::fill(const GCTAEventList& events)
+{
+    // Allocate directions and energy bins of selected events
+    std::vector<GSkyDir> dirs;
+    std::vector<int>     iebins;
+    dirs.reserve(events.size());
+    iebins.reserve(events.size());
+
+    // Loop over all events
+    for (int i = 0; i < events.size(); ++i) {
+
+        // Get event
+        const GCTAEventAtom* event = events[i];
+
+        // Skip event if it is outside the Good Time Intervals
+        if (m_gti.size() > 0 && !m_gti.contains(event->time())) {
+            continue;
+        }
+
+        // Determine energy bin and skip event if it is outside the
+        // energy boundaries
+        int iebin = m_ebounds.index(event->energy());
+        if (iebin < 0) {
+            continue;
+        }
+
+        // Collect event direction and energy bin
+        dirs.push_back(event->dir().dir());
+        iebins.push_back(iebin);
+
+    } // endfor: looped over all events
+
+    // Determine sky map pixels of selected events
+    std::vector<GSkyPixel> pixels = m_map.dir2pix(dirs);
+
+    // Add events that fall within the sky map to counts
+    for (int i = 0; i < pixels.size(); ++i) {
+        if (m_map.contains(pixels[i])) {
+            m_map(m_map.pix2inx(pixels[i]), iebins[i]) += 1.0;
+        }
+    }
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Return IRF cache handle for a given model and parameters
+ *
+ * @param[in] name Model name.
+ * @param[in] pars Model parameter values.
+ * @return IRF cache handle.
+ *
+ * Returns the IRF cache handle for the model with the specified @p name.
+ * If the model is not yet in the cache, a new handle is created. The
+ * parameter values @p pars are the values on which the cached IRF values
+ * depend. If they differ from the values that were specified when the
+ * cached values were computed, all cached values of the model are reset.
+ ***************************************************************************/
+int GCTAEventCube::irf_cache_handle(const std::string&         name,
+                                    const std::vector<double>& pars) const
+{
+    // Initialise handle
+    int handle = -1;
+
+    // Get handle. The cache is shared by all threads that process the
+    // event cube, hence the cache access is protected by a critical region.
+    #pragma omp critical(GCTAEventCube_irf_cache)
+    {
+        // Search model name
+        std::map<std::string,int>::const_iterator it = m_irf_handles.find(name);
+
+        // If model was found then reset cache values if the parameters
+        // have changed ...
+        if (it != m_irf_handles.end()) {
+            handle = it->second;
+            if (m_irf_pars[handle] != pars) {
+                m_irf_pars[handle] = pars;
+                m_irf_values[handle].clear();
+                m_irf_grads[handle].clear();
+            }
+        }
+
+        // ... otherwise add model to cache. No memory is allocated before
+        // the first IRF value is stored.
+        else {
+            handle = m_irf_pars.size();
+            m_irf_handles[name] = handle;
+            m_irf_pars.push_back(pars);
+            m_irf_values.push_back(std::vector<double>());
+            m_irf_grads.push_back(std::vector<double>());
+        }
+    }
+
+    // Return handle
+    return handle;
+}
+
+
+/***********************************************************************//**
+ * @brief Get cache IRF value
+ *
+ * @param[in] handle IRF cache handle.
+ * @param[in] index Event bin index [0,...,size()-1].
+ * @return IRF value (-1 if no cache value found).
+ ***************************************************************************/
+double GCTAEventCube::irf_cache(const int& handle, const int& index) const
+{
+    // Initialise IRF value to invalid value
+    double irf = -1.0;
+
+    // Get IRF value. The cache is shared by all threads that process the
+    // event cube, hence the cache access is protected by a critical region.
+    #pragma omp critical(GCTAEventCube_irf_cache)
+    {
+        if (handle >= 0 && handle < m_irf_values.size()) {
+            if (index >= 0 && index < m_irf_values[handle].size()) {
+                irf = (m_irf_values[handle])[index];
+            }
+        }
+    }
+
+    // Return IRF value
+    return irf;
+}
+
+
+/***********************************************************************//**
+ * @brief Set cache IRF value
+ *
+ * @param[in] handle IRF cache handle.
+ * @param[in] index Event bin index [0,...,size()-1].
+ * @param[in] irf IRF value.
+ *
+ * Stores an IRF value in the cache. If no values were stored so far for
+ * the model, memory for the values of all event bins is allocated.
+ ***************************************************************************/
+void GCTAEventCube::irf_cache(const int& handle, const int& index,
+                              const double& irf) const
+{
+    // Set IRF value. The cache is shared by all threads that process the
+    // event cube, hence the cache access is protected by a critical region.
+    #pragma omp critical(GCTAEventCube_irf_cache)
+    {
+        if (handle >= 0 && handle < m_irf_values.size()) {
+            if (m_irf_values[handle].empty()) {
+                m_irf_values[handle].assign(size(), -1.0);
+            }
+            if (index >= 0 && index < m_irf_values[handle].size()) {
+                (m_irf_values[handle])[index] = irf;
+            }
+        }
+    }
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Prepare IRF cache values of a model
+ *
+ * @param[in] handle IRF cache handle.
+ *
+ * Allocates the IRF cache values and gradients of the model for all event
+ * bins if they have not yet been allocated, so that they can subsequently
+ * be accessed with irf_cache_value() and irf_cache_gradients() without
+ * locking. The gradients of each event bin are preceded by a flag that
+ * signals whether gradients were stored.
+ ***************************************************************************/
+void GCTAEventCube::irf_cache_prepare(const int& handle) const
+{
+    // Allocate values. The cache is shared by all threads that process the
+    // event cube, hence the cache access is protected by a critical region.
+    #pragma omp critical(GCTAEventCube_irf_cache)
+    {
+        if (handle >= 0 && handle < m_irf_values.size()) {
+            int npars = m_irf_pars[handle].size();
+            if (m_irf_values[handle].empty()) {
+                m_irf_values[handle].assign(size(), -1.0);
+            }
+            if (npars > 0 && m_irf_grads[handle].empty()) {
+                m_irf_grads[handle].assign(size() * (npars+1), 0.0);
+            }
+        }
+    }
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Clear IRF cache
+ *
+ * Removes all models and IRF values from the IRF cache. Handles that were
+ * obtained before become invalid.
+ ***************************************************************************/
+void GCTAEventCube::irf_cache_clear(void)
+{
+    // Clear cache
+    m_irf_handles.clear();
+    m_irf_pars.clear();
+    m_irf_values.clear();
+    m_irf_grads.clear();
+
+    // Return
+    return;
+}
+
+
 /***********************************************************************//**
  * @brief Print event cube information
  *
@@ -525,13 +779,21 @@ void GCTAEventCube::init_members(void)
 {
     // Initialise members
     m_map.clear();
-    m_bin.clear();
+    m_bins.clear();
+    m_bins_nested.clear();
     m_time.clear();
     m_dirs.clear();
     m_solidangle.clear();
     m_energies.clear();
     m_ewidth.clear();
     m_ontime = 0.0;
+    m_irf_handles.clear();
+    m_irf_pars.clear();
+    m_irf_values.clear();
+    m_irf_grads.clear();
+
+    // Allocate event bins
+    init_bins();
 
     // Return
     return;
@@ -542,12 +804,14 @@ void GCTAEventCube::init_members(void)
  * @brief Copy class members
  *
  * @param[in] cube Event cube.
+ *
+ * The event bins are not copied since they point to the members of the
+ * copied event cube. They are set up when a bin is accessed.
  ***************************************************************************/
 void GCTAEventCube::copy_members(const GCTAEventCube& cube)
 {
     // Copy members
     m_map        = cube.m_map;
-    m_bin        = cube.m_bin;
     m_time       = cube.m_time;
     m_dirs       = cube.m_dirs;
     m_solidangle = cube.m_solidangle;
@@ -555,6 +819,12 @@ void GCTAEventCube::copy_members(const GCTAEventCube& cube)
     m_ewidth     = cube.m_ewidth;
     m_ontime     = cube.m_ontime;
 
+    // Copy IRF cache
+    m_irf_handles = cube.m_irf_handles;
+    m_irf_pars    = cube.m_irf_pars;
+    m_irf_values  = cube.m_irf_values;
+    m_irf_grads   = cube.m_irf_grads;
+
     // Return
     return;
 }
@@ -649,6 +919,10 @@ void GCTAEventCube::read_gti(const GFitsTable& hdu)
  * lie outside the valid sky region. As invalid pixels lead to exceptions
  * in the WCS classes, we simply need to catch the exceptions here. Invalid
  * pixels are signaled by setting the solid angle of the pixel to 0.
+ *
+ * The pixel directions are computed in a single batched transformation.
+ * If the map contains invalid pixels the batched transformation fails,
+ * and the pixel directions are computed pixel by pixel.
  ***************************************************************************/
 void GCTAEventCube::set_directions(void)
 {
@@ -658,6 +932,9 @@ void GCTAEventCube::set_directions(void)
                                    " needs a definition of the sky pixels.");
     }
 
+    // Clear IRF cache since the event bins change
+    irf_cache_clear();
+
     // Clear old pixel directions and solid angle
     m_dirs.clear();
     m_solidangle.clear();
@@ -666,13 +943,32 @@ void GCTAEventCube::set_directions(void)
     m_dirs.reserve(npix());
     m_solidangle.reserve(npix());
 
-    // Set pixel directions and solid angles
+    // Set sky map pixels
+    std::vector<GSkyPixel> pixels;
+    pixels.reserve(npix());
     for (int iy = 0; iy < ny(); ++iy) {
         for (int ix = 0; ix < nx(); ++ix) {
+            pixels.push_back(GSkyPixel(double(ix), double(iy)));
+        }
+    }
+
+    // Set pixel directions and solid angles using a batched transformation
+    try {
+        std::vector<GSkyDir> dirs = m_map.pix2dir(pixels);
+        for (int i = 0; i < pixels.size(); ++i) {
+            m_dirs.push_back(GCTAInstDir(dirs[i]));
+            m_solidangle.push_back(m_map.solidangle(pixels[i]));
+        }
+    }
+
+    // ... otherwise set pixel directions and solid angles pixel by pixel
+    catch (GException::wcs_invalid_x_y& e) {
+        m_dirs.clear();
+        m_solidangle.clear();
+        for (int i = 0; i < pixels.size(); ++i) {
             try {
-                GSkyPixel pixel = GSkyPixel(double(ix), double(iy));
-                m_dirs.push_back(GCTAInstDir(m_map.pix2dir(pixel)));
-                m_solidangle.push_back(m_map.solidangle(pixel));
+                m_dirs.push_back(GCTAInstDir(m_map.pix2dir(pixels[i])));
+                m_solidangle.push_back(m_map.solidangle(pixels[i]));
             }
             catch (GException::wcs_invalid_x_y& e) {
                 m_dirs.push_back(GCTAInstDir());
@@ -704,6 +1000,9 @@ void GCTAEventCube::set_energies(void)
                              " needs a definition of the energy boundaries.");
     }
 
+    // Clear IRF cache since the event bins change
+    irf_cache_clear();
+
     // Clear old bin energies and energy widths
     m_energies.clear();
     m_ewidth.clear();
@@ -745,6 +1044,9 @@ void GCTAEventCube::set_times(void)
                   " associated GTIs to allow the computation of the ontime.");
     }
 
+    // Clear IRF cache since the event bins change
+    irf_cache_clear();
+
     // Compute mean time
     m_time = 0.5 * (m_gti.tstart() + m_gti.tstop());
 
@@ -760,6 +1062,7 @@ void GCTAEventCube::set_times(void)
  * @brief Set event bin
  *
  * @param[in] index Event index [0,...,size()-1].
+ * @return Pointer to event bin.
  *
  * @exception GException::out_of_range
  *            Event index is outside valid range.
@@ -768,13 +1071,13 @@ void GCTAEventCube::set_times(void)
  * @exception GCTAException::no_dirs
  *            Sky directions and solid angles vectors have not been set up.
  *
- * This method provides the event attributes to the event bin. The event bin
- * is in fact physically stored in the event cube, and only a single event
- * bin is indeed allocated. This method sets up the pointers in the event
- * bin so that a client can easily access the information of individual bins
- * as if they were stored in an array.
+ * This method provides the event attributes to the event bin of the calling
+ * thread. The event bin is in fact physically stored in the event cube, and
+ * only a single event bin per thread is indeed allocated. This method sets
+ * up the pointers in the event bin so that a client can easily access the
+ * information of individual bins as if they were stored in an array.
  ***************************************************************************/
-void GCTAEventCube::set_bin(const int& index)
+GCTAEventBin* GCTAEventCube::set_bin(const int& index)
 {
     // Optionally check if the index is valid
     #if defined(G_RANGE_CHECK)
@@ -793,18 +1096,99 @@ void GCTAEventCube::set_bin(const int& index)
         throw GCTAException::no_dirs(G_SET_BIN);
     }
 
+    // Get event bin of calling thread
+    GCTAEventBin* bin = thread_bin();
+
     // Get pixel and energy bin indices.
     int ipix = index % npix();
     int ieng = index / npix();
 
     // Set pointers
-    m_bin.m_counts     = const_cast<double*>(&(m_map.pixels()[index]));
-    m_bin.m_energy     = &(m_energies[ieng]);
-    m_bin.m_time       = &m_time;
-    m_bin.m_dir        = &(m_dirs[ipix]);
-    m_bin.m_solidangle = &(m_solidangle[ipix]);
-    m_bin.m_ewidth     = &(m_ewidth[ieng]);
-    m_bin.m_ontime     = &m_ontime;
+    bin->m_counts     = const_cast<double*>(&(m_map.pixels()[index]));
+    bin->m_energy     = &(m_energies[ieng]);
+    bin->m_time       = &m_time;
+    bin->m_dir        = &(m_dirs[ipix]);
+    bin->m_solidangle = &(m_solidangle[ipix]);
+    bin->m_ewidth     = &(m_ewidth[ieng]);
+    bin->m_ontime     = &m_ontime;
+    bin->m_index      = index;
+
+    // Return pointer
+    return bin;
+}
+
+
+/***********************************************************************//**
+ * @brief Return event bin of calling thread
+ *
+ * @return Pointer to event bin of calling thread.
+ *
+ * Returns the per-thread event bin if the thread number identifies the
+ * calling thread and if an event bin was allocated for the thread.
+ * Otherwise, for example for threads of nested parallel regions or if the
+ * number of threads was increased after the event cube was created, an
+ * event bin that is keyed by the thread numbers at all nesting levels is
+ * used. These event bins are created on first use under a lock.
+ ***************************************************************************/
+GCTAEventBin* GCTAEventCube::thread_bin(void)
+{
+    // Initialise pointer to event bin
+    GCTAEventBin* bin = NULL;
+
+    #ifdef _OPENMP
+    // Determine whether the thread number identifies the calling thread
+    int  level  = omp_get_level();
+    int  thread = omp_get_thread_num();
+    bool unique = true;
+    for (int l = 1; l < level; ++l) {
+        if (omp_get_team_size(l) > 1) {
+            unique = false;
+            break;
+        }
+    }
+
+    // Use per-thread event bin if possible
+    if (unique && thread < m_bins.size()) {
+        bin = &(m_bins[thread]);
+    }
+
+    // ... otherwise use an event bin keyed by the thread numbers at all
+    // levels
+    if (bin == NULL) {
+        std::vector<int> key(level, 0);
+        for (int l = 1; l <= level; ++l) {
+            key[l-1] = omp_get_ancestor_thread_num(l);
+        }
+        #pragma omp critical(GCTAEventCube_thread_bin)
+        {
+            bin = &(m_bins_nested[key]);
+        }
+    }
+    #else
+    // Use the single event bin
+    bin = &(m_bins[0]);
+    #endif
+
+    // Return pointer
+    return bin;
+}
+
+
+/***********************************************************************//**
+ * @brief Allocate event bins
+ *
+ * Allocates one event bin per thread that may access the event cube.
+ ***************************************************************************/
+void GCTAEventCube::init_bins(void)
+{
+    // Determine number of event bins
+    int num = 1;
+    #ifdef _OPENMP
+    num = std::max(omp_get_max_threads(), omp_get_num_procs());
+    #endif
+
+    // Allocate event bins
+    m_bins.assign(num, GCTAEventBin());
 
     // Return
     return;
@@ -28,9 +28,12 @@
 #ifdef HAVE_CONFIG_H
 #include <config.h>
 #endif
+#include <algorithm>
+#include <cmath>
 #include "GCTAEventList.hpp"
 #include "GCTAException.hpp"
 #include "GTools.hpp"
+#include "GMath.hpp"
 #include "GFits.hpp"
 #include "GFitsTableBitCol.hpp"
 #include "GFitsTableFloatCol.hpp"
@@ -41,8 +44,31 @@
 #include "GTime.hpp"
 #include "GTimeReference.hpp"
 
+/* __ OpenMP section _____________________________________________________ */
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+/* __ Constants __________________________________________________________ */
+const int         g_cta_aux_num                  = 21;
+const std::string g_cta_aux_names[g_cta_aux_num] = {"EVENT_ID", "OBS_ID",
+                                                    "MULTIP", "TELMASK",
+                                                    "DIR_ERR", "DETX", "DETY",
+                                                    "ALT", "AZ", "COREX",
+                                                    "COREY", "CORE_ERR",
+                                                    "XMAX", "XMAX_ERR",
+                                                    "SHWIDTH", "SHLENGTH",
+                                                    "ENERGY_ERR", "HIL_MSW",
+                                                    "HIL_MSW_ERR", "HIL_MSL",
+                                                    "HIL_MSL_ERR"};
+const int         g_cta_aux_num_int              = 4; // Integer columns first
+const int         g_cta_read_block               = 100000;
+
 /* __ Method name definitions ____________________________________________ */
 #define G_OPERATOR                          "GCTAEventList::operator[](int&)"
+#define G_COLUMN                         "GCTAEventList::column(std::string&)"
+#define G_PROJECTION    "GCTAEventList::projection(std::vector<std::string>&)"
+#define G_FETCH_COLUMN                   "GCTAEventList::fetch_column(int&)"
 #define G_ROI                                     "GCTAEventList::roi(GRoi&)"
 #define G_READ_DS_EBOUNDS         "GCTAEventList::read_ds_ebounds(GFitsHDU*)"
 #define G_READ_DS_ROI                 "GCTAEventList::read_ds_roi(GFitsHDU*)"
@@ -148,7 +174,13 @@ GCTAEventList& GCTAEventList::operator=(const GCTAEventList& list)
  * @exception GException::out_of_range
  *            Event index outside valid range.
  *
- * Returns pointer to an event atom.
+ * Returns pointer to an event atom. Since events can not be modified in
+ * columnar mode, an event list in columnar mode is converted into event
+ * atoms (see columnar()) before the pointer is returned. Use the const
+ * operator to access the events without leaving columnar mode.
+ *
+ * Since the event may be modified through the returned pointer, the event
+ * geometry cache is cleared.
  ***************************************************************************/
 GCTAEventAtom* GCTAEventList::operator[](const int& index)
 {
@@ -159,7 +191,17 @@ GCTAEventAtom* GCTAEventList::operator[](const int& index)
     }
     #endif
 
-    // Return pointer
+    // Convert events into event atoms in columnar mode
+    if (m_columnar) {
+        columnar(false);
+    }
+
+    // Clear event geometry since the caller may modify the event
+    if (m_geo_stride > 0) {
+        geometry_clear();
+    }
+
+    // Return pointer to event atom
     return (&(m_events[index]));
 }
 
@@ -172,7 +214,10 @@ GCTAEventAtom* GCTAEventList::operator[](const int& index)
  * @exception GException::out_of_range
  *            Event index outside valid range.
  *
- * Returns pointer to an event atom.
+ * Returns pointer to an event atom. In columnar mode, the pointer refers
+ * to a view on the event that is valid until the next access from the
+ * same thread. Each thread has its own view (see thread_view()), hence the
+ * operator can be used from within parallel regions.
  ***************************************************************************/
 const GCTAEventAtom* GCTAEventList::operator[](const int& index) const
 {
@@ -183,8 +228,26 @@ const GCTAEventAtom* GCTAEventList::operator[](const int& index) const
     }
     #endif
 
+    // Initialise pointer
+    const GCTAEventAtom* atom = NULL;
+
+    // In columnar mode, fill the view of the calling thread. The view is
+    // only refilled if it does not yet hold the requested event.
+    if (m_columnar) {
+        GCTAEventAtom& view = thread_view();
+        if (view.m_index != m_col_index[index]) {
+            set_view(view, index);
+        }
+        atom = &view;
+    }
+
+    // ... otherwise return pointer to event atom
+    else {
+        atom = &(m_events[index]);
+    }
+
     // Return pointer
-    return (&(m_events[index]));
+    return atom;
 }
 
 
@@ -238,13 +301,11 @@ GCTAEventList* GCTAEventList::clone(void) const
  * and read the Good Time Intervals from the GTI extension.
  *
  * The method clears the object before loading, thus any events residing in
- * the object before loading will be lost.
+ * the object before loading will be lost. The storage mode and the column
+ * projection are kept.
  ***************************************************************************/
 void GCTAEventList::load(const std::string& filename)
 {
-    // Clear object
-    clear();
-
     // Open FITS file
     GFits file(filename);
 
@@ -299,56 +360,32 @@ void GCTAEventList::save(const std::string& filename,
  * be assumed based on the TSTART and TSTOP keywords.
  *
  * The method clears the object before reading, thus any information residing
- * in the event list prior to reading will be lost.
+ * in the event list prior to reading will be lost. The storage mode (atoms
+ * or columns) and the column projection are kept.
  *
  * @todo Ultimately, any events file should have a GTI extension, hence the
  *       extraction of GTIs from TSTART and TSTOP should not be necessary.
  ***************************************************************************/
 void GCTAEventList::read(const GFits& fits)
 {
-    // Clear object
+    // Clear object but keep storage mode and column projection
+    bool                     columnar   = m_columnar;
+    bool                     projected  = m_projected;
+    std::vector<std::string> projection = m_projection;
     clear();
-
-    // Get event list HDU
-    const GFitsTable& events = *fits.table("EVENTS");
-
-    // If we have a GTI extension, then read Good Time Intervals from that
-    // extension
-    if (fits.contains("GTI")) {
-        const GFitsTable& gti = *fits.table("GTI");
-        m_gti.read(gti);
+    this->columnar(columnar);
+    if (projected) {
+        this->projection(projection);
     }
 
-    // ... otherwise build GTI from TSTART and TSTOP
-    else {
-
-        // Read start and stop time
-        double tstart = events.real("TSTART");
-        double tstop  = events.real("TSTOP");
-
-        // Create time reference from header information
-        GTimeReference timeref(events);
-
-        // Set start and stop time
-        GTime start(tstart);
-        GTime stop(tstop);
-
-        // Append start and stop time as single time interval to GTI
-        m_gti.append(start, stop);
-
-        // Set GTI time reference
-        m_gti.reference(timeref);
+    // Store file name for reading of columns on request
+    m_filename = fits.filename();
 
-    } // endelse: GTI built from TSTART and TSTOP
+    // Read Good Time Intervals, region of interest and energy boundaries
+    read_header(fits);
 
     // Load event data
-    read_events(events);
-
-    // Read region of interest from data selection keyword
-    read_ds_roi(events);
-
-    // Read energy boundaries from data selection keyword
-    read_ds_ebounds(events);
+    read_events(*fits.table("EVENTS"));
 
     // Return
     return;
@@ -370,8 +407,16 @@ void GCTAEventList::write(GFits& file) const
     // Allocate FITS binary table HDU
     GFitsBinTable* events = new GFitsBinTable;
 
-    // Write events
-    write_events(*events);
+    // Write events. In columnar mode the events are written from a copy of
+    // the event list that holds event atoms.
+    if (m_columnar) {
+        GCTAEventList list(*this);
+        list.columnar(false);
+        list.write_events(*events);
+    }
+    else {
+        write_events(*events);
+    }
 
     // Write data selection keywords
     write_ds_keys(*events);
@@ -470,18 +515,54 @@ std::string GCTAEventList::print(const GChatter& chatter) const
             }
         }
 
+        // EXPLICIT: Append event storage
+        if (chatter >= EXPLICIT) {
+            result.append("\n"+gammalib::parformat("Event storage"));
+            if (m_columnar) {
+                result.append("columns");
+                int num = 0;
+                for (int k = 0; k < g_cta_aux_num; ++k) {
+                    if (m_aux[k].size() == size()) {
+                        num++;
+                    }
+                }
+                result.append(" ("+gammalib::str(num)+" of ");
+                result.append(gammalib::str(g_cta_aux_num)+" auxiliary ");
+                result.append("columns loaded)");
+                if (m_projected) {
+                    result.append(", projected");
+                }
+            }
+            else {
+                result.append("atoms");
+            }
+        }
+
         // EXPLICIT: Append IRF cache
         if (chatter >= EXPLICIT) {
+            result.append("\n"+gammalib::parformat("IRF cache"));
+            result.append(gammalib::str(m_irf_memory)+" MB");
+            if (m_irf_max_memory > 0.0) {
+                result.append(" (max. "+gammalib::str(m_irf_max_memory)+" MB)");
+            }
+            result.append((m_irf_float) ? ", float" : ", double");
+            result.append(", "+gammalib::str(m_irf_hits)+" hits");
+            result.append(", "+gammalib::str(m_irf_misses)+" misses");
             for (int i = 0; i < m_irf_names.size(); ++i) {
                 result.append("\n"+gammalib::parformat("IRF cache " +
                               gammalib::str(i)));
                 result.append(m_irf_names[i]+" = ");
-                int num   = 0;
-                for (int k = 0; k < size(); ++k) {
+                int num = 0;
+                for (int k = 0; k < m_irf_values[i].size(); ++k) {
                     if ((m_irf_values[i])[k] != -1.0) {
                         num++;
                     }
                 }
+                for (int k = 0; k < m_irf_fvalues[i].size(); ++k) {
+                    if ((m_irf_fvalues[i])[k] != -1.0) {
+                        num++;
+                    }
+                }
                 result.append(gammalib::str(num)+" values");
             }
         } // endif: chatter was explicit
@@ -493,27 +574,334 @@ std::string GCTAEventList::print(const GChatter& chatter) const
 }
 
 
+/***********************************************************************//**
+ * @brief Load events from event FITS file with column projection
+ *
+ * @param[in] filename Name of FITS file from which events are loaded.
+ * @param[in] columns Auxiliary columns to read.
+ *
+ * Loads CTA events in columnar form, reading only the columns needed for
+ * a likelihood analysis and the specified auxiliary columns. All other
+ * auxiliary columns are read from the file when they are first requested.
+ ***************************************************************************/
+void GCTAEventList::load(const std::string&              filename,
+                         const std::vector<std::string>& columns)
+{
+    // Set column projection
+    projection(columns);
+
+    // Load events
+    load(filename);
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Read CTA events from FITS file with column projection
+ *
+ * @param[in] fits FITS file.
+ * @param[in] columns Auxiliary columns to read.
+ *
+ * Reads CTA events in columnar form, reading only the columns needed for
+ * a likelihood analysis and the specified auxiliary columns. All other
+ * auxiliary columns are read from the file when they are first requested.
+ * This requires that the FITS file is associated with a file name.
+ ***************************************************************************/
+void GCTAEventList::read(const GFits&                    fits,
+                         const std::vector<std::string>& columns)
+{
+    // Set column projection
+    projection(columns);
+
+    // Read events
+    read(fits);
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Set column projection
+ *
+ * @param[in] columns Auxiliary columns to read.
+ *
+ * @exception GException::invalid_argument
+ *            Invalid column name.
+ *
+ * Sets the auxiliary columns that will be read when events are loaded from
+ * a file. The TIME, RA, DEC and ENERGY columns are always read and may be
+ * included in the list. Setting a column projection switches the event
+ * list into columnar mode.
+ ***************************************************************************/
+void GCTAEventList::projection(const std::vector<std::string>& columns)
+{
+    // Check and store column names
+    std::vector<std::string> projection;
+    for (int i = 0; i < columns.size(); ++i) {
+
+        // Get column name
+        std::string name = gammalib::toupper(gammalib::strip_whitespace(columns[i]));
+
+        // Skip columns that are always read
+        if (name == "TIME" || name == "RA" || name == "DEC" || name == "ENERGY") {
+            continue;
+        }
+
+        // Throw an exception if the column is not an auxiliary column
+        bool found = false;
+        for (int k = 0; k < g_cta_aux_num; ++k) {
+            if (g_cta_aux_names[k] == name) {
+                found = true;
+                break;
+            }
+        }
+        if (!found) {
+            std::string msg = "Column \""+columns[i]+"\" is not an event "
+                              "column.";
+            throw GException::invalid_argument(G_PROJECTION, msg);
+        }
+
+        // Store column name
+        projection.push_back(name);
+
+    } // endfor: looped over columns
+
+    // Set projection and switch into columnar mode
+    m_projection = projection;
+    m_projected  = true;
+    columnar(true);
+
+    // Return
+    return;
+}
+
+
 /***********************************************************************//**
  * @brief Append event atom to event list
  *
  * @param[in] event Event.
  *
- * Appends an event atom to the event list.
+ * Appends an event atom to the event list. The event geometry cache is
+ * cleared.
  ***************************************************************************/
 void GCTAEventList::append(const GCTAEventAtom& event)
 {
-    // Append event
-    m_events.push_back(event);
+    // Clear event geometry
+    if (m_geo_stride > 0) {
+        geometry_clear();
+    }
+
+    // Columnar mode: append event to columns
+    if (m_columnar) {
+
+        // Make sure that all auxiliary columns are unpacked
+        load_columns();
+
+        // Append event
+        const GSkyDir& dir = event.dir().dir();
+        m_col_ra.push_back(dir.ra());
+        m_col_dec.push_back(dir.dec());
+        m_col_logE.push_back(event.energy().log10TeV());
+        m_col_time.push_back(event.time().secs());
+        m_col_index.push_back(m_col_index.size());
+        for (int k = 0; k < g_cta_aux_num; ++k) {
+            m_aux[k].push_back(aux_value(event, k));
+        }
+
+    } // endif: columnar mode
+
+    // ... otherwise append event atom
+    else {
+
+        // Append event
+        m_events.push_back(event);
+
+        // Set event index
+        int index = m_events.size()-1;
+        m_events[index].m_index = index;
+
+    } // endelse: atom mode
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Reserves space for events
+ *
+ * @param[in] number Number of events.
+ *
+ * Reserves space for number events in the event list.
+ ***************************************************************************/
+void GCTAEventList::reserve(const int& number)
+{
+    // Reserve space in columns or atoms
+    if (m_columnar) {
+        m_col_ra.reserve(number);
+        m_col_dec.reserve(number);
+        m_col_logE.reserve(number);
+        m_col_time.reserve(number);
+        m_col_index.reserve(number);
+        for (int k = 0; k < m_aux.size(); ++k) {
+            m_aux[k].reserve(number);
+        }
+    }
+    else {
+        m_events.reserve(number);
+    }
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Set event storage mode
+ *
+ * @param[in] columnar Store events in columnar form?
+ *
+ * Switches between storage of the events as event atoms and storage in
+ * columnar form. Any events in the list are converted into the new storage
+ * form. When switching into columnar mode, the per-thread event views are
+ * allocated for the current number of threads.
+ ***************************************************************************/
+void GCTAEventList::columnar(const bool& columnar)
+{
+    // Switch from atoms to columns
+    if (columnar && !m_columnar) {
+
+        // Allocate columns
+        int num = m_events.size();
+        m_col_ra.assign(num, 0.0);
+        m_col_dec.assign(num, 0.0);
+        m_col_logE.assign(num, 0.0);
+        m_col_time.assign(num, 0.0);
+        m_col_index.assign(num, 0);
+        m_aux.assign(g_cta_aux_num, std::vector<double>(num, 0.0));
+        m_aux_cols.assign(g_cta_aux_num, NULL);
+        m_aux_lazy.assign(g_cta_aux_num, false);
+
+        // Fill columns
+        for (int i = 0; i < num; ++i) {
+            const GCTAEventAtom& event = m_events[i];
+            const GSkyDir&       dir   = event.dir().dir();
+            m_col_ra[i]    = dir.ra();
+            m_col_dec[i]   = dir.dec();
+            m_col_logE[i]  = event.energy().log10TeV();
+            m_col_time[i]  = event.time().secs();
+            m_col_index[i] = i;
+            for (int k = 0; k < g_cta_aux_num; ++k) {
+                m_aux[k][i] = aux_value(event, k);
+            }
+        }
+
+        // Release event atoms
+        std::vector<GCTAEventAtom>().swap(m_events);
+
+        // Set columnar mode
+        m_columnar = true;
+
+    } // endif: switched from atoms to columns
+
+    // Switch from columns to atoms
+    else if (!columnar && m_columnar) {
+
+        // Make sure that all auxiliary columns are unpacked
+        load_columns();
+
+        // Build event atoms
+        int num = size();
+        m_events.assign(num, GCTAEventAtom());
+        for (int i = 0; i < num; ++i) {
+            set_view(m_events[i], i);
+        }
 
-    // Set event index
-    int index = m_events.size()-1;
-    m_events[index].m_index = index;
+        // Release columns
+        for (int k = 0; k < m_aux_cols.size(); ++k) {
+            if (m_aux_cols[k] != NULL) delete m_aux_cols[k];
+        }
+        std::vector<double>().swap(m_col_ra);
+        std::vector<double>().swap(m_col_dec);
+        std::vector<double>().swap(m_col_logE);
+        std::vector<double>().swap(m_col_time);
+        std::vector<int>().swap(m_col_index);
+        std::vector<std::vector<double> >().swap(m_aux);
+        m_aux_cols.clear();
+        m_aux_lazy.clear();
+        m_views.clear();
+        m_views_nested.clear();
+
+        // Remove column projection
+        m_projection.clear();
+        m_projected = false;
+
+        // Set atom mode
+        m_columnar = false;
+
+    } // endif: switched from columns to atoms
+
+    // Allocate event views
+    if (m_columnar) {
+        init_views();
+    }
 
     // Return
     return;
 }
 
 
+/***********************************************************************//**
+ * @brief Return auxiliary event column
+ *
+ * @param[in] name Column name.
+ * @return Column values.
+ *
+ * @exception GException::invalid_argument
+ *            Event list not in columnar mode or invalid column name.
+ *
+ * Returns the values of an auxiliary event column (e.g. "DETX" or
+ * "HIL_MSW"). The column is unpacked on the first request. Once a column
+ * has been unpacked, its values are also set in the event views that are
+ * returned by the operator[]. Columns that were not present in the event
+ * file are filled with zeros.
+ ***************************************************************************/
+const std::vector<double>& GCTAEventList::column(const std::string& name) const
+{
+    // Throw an exception if the list is not in columnar mode
+    if (!m_columnar) {
+        std::string msg = "Event list is not in columnar mode. Please call "
+                          "columnar(true) before requesting a column.";
+        throw GException::invalid_argument(G_COLUMN, msg);
+    }
+
+    // Search column
+    int column = -1;
+    for (int k = 0; k < g_cta_aux_num; ++k) {
+        if (g_cta_aux_names[k] == gammalib::toupper(name)) {
+            column = k;
+            break;
+        }
+    }
+
+    // Throw an exception if the column was not found
+    if (column == -1) {
+        std::string msg = "Column \""+name+"\" is not an auxiliary event "
+                          "column.";
+        throw GException::invalid_argument(G_COLUMN, msg);
+    }
+
+    // Make sure that column is unpacked
+    load_column(column);
+
+    // Return column
+    return (m_aux[column]);
+}
+
+
 /*==========================================================================
  =                                                                         =
  =                             Private methods                             =
@@ -529,9 +917,41 @@ void GCTAEventList::init_members(void)
     m_roi.clear();
     m_events.clear();
 
+    // Initialise columnar event storage
+    m_columnar = false;
+    m_col_ra.clear();
+    m_col_dec.clear();
+    m_col_logE.clear();
+    m_col_time.clear();
+    m_col_index.clear();
+    m_aux.clear();
+    m_aux_cols.clear();
+    m_aux_lazy.clear();
+    m_views.clear();
+    m_views_nested.clear();
+    m_filename.clear();
+    m_projection.clear();
+    m_projected = false;
+
     // Initialise cache
+    m_irf_handles.clear();
     m_irf_names.clear();
+    m_irf_pars.clear();
     m_irf_values.clear();
+    m_irf_fvalues.clear();
+    m_irf_grads.clear();
+    m_irf_used.clear();
+    m_irf_clock      = 0;
+    m_irf_hits       = 0;
+    m_irf_misses     = 0;
+    m_irf_memory     = 0.0;
+    m_irf_max_memory = 0.0;
+    m_irf_float      = false;
+
+    // Initialise event geometry cache
+    m_geo_key.clear();
+    m_geo_values.clear();
+    m_geo_stride = 0;
 
     // Return
     return;
@@ -549,9 +969,47 @@ void GCTAEventList::copy_members(const GCTAEventList& list)
     m_roi    = list.m_roi;
     m_events = list.m_events;
 
+    // Copy columnar event storage
+    m_columnar    = list.m_columnar;
+    m_col_ra      = list.m_col_ra;
+    m_col_dec     = list.m_col_dec;
+    m_col_logE    = list.m_col_logE;
+    m_col_time    = list.m_col_time;
+    m_col_index   = list.m_col_index;
+    m_aux         = list.m_aux;
+    m_aux_lazy    = list.m_aux_lazy;
+    m_filename    = list.m_filename;
+    m_projection  = list.m_projection;
+    m_projected   = list.m_projected;
+    m_aux_cols.assign(list.m_aux_cols.size(), NULL);
+    for (int k = 0; k < list.m_aux_cols.size(); ++k) {
+        if (list.m_aux_cols[k] != NULL) {
+            m_aux_cols[k] = list.m_aux_cols[k]->clone();
+        }
+    }
+    if (m_columnar) {
+        init_views();
+    }
+
     // Copy cache
-    m_irf_names  = list.m_irf_names;
-    m_irf_values = list.m_irf_values;
+    m_irf_handles    = list.m_irf_handles;
+    m_irf_names      = list.m_irf_names;
+    m_irf_pars       = list.m_irf_pars;
+    m_irf_values     = list.m_irf_values;
+    m_irf_fvalues    = list.m_irf_fvalues;
+    m_irf_grads      = list.m_irf_grads;
+    m_irf_used       = list.m_irf_used;
+    m_irf_clock      = list.m_irf_clock;
+    m_irf_hits       = list.m_irf_hits;
+    m_irf_misses     = list.m_irf_misses;
+    m_irf_memory     = list.m_irf_memory;
+    m_irf_max_memory = list.m_irf_max_memory;
+    m_irf_float      = list.m_irf_float;
+
+    // Copy event geometry cache
+    m_geo_key    = list.m_geo_key;
+    m_geo_values = list.m_geo_values;
+    m_geo_stride = list.m_geo_stride;
 
     // Return
     return;
@@ -563,45 +1021,69 @@ void GCTAEventList::copy_members(const GCTAEventList& list)
  ***************************************************************************/
 void GCTAEventList::free_members(void)
 {
+    // Free packed auxiliary columns
+    for (int k = 0; k < m_aux_cols.size(); ++k) {
+        if (m_aux_cols[k] != NULL) delete m_aux_cols[k];
+        m_aux_cols[k] = NULL;
+    }
+
     // Return
     return;
 }
 
 
 /***********************************************************************//**
- * @brief Read CTA events from FITS table
+ * @brief Read event list header information from FITS file
  *
- * @param[in] table FITS table.
+ * @param[in] fits FITS file.
  *
- * This method reads the CTA event list from a FITS table HDU into memory.
- * Depending on the columns existing in the file, it either selects v0 or
- * v1 of the event list reader.
+ * Reads the Good Time Intervals, the region of interest and the energy
+ * boundaries of the event list. If present, Good Time Intervals will be
+ * read from an extension names "GTI". If no "GTI" extension is present, a
+ * single Good Time Interval will be assumed based on the TSTART and TSTOP
+ * keywords. The region of interest and the energy boundaries are read from
+ * the data selection keywords of the "EVENTS" extension. No events are
+ * read.
  ***************************************************************************/
-void GCTAEventList::read_events(const GFitsTable& table)
+void GCTAEventList::read_header(const GFits& fits)
 {
-    // Clear existing events
-    m_events.clear();
+    // Get event list HDU
+    const GFitsTable& events = *fits.table("EVENTS");
 
-    // Extract number of events in FITS file
-    int num = table.integer("NAXIS2");
+    // If we have a GTI extension, then read Good Time Intervals from that
+    // extension
+    if (fits.contains("GTI")) {
+        const GFitsTable& gti = *fits.table("GTI");
+        m_gti.read(gti);
+    }
 
-    // Continue only if there are events
-    if (num > 0) {
+    // ... otherwise build GTI from TSTART and TSTOP
+    else {
 
-        // Read events for v1
-        if (table.contains("SHWIDTH") && table.contains("SHLENGTH")) {
-            read_events_v1(table);
-        }
+        // Read start and stop time
+        double tstart = events.real("TSTART");
+        double tstop  = events.real("TSTOP");
 
-        // ... otherwise read events for v0
-        else {
-            read_events_v0(table);
-        }
+        // Create time reference from header information
+        GTimeReference timeref(events);
 
-        // Read (optional) Hillas parameters
-        read_events_hillas(table);
+        // Set start and stop time
+        GTime start(tstart);
+        GTime stop(tstop);
 
-    } // endif: there were events
+        // Append start and stop time as single time interval to GTI
+        m_gti.append(start, stop);
+
+        // Set GTI time reference
+        m_gti.reference(timeref);
+
+    } // endelse: GTI built from TSTART and TSTOP
+
+    // Read region of interest from data selection keyword
+    read_ds_roi(events);
+
+    // Read energy boundaries from data selection keyword
+    read_ds_ebounds(events);
 
     // Return
     return;
@@ -609,73 +1091,34 @@ void GCTAEventList::read_events(const GFitsTable& table)
 
 
 /***********************************************************************//**
- * @brief Read CTA events from FITS table (version 0)
+ * @brief Read CTA events from FITS table
  *
  * @param[in] table FITS table.
  *
  * This method reads the CTA event list from a FITS table HDU into memory.
- * It is a minimal event reader that is compliant with the initial data
- * format distributed by Karl Kosack. Information that is not present in
- * that format is set to 0.
+ * Depending on the storage mode, the events are either read into event
+ * atoms or into columns.
  ***************************************************************************/
-void GCTAEventList::read_events_v0(const GFitsTable& table)
+void GCTAEventList::read_events(const GFitsTable& table)
 {
-    // Clear existing events
+    // Clear existing events and event geometry
     m_events.clear();
+    geometry_clear();
 
     // Extract number of events in FITS file
-    int num = table.nrows();
+    int num = table.integer("NAXIS2");
 
-    // If there are events then load them
+    // Continue only if there are events
     if (num > 0) {
 
-        // Reserve data
-        m_events.reserve(num);
+        // Read events in columnar form
+        if (m_columnar) {
+            read_events_columnar(table);
+        }
 
-        // Get column pointers
-        const GFitsTableCol* ptr_eid         = table["EVENT_ID"];
-        const GFitsTableCol* ptr_time        = table["TIME"];
-        const GFitsTableCol* ptr_multip      = table["MULTIP"];
-        const GFitsTableCol* ptr_ra          = table["RA"];
-        const GFitsTableCol* ptr_dec         = table["DEC"];
-        const GFitsTableCol* ptr_dir_err     = table["DIR_ERR"];
-        const GFitsTableCol* ptr_detx        = table["DETX"];
-        const GFitsTableCol* ptr_dety        = table["DETY"];
-        const GFitsTableCol* ptr_alt         = table["ALT"];
-        const GFitsTableCol* ptr_az          = table["AZ"];
-        const GFitsTableCol* ptr_corex       = table["COREX"];
-        const GFitsTableCol* ptr_corey       = table["COREY"];
-        const GFitsTableCol* ptr_core_err    = table["CORE_ERR"];
-        const GFitsTableCol* ptr_xmax        = table["XMAX"];
-        const GFitsTableCol* ptr_xmax_err    = table["XMAX_ERR"];
-        const GFitsTableCol* ptr_energy      = table["ENERGY"];
-        const GFitsTableCol* ptr_energy_err  = table["ENERGY_ERR"];
-
-        // Copy data from columns into GCTAEventAtom objects
-        GCTAEventAtom event;
-        for (int i = 0; i < num; ++i) {
-            event.m_index     = i;
-            event.m_time.set(ptr_time->real(i), m_gti.reference());
-            event.m_dir.dir().radec_deg(ptr_ra->real(i), ptr_dec->real(i));
-            event.m_energy.TeV(ptr_energy->real(i));
-            event.m_event_id    = ptr_eid->integer(i);
-            event.m_obs_id      = 0;
-            event.m_multip      = ptr_multip->integer(i);
-            event.m_telmask     = 0;
-            event.m_dir_err     = ptr_dir_err->real(i);
-            event.m_detx        = ptr_detx->real(i);
-            event.m_dety        = ptr_dety->real(i);
-            event.m_alt         = ptr_alt->real(i);
-            event.m_az          = ptr_az->real(i);
-            event.m_corex       = ptr_corex->real(i);
-            event.m_corey       = ptr_corey->real(i);
-            event.m_core_err    = ptr_core_err->real(i);
-            event.m_xmax        = ptr_xmax->real(i);
-            event.m_xmax_err    = ptr_xmax_err->real(i);
-            event.m_shwidth     = 0.0;
-            event.m_shlength    = 0.0;
-            event.m_energy_err  = ptr_energy_err->real(i);
-            m_events.push_back(event);
+        // ... otherwise read events into event atoms
+        else {
+            read_events_atoms(table);
         }
 
     } // endif: there were events
@@ -686,75 +1129,114 @@ void GCTAEventList::read_events_v0(const GFitsTable& table)
 
 
 /***********************************************************************//**
- * @brief Read CTA events from FITS table (version 1)
+ * @brief Read CTA events from FITS table into event atoms
  *
  * @param[in] table FITS table.
  *
  * This method reads the CTA event list from a FITS table HDU into memory.
- *
- * @todo Implement agreed column format
+ * See read_events_atoms(const GFitsTable&, const int&, const int&) for
+ * details.
  ***************************************************************************/
-void GCTAEventList::read_events_v1(const GFitsTable& table)
+void GCTAEventList::read_events_atoms(const GFitsTable& table)
 {
-    // Clear existing events
-    m_events.clear();
+    // Read all rows
+    read_events_atoms(table, 0, table.nrows());
+
+    // Return
+    return;
+}
 
-    // Extract number of events in FITS file
-    int num = table.nrows();
+
+/***********************************************************************//**
+ * @brief Read range of CTA events from FITS table into event atoms
+ *
+ * @param[in] table FITS table.
+ * @param[in] row First row to read.
+ * @param[in] nrows Number of rows to read.
+ *
+ * This method reads the rows [@p row, @p row + @p nrows - 1] of the CTA
+ * event list from a FITS table HDU into memory, replacing all events in
+ * the list. The TIME, RA, DEC and ENERGY columns are mandatory. All other
+ * event columns (EVENT_ID, OBS_ID, MULTIP, DIR_ERR, DETX, DETY, ALT, AZ,
+ * COREX, COREY, CORE_ERR, XMAX, XMAX_ERR, SHWIDTH, SHLENGTH, ENERGY_ERR and
+ * the Hillas parameters HIL_MSW, HIL_MSW_ERR, HIL_MSL and HIL_MSL_ERR) are
+ * read if they exist in the table, otherwise the information is set to 0.
+ *
+ * The columns are read in blocks of rows using GFitsTableCol::read_range().
+ * Columns that are not loaded are read block by block from the FITS file,
+ * hence only the requested rows are held in memory.
+ ***************************************************************************/
+void GCTAEventList::read_events_atoms(const GFitsTable& table,
+                                      const int&        row,
+                                      const int&        nrows)
+{
+    // Clear existing events
+    m_events.clear();
+
+    // Set number of events to read
+    int num = nrows;
 
     // If there are events then load them
     if (num > 0) {
 
-        // Reserve data
-        m_events.reserve(num);
+        // Allocate events
+        m_events.assign(num, GCTAEventAtom());
 
         // Get column pointers
-        const GFitsTableCol* ptr_eid         = table["EVENT_ID"];
-        const GFitsTableCol* ptr_oid         = table["OBS_ID"];
-        const GFitsTableCol* ptr_time        = table["TIME"];
-        const GFitsTableCol* ptr_multip      = table["MULTIP"];
-        const GFitsTableCol* ptr_ra          = table["RA"];
-        const GFitsTableCol* ptr_dec         = table["DEC"];
-        const GFitsTableCol* ptr_dir_err     = table["DIR_ERR"];
-        const GFitsTableCol* ptr_detx        = table["DETX"];
-        const GFitsTableCol* ptr_dety        = table["DETY"];
-        const GFitsTableCol* ptr_alt         = table["ALT"];
-        const GFitsTableCol* ptr_az          = table["AZ"];
-        const GFitsTableCol* ptr_corex       = table["COREX"];
-        const GFitsTableCol* ptr_corey       = table["COREY"];
-        const GFitsTableCol* ptr_core_err    = table["CORE_ERR"];
-        const GFitsTableCol* ptr_xmax        = table["XMAX"];
-        const GFitsTableCol* ptr_xmax_err    = table["XMAX_ERR"];
-        const GFitsTableCol* ptr_shw         = table["SHWIDTH"];
-        const GFitsTableCol* ptr_shl         = table["SHLENGTH"];
-        const GFitsTableCol* ptr_energy      = table["ENERGY"];
-        const GFitsTableCol* ptr_energy_err  = table["ENERGY_ERR"];
-
-        // Copy data from columns into GCTAEventAtom objects
-        GCTAEventAtom event;
-        for (int i = 0; i < num; ++i) {
-            event.m_index     = i;
-            event.m_time.set(ptr_time->real(i), m_gti.reference());
-            event.m_dir.dir().radec_deg(ptr_ra->real(i), ptr_dec->real(i));
-            event.m_energy.TeV(ptr_energy->real(i));
-            event.m_event_id    = ptr_eid->integer(i);
-            event.m_obs_id      = ptr_oid->integer(i);
-            event.m_multip      = ptr_multip->integer(i);
-            event.m_telmask     = 0;
-            event.m_dir_err     = ptr_dir_err->real(i);
-            event.m_detx        = ptr_detx->real(i);
-            event.m_dety        = ptr_dety->real(i);
-            event.m_alt         = ptr_alt->real(i);
-            event.m_az          = ptr_az->real(i);
-            event.m_corex       = ptr_corex->real(i);
-            event.m_corey       = ptr_corey->real(i);
-            event.m_core_err    = ptr_core_err->real(i);
-            event.m_xmax        = ptr_xmax->real(i);
-            event.m_xmax_err    = ptr_xmax_err->real(i);
-            event.m_shwidth     = ptr_shw->real(i);
-            event.m_shlength    = ptr_shl->real(i);
-            event.m_energy_err  = ptr_energy_err->real(i);
-            m_events.push_back(event);
+        const GFitsTableCol* ptr_time   = table["TIME"];
+        const GFitsTableCol* ptr_ra     = table["RA"];
+        const GFitsTableCol* ptr_dec    = table["DEC"];
+        const GFitsTableCol* ptr_energy = table["ENERGY"];
+
+        // Allocate block buffers
+        int                 block = std::min(num, g_cta_read_block);
+        std::vector<double> time(block);
+        std::vector<double> ra(block);
+        std::vector<double> dec(block);
+        std::vector<double> energy(block);
+
+        // Copy time, direction and energy into GCTAEventAtom objects
+        for (int first = 0; first < num; first += block) {
+            int n = std::min(block, num-first);
+            ptr_time->read_range(row+first, n, &time[0]);
+            ptr_ra->read_range(row+first, n, &ra[0]);
+            ptr_dec->read_range(row+first, n, &dec[0]);
+            ptr_energy->read_range(row+first, n, &energy[0]);
+            for (int i = 0; i < n; ++i) {
+                GCTAEventAtom& event = m_events[first+i];
+                event.m_index = first+i;
+                event.m_time.set(time[i], m_gti.reference());
+                event.m_dir.dir().radec_deg(ra[i], dec[i]);
+                event.m_energy.TeV(energy[i]);
+            }
+        }
+
+        // Copy all scalar auxiliary columns into GCTAEventAtom objects. The
+        // integer columns are read as integers so that identifiers are
+        // copied without conversion into floating point values.
+        std::vector<double>    values(block);
+        std::vector<long long> ivalues(block);
+        for (int k = 0; k < g_cta_aux_num; ++k) {
+            if (table.contains(g_cta_aux_names[k])) {
+                const GFitsTableCol* ptr = table[g_cta_aux_names[k]];
+                if (ptr->number() == 1) {
+                    for (int first = 0; first < num; first += block) {
+                        int n = std::min(block, num-first);
+                        if (k < g_cta_aux_num_int) {
+                            ptr->read_range(row+first, n, &ivalues[0]);
+                            for (int i = 0; i < n; ++i) {
+                                aux_value(m_events[first+i], k, ivalues[i]);
+                            }
+                        }
+                        else {
+                            ptr->read_range(row+first, n, &values[0]);
+                            for (int i = 0; i < n; ++i) {
+                                aux_value(m_events[first+i], k, values[i]);
+                            }
+                        }
+                    }
+                }
+            }
         }
 
     } // endif: there were events
@@ -765,62 +1247,504 @@ void GCTAEventList::read_events_v1(const GFitsTable& table)
 
 
 /***********************************************************************//**
- * @brief Read Hillas information for CTA events from FITS table
+ * @brief Select events within region of interest and energy boundaries
+ *
+ * @param[in] roi Region of interest (ignored if radius is not positive).
+ * @param[in] ebounds Energy boundaries (ignored if empty).
+ *
+ * Removes all events from the event list that fall outside the region of
+ * interest or the energy boundaries. The event indices of the remaining
+ * events are updated so that they correspond to the position of the events
+ * in the list. The method operates on event atoms only.
+ ***************************************************************************/
+void GCTAEventList::select_events(const GCTARoi& roi, const GEbounds& ebounds)
+{
+    // Determine which selections apply
+    bool use_roi     = (roi.radius() > 0.0);
+    bool use_ebounds = (ebounds.size() > 0);
+
+    // Continue only if a selection applies
+    if (use_roi || use_ebounds) {
+
+        // Move selected events to the front of the list
+        int num = 0;
+        for (int i = 0; i < m_events.size(); ++i) {
+            const GCTAEventAtom& event = m_events[i];
+            if ((!use_roi     || roi.contains(event)) &&
+                (!use_ebounds || ebounds.contains(event.energy()))) {
+                if (num != i) {
+                    m_events[num] = event;
+                }
+                m_events[num].m_index = num;
+                num++;
+            }
+        }
+
+        // Remove events that were not selected
+        m_events.resize(num);
+
+    } // endif: a selection applied
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Read CTA events from FITS table into columns
  *
  * @param[in] table FITS table.
  *
- * This method reads the Hillas reconstruction information for CTA events
- * from an EVENTS file. It searches for the columns HIL_MSW, HIL_MSW_ERR,
- * HIL_MSL, and HIL_MSL_ERR in the FITS table and extracts the relevant
- * columns from the FITS file. If a column is not found, no action is
- * performed.
+ * This method reads the CTA event list from a FITS table HDU into the
+ * columnar event storage. Only the TIME, RA, DEC and ENERGY columns are
+ * unpacked. Copies of all other event columns that exist in the table are
+ * kept in packed form and are only unpacked when requested.
  *
- * @todo Verify consistency of event list size
+ * If a column projection is active and the event list is associated with
+ * a file, only the auxiliary columns in the projection are copied. The
+ * other auxiliary columns are read from the file on request.
  ***************************************************************************/
-void GCTAEventList::read_events_hillas(const GFitsTable& table)
+void GCTAEventList::read_events_columnar(const GFitsTable& table)
 {
     // Extract number of events in FITS file
     int num = table.nrows();
 
-    //TODO: Make sure that dimension is consistent with existing event
-    //      list
+    // Get column pointers
+    const GFitsTableCol* ptr_time   = table["TIME"];
+    const GFitsTableCol* ptr_ra     = table["RA"];
+    const GFitsTableCol* ptr_dec    = table["DEC"];
+    const GFitsTableCol* ptr_energy = table["ENERGY"];
 
-    // Continue only if there are events
+    // Allocate columns
+    m_col_ra.assign(num, 0.0);
+    m_col_dec.assign(num, 0.0);
+    m_col_logE.assign(num, 0.0);
+    m_col_time.assign(num, 0.0);
+    m_col_index.assign(num, 0);
+
+    // Read columns
     if (num > 0) {
+        ptr_time->read_range(0, num, &m_col_time[0]);
+        ptr_ra->read_range(0, num, &m_col_ra[0]);
+        ptr_dec->read_range(0, num, &m_col_dec[0]);
+        ptr_energy->read_range(0, num, &m_col_logE[0]);
+    }
 
-        // HIL_MSW
-        if (table.contains("HIL_MSW")) {
-            const GFitsTableCol* ptr = table["HIL_MSW"];
-            for (int i = 0; i < num; ++i) {
-                m_events[i].m_hil_msw = ptr->real(i);
+    // Convert columns
+    GTime time;
+    for (int i = 0; i < num; ++i) {
+        time.set(m_col_time[i], m_gti.reference());
+        m_col_ra[i]    *= gammalib::deg2rad;
+        m_col_dec[i]   *= gammalib::deg2rad;
+        m_col_logE[i]   = std::log10(m_col_logE[i]);
+        m_col_time[i]   = time.secs();
+        m_col_index[i]  = i;
+    }
+
+    // Keep packed copies of the auxiliary columns that are in the
+    // projection and mark all others for reading on request
+    bool lazy = (m_projected && !m_filename.empty());
+    for (int k = 0; k < g_cta_aux_num; ++k) {
+        m_aux[k].clear();
+        m_aux_lazy[k] = false;
+        if (m_aux_cols[k] != NULL) {
+            delete m_aux_cols[k];
+            m_aux_cols[k] = NULL;
+        }
+        if (table.contains(g_cta_aux_names[k]) &&
+            table[g_cta_aux_names[k]]->number() == 1) {
+            bool read = !lazy ||
+                        (std::find(m_projection.begin(), m_projection.end(),
+                                   g_cta_aux_names[k]) != m_projection.end());
+            if (read) {
+                m_aux_cols[k] = table[g_cta_aux_names[k]]->clone();
+            }
+            else {
+                m_aux_lazy[k] = true;
             }
         }
+    }
 
-        // HIL_MSW_ERR
-        if (table.contains("HIL_MSW_ERR")) {
-            const GFitsTableCol* ptr = table["HIL_MSW_ERR"];
-            for (int i = 0; i < num; ++i) {
-                m_events[i].m_hil_msw_err = ptr->real(i);
-            }
+    // Invalidate event views
+    init_views();
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Initialise event views
+ *
+ * Marks all event views as empty and makes sure that there is one event
+ * view per thread that may access the event list in columnar mode.
+ ***************************************************************************/
+void GCTAEventList::init_views(void)
+{
+    // Mark views as empty
+    for (int i = 0; i < m_views.size(); ++i) {
+        m_views[i].m_index = -1;
+    }
+    m_views_nested.clear();
+
+    // Allocate missing views
+    grow_views(1);
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Add event views
+ *
+ * @param[in] num Minimum number of event views.
+ *
+ * Makes sure that at least @p num event views exist, and at least one
+ * event view per thread of the current thread team and per thread that a
+ * new parallel region may use. Adding views may move the existing views,
+ * hence this method must not be called while other threads access the
+ * event list.
+ ***************************************************************************/
+void GCTAEventList::grow_views(const int& num) const
+{
+    // Determine number of views
+    int required = num;
+    #ifdef _OPENMP
+    required = std::max(required, omp_get_max_threads());
+    required = std::max(required, omp_get_num_procs());
+    required = std::max(required, omp_get_num_threads());
+    #endif
+
+    // Add views and mark them as empty
+    int current = m_views.size();
+    if (current < required) {
+        m_views.resize(required, GCTAEventAtom());
+        for (int i = current; i < required; ++i) {
+            m_views[i].m_index = -1;
         }
+    }
+
+    // Return
+    return;
+}
 
-        // HIL_MSL
-        if (table.contains("HIL_MSL")) {
-            const GFitsTableCol* ptr = table["HIL_MSL"];
-            for (int i = 0; i < num; ++i) {
-                m_events[i].m_hil_msl = ptr->real(i);
+
+/***********************************************************************//**
+ * @brief Set event atom from columns
+ *
+ * @param[in,out] atom Event atom.
+ * @param[in] index Event index [0,...,size()-1].
+ *
+ * Sets an event atom from the columnar event storage. Only auxiliary
+ * columns that have been unpacked are set.
+ ***************************************************************************/
+void GCTAEventList::set_view(GCTAEventAtom& atom, const int& index) const
+{
+    // Set event information that is needed for likelihood analysis
+    atom.m_index = m_col_index[index];
+    atom.m_dir.dir().radec(m_col_ra[index], m_col_dec[index]);
+    atom.m_energy.log10TeV(m_col_logE[index]);
+    atom.m_time.secs(m_col_time[index]);
+
+    // Set unpacked auxiliary information
+    int num = m_col_index.size();
+    for (int k = 0; k < m_aux.size(); ++k) {
+        if (m_aux[k].size() == num) {
+            aux_value(atom, k, m_aux[k][index]);
+        }
+    }
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Return event view of calling thread
+ *
+ * @return Event view of calling thread.
+ *
+ * Returns the event view of the calling thread. The thread number
+ * identifies the calling thread if none of the enclosing parallel regions
+ * has more than one thread. In that case the view is taken from the
+ * per-thread views, which are added if needed outside a parallel region.
+ * For nested parallel regions, or for threads without a per-thread view
+ * in a parallel region, the view is taken from a map that is keyed by the
+ * thread numbers at all nesting levels. Views in the map are added under
+ * a lock and keep their address, hence they can be used concurrently.
+ ***************************************************************************/
+GCTAEventAtom& GCTAEventList::thread_view(void) const
+{
+    // Initialise pointer to view
+    GCTAEventAtom* view = NULL;
+
+    #ifdef _OPENMP
+    // Determine whether the thread number identifies the calling thread
+    int  level  = omp_get_level();
+    int  thread = omp_get_thread_num();
+    bool unique = true;
+    for (int l = 1; l < level; ++l) {
+        if (omp_get_team_size(l) > 1) {
+            unique = false;
+            break;
+        }
+    }
+
+    // Use per-thread view if possible
+    if (unique) {
+        if (thread >= m_views.size() && !omp_in_parallel()) {
+            grow_views(thread+1);
+        }
+        if (thread < m_views.size()) {
+            view = &(m_views[thread]);
+        }
+    }
+
+    // ... otherwise use a view keyed by the thread numbers at all levels
+    if (view == NULL) {
+        std::vector<int> key(level, 0);
+        for (int l = 1; l <= level; ++l) {
+            key[l-1] = omp_get_ancestor_thread_num(l);
+        }
+        #pragma omp critical(GCTAEventList_thread_view)
+        {
+            std::map<std::vector<int>,GCTAEventAtom>::iterator it =
+                                             m_views_nested.find(key);
+            if (it == m_views_nested.end()) {
+                it = m_views_nested.insert(std::make_pair(key,
+                                           GCTAEventAtom())).first;
+                it->second.m_index = -1;
             }
+            view = &(it->second);
         }
+    }
+    #else
+    // Use the single view
+    if (m_views.empty()) {
+        grow_views(1);
+    }
+    view = &(m_views[0]);
+    #endif
+
+    // Return view
+    return *view;
+}
 
-        // HIL_MSL_ERR
-        if (table.contains("HIL_MSL_ERR")) {
-            const GFitsTableCol* ptr = table["HIL_MSL_ERR"];
-            for (int i = 0; i < num; ++i) {
-                m_events[i].m_hil_msl_err = ptr->real(i);
+
+/***********************************************************************//**
+ * @brief Unpack auxiliary column
+ *
+ * @param[in] column Auxiliary column index.
+ *
+ * Unpacks an auxiliary column if it has not been unpacked before. Columns
+ * that were not read due to a column projection are read from the event
+ * file. Columns without data are filled with zeros. The event views are
+ * invalidated so that they get the unpacked values on the next access.
+ ***************************************************************************/
+void GCTAEventList::load_column(const int& column) const
+{
+    // Continue only if column is not yet unpacked
+    int num = size();
+    if (m_aux[column].size() != num) {
+
+        // Unpack column
+        m_aux[column].assign(num, 0.0);
+        if (m_aux_cols[column] != NULL) {
+            if (num > 0) {
+                m_aux_cols[column]->read_range(0, num, &(m_aux[column][0]));
             }
+            delete m_aux_cols[column];
+            m_aux_cols[column] = NULL;
+        }
+        else if (m_aux_lazy[column]) {
+            fetch_column(column);
         }
 
-    } // endif: there were events
+        // Invalidate event views
+        for (int i = 0; i < m_views.size(); ++i) {
+            m_views[i].m_index = -1;
+        }
+        std::map<std::vector<int>,GCTAEventAtom>::iterator it;
+        for (it = m_views_nested.begin(); it != m_views_nested.end(); ++it) {
+            it->second.m_index = -1;
+        }
+
+    } // endif: column was not unpacked
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Read auxiliary column from event file
+ *
+ * @param[in] column Auxiliary column index.
+ *
+ * @exception GException::invalid_value
+ *            Number of rows in event file differs from number of events.
+ *
+ * Reads an auxiliary column that was skipped by the column projection from
+ * the EVENTS extension of the event file.
+ ***************************************************************************/
+void GCTAEventList::fetch_column(const int& column) const
+{
+    // Open FITS file
+    GFits fits(m_filename);
+
+    // Get column
+    const GFitsTable&    table = *fits.table("EVENTS");
+    const GFitsTableCol* ptr   = table[g_cta_aux_names[column]];
+
+    // Throw an exception if the number of rows changed
+    int num = m_aux[column].size();
+    if (table.nrows() != num) {
+        std::string msg = "Event file \""+m_filename+"\" has "+
+                          gammalib::str(table.nrows())+" events while "+
+                          gammalib::str(num)+" events were expected.";
+        throw GException::invalid_value(G_FETCH_COLUMN, msg);
+    }
+
+    // Read column
+    if (num > 0) {
+        ptr->read_range(0, num, &(m_aux[column][0]));
+    }
+
+    // Close FITS file
+    fits.close();
+
+    // Signal that column was read
+    m_aux_lazy[column] = false;
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Unpack all auxiliary columns
+ ***************************************************************************/
+void GCTAEventList::load_columns(void) const
+{
+    // Unpack all columns
+    for (int k = 0; k < m_aux.size(); ++k) {
+        load_column(k);
+    }
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Return auxiliary information of event atom
+ *
+ * @param[in] atom Event atom.
+ * @param[in] column Auxiliary column index.
+ * @return Auxiliary information.
+ ***************************************************************************/
+double GCTAEventList::aux_value(const GCTAEventAtom& atom,
+                                const int&           column) const
+{
+    // Initialise value
+    double value = 0.0;
+
+    // Get value
+    switch (column) {
+    case 0:  value = double(atom.m_event_id); break;
+    case 1:  value = double(atom.m_obs_id); break;
+    case 2:  value = atom.m_multip; break;
+    case 3:  value = atom.m_telmask; break;
+    case 4:  value = atom.m_dir_err; break;
+    case 5:  value = atom.m_detx; break;
+    case 6:  value = atom.m_dety; break;
+    case 7:  value = atom.m_alt; break;
+    case 8:  value = atom.m_az; break;
+    case 9:  value = atom.m_corex; break;
+    case 10: value = atom.m_corey; break;
+    case 11: value = atom.m_core_err; break;
+    case 12: value = atom.m_xmax; break;
+    case 13: value = atom.m_xmax_err; break;
+    case 14: value = atom.m_shwidth; break;
+    case 15: value = atom.m_shlength; break;
+    case 16: value = atom.m_energy_err; break;
+    case 17: value = atom.m_hil_msw; break;
+    case 18: value = atom.m_hil_msw_err; break;
+    case 19: value = atom.m_hil_msl; break;
+    case 20: value = atom.m_hil_msl_err; break;
+    default: break;
+    }
+
+    // Return value
+    return value;
+}
+
+
+/***********************************************************************//**
+ * @brief Set auxiliary information of event atom
+ *
+ * @param[in,out] atom Event atom.
+ * @param[in] column Auxiliary column index.
+ * @param[in] value Auxiliary information.
+ ***************************************************************************/
+void GCTAEventList::aux_value(GCTAEventAtom& atom, const int& column,
+                              const double& value) const
+{
+    // Set value
+    switch (column) {
+    case 0:  atom.m_event_id    = (unsigned long)(value); break;
+    case 1:  atom.m_obs_id      = (unsigned long)(value); break;
+    case 2:  atom.m_multip      = int(value); break;
+    case 3:  atom.m_telmask     = char(value); break;
+    case 4:  atom.m_dir_err     = float(value); break;
+    case 5:  atom.m_detx        = float(value); break;
+    case 6:  atom.m_dety        = float(value); break;
+    case 7:  atom.m_alt         = float(value); break;
+    case 8:  atom.m_az          = float(value); break;
+    case 9:  atom.m_corex       = float(value); break;
+    case 10: atom.m_corey       = float(value); break;
+    case 11: atom.m_core_err    = float(value); break;
+    case 12: atom.m_xmax        = float(value); break;
+    case 13: atom.m_xmax_err    = float(value); break;
+    case 14: atom.m_shwidth     = float(value); break;
+    case 15: atom.m_shlength    = float(value); break;
+    case 16: atom.m_energy_err  = float(value); break;
+    case 17: atom.m_hil_msw     = float(value); break;
+    case 18: atom.m_hil_msw_err = float(value); break;
+    case 19: atom.m_hil_msl     = float(value); break;
+    case 20: atom.m_hil_msl_err = float(value); break;
+    default: break;
+    }
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Set integer auxiliary column value of event atom
+ *
+ * @param[in,out] atom Event atom.
+ * @param[in] column Auxiliary column index.
+ * @param[in] value Integer value.
+ *
+ * Sets the value of one of the integer auxiliary columns (EVENT_ID,
+ * OBS_ID, MULTIP and TELMASK) without conversion into a floating point
+ * value. Values of all other columns are set using the floating point
+ * method.
+ ***************************************************************************/
+void GCTAEventList::aux_value(GCTAEventAtom& atom, const int& column,
+                              const long long& value) const
+{
+    // Set value
+    switch (column) {
+    case 0:  atom.m_event_id = (unsigned long)(value); break;
+    case 1:  atom.m_obs_id   = (unsigned long)(value); break;
+    case 2:  atom.m_multip   = int(value); break;
+    case 3:  atom.m_telmask  = char(value); break;
+    default: aux_value(atom, column, double(value)); break;
+    }
 
     // Return
     return;
@@ -1129,79 +2053,137 @@ void GCTAEventList::write_ds_keys(GFitsHDU& hdu) const
 
 
 /***********************************************************************//**
- * @brief Initialize IRF cache for a given model
+ * @brief Reserve event views for all threads
  *
- * @param[in] name Model name.
- * @return Cache index (-1 if invalid).
+ * In columnar mode, makes sure that an event view exists for every thread
+ * that may access the events from a parallel region. Threads without a
+ * per-thread view use a view that is looked up under a lock, hence calling
+ * this method before a parallel region with more threads avoids locking.
+ * It must not be called while other threads access the event list.
  ***************************************************************************/
-int GCTAEventList::irf_cache_init(const std::string& name) const
+void GCTAEventList::reserve_views(void) const
 {
-    // Initialise cache index
-    int index = irf_cache_index(name);
-
-    // Continue only if model does not yet exist
-    if (index == -1) {
-
-        // Add model name and vector to cache. The vector is initialized
-        // to -1, which signals that no cache values exist
-        m_irf_names.push_back(name);
-        m_irf_values.push_back(std::vector<double>(size(), -1.0));
-
-        // Set index
-        index = m_irf_names.size()-1;
-
-    } // endif: model cache did not yet exist
+    // Add views in columnar mode
+    if (m_columnar) {
+        grow_views(1);
+    }
 
-    // Return index
-    return index;
+    // Return
+    return;
 }
 
 
 /***********************************************************************//**
- * @brief Determines the cache index for a given model name
+ * @brief Return IRF cache handle for a given model
  *
  * @param[in] name Model name.
- * @return Cache index (-1 if model has not been found).
+ * @return IRF cache handle.
+ *
+ * Returns the IRF cache handle for the model with the specified @p name.
+ * If the model is not yet in the cache, a new handle is created. The
+ * handle remains valid until the cache is cleared, hence it can be
+ * determined once and then be used for all events.
  ***************************************************************************/
-int GCTAEventList::irf_cache_index(const std::string& name) const
+int GCTAEventList::irf_cache_handle(const std::string& name) const
 {
-    // Initialise index
-    int index = -1;
+    // Return handle for empty parameter signature
+    return (irf_cache_handle(name, std::vector<double>()));
+}
 
-    // Continue only if there are models in cache
-    if (!m_irf_names.empty()) {
 
-         // Search for model name
-         for (int i = 0; i < m_irf_names.size(); ++i) {
-             if (m_irf_names[i] == name) {
-                 index = i;
-                 break;
-             }
-         }
+/***********************************************************************//**
+ * @brief Return IRF cache handle for a given model and parameters
+ *
+ * @param[in] name Model name.
+ * @param[in] pars Model parameter values.
+ * @return IRF cache handle.
+ *
+ * Returns the IRF cache handle for the model with the specified @p name.
+ * If the model is not yet in the cache, a new handle is created. The
+ * parameter values @p pars are the values on which the cached IRF values
+ * depend. If they differ from the values that were specified when the
+ * cached values were computed, all cached values of the model are reset.
+ ***************************************************************************/
+int GCTAEventList::irf_cache_handle(const std::string&         name,
+                                    const std::vector<double>& pars) const
+{
+    // Initialise handle
+    int handle = -1;
+
+    // Get handle. The cache is shared by all threads that process the
+    // event list, hence the cache access is protected by a critical region.
+    #pragma omp critical(GCTAEventList_irf_cache)
+    {
+        // Search model name
+        std::map<std::string,int>::const_iterator it = m_irf_handles.find(name);
+
+        // If model was found then reset cache values if the parameters
+        // have changed ...
+        if (it != m_irf_handles.end()) {
+            handle = it->second;
+            if (m_irf_pars[handle] != pars) {
+                if (m_irf_pars[handle].size() != pars.size()) {
+                    irf_cache_free(handle);
+                }
+                m_irf_pars[handle] = pars;
+                irf_cache_reset(handle);
+            }
+        }
 
-    } // endif: there were models in cache
+        // ... otherwise add model to cache. No memory is allocated before
+        // the first IRF value is stored.
+        else {
+            handle = m_irf_names.size();
+            m_irf_handles[name] = handle;
+            m_irf_names.push_back(name);
+            m_irf_pars.push_back(pars);
+            m_irf_values.push_back(std::vector<double>());
+            m_irf_fvalues.push_back(std::vector<float>());
+            m_irf_grads.push_back(std::vector<double>());
+            m_irf_used.push_back(0);
+        }
+    }
 
-    // Return index
-    return index;
+    // Return handle
+    return handle;
 }
 
 
 /***********************************************************************//**
  * @brief Get cache IRF value
  *
- * @param[in] name Model name.
+ * @param[in] handle IRF cache handle.
  * @param[in] index Event index [0,...,size()-1].
  * @return IRF value (-1 if no cache value found).
  ***************************************************************************/
-double GCTAEventList::irf_cache(const std::string& name, const int& index) const
+double GCTAEventList::irf_cache(const int& handle, const int& index) const
 {
     // Initialise IRF value to invalid value
     double irf = -1.0;
 
-    // Get cache index. Continue only if index is valid
-    int icache = irf_cache_index(name);
-    if (icache != -1) {
-        irf = (m_irf_values[icache])[index];
+    // Get IRF value. The cache is shared by all threads that process the
+    // event list, hence the cache access is protected by a critical region.
+    #pragma omp critical(GCTAEventList_irf_cache)
+    {
+        if (handle >= 0 && handle < m_irf_names.size()) {
+            if (m_irf_float) {
+                if (index >= 0 && index < m_irf_fvalues[handle].size()) {
+                    irf = (m_irf_fvalues[handle])[index];
+                }
+            }
+            else {
+                if (index >= 0 && index < m_irf_values[handle].size()) {
+                    irf = (m_irf_values[handle])[index];
+                }
+            }
+            m_irf_used[handle] = ++m_irf_clock;
+        }
+        if (irf >= 0.0) {
+            m_irf_hits++;
+        }
+        else {
+            m_irf_misses++;
+        }
     }
 
     // Return IRF value
@@ -1209,6 +2191,61 @@ double GCTAEventList::irf_cache(const std::string& name, const int& index) const
 }
 
 
+/***********************************************************************//**
+ * @brief Set cache IRF value
+ *
+ * @param[in] handle IRF cache handle.
+ * @param[in] index Event index [0,...,size()-1].
+ * @param[in] irf IRF value.
+ *
+ * Stores an IRF value in the cache. If no values were stored so far for
+ * the model, memory for the values of all events is allocated. If this
+ * exceeds the memory ceiling, the least recently used models are removed
+ * from the cache. If the memory ceiling is still exceeded, the value is
+ * not stored.
+ ***************************************************************************/
+void GCTAEventList::irf_cache(const int& handle, const int& index,
+                              const double& irf) const
+{
+    // Set IRF value. The cache is shared by all threads that process the
+    // event list, hence the cache access is protected by a critical region.
+    #pragma omp critical(GCTAEventList_irf_cache)
+    {
+        if (handle >= 0 && handle < m_irf_names.size()) {
+            irf_cache_alloc(handle);
+            if (m_irf_float) {
+                if (index >= 0 && index < m_irf_fvalues[handle].size()) {
+                    (m_irf_fvalues[handle])[index] = float(irf);
+                }
+            }
+            else {
+                if (index >= 0 && index < m_irf_values[handle].size()) {
+                    (m_irf_values[handle])[index] = irf;
+                }
+            }
+            m_irf_used[handle] = ++m_irf_clock;
+        }
+    }
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Get cache IRF value
+ *
+ * @param[in] name Model name.
+ * @param[in] index Event index [0,...,size()-1].
+ * @return IRF value (-1 if no cache value found).
+ ***************************************************************************/
+double GCTAEventList::irf_cache(const std::string& name, const int& index) const
+{
+    // Return IRF value
+    return (irf_cache(irf_cache_handle(name), index));
+}
+
+
 /***********************************************************************//**
  * @brief Set cache IRF value
  *
@@ -1219,12 +2256,403 @@ double GCTAEventList::irf_cache(const std::string& name, const int& index) const
 void GCTAEventList::irf_cache(const std::string& name, const int& index,
                               const double& irf) const
 {
-    // Initialize cache index. Continue only if index is valid
-    int icache = irf_cache_init(name);
-    if (icache != -1) {
-        (m_irf_values[icache])[index] = irf;
+    // Set IRF value
+    irf_cache(irf_cache_handle(name), index, irf);
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Prepare IRF cache values of a model
+ *
+ * @param[in] handle IRF cache handle.
+ *
+ * Allocates the IRF cache values of the model for all events, so that the
+ * values can subsequently be accessed with irf_cache_value() without
+ * locking. The model is marked as used. If the memory ceiling does not
+ * allow the allocation, irf_cache_value() will not find or store values
+ * for the model.
+ ***************************************************************************/
+void GCTAEventList::irf_cache_prepare(const int& handle) const
+{
+    // Allocate values. The cache is shared by all threads that process the
+    // event list, hence the cache access is protected by a critical region.
+    #pragma omp critical(GCTAEventList_irf_cache)
+    {
+        if (handle >= 0 && handle < m_irf_names.size()) {
+            irf_cache_alloc(handle);
+            m_irf_used[handle] = ++m_irf_clock;
+        }
+    }
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Add IRF cache hits and misses
+ *
+ * @param[in] hits Number of cache hits.
+ * @param[in] misses Number of cache misses.
+ *
+ * Adds the number of cache hits and misses that occured while the values
+ * were accessed using irf_cache_value().
+ ***************************************************************************/
+void GCTAEventList::irf_cache_count(const unsigned long& hits,
+                                    const unsigned long& misses) const
+{
+    // Update counters
+    #pragma omp critical(GCTAEventList_irf_cache)
+    {
+        m_irf_hits   += hits;
+        m_irf_misses += misses;
     }
 
     // Return
     return;
 }
+
+
+/***********************************************************************//**
+ * @brief Clear IRF cache
+ *
+ * Removes all models from the IRF cache and resets the hit and miss
+ * counters. All IRF cache handles become invalid.
+ ***************************************************************************/
+void GCTAEventList::irf_cache_clear(void)
+{
+    // Clear cache
+    m_irf_handles.clear();
+    m_irf_names.clear();
+    m_irf_pars.clear();
+    m_irf_values.clear();
+    m_irf_fvalues.clear();
+    m_irf_grads.clear();
+    m_irf_used.clear();
+    m_irf_clock  = 0;
+    m_irf_hits   = 0;
+    m_irf_misses = 0;
+    m_irf_memory = 0.0;
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Signals if event geometry cache is valid for a key
+ *
+ * @param[in] key Geometry key.
+ * @return True if event geometry cache holds values for @p key.
+ ***************************************************************************/
+bool GCTAEventList::has_geometry(const std::vector<double>& key) const
+{
+    // Initialise flag
+    bool valid = false;
+
+    // Check key. The cache is shared by all threads that process the event
+    // list, hence the cache access is protected by a critical region.
+    #pragma omp critical(GCTAEventList_geometry)
+    {
+        valid = (m_geo_stride > 0 && m_geo_key == key);
+    }
+
+    // Return flag
+    return valid;
+}
+
+
+/***********************************************************************//**
+ * @brief Get event geometry values
+ *
+ * @param[in] key Geometry key.
+ * @param[in] index Event index [0,...,size()-1].
+ * @param[out] values Geometry values of event.
+ * @return True if geometry values were found.
+ *
+ * Copies the geometry values of the event with the specified @p index into
+ * the @p values array, which needs to provide space for the number of
+ * values per event that was specified when storing the values. False is
+ * returned if the cache holds no values for @p key or @p index.
+ ***************************************************************************/
+bool GCTAEventList::geometry(const std::vector<double>& key,
+                             const int&                 index,
+                             double*                    values) const
+{
+    // Initialise flag
+    bool found = false;
+
+    // Get values. The cache is shared by all threads that process the
+    // event list, hence the cache access is protected by a critical region.
+    #pragma omp critical(GCTAEventList_geometry)
+    {
+        if (m_geo_stride > 0 && index >= 0 &&
+            (index+1) * m_geo_stride <= m_geo_values.size() &&
+            m_geo_key == key) {
+            const double* ptr = &(m_geo_values[index * m_geo_stride]);
+            for (int i = 0; i < m_geo_stride; ++i) {
+                values[i] = ptr[i];
+            }
+            found = true;
+        }
+    }
+
+    // Return flag
+    return found;
+}
+
+
+/***********************************************************************//**
+ * @brief Set event geometry values
+ *
+ * @param[in] key Geometry key.
+ * @param[in] values Geometry values of all events.
+ * @param[in] stride Number of values per event.
+ *
+ * Replaces the content of the event geometry cache. The @p values array
+ * holds @p stride consecutive values for each event. The @p key specifies
+ * the quantities on which the values depend (e.g. the pointing direction);
+ * values are only returned by geometry() for an identical key. The cache
+ * is cleared when events are appended or accessed through the non-const
+ * access operator, since the events may be modified in that case.
+ ***************************************************************************/
+void GCTAEventList::geometry(const std::vector<double>& key,
+                             const std::vector<double>& values,
+                             const int&                 stride) const
+{
+    // Set values. The cache is shared by all threads that process the
+    // event list, hence the cache access is protected by a critical region.
+    #pragma omp critical(GCTAEventList_geometry)
+    {
+        m_geo_key    = key;
+        m_geo_values = values;
+        m_geo_stride = (stride > 0) ? stride : 0;
+    }
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Clear event geometry cache
+ ***************************************************************************/
+void GCTAEventList::geometry_clear(void)
+{
+    // Clear cache
+    m_geo_key.clear();
+    std::vector<double>().swap(m_geo_values);
+    m_geo_stride = 0;
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Set IRF cache memory ceiling
+ *
+ * @param[in] mbytes Memory ceiling (MB). A value of 0 means no ceiling.
+ *
+ * Sets the maximum memory that is used for storing IRF values. If the
+ * cache currently uses more memory, the least recently used models are
+ * removed from the cache.
+ ***************************************************************************/
+void GCTAEventList::irf_cache_max_memory(const double& mbytes)
+{
+    // Set memory ceiling
+    m_irf_max_memory = (mbytes > 0.0) ? mbytes : 0.0;
+
+    // Remove least recently used models until memory fits into ceiling
+    if (m_irf_max_memory > 0.0) {
+        while (m_irf_memory > m_irf_max_memory) {
+            int           lru  = -1;
+            unsigned long used = 0;
+            for (int i = 0; i < m_irf_names.size(); ++i) {
+                bool allocated = (m_irf_float) ? !m_irf_fvalues[i].empty()
+                                               : !m_irf_values[i].empty();
+                if (allocated && (lru == -1 || m_irf_used[i] < used)) {
+                    lru  = i;
+                    used = m_irf_used[i];
+                }
+            }
+            if (lru == -1) {
+                break;
+            }
+            irf_cache_free(lru);
+        }
+    }
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Set IRF cache precision
+ *
+ * @param[in] use_float Store IRF values as floats?
+ *
+ * Specifies whether IRF values are stored in single precision (4 Bytes
+ * per value) or double precision (8 Bytes per value). Changing the
+ * precision removes all IRF values from the cache.
+ ***************************************************************************/
+void GCTAEventList::irf_cache_float(const bool& use_float)
+{
+    // Continue only if precision changes
+    if (use_float != m_irf_float) {
+
+        // Free all cache values
+        for (int i = 0; i < m_irf_names.size(); ++i) {
+            irf_cache_free(i);
+        }
+
+        // Set precision
+        m_irf_float = use_float;
+
+    } // endif: precision has changed
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Allocate IRF cache values for a model
+ *
+ * @param[in] handle IRF cache handle.
+ *
+ * Allocates the IRF cache values and gradients for all events of a model
+ * if they have not yet been allocated. All values are initialised to -1,
+ * which signals that no cache value exists. The gradients of each event
+ * are preceded by a flag that signals whether gradients were stored. If the memory ceiling would be exceeded,
+ * the values of the least recently used models are freed first. If the
+ * ceiling is still exceeded, no memory is allocated.
+ *
+ * This method is called within the IRF cache critical region.
+ ***************************************************************************/
+void GCTAEventList::irf_cache_alloc(const int& handle) const
+{
+    // Continue only if values are not yet allocated
+    bool allocated = (m_irf_float) ? !m_irf_fvalues[handle].empty()
+                                   : !m_irf_values[handle].empty();
+    if (!allocated && size() > 0) {
+
+        // Get memory needed for the model
+        double mbytes = irf_cache_mbytes(handle);
+
+        // Free least recently used models until the model fits into the
+        // memory ceiling
+        if (m_irf_max_memory > 0.0) {
+            while (m_irf_memory + mbytes > m_irf_max_memory) {
+                int           lru  = -1;
+                unsigned long used = 0;
+                for (int i = 0; i < m_irf_names.size(); ++i) {
+                    bool alloc = (m_irf_float) ? !m_irf_fvalues[i].empty()
+                                               : !m_irf_values[i].empty();
+                    if (alloc && (lru == -1 || m_irf_used[i] < used)) {
+                        lru  = i;
+                        used = m_irf_used[i];
+                    }
+                }
+                if (lru == -1) {
+                    break;
+                }
+                irf_cache_free(lru);
+            }
+        }
+
+        // Allocate values if they fit into the memory ceiling
+        if (m_irf_max_memory <= 0.0 ||
+            m_irf_memory + mbytes <= m_irf_max_memory) {
+            if (m_irf_float) {
+                m_irf_fvalues[handle].assign(size(), -1.0);
+            }
+            else {
+                m_irf_values[handle].assign(size(), -1.0);
+            }
+            int npars = m_irf_pars[handle].size();
+            m_irf_grads[handle].assign((npars > 0) ? size() * (npars+1) : 0,
+                                       0.0);
+            m_irf_memory += mbytes;
+        }
+
+    } // endif: values were not allocated
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Reset IRF cache values of a model
+ *
+ * @param[in] handle IRF cache handle.
+ *
+ * Sets all IRF cache values of a model to -1 and clears all gradient
+ * flags, which signals that no cache value or gradient exists. This method is called within the IRF cache critical
+ * region.
+ ***************************************************************************/
+void GCTAEventList::irf_cache_reset(const int& handle) const
+{
+    // Reset values
+    std::fill(m_irf_values[handle].begin(), m_irf_values[handle].end(), -1.0);
+    std::fill(m_irf_fvalues[handle].begin(), m_irf_fvalues[handle].end(),
+              -1.0f);
+    std::fill(m_irf_grads[handle].begin(), m_irf_grads[handle].end(), 0.0);
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Free IRF cache values of a model
+ *
+ * @param[in] handle IRF cache handle.
+ *
+ * Frees the memory of the IRF cache values of a model. The model handle
+ * remains valid.
+ ***************************************************************************/
+void GCTAEventList::irf_cache_free(const int& handle) const
+{
+    // Update used memory
+    if (!m_irf_values[handle].empty() || !m_irf_fvalues[handle].empty()) {
+        m_irf_memory -= irf_cache_mbytes(handle);
+        if (m_irf_memory < 0.0) {
+            m_irf_memory = 0.0;
+        }
+    }
+
+    // Free memory (swapping with an empty vector releases the memory)
+    std::vector<double>().swap(m_irf_values[handle]);
+    std::vector<float>().swap(m_irf_fvalues[handle]);
+    std::vector<double>().swap(m_irf_grads[handle]);
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Return memory needed for the IRF cache values of one model
+ *
+ * @param[in] handle IRF cache handle.
+ * @return Memory (MB).
+ *
+ * The memory comprises the IRF value and the IRF gradients with respect to
+ * all model parameters of each event.
+ ***************************************************************************/
+double GCTAEventList::irf_cache_mbytes(const int& handle) const
+{
+    // Get number of bytes per event
+    int    npars  = m_irf_pars[handle].size();
+    double nbytes = ((m_irf_float) ? sizeof(float) : sizeof(double)) +
+                    ((npars > 0) ? (npars+1) * sizeof(double) : 0);
+
+    // Return memory in MB
+    return (double(size()) * nbytes / (1024.0 * 1024.0));
+}
@@ -0,0 +1,464 @@
+/***************************************************************************
+ *            GCTAEventStream.cpp - CTA event stream class                 *
+ * ----------------------------------------------------------------------- *
+ *  copyright (C) 2013 by Juergen Knoedlseder                              *
+ * ----------------------------------------------------------------------- *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.  *
+ *                                                                         *
+ ***************************************************************************/
+/**
+ * @file GCTAEventStream.cpp
+ * @brief CTA event stream class implementation
+ * @author Juergen Knoedlseder
+ */
+
+/* __ Includes ___________________________________________________________ */
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+#include <algorithm>
+#include "GException.hpp"
+#include "GTools.hpp"
+#include "GFitsTable.hpp"
+#include "GCTAEventStream.hpp"
+
+/* __ Method name definitions ____________________________________________ */
+#define G_CHUNK_SIZE                      "GCTAEventStream::chunk_size(int&)"
+
+/* __ Macros _____________________________________________________________ */
+
+/* __ Coding definitions _________________________________________________ */
+
+/* __ Debug definitions __________________________________________________ */
+
+
+/*==========================================================================
+ =                                                                         =
+ =                        Constructors/destructors                         =
+ =                                                                         =
+ ==========================================================================*/
+
+/***********************************************************************//**
+ * @brief Void constructor
+ ***************************************************************************/
+GCTAEventStream::GCTAEventStream(void) : GBase()
+{
+    // Initialise members
+    init_members();
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Event file constructor
+ *
+ * @param[in] filename Event file name.
+ * @param[in] chunk_size Number of rows per chunk.
+ ***************************************************************************/
+GCTAEventStream::GCTAEventStream(const std::string& filename,
+                                 const int&         chunk_size) : GBase()
+{
+    // Initialise members
+    init_members();
+
+    // Set chunk size
+    this->chunk_size(chunk_size);
+
+    // Open event file
+    open(filename);
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Copy constructor
+ *
+ * @param[in] stream Event stream.
+ ***************************************************************************/
+GCTAEventStream::GCTAEventStream(const GCTAEventStream& stream) : GBase(stream)
+{
+    // Initialise members
+    init_members();
+
+    // Copy members
+    copy_members(stream);
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Destructor
+ ***************************************************************************/
+GCTAEventStream::~GCTAEventStream(void)
+{
+    // Free members
+    free_members();
+
+    // Return
+    return;
+}
+
+
+/*==========================================================================
+ =                                                                         =
+ =                                Operators                                =
+ =                                                                         =
+ ==========================================================================*/
+
+/***********************************************************************//**
+ * @brief Assignment operator
+ *
+ * @param[in] stream Event stream.
+ * @return Event stream.
+ ***************************************************************************/
+GCTAEventStream& GCTAEventStream::operator=(const GCTAEventStream& stream)
+{
+    // Execute only if object is not identical
+    if (this != &stream) {
+
+        // Free members
+        free_members();
+
+        // Initialise members
+        init_members();
+
+        // Copy members
+        copy_members(stream);
+
+    } // endif: object was not identical
+
+    // Return this object
+    return *this;
+}
+
+
+/*==========================================================================
+ =                                                                         =
+ =                             Public methods                              =
+ =                                                                         =
+ ==========================================================================*/
+
+/***********************************************************************//**
+ * @brief Clear event stream
+ ***************************************************************************/
+void GCTAEventStream::clear(void)
+{
+    // Free members
+    free_members();
+
+    // Initialise members
+    init_members();
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Clone event stream
+ *
+ * @return Pointer to deep copy of event stream.
+ ***************************************************************************/
+GCTAEventStream* GCTAEventStream::clone(void) const
+{
+    return new GCTAEventStream(*this);
+}
+
+
+/***********************************************************************//**
+ * @brief Open event file
+ *
+ * @param[in] filename Event file name.
+ *
+ * Opens the event file and reads the number of rows, the Good Time
+ * Intervals, the region of interest and the energy boundaries from the
+ * file. No events are read. The stream is positioned at the first row.
+ * The chunk size and the event selection are kept.
+ ***************************************************************************/
+void GCTAEventStream::open(const std::string& filename)
+{
+    // Close any open event file
+    close();
+
+    // Open event file
+    m_filename = filename;
+    open_file();
+
+    // Read number of rows and event list header
+    m_nrows = m_fits.table("EVENTS")->nrows();
+    m_header.read_header(m_fits);
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Close event file
+ *
+ * Closes the event file. The chunk size and the event selection are kept.
+ ***************************************************************************/
+void GCTAEventStream::close(void)
+{
+    // Close event file
+    m_fits.close();
+
+    // Reset file information
+    m_filename.clear();
+    m_header.clear();
+    m_row   = 0;
+    m_nrows = 0;
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Rewind event stream
+ *
+ * Positions the event stream at the first row of the event file.
+ ***************************************************************************/
+void GCTAEventStream::rewind(void)
+{
+    // Reset row
+    m_row = 0;
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Read next chunk of events
+ *
+ * @param[in,out] events Event list.
+ * @return True if a chunk was read, false if the end of the event file
+ *         was reached.
+ *
+ * Reads the next chunk of rows from the event file into the event list,
+ * replacing all events in the list. If a selection region of interest or
+ * selection energy boundaries are set, only events that fall within them
+ * are kept, hence the event list may be empty even if true is returned.
+ *
+ * The Good Time Intervals of the event list are set from the event file.
+ * The region of interest and energy boundaries of the event list are set
+ * from the selection, or from the event file if no selection is set. The
+ * IRF and event geometry caches of the event list are cleared. The events
+ * are stored as event atoms; an event list in columnar mode is cleared
+ * before reading.
+ ***************************************************************************/
+bool GCTAEventStream::next(GCTAEventList& events)
+{
+    // Initialise result
+    bool read = false;
+
+    // Continue only if rows are left
+    if (is_open() && m_row < m_nrows) {
+
+        // Make sure that event file is opened
+        open_file();
+
+        // Store events as event atoms
+        if (events.columnar()) {
+            events.clear();
+        }
+
+        // Set event list header
+        events.m_gti     = m_header.m_gti;
+        events.m_roi     = (m_roi.radius() > 0.0) ? m_roi : m_header.m_roi;
+        events.m_ebounds = (m_ebounds.size() > 0) ? m_ebounds
+                                                  : m_header.m_ebounds;
+
+        // Clear IRF and event geometry caches since event indices change
+        events.irf_cache_clear();
+        events.geometry_clear();
+
+        // Read chunk of events
+        int nrows = std::min(m_chunk_size, m_nrows - m_row);
+        events.read_events_atoms(*m_fits.table("EVENTS"), m_row, nrows);
+
+        // Select events
+        events.select_events(m_roi, m_ebounds);
+
+        // Move to next chunk
+        m_row += nrows;
+        read   = true;
+
+    } // endif: rows were left
+
+    // Return flag
+    return read;
+}
+
+
+/***********************************************************************//**
+ * @brief Set chunk size
+ *
+ * @param[in] chunk_size Number of rows per chunk.
+ *
+ * @exception GException::invalid_argument
+ *            Chunk size is not positive.
+ ***************************************************************************/
+void GCTAEventStream::chunk_size(const int& chunk_size)
+{
+    // Check chunk size
+    if (chunk_size < 1) {
+        std::string msg = "Chunk size "+gammalib::str(chunk_size)+" is not"
+                          " positive. Please specify a positive number of"
+                          " rows.";
+        throw GException::invalid_argument(G_CHUNK_SIZE, msg);
+    }
+
+    // Set chunk size
+    m_chunk_size = chunk_size;
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Print event stream information
+ *
+ * @param[in] chatter Chattiness (defaults to NORMAL).
+ * @return String containing event stream information.
+ ***************************************************************************/
+std::string GCTAEventStream::print(const GChatter& chatter) const
+{
+    // Initialise result string
+    std::string result;
+
+    // Continue only if chatter is not silent
+    if (chatter != SILENT) {
+
+        // Append header
+        result.append("=== GCTAEventStream ===");
+
+        // Append information
+        result.append("\n"+gammalib::parformat("Event file"));
+        result.append((is_open()) ? m_filename : "none");
+        result.append("\n"+gammalib::parformat("Number of rows"));
+        result.append(gammalib::str(m_nrows));
+        result.append("\n"+gammalib::parformat("Next row"));
+        result.append(gammalib::str(m_row));
+        result.append("\n"+gammalib::parformat("Chunk size"));
+        result.append(gammalib::str(m_chunk_size));
+        result.append("\n"+gammalib::parformat("ROI selection"));
+        if (m_roi.radius() > 0.0) {
+            result.append(m_roi.centre().print()+" (radius=");
+            result.append(gammalib::str(m_roi.radius())+" deg)");
+        }
+        else {
+            result.append("none");
+        }
+        result.append("\n"+gammalib::parformat("Energy selection"));
+        if (m_ebounds.size() > 0) {
+            result.append(m_ebounds.emin().print()+" - ");
+            result.append(m_ebounds.emax().print());
+        }
+        else {
+            result.append("none");
+        }
+
+    } // endif: chatter was not silent
+
+    // Return result
+    return result;
+}
+
+
+/*==========================================================================
+ =                                                                         =
+ =                             Private methods                             =
+ =                                                                         =
+ ==========================================================================*/
+
+/***********************************************************************//**
+ * @brief Initialise class members
+ ***************************************************************************/
+void GCTAEventStream::init_members(void)
+{
+    // Initialise members
+    m_filename.clear();
+    m_fits.clear();
+    m_chunk_size = 100000;
+    m_row        = 0;
+    m_nrows      = 0;
+    m_roi.clear();
+    m_ebounds.clear();
+    m_header.clear();
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Copy class members
+ *
+ * @param[in] stream Event stream.
+ *
+ * The FITS file is not copied. The copy opens the event file when it
+ * first reads events.
+ ***************************************************************************/
+void GCTAEventStream::copy_members(const GCTAEventStream& stream)
+{
+    // Copy members
+    m_filename   = stream.m_filename;
+    m_chunk_size = stream.m_chunk_size;
+    m_row        = stream.m_row;
+    m_nrows      = stream.m_nrows;
+    m_roi        = stream.m_roi;
+    m_ebounds    = stream.m_ebounds;
+    m_header     = stream.m_header;
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Delete class members
+ ***************************************************************************/
+void GCTAEventStream::free_members(void)
+{
+    // Close FITS file
+    m_fits.close();
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Open event file if it is not yet opened
+ ***************************************************************************/
+void GCTAEventStream::open_file(void)
+{
+    // Open event file if it is not yet opened
+    if (m_fits.size() == 0) {
+        m_fits.open(m_filename);
+    }
+
+    // Return
+    return;
+}
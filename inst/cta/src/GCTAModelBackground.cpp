@@ -40,8 +40,11 @@
 #include "GCTAModelBackground.hpp"
 #include "GModelSpatialRegistry.hpp"
 #include "GModelSpatial.hpp"
+#include "GModelSpatialDiffuseMap.hpp"
 #include "GModelSpatialDiffuseCube.hpp"
 #include "GCTAObservation.hpp"
+#include "GCTAEventAtom.hpp"
+#include "GCTAEventBin.hpp"
 #include "GCTAPointing.hpp"
 #include "GCTAInstDir.hpp"
 #include "GCTARoi.hpp"
@@ -297,8 +300,8 @@ GCTAModelBackground* GCTAModelBackground::clone(void) const
  * a deadtime correction factor, so that the normalization of the model is
  * a real rate (counts/exposure time).
  *
- * @todo Add bookkeeping of last value and evaluate only if argument 
- *       changed
+ * Sky map based spatial models cache the sky map pixel weights of the
+ * event direction, hence the sky projection is only done once per event.
  ***************************************************************************/
 double GCTAModelBackground::eval(const GEvent& event,
                                  const GObservation& obs) const
@@ -324,9 +327,9 @@ double GCTAModelBackground::eval(const GEvent& event,
     // since the IRFs are not folded in
     GPhoton photon(dir->dir(), event.energy(), event.time());
 
-    // Evaluate function and gradients
+    // Evaluate function
     double spat = (spatial() != NULL)
-                  ? spatial()->eval(photon) : 1.0;
+                  ? eval_spatial(photon, event, obs, false) : 1.0;
     double spec = (spectral() != NULL)
                   ? spectral()->eval(event.energy(), event.time()) : 1.0;
     double temp = (temporal() != NULL)
@@ -359,8 +362,8 @@ double GCTAModelBackground::eval(const GEvent& event,
  * factor, so that the normalization of the model is a real rate
  * (counts/exposure time).
  *
- * @todo Add bookkeeping of last value and evaluate only if argument 
- *       changed
+ * Sky map based spatial models cache the sky map pixel weights of the
+ * event direction, hence the sky projection is only done once per event.
  ***************************************************************************/
 double GCTAModelBackground::eval_gradients(const GEvent& event,
                                            const GObservation& obs) const
@@ -388,7 +391,7 @@ double GCTAModelBackground::eval_gradients(const GEvent& event,
 
     // Evaluate function and gradients
     double spat = (spatial() != NULL)
-                  ? spatial()->eval_gradients(photon) : 1.0;
+                  ? eval_spatial(photon, event, obs, true) : 1.0;
     double spec = (spectral() != NULL)
                   ? spectral()->eval_gradients(event.energy(), event.time()) : 1.0;
     double temp = (temporal() != NULL)
@@ -1094,6 +1097,65 @@ bool GCTAModelBackground::valid_model(void) const
 }
 
 
+/***********************************************************************//**
+ * @brief Evaluate spatial model component for event
+ *
+ * @param[in] photon Photon that corresponds to the event.
+ * @param[in] event Observed event.
+ * @param[in] obs Observation.
+ * @param[in] gradients Compute parameter gradients?
+ * @return Spatial model value.
+ *
+ * Evaluates the spatial model component for an event. Sky map and map
+ * cube models are evaluated with the observation and the index of the
+ * event in the event list or event cube, so that they cache the sky map
+ * pixel weights of the event direction. Other spatial models are evaluated
+ * directly.
+ ***************************************************************************/
+double GCTAModelBackground::eval_spatial(const GPhoton&      photon,
+                                         const GEvent&       event,
+                                         const GObservation& obs,
+                                         const bool&         gradients) const
+{
+    // Get event index (-1 if the event index is unknown)
+    int                  index = -1;
+    const GCTAEventAtom* atom  = dynamic_cast<const GCTAEventAtom*>(&event);
+    if (atom != NULL) {
+        index = atom->index();
+    }
+    else {
+        const GCTAEventBin* bin = dynamic_cast<const GCTAEventBin*>(&event);
+        if (bin != NULL) {
+            index = bin->index();
+        }
+    }
+
+    // Get pointers on sky map based spatial models
+    const GModelSpatialDiffuseMap*  map  =
+          dynamic_cast<const GModelSpatialDiffuseMap*>(m_spatial);
+    const GModelSpatialDiffuseCube* cube = (map == NULL) ?
+          dynamic_cast<const GModelSpatialDiffuseCube*>(m_spatial) : NULL;
+
+    // Evaluate spatial model
+    double value;
+    if (map != NULL) {
+        value = (gradients) ? map->eval_gradients(photon, &obs, index)
+                            : map->eval(photon, &obs, index);
+    }
+    else if (cube != NULL) {
+        value = (gradients) ? cube->eval_gradients(photon, &obs, index)
+                            : cube->eval(photon, &obs, index);
+    }
+    else {
+        value = (gradients) ? m_spatial->eval_gradients(photon)
+                            : m_spatial->eval(photon);
+    }
+
+    // Return value
+    return value;
+}
+
+
 /***********************************************************************//**
  * @brief Construct spatial model from XML element
  *
@@ -294,6 +294,17 @@ void GCTAObservation::response(const std::string& irfname,
  *
  * for a binned observation.
  *
+ * The EventList parameter may have an optional "columns" attribute that
+ * specifies a comma separated list of event columns that should be read
+ * (e.g. columns="TIME,RA,DEC,ENERGY"). In that case the events are stored
+ * in columnar form and columns that are not listed are only read from the
+ * event file when they are requested.
+ *
+ * The EventList parameter may also have an optional "chunk" attribute that
+ * specifies a number of rows (e.g. chunk="100000"). In that case the event
+ * file is not loaded into memory but streamed in chunks of the specified
+ * number of rows (see stream_unbinned()).
+ *
  * @todo Still supports old ARF, PSF and RMF parameter names.
  * @todo PSF correction for ARF not yet implemented.
  ***************************************************************************/
@@ -327,8 +338,20 @@ void GCTAObservation::read(const GXmlElement& xml)
             // Read eventlist file name
             std::string filename = par->attribute("file");
 
+            // Optionally extract column projection and chunk size
+            std::string s_columns = par->attribute("columns");
+            std::string s_chunk   = par->attribute("chunk");
+
             // Load unbinned observation (sets also m_evenfile member)
-            load_unbinned(filename);
+            if (gammalib::strip_whitespace(s_chunk).length() > 0) {
+                stream_unbinned(filename, gammalib::toint(s_chunk));
+            }
+            else if (gammalib::strip_whitespace(s_columns).length() > 0) {
+                load_unbinned(filename, gammalib::split(s_columns, ","));
+            }
+            else {
+                load_unbinned(filename);
+            }
 
             // Increment parameter counter
             npar[0]++;
@@ -536,6 +559,16 @@ void GCTAObservation::write(GXmlElement& xml) const
         // Handle Eventlist
         if (par->attribute("name") == "EventList") {
             par->attribute("file", m_eventfile);
+            if (list->projected()) {
+                std::string columns = "TIME,RA,DEC,ENERGY";
+                for (int k = 0; k < list->projection().size(); ++k) {
+                    columns += ","+list->projection()[k];
+                }
+                par->attribute("columns", columns);
+            }
+            if (m_stream.is_open()) {
+                par->attribute("chunk", gammalib::str(m_stream.chunk_size()));
+            }
             npar[0]++;
         }
 
@@ -663,6 +696,11 @@ std::string GCTAObservation::print(const GChatter& chatter) const
             result.append("\n"+response().print(gammalib::reduce(chatter)));
         }
 
+        // Append event stream
+        if (m_stream.is_open() && gammalib::reduce(chatter) > SILENT) {
+            result.append("\n"+m_stream.print(gammalib::reduce(chatter)));
+        }
+
         // Append events
         if (m_events != NULL && gammalib::reduce(chatter) > SILENT) {
             result.append("\n"+m_events->print(gammalib::reduce(chatter)));
@@ -682,10 +720,11 @@ std::string GCTAObservation::print(const GChatter& chatter) const
  ***************************************************************************/
 void GCTAObservation::load_unbinned(const std::string& filename)
 {
-    // Delete any existing event container (do not call clear() as we do not
-    // want to delete the response function)
+    // Delete any existing event container and close any event stream (do
+    // not call clear() as we do not want to delete the response function)
     if (m_events != NULL) delete m_events;
     m_events = NULL;
+    m_stream.close();
 
     // Allocate event list
     GCTAEventList* events = new GCTAEventList;
@@ -714,6 +753,99 @@ void GCTAObservation::load_unbinned(const std::string& filename)
 }
 
 
+/***********************************************************************//**
+ * @brief Load data for unbinned analysis with column projection
+ *
+ * @param[in] filename Event FITS file name.
+ * @param[in] columns Event columns to read.
+ *
+ * Loads the events in columnar form, reading only the columns that are
+ * needed for a likelihood analysis and the specified columns. All other
+ * event columns are read from the file when they are requested.
+ ***************************************************************************/
+void GCTAObservation::load_unbinned(const std::string&              filename,
+                                    const std::vector<std::string>& columns)
+{
+    // Delete any existing event container and close any event stream (do
+    // not call clear() as we do not want to delete the response function)
+    if (m_events != NULL) delete m_events;
+    m_events = NULL;
+    m_stream.close();
+
+    // Allocate event list with column projection
+    GCTAEventList* events = new GCTAEventList;
+    events->projection(columns);
+
+    // Assign event list as the observation's event container
+    m_events = events;
+
+    // Open FITS file
+    GFits fits(filename);
+
+    // Read event list
+    events->read(fits);
+
+    // Read observation attributes from EVENTS extension
+    const GFitsHDU& hdu = *fits.at("EVENTS");
+    read_attributes(hdu);
+
+    // Close FITS file
+    fits.close();
+
+    // Store event filename
+    m_eventfile = filename;
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Stream data for unbinned analysis
+ *
+ * @param[in] filename Event FITS file name.
+ * @param[in] chunk_size Number of event file rows per chunk.
+ *
+ * Associates the observation with an event stream instead of loading all
+ * events into memory. Only a single chunk of @p chunk_size rows is held in
+ * memory at any time. The event list of the observation holds the first
+ * chunk of events. The unbinned likelihood is computed in one pass over
+ * all chunks of the event file, which are read into an event list of
+ * the likelihood computation, hence the event list of the observation is
+ * not altered by the likelihood computation.
+ ***************************************************************************/
+void GCTAObservation::stream_unbinned(const std::string& filename,
+                                      const int&         chunk_size)
+{
+    // Delete any existing event container and close any event stream (do
+    // not call clear() as we do not want to delete the response function)
+    if (m_events != NULL) delete m_events;
+    m_events = NULL;
+    m_stream.close();
+
+    // Open event stream
+    m_stream.chunk_size(chunk_size);
+    m_stream.open(filename);
+
+    // Allocate event list and read first chunk of events
+    GCTAEventList* events = new GCTAEventList;
+    m_events = events;
+    m_stream.next(*events);
+
+    // Read observation attributes from EVENTS extension
+    GFits fits(filename);
+    const GFitsHDU& hdu = *fits.at("EVENTS");
+    read_attributes(hdu);
+    fits.close();
+
+    // Store event filename
+    m_eventfile = filename;
+
+    // Return
+    return;
+}
+
+
 /***********************************************************************//**
  * @brief Load data for binned analysis
  *
@@ -721,10 +853,11 @@ void GCTAObservation::load_unbinned(const std::string& filename)
  ***************************************************************************/
 void GCTAObservation::load_binned(const std::string& filename)
 {
-    // Delete any existing event container (do not call clear() as we do not
-    // want to delete the response function)
+    // Delete any existing event container and close any event stream (do
+    // not call clear() as we do not want to delete the response function)
     if (m_events != NULL) delete m_events;
     m_events = NULL;
+    m_stream.close();
 
     // Allocate event cube
     GCTAEventCube* events = new GCTAEventCube;
@@ -803,6 +936,92 @@ void GCTAObservation::save(const std::string& filename, const bool& clobber) con
 }
 
 
+/*==========================================================================
+ =                                                                         =
+ =                            Protected methods                            =
+ =                                                                         =
+ ==========================================================================*/
+
+/***********************************************************************//**
+ * @brief Evaluate log-likelihood function for Poisson statistics and
+ *        unbinned analysis
+ *
+ * @param[in] models Models.
+ * @param[in,out] gradient Gradient.
+ * @param[in,out] curvature Curvature matrix.
+ * @param[in,out] npred Number of predicted events.
+ * @return Likelihood value.
+ *
+ * If the observation is associated with an event stream, the Npred term is
+ * computed once from the observation and the event term of the
+ * -(log-likelihood) function is accumulated in one pass over all chunks
+ * of the event file. The chunks are read into an event list that is owned
+ * by this method and that is evaluated through a copy of the observation,
+ * so neither the event list nor the event stream of the observation are
+ * altered. Otherwise the likelihood is computed from the event list.
+ ***************************************************************************/
+double GCTAObservation::likelihood_poisson_unbinned(const GModels& models,
+                                                    GVector*       gradient,
+                                                    GMatrixSparse* curvature,
+                                                    double*        npred) const
+{
+    // Initialise likelihood value
+    double value = 0.0;
+
+    // Stream events if an event stream exists
+    if (m_stream.is_open()) {
+
+        // Determine Npred value and gradient for this observation
+        GVector wrk_grad(gradient->size());
+        double  npred_value = this->npred(models, &wrk_grad);
+
+        // Update likelihood, Npred and gradient
+        value     += npred_value;
+        *npred    += npred_value;
+        *gradient += wrk_grad;
+
+        // Setup a copy of the event stream and an event list that holds
+        // the chunks of events, and attach the event list to a copy of the
+        // observation. The copy keeps its chunk workspaces so that they
+        // are allocated only once for all chunks of events.
+        GCTAEventStream  stream = m_stream;
+        GCTAEventList    events;
+        GCTAObservation* obs    =
+            static_cast<GCTAObservation*>(clone_for_thread(true));
+        obs->m_events = &events;
+        obs->keep_workspaces(true);
+
+        // Update likelihood, gradient and curvature matrix for all chunks.
+        // Re-attach the shared event container of the observation before
+        // the copy is released, also if an exception occurs.
+        try {
+            stream.rewind();
+            while (stream.next(events)) {
+                value += obs->likelihood_poisson_events(models, gradient,
+                                                        curvature);
+            }
+        }
+        catch (...) {
+            obs->m_events = m_events;
+            free_thread_clone(obs, true);
+            throw;
+        }
+        obs->m_events = m_events;
+        free_thread_clone(obs, true);
+
+    } // endif: events were streamed
+
+    // ... otherwise use event list
+    else {
+        value = GObservation::likelihood_poisson_unbinned(models, gradient,
+                                                          curvature, npred);
+    }
+
+    // Return
+    return value;
+}
+
+
 /*==========================================================================
  =                                                                         =
  =                            Private methods                              =
@@ -825,6 +1044,7 @@ void GCTAObservation::init_members(void)
     m_deadc      = 0.0;
     m_ra_obj     = 0.0;
     m_dec_obj    = 0.0;
+    m_stream.clear();
 
     // Return
     return;
@@ -849,6 +1069,7 @@ void GCTAObservation::copy_members(const GCTAObservation& obs)
     m_deadc      = obs.m_deadc;
     m_ra_obj     = obs.m_ra_obj;
     m_dec_obj    = obs.m_dec_obj;
+    m_stream     = obs.m_stream;
 
     // Return
     return;
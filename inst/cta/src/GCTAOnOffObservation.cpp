@@ -28,6 +28,7 @@
 #ifdef HAVE_CONFIG_H
 #include <config.h>
 #endif
+#include <vector>
 #include "GCTAOnOffObservation.hpp"
 #include "GTools.hpp"
 
@@ -455,19 +456,26 @@ void GCTAOnOffObservation::fill(const GCTAObservation& obs)
         throw GException::invalid_value(G_FILL, msg);
 	}
 
+    // Collect measured event directions
+    std::vector<GSkyDir> dirs;
+    dirs.reserve(events->size());
+    for (int i = 0; i < events->size(); ++i) {
+        dirs.push_back((*events)[i]->dir().dir());
+    }
+
+    // Determine region containment of all events at once
+    std::vector<bool> in_on  = m_on_regions.contains(dirs);
+    std::vector<bool> in_off = m_off_regions.contains(dirs);
+
     // Loop over all events
 	for (int i = 0; i < events->size(); ++i) {
 
-        // Get measured event direction
-		const GCTAEventAtom* atom = (*events)[i];
-		GSkyDir              dir  = atom->dir().dir();
-
         // Fill in spectrum according to region containment
-		if (m_on_regions.contains(dir)) {
-			m_on_spec.fill(atom->energy());
+		if (in_on[i]) {
+			m_on_spec.fill((*events)[i]->energy());
 		}
-		if (m_off_regions.contains(dir)) {
-			m_off_spec.fill(atom->energy());
+		if (in_off[i]) {
+			m_off_spec.fill((*events)[i]->energy());
 		}
         
 	} // endfor: looped over all events
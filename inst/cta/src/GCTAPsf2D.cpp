@@ -369,6 +369,31 @@ double GCTAPsf2D::delta_max(const double& logE,
 }
 
 
+/***********************************************************************//**
+ * @brief Compile point spread function onto a regular grid
+ *
+ * @param[in] nlogE Number of grid nodes in log10 energy (>=2).
+ * @param[in] ntheta Number of grid nodes in offset angle (>=2).
+ *
+ * Compiles the point spread function response table onto a regular grid
+ * in log10 energy and offset angle (see GCTAResponseTable::compile()). The
+ * maximum interpolation error of the grid can be retrieved from the
+ * response table using table().compile_error().
+ ***************************************************************************/
+void GCTAPsf2D::compile(const int& nlogE, const int& ntheta)
+{
+    // Compile response table
+    m_psf.compile(nlogE, ntheta);
+
+    // Invalidate parameter cache
+    m_par_logE  = -1.0e30;
+    m_par_theta = -1.0;
+
+    // Return
+    return;
+}
+
+
 /***********************************************************************//**
  * @brief Print point spread function information
  *
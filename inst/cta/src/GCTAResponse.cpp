@@ -36,14 +36,23 @@
 #include "GMath.hpp"
 #include "GIntegral.hpp"
 #include "GCaldb.hpp"
+#include "GModels.hpp"
+#include "GModelSky.hpp"
+#include "GModelSpatialPointSource.hpp"
 #include "GModelSpatialRadial.hpp"
+#include "GModelSpatialRadialDisk.hpp"
+#include "GModelSpatialRadialShell.hpp"
 #include "GModelSpatialElliptical.hpp"
+#include "GModelSpatialEllipticalDisk.hpp"
+#include "GModelSpatialDiffuse.hpp"
 #include "GCTAObservation.hpp"
 #include "GCTAResponse.hpp"
 #include "GCTAResponse_helpers.hpp"
 #include "GCTAPointing.hpp"
 #include "GCTAEventAtom.hpp"
 #include "GCTAEventList.hpp"
+#include "GCTAEventBin.hpp"
+#include "GCTAEventCube.hpp"
 #include "GCTARoi.hpp"
 #include "GCTAException.hpp"
 #include "GCTASupport.hpp"
@@ -58,6 +67,22 @@
 #include "GCTAPsf.hpp"
 #include "GCTAEdisp.hpp"
 
+/* __ Constants __________________________________________________________ */
+const int g_geo_index     = 0;  //!< Event index
+const int g_geo_eta       = 1;  //!< Offset angle from pointing (radians)
+const int g_geo_logE      = 2;  //!< log10 of measured energy (TeV)
+const int g_geo_delta_max = 3;  //!< Maximum PSF radius (radians)
+const int g_geo_rot       = 4;  //!< Rotation matrix (9 values)
+const int g_geo_size      = 13; //!< Number of geometry values per event
+const int g_par_ra        = 0;  //!< Right Ascension parameter index
+const int g_par_dec       = 1;  //!< Declination parameter index
+const int g_par_pa        = 2;  //!< Elliptical Position Angle parameter index
+const int g_par_radius    = 2;  //!< Radial disk and shell radius parameter index
+const int g_par_width     = 3;  //!< Radial shell width parameter index
+const int g_par_semiminor = 3;  //!< Elliptical disk semi-minor axis index
+const int g_par_semimajor = 4;  //!< Elliptical disk semi-major axis index
+const int g_gk_max_iter   = 50; //!< Maximum Gauss-Kronrod bisections
+
 /* __ Method name definitions ____________________________________________ */
 #define G_CALDB                           "GCTAResponse::caldb(std::string&)"
 #define G_IRF      "GCTAResponse::irf(GInstDir&, GEnergy&, GTime&, GSkyDir&,"\
@@ -67,9 +92,9 @@
 #define G_MC            "GCTAResponse::mc(double&,GPhoton&,GPointing&,GRan&)"
 
 #define G_IRF_RADIAL            "GCTAResponse::irf_radial(GEvent&, GSource&,"\
-                                                            " GObservation&)"
+                                                     " GObservation&, bool&)"
 #define G_IRF_ELLIPTICAL    "GCTAResponse::irf_elliptical(GEvent&, GSource&,"\
-                                                            " GObservation&)"
+                                                     " GObservation&, bool&)"
 #define G_IRF_DIFFUSE          "GCTAResponse::irf_diffuse(GEvent&, GSource&,"\
                                                             " GObservation&)"
 #define G_NPRED_RADIAL  "GCTAResponse::npred_radial(GSource&, GObservation&)"
@@ -82,8 +107,9 @@
 /* __ Macros _____________________________________________________________ */
 
 /* __ Coding definitions _________________________________________________ */
-#define G_USE_IRF_CACHE            //!< Use IRF cache in irf_diffuse method
+#define G_USE_IRF_CACHE            //!< Use IRF cache in irf_* methods
 #define G_USE_NPRED_CACHE      //!< Use Npred cache in npred_diffuse method
+#define G_USE_GEOMETRY_CACHE  //!< Use event geometry cache in irf_* methods
 
 /* __ Debug definitions __________________________________________________ */
 //#define G_DEBUG_IRF_RADIAL                     //!< Debug irf_radial method
@@ -642,6 +668,9 @@ void GCTAResponse::load_aeff(const std::string& filename)
         m_aeff = new GCTAAeffPerfTable(filename);
     }
 
+    // Compile response tables if requested
+    compile_irfs();
+
     // Return
     return;
 }
@@ -717,6 +746,46 @@ void GCTAResponse::load_psf(const std::string& filename)
         m_psf = new GCTAPsfPerfTable(filename);
     }
 
+    // Compile response tables if requested
+    compile_irfs();
+
+    // Signal that point spread function has changed
+    set_psf_id();
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Compile response tables onto regular grids
+ *
+ * @param[in] nlogE Number of grid nodes in log10 energy (>=2).
+ * @param[in] ntheta Number of grid nodes in offset angle (>=2).
+ *
+ * Enables the compiled response mode. All effective area and point spread
+ * function response tables are resampled onto a regular grid in log10
+ * energy and offset angle, so that their interpolation reduces to index
+ * arithmetic (see GCTAResponseTable::compile()). This applies to the
+ * response tables that are currently loaded and to all response tables
+ * that are loaded later using load_aeff() or load_psf(). The maximum
+ * interpolation errors of the grids are listed by print().
+ *
+ * Response functions that are not based on response tables (performance
+ * tables, ARF and PSF vectors) are not affected.
+ ***************************************************************************/
+void GCTAResponse::compile(const int& nlogE, const int& ntheta)
+{
+    // Set grid size
+    m_grid_nlogE  = nlogE;
+    m_grid_ntheta = ntheta;
+
+    // Compile response tables
+    compile_irfs();
+
+    // Signal that point spread function has changed
+    set_psf_id();
+
     // Return
     return;
 }
@@ -842,12 +911,96 @@ std::string GCTAResponse::print(const GChatter& chatter) const
  =                                                                         =
  ==========================================================================*/
 
+/***********************************************************************//**
+ * @brief Return IRF value for a source model
+ *
+ * @param[in] event Observed event.
+ * @param[in] source Source.
+ * @param[in] obs Observation.
+ * @param[in] grad Compute spatial model parameter gradients?
+ * @return IRF value.
+ *
+ * Returns the IRF value for a source model. For binned analyses, the IRF
+ * values of extended and diffuse sources are cached in the event cube, so
+ * that the computation of the IRF is only done once per event bin and
+ * source. The cached values are reset when a spatial model parameter
+ * changes, hence a fit that adjusts only spectral parameters reuses the
+ * cached values in all iterations. Point sources are not cached since
+ * their IRF is a direct evaluation that is faster than the cache lookup.
+ *
+ * The cache is only used during model evaluations for which the cache
+ * handles were resolved by set_source_caches(), so that the values of the
+ * individual event bins are accessed without locking the cache.
+ ***************************************************************************/
+double GCTAResponse::irf(const GEvent&       event,
+                         const GSource&      source,
+                         const GObservation& obs,
+                         const bool&         grad) const
+{
+    // Try getting the IRF value from the event cube cache. If the value
+    // was found and no gradients are requested then return the value. If
+    // gradients are requested then restore the gradients that were stored
+    // with the value (circumvent const correctness) and return the value.
+    #if defined(G_USE_IRF_CACHE)
+    const GCTAEventCube* cube   = NULL;
+    const GCTAEventBin*  bin    = NULL;
+    int                  handle = -1;
+    if (m_src_set) {
+        cube = dynamic_cast<const GCTAEventCube*>(obs.events());
+        bin  = dynamic_cast<const GCTAEventBin*>(&event);
+        if (cube != NULL && bin != NULL &&
+            source.energy() == event.energy() && source.time() == event.time()) {
+            handle = source_cache_handle(source);
+        }
+    }
+    if (handle != -1) {
+        double cached = cube->irf_cache_value(handle, bin->index());
+        if (cached >= 0.0) {
+            if (!grad) {
+                return cached;
+            }
+            GModelSpatial*      ptr = const_cast<GModelSpatial*>(source.model());
+            std::vector<double> cached_grads(ptr->size(), 0.0);
+            if (cube->irf_cache_gradients(handle, bin->index(), &cached_grads)) {
+                for (int i = 0; i < ptr->size(); ++i) {
+                    (*ptr)[i].factor_gradient(cached_grads[i]);
+                }
+                return cached;
+            }
+        }
+    }
+    #endif
+
+    // Compute IRF value
+    double irf = GResponse::irf(event, source, obs, grad);
+
+    // Put IRF value and gradients in cache
+    #if defined(G_USE_IRF_CACHE)
+    if (handle != -1) {
+        cube->irf_cache_value(handle, bin->index(), irf);
+        if (grad) {
+            const GModelSpatial* ptr = source.model();
+            std::vector<double>  grads(ptr->size(), 0.0);
+            for (int i = 0; i < ptr->size(); ++i) {
+                grads[i] = (*ptr)[i].factor_gradient();
+            }
+            cube->irf_cache_gradients(handle, bin->index(), grads);
+        }
+    }
+    #endif
+
+    // Return IRF value
+    return irf;
+}
+
+
 /***********************************************************************//**
  * @brief Return IRF value for radial source model
  *
  * @param[in] event Observed event.
  * @param[in] source Source.
  * @param[in] obs Observation.
+ * @param[in] grad Compute spatial model parameter gradients?
  *
  * @exception GCTAException::bad_model_type
  *            Model is not a radial model.
@@ -887,10 +1040,35 @@ std::string GCTAResponse::print(const GChatter& chatter) const
  * direction). Given the slow variation of the PSF shape over the field of
  * view, this approximation should be fine. It helps in fact a lot in
  * speeding up the computations.
+ *
+ * If @p grad is true, the method also sets the factor gradients of the
+ * spatial model parameters to the derivatives of the IRF with respect to
+ * the parameters. The shape parameter gradients are obtained by
+ * integrating the model gradients over the IRF. For the disk and the shell
+ * models, which are not continuous in \f$\rho\f$, the contributions of
+ * the model boundaries are computed explicitly. The gradients with respect
+ * to the model centre are computed from the derivative of the IRF with
+ * respect to a shift of the model centre towards the measured photon
+ * direction,
+ *
+ * \f[
+ *    \frac{\partial IRF}{\partial \epsilon} =
+ *    -\int_{\rho_{\rm min}}^{\rho_{\rm max}}
+ *    \sin \rho \times \frac{\partial S_{\rm p}(\rho | E, t)}{\partial \rho}
+ *    \times \int_{\omega_{\rm min}}^{\omega_{\rm max}}
+ *    IRF(\rho, \omega) \cos \omega d\omega d\rho
+ * \f]
+ *
+ * The derivative with respect to a shift perpendicular to this direction
+ * vanishes for an azimuthally symmetric IRF, and is neglected.
+ *
+ * For unbinned observations, the IRF values are stored in the IRF cache of
+ * the event list if all spatial model parameters are fixed.
  ***************************************************************************/
 double GCTAResponse::irf_radial(const GEvent&       event,
                                 const GSource&      source,
-                                const GObservation& obs) const
+                                const GObservation& obs,
+                                const bool&         grad) const
 {
     // Retrieve CTA pointing
     const GCTAPointing& pnt = retrieve_pnt(G_IRF_RADIAL, obs);
@@ -903,6 +1081,35 @@ double GCTAResponse::irf_radial(const GEvent&       event,
         throw GCTAException::bad_model_type(G_IRF_RADIAL);
     }
 
+    // Try getting the IRF value from cache. If the value was found and no
+    // gradients are requested then return the value. If gradients are
+    // requested then restore the gradients that were stored with the value
+    // (circumvent const correctness) and return the value. Gradients are
+    // only cached during model evaluations for which the source caches
+    // were set, since they are accessed without locking.
+    #if defined(G_USE_IRF_CACHE)
+    const GCTAEventList* list   = dynamic_cast<const GCTAEventList*>(obs.events());
+    const GCTAEventAtom* atom   = dynamic_cast<const GCTAEventAtom*>(&event);
+    int                  handle = (list != NULL && atom != NULL && (m_src_set || !grad))
+                                  ? irf_cache_handle(*list, event, source) : -1;
+    if (handle != -1) {
+        double cached = irf_cache_value(*list, handle, atom->index());
+        if (cached >= 0.0) {
+            if (!grad) {
+                return cached;
+            }
+            std::vector<double> cached_grads(model->size(), 0.0);
+            if (list->irf_cache_gradients(handle, atom->index(), &cached_grads)) {
+                GModelSpatialRadial* ptr = const_cast<GModelSpatialRadial*>(model);
+                for (int i = 0; i < ptr->size(); ++i) {
+                    (*ptr)[i].factor_gradient(cached_grads[i]);
+                }
+                return cached;
+            }
+        }
+    }
+    #endif
+
     // Get event attributes
     //const GSkyDir& obsDir = dir->dir();
     const GEnergy& obsEng = event.energy();
@@ -912,6 +1119,10 @@ double GCTAResponse::irf_radial(const GEvent&       event,
     const GEnergy& srcEng  = source.energy();
     const GTime&   srcTime = source.time();
 
+    // Get event geometry
+    double geo[g_geo_size];
+    event_geometry(event, dir, pnt, obs, geo);
+
     // Get pointing direction zenith angle and azimuth [radians]
     double zenith  = pnt.zenith();
     double azimuth = pnt.azimuth();
@@ -920,9 +1131,9 @@ double GCTAResponse::irf_radial(const GEvent&       event,
     // centre [radians]
     double zeta = centre.dist(dir.dir());
 
-    // Determine angular distance between measured photon direction and
-    // pointing direction [radians]
-    double eta = pnt.dir().dist(dir.dir());
+    // Get angular distance between measured photon direction and pointing
+    // direction [radians]
+    double eta = geo[g_geo_eta];
 
     // Determine angular distance between model centre and pointing direction
     // [radians]
@@ -938,8 +1149,8 @@ double GCTAResponse::irf_radial(const GEvent&       event,
     }
 
     // Get log10(E/TeV) of true and measured photon energies
-    double srcLogEng = srcEng.log10TeV();
-    double obsLogEng = obsEng.log10TeV();
+    double obsLogEng = geo[g_geo_logE];
+    double srcLogEng = (srcEng == obsEng) ? obsLogEng : srcEng.log10TeV();
 
     // Assign the observed theta angle (eta) as the true theta angle
     // between the source and the pointing directions. This is a (not
@@ -951,8 +1162,12 @@ double GCTAResponse::irf_radial(const GEvent&       event,
     double theta = eta;
     double phi   = 0.0; //TODO: Implement IRF Phi dependence
 
-    // Get maximum PSF and source radius in radians.
-    double delta_max = psf_delta_max(theta, phi, zenith, azimuth, srcLogEng);
+    // Get maximum PSF and source radius in radians. The maximum PSF radius
+    // of the event geometry applies if the true energy is the measured
+    // energy.
+    double delta_max = (srcEng == obsEng)
+                       ? geo[g_geo_delta_max]
+                       : psf_delta_max(theta, phi, zenith, azimuth, srcLogEng);
     double src_max   = model->theta_max();
 
     // Set radial model zenith angle range
@@ -962,8 +1177,9 @@ double GCTAResponse::irf_radial(const GEvent&       event,
         rho_max = src_max;
     }
 
-    // Initialise IRF value
-    double irf = 0.0;
+    // Initialise IRF value and gradients
+    double              irf = 0.0;
+    std::vector<double> gradients((grad) ? model->size() : 0, 0.0);
 
     // Perform zenith angle integration if interval is valid
     if (rho_max > rho_min) {
@@ -982,10 +1198,13 @@ double GCTAResponse::irf_radial(const GEvent&       event,
                                           omega0,
                                           delta_max);
 
-        // Integrate over zenith angle
+        // Integrate over zenith angle. The adaptive Gauss-Kronrod rule
+        // needs far fewer kernel calls than Romberg integration; kinks of
+        // the kernel are handled by bisection
         GIntegral integral(&integrand);
         integral.eps(m_eps);
-        irf = integral.romb(rho_min, rho_max);
+        integral.max_iter(g_gk_max_iter);
+        irf = integral.gauss_kronrod(rho_min, rho_max);
 
         // Compile option: Check for NaN/Inf
         #if defined(G_NAN_CHECK)
@@ -1000,11 +1219,258 @@ double GCTAResponse::irf_radial(const GEvent&       event,
         }
         #endif
 
+        // Optionally compute gradients
+        if (grad) {
+
+            // Set model parameter indices of model centre. The parameter
+            // order is fixed by the init_members() methods of the models.
+            const int ira  = g_par_ra;
+            const int idec = g_par_dec;
+
+            // Determine whether centre gradients are needed. The centre
+            // gradients vanish if the measured photon direction coincides
+            // with the model centre.
+            bool do_shift = (zeta > 0.0) &&
+                            ((*model)[ira].is_free() || (*model)[idec].is_free());
+
+            // Initialise derivative with respect to a shift of the model
+            // centre towards the measured photon direction
+            double g_shift = 0.0;
+
+            // Case A: Radial disk model
+            if (dynamic_cast<const GModelSpatialRadialDisk*>(model) != NULL) {
+
+                // Get disk radius and parameter index
+                const GModelSpatialRadialDisk* disk =
+                      static_cast<const GModelSpatialRadialDisk*>(model);
+                double    radius = disk->radius() * gammalib::deg2rad;
+                const int irad   = g_par_radius;
+
+                // Get disk normalisation and its gradient. Within the
+                // disk, the model gradient is proportional to the model
+                // value
+                double norm = model->eval_gradients(0.0, srcEng, srcTime);
+                if (norm > 0.0) {
+                    gradients[irad] = (*model)[irad].factor_gradient() / norm *
+                                      irf;
+                }
+
+                // Add contributions from disk boundary
+                if (radius >= rho_min && radius <= rho_max) {
+                    if ((*model)[irad].is_free()) {
+                        gradients[irad] += norm * integrand.arc(radius, false) *
+                                           gammalib::deg2rad *
+                                           (*model)[irad].scale();
+                    }
+                    if (do_shift) {
+                        g_shift = norm * integrand.arc(radius, true);
+                    }
+                }
+
+            } // endif: radial disk model
+
+            // Case B: Radial shell model
+            else if (dynamic_cast<const GModelSpatialRadialShell*>(model) != NULL) {
+
+                // Get shell radii and parameter indices
+                const GModelSpatialRadialShell* shell =
+                      static_cast<const GModelSpatialRadialShell*>(model);
+                bool   small_angle = shell->small_angle();
+                double radii[2];
+                radii[0]    = shell->radius() * gammalib::deg2rad;
+                radii[1]    = (shell->radius() + shell->width()) *
+                              gammalib::deg2rad;
+                const int irad = g_par_radius;
+                const int iwid = g_par_width;
+
+                // Compute shell function at the shell centre for inner and
+                // outer radius, and derivative of the normalisation integral
+                // of the shell function with respect to both radii
+                double f[2];
+                double dk[2];
+                for (int k = 0; k < 2; ++k) {
+                    double sin_r = std::sin(radii[k]);
+                    double cos_r = std::cos(radii[k]);
+                    if (small_angle) {
+                        f[k]  = radii[k];
+                        dk[k] = gammalib::twopi * radii[k] * radii[k];
+                    }
+                    else {
+                        f[k]  = sin_r;
+                        dk[k] = (radii[k] > 0.0)
+                                ? gammalib::twopi * sin_r * cos_r *
+                                  std::log((1.0 + sin_r) / cos_r)
+                                : 0.0;
+                    }
+                }
+
+                // Get shell normalisation
+                double norm = (f[1] > f[0])
+                              ? model->eval(0.0, srcEng, srcTime) / (f[1] - f[0])
+                              : 0.0;
+
+                // Compute derivatives of the shell function integrals with
+                // respect to the radii. The integration is done in the
+                // substitution variable t.
+                double dj[2] = {0.0, 0.0};
+                double dl[2] = {0.0, 0.0};
+                for (int k = 0; k < 2; ++k) {
+
+                    // Skip zero radius and radii below integration range
+                    if (radii[k] <= 0.0 || radii[k] <= rho_min) {
+                        continue;
+                    }
+
+                    // Compute substitution variable integration range
+                    double rho_up = (radii[k] < rho_max) ? radii[k] : rho_max;
+                    double t_min;
+                    double t_max;
+                    if (small_angle) {
+                        t_min = std::asin(rho_min / radii[k]);
+                        t_max = std::asin(rho_up  / radii[k]);
+                    }
+                    else {
+                        double sin_r = std::sin(radii[k]);
+                        t_min = std::asin(std::sin(rho_min) / sin_r);
+                        t_max = std::asin(std::sin(rho_up)  / sin_r);
+                    }
+
+                    // Integrate radius derivative kernel
+                    if ((*model)[irad].is_free() || (*model)[iwid].is_free()) {
+                        cta_irf_radial_kern_shell kernel(*this, *model, zenith,
+                                                         azimuth, srcEng,
+                                                         srcTime, srcLogEng,
+                                                         obsLogEng, zeta,
+                                                         lambda, omega0,
+                                                         delta_max, radii[k],
+                                                         small_angle, false);
+                        GIntegral integral(&kernel);
+                        integral.eps(m_eps);
+                        dj[k] = integral.romb(t_min, t_max);
+                    }
+
+                    // Integrate centre derivative kernel
+                    if (do_shift) {
+                        cta_irf_radial_kern_shell kernel(*this, *model, zenith,
+                                                         azimuth, srcEng,
+                                                         srcTime, srcLogEng,
+                                                         obsLogEng, zeta,
+                                                         lambda, omega0,
+                                                         delta_max, radii[k],
+                                                         small_angle, true);
+                        GIntegral integral(&kernel);
+                        integral.eps(m_eps);
+                        dl[k] = integral.romb(t_min, t_max);
+                    }
+
+                } // endfor: looped over radii
+
+                // Compute IRF derivatives with respect to inner and outer
+                // radius
+                double d_in  = norm * (irf * dk[0] - dj[0]);
+                double d_out = norm * (dj[1] - irf * dk[1]);
+
+                // Set shape gradients
+                if ((*model)[irad].is_free()) {
+                    gradients[irad] = (d_in + d_out) * gammalib::deg2rad *
+                                      (*model)[irad].scale();
+                }
+                if ((*model)[iwid].is_free()) {
+                    gradients[iwid] = d_out * gammalib::deg2rad *
+                                      (*model)[iwid].scale();
+                }
+
+                // Set shift derivative
+                g_shift = norm * (dl[1] - dl[0]);
+
+            } // endelse: radial shell model
+
+            // Case C: Continuous radial model
+            else {
+
+                // Loop over all shape parameters
+                for (int i = 0; i < model->size(); ++i) {
+
+                    // Skip centre and fixed parameters
+                    if (i == ira || i == idec || !(*model)[i].is_free()) {
+                        continue;
+                    }
+
+                    // Integrate model gradient over IRF
+                    cta_irf_radial_kern_rho_grad kernel(*this, *model, zenith,
+                                                        azimuth, srcEng,
+                                                        srcTime, srcLogEng,
+                                                        obsLogEng, zeta,
+                                                        lambda, omega0,
+                                                        delta_max, i, false);
+                    GIntegral integral(&kernel);
+                    integral.eps(m_eps);
+                    integral.max_iter(g_gk_max_iter);
+                    gradients[i] = integral.gauss_kronrod(rho_min, rho_max);
+
+                } // endfor: looped over shape parameters
+
+                // Integrate model derivative with respect to rho
+                if (do_shift) {
+                    cta_irf_radial_kern_rho_grad kernel(*this, *model, zenith,
+                                                        azimuth, srcEng,
+                                                        srcTime, srcLogEng,
+                                                        obsLogEng, zeta,
+                                                        lambda, omega0,
+                                                        delta_max, -1, true);
+                    GIntegral integral(&kernel);
+                    integral.eps(m_eps);
+                    integral.max_iter(g_gk_max_iter);
+                    g_shift = -integral.gauss_kronrod(rho_min, rho_max);
+                }
+
+            } // endelse: continuous radial model
+
+            // Convert shift derivative into centre gradients
+            if (do_shift) {
+                double posang  = centre.posang(dir.dir());
+                double cos_dec = std::cos(centre.dec());
+                if ((*model)[ira].is_free()) {
+                    gradients[ira] = g_shift * std::sin(posang) * cos_dec *
+                                     gammalib::deg2rad * (*model)[ira].scale();
+                }
+                if ((*model)[idec].is_free()) {
+                    gradients[idec] = g_shift * std::cos(posang) *
+                                      gammalib::deg2rad * (*model)[idec].scale();
+                }
+            }
+
+            // Apply deadtime correction to gradients
+            double deadc = obs.deadc(srcTime);
+            for (int i = 0; i < model->size(); ++i) {
+                gradients[i] *= deadc;
+            }
+
+        } // endif: gradients were requested
+
         // Apply deadtime correction
         irf *= obs.deadc(srcTime);
 
     }
 
+    // Optionally set gradients (circumvent const correctness)
+    if (grad) {
+        GModelSpatialRadial* ptr = const_cast<GModelSpatialRadial*>(model);
+        for (int i = 0; i < ptr->size(); ++i) {
+            (*ptr)[i].factor_gradient(gradients[i]);
+        }
+    }
+
+    // Put IRF value and gradients in cache
+    #if defined(G_USE_IRF_CACHE)
+    if (handle != -1) {
+        irf_cache_value(*list, handle, atom->index(), irf);
+        if (grad) {
+            list->irf_cache_gradients(handle, atom->index(), gradients);
+        }
+    }
+    #endif
+
     // Compile option: Show integration results
     #if defined(G_DEBUG_IRF_RADIAL)
     std::cout << "GCTAResponse::irf_radial:";
@@ -1024,6 +1490,7 @@ double GCTAResponse::irf_radial(const GEvent&       event,
  * @param[in] event Observed event.
  * @param[in] source Source.
  * @param[in] obs Observation.
+ * @param[in] grad Compute spatial model parameter gradients?
  *
  * @exception GCTAException::bad_instdir_type
  *            Instrument direction is not a valid CTA instrument direction.
@@ -1054,10 +1521,22 @@ double GCTAResponse::irf_radial(const GEvent&       event,
  * \f$(\omega)\f$ is counted counterclockwise from the vector that runs from
  * the model centre \f$\vec{m}\f$ to the measured photon direction
  * \f$\vec{p'}\f$.
+ *
+ * If @p grad is true and the model is an elliptical disk, the method also
+ * sets the factor gradients of the spatial model parameters to the
+ * derivatives of the IRF with respect to the parameters. Since the disk is
+ * constant within the ellipse, all derivatives besides those of the disk
+ * normalisation are given by integrals of the IRF along the ellipse
+ * boundary \f$\rho=r(\omega)\f$ (see cta_irf_elliptical_kern_edge). For
+ * other elliptical models the gradients are set to zero.
+ *
+ * For unbinned observations, the IRF values are stored in the IRF cache of
+ * the event list if all spatial model parameters are fixed.
  ***************************************************************************/
 double GCTAResponse::irf_elliptical(const GEvent&       event,
                                     const GSource&      source,
-                                    const GObservation& obs) const
+                                    const GObservation& obs,
+                                    const bool&         grad) const
 {
     // Retrieve CTA pointing
     const GCTAPointing& pnt = retrieve_pnt(G_IRF_ELLIPTICAL, obs);
@@ -1070,6 +1549,35 @@ double GCTAResponse::irf_elliptical(const GEvent&       event,
         throw GCTAException::bad_model_type(G_IRF_ELLIPTICAL);
     }
 
+    // Try getting the IRF value from cache. If the value was found and no
+    // gradients are requested then return the value. If gradients are
+    // requested then restore the gradients that were stored with the value
+    // (circumvent const correctness) and return the value. Gradients are
+    // only cached during model evaluations for which the source caches
+    // were set, since they are accessed without locking.
+    #if defined(G_USE_IRF_CACHE)
+    const GCTAEventList* list   = dynamic_cast<const GCTAEventList*>(obs.events());
+    const GCTAEventAtom* atom   = dynamic_cast<const GCTAEventAtom*>(&event);
+    int                  handle = (list != NULL && atom != NULL && (m_src_set || !grad))
+                                  ? irf_cache_handle(*list, event, source) : -1;
+    if (handle != -1) {
+        double cached = irf_cache_value(*list, handle, atom->index());
+        if (cached >= 0.0) {
+            if (!grad) {
+                return cached;
+            }
+            std::vector<double> cached_grads(model->size(), 0.0);
+            if (list->irf_cache_gradients(handle, atom->index(), &cached_grads)) {
+                GModelSpatialElliptical* ptr = const_cast<GModelSpatialElliptical*>(model);
+                for (int i = 0; i < ptr->size(); ++i) {
+                    (*ptr)[i].factor_gradient(cached_grads[i]);
+                }
+                return cached;
+            }
+        }
+    }
+    #endif
+
     // Get event attributes (measured photon)
     const GSkyDir& obsDir = dir.dir();
     const GEnergy& obsEng = event.energy();
@@ -1079,6 +1587,10 @@ double GCTAResponse::irf_elliptical(const GEvent&       event,
     const GEnergy& srcEng  = source.energy();
     const GTime&   srcTime = source.time();
 
+    // Get event geometry
+    double geo[g_geo_size];
+    event_geometry(event, dir, pnt, obs, geo);
+
     // Get pointing direction zenith angle and azimuth [radians]
     double zenith  = pnt.zenith();
     double azimuth = pnt.azimuth();
@@ -1089,9 +1601,9 @@ double GCTAResponse::irf_elliptical(const GEvent&       event,
     double zeta     = centre.dist(obsDir);
     double obsOmega = centre.posang(obsDir);
 
-    // Determine angular distance between measured photon direction and
-    // pointing direction [radians]
-    double eta = pnt.dir().dist(obsDir);
+    // Get angular distance between measured photon direction and pointing
+    // direction [radians]
+    double eta = geo[g_geo_eta];
 
     // Determine angular distance between model centre and pointing direction
     // [radians]
@@ -1108,16 +1620,19 @@ double GCTAResponse::irf_elliptical(const GEvent&       event,
     }
 
     // Get log10(E/TeV) of true and measured photon energies
-    double srcLogEng = srcEng.log10TeV();
-    double obsLogEng = obsEng.log10TeV();
+    double obsLogEng = geo[g_geo_logE];
+    double srcLogEng = (srcEng == obsEng) ? obsLogEng : srcEng.log10TeV();
 
     // Get maximum PSF radius [radians]. We assign here the measured theta
     // angle (eta) as the true theta angle between the source and the pointing
     // directions. As we only use the angle to determine the maximum PSF size,
-    // this should be sufficient.
+    // this should be sufficient. The maximum PSF radius of the event geometry
+    // applies if the true energy is the measured energy.
     double theta     = eta;
     double phi       = 0.0; //TODO: Implement IRF Phi dependence
-    double delta_max = psf_delta_max(theta, phi, zenith, azimuth, srcLogEng);
+    double delta_max = (srcEng == obsEng)
+                       ? geo[g_geo_delta_max]
+                       : psf_delta_max(theta, phi, zenith, azimuth, srcLogEng);
 
     // Get maximum source model radius [radians]
     double src_max = model->theta_max();
@@ -1129,8 +1644,9 @@ double GCTAResponse::irf_elliptical(const GEvent&       event,
         rho_max = src_max;
     }
 
-    // Initialise IRF value
-    double irf = 0.0;
+    // Initialise IRF value and gradients
+    double              irf = 0.0;
+    std::vector<double> gradients((grad) ? model->size() : 0, 0.0);
 
     // Perform zenith angle integration if interval is valid
     if (rho_max > rho_min) {
@@ -1168,10 +1684,138 @@ double GCTAResponse::irf_elliptical(const GEvent&       event,
         }
         #endif
 
+        // Optionally compute gradients for elliptical disk model
+        const GModelSpatialEllipticalDisk* disk =
+              dynamic_cast<const GModelSpatialEllipticalDisk*>(model);
+        if (grad && disk != NULL) {
+
+            // Set model parameter indices. The parameter order is fixed by
+            // the init_members() methods of the models.
+            const int ira  = g_par_ra;
+            const int idec = g_par_dec;
+            const int ipa  = g_par_pa;
+            const int imaj = g_par_semimajor;
+            const int imin = g_par_semiminor;
+
+            // Get ellipse parameters [radians]
+            double semimajor = disk->semimajor() * gammalib::deg2rad;
+            double semiminor = disk->semiminor() * gammalib::deg2rad;
+            double posangle  = disk->posangle()  * gammalib::deg2rad;
+
+            // Get disk normalisation and its gradients. Within the disk,
+            // the model gradients are proportional to the model value
+            double norm = model->eval_gradients(0.0, 0.0, srcEng, srcTime);
+            if (norm > 0.0) {
+                gradients[imaj] = (*model)[imaj].factor_gradient() / norm * irf;
+                gradients[imin] = (*model)[imin].factor_gradient() / norm * irf;
+            }
+
+            // Determine azimuth angle range of the ellipse boundary that
+            // lies within the PSF validity circle
+            double omega_min = -gammalib::pi;
+            double omega_max = +gammalib::pi;
+            if (zeta > delta_max) {
+                double arg = std::sin(delta_max) / std::sin(zeta);
+                omega_max  = (arg < 1.0) ? std::asin(arg) : gammalib::pihalf;
+                omega_min  = -omega_max;
+            }
+
+            // Split the azimuth range into sub-intervals so that Romberg
+            // integration does not miss the PSF peak on the boundary
+            int    nsub   = int((omega_max - omega_min) / (0.125*gammalib::pi)) + 1;
+            double domega = (omega_max - omega_min) / double(nsub);
+
+            // Compute boundary integrals. The centre shift integrals are
+            // only computed if the measured photon direction differs from
+            // the model centre.
+            bool   shift   = (zeta > 0.0) &&
+                             ((*model)[ira].is_free() || (*model)[idec].is_free());
+            double edge[5] = {0.0, 0.0, 0.0, 0.0, 0.0};
+            bool   need[5] = {(*model)[imaj].is_free(),
+                              (*model)[imin].is_free(),
+                              (*model)[ipa].is_free(),
+                              shift,
+                              shift};
+            for (int mode = 0; mode < 5; ++mode) {
+                if (need[mode]) {
+                    cta_irf_elliptical_kern_edge kernel(*this, zenith, azimuth,
+                                                        srcLogEng, obsLogEng,
+                                                        zeta, lambda, obsOmega,
+                                                        omega0, semimajor,
+                                                        semiminor, posangle,
+                                                        mode);
+                    GIntegral integral(&kernel);
+                    integral.eps(m_eps);
+                    double sum = 0.0;
+                    for (int i = 0; i < nsub; ++i) {
+                        double omin = omega_min + i * domega;
+                        sum        += integral.romb(omin, omin + domega);
+                    }
+                    edge[mode] = norm * sum;
+                }
+            }
+
+            // Set shape gradients
+            if ((*model)[imaj].is_free()) {
+                gradients[imaj] += edge[0] * gammalib::deg2rad *
+                                   (*model)[imaj].scale();
+            }
+            if ((*model)[imin].is_free()) {
+                gradients[imin] += edge[1] * gammalib::deg2rad *
+                                   (*model)[imin].scale();
+            }
+            if ((*model)[ipa].is_free()) {
+                gradients[ipa] = edge[2] * gammalib::deg2rad *
+                                 (*model)[ipa].scale();
+            }
+
+            // Convert centre shift derivatives into centre gradients
+            if (shift) {
+                double sin_pa  = std::sin(obsOmega);
+                double cos_pa  = std::cos(obsOmega);
+                double cos_dec = std::cos(centre.dec());
+                if ((*model)[ira].is_free()) {
+                    gradients[ira] = (edge[3] * sin_pa + edge[4] * cos_pa) *
+                                     cos_dec * gammalib::deg2rad *
+                                     (*model)[ira].scale();
+                }
+                if ((*model)[idec].is_free()) {
+                    gradients[idec] = (edge[3] * cos_pa - edge[4] * sin_pa) *
+                                      gammalib::deg2rad *
+                                      (*model)[idec].scale();
+                }
+            }
+
+            // Apply deadtime correction to gradients
+            double deadc = obs.deadc(srcTime);
+            for (int i = 0; i < model->size(); ++i) {
+                gradients[i] *= deadc;
+            }
+
+        } // endif: gradients were requested
+
         // Apply deadtime correction
         irf *= obs.deadc(srcTime);
     }
 
+    // Optionally set gradients (circumvent const correctness)
+    if (grad) {
+        GModelSpatialElliptical* ptr = const_cast<GModelSpatialElliptical*>(model);
+        for (int i = 0; i < ptr->size(); ++i) {
+            (*ptr)[i].factor_gradient(gradients[i]);
+        }
+    }
+
+    // Put IRF value and gradients in cache
+    #if defined(G_USE_IRF_CACHE)
+    if (handle != -1) {
+        irf_cache_value(*list, handle, atom->index(), irf);
+        if (grad) {
+            list->irf_cache_gradients(handle, atom->index(), gradients);
+        }
+    }
+    #endif
+
     // Compile option: Show integration results
     #if defined(G_DEBUG_IRF_ELLIPTICAL)
     std::cout << "GCTAResponse::irf_elliptical:";
@@ -1232,10 +1876,13 @@ double GCTAResponse::irf_diffuse(const GEvent&       event,
 
     // Try getting the IRF value from cache
     #if defined(G_USE_IRF_CACHE)
-    const GCTAEventList* list = dynamic_cast<const GCTAEventList*>(obs.events());
-    const GCTAEventAtom* atom = dynamic_cast<const GCTAEventAtom*>(&event);
+    const GCTAEventList* list   = dynamic_cast<const GCTAEventList*>(obs.events());
+    const GCTAEventAtom* atom   = dynamic_cast<const GCTAEventAtom*>(&event);
+    int                  handle = -1;
     if (list != NULL && atom != NULL) {
-        irf = list->irf_cache(source.name(), atom->index());
+        handle = (m_src_set) ? source_cache_handle(source)
+                             : list->irf_cache_handle(source.name());
+        irf    = irf_cache_value(*list, handle, atom->index());
         if (irf >= 0.0) {
             has_irf = true;
             #if defined(G_DEBUG_IRF_DIFFUSE)
@@ -1270,17 +1917,21 @@ double GCTAResponse::irf_diffuse(const GEvent&       event,
         const GEnergy& srcEng  = source.energy();
         const GTime&   srcTime = source.time();
 
+        // Get event geometry
+        double geo[g_geo_size];
+        event_geometry(event, dir, pnt, obs, geo);
+
         // Get pointing direction zenith angle and azimuth [radians]
         double zenith  = pnt.zenith();
         double azimuth = pnt.azimuth();
 
-        // Determine angular distance between measured photon direction and
+        // Get angular distance between measured photon direction and
         // pointing direction [radians]
-        double eta = pnt.dir().dist(dir.dir());
+        double eta = geo[g_geo_eta];
 
         // Get log10(E/TeV) of true and measured photon energies
-        double srcLogEng = srcEng.log10TeV();
-        double obsLogEng = obsEng.log10TeV();
+        double obsLogEng = geo[g_geo_logE];
+        double srcLogEng = (srcEng == obsEng) ? obsLogEng : srcEng.log10TeV();
 
         // Assign the observed theta angle (eta) as the true theta angle
         // between the source and the pointing directions. This is a (not
@@ -1292,20 +1943,25 @@ double GCTAResponse::irf_diffuse(const GEvent&       event,
         double theta = eta;
         double phi   = 0.0; //TODO: Implement Phi dependence
 
-        // Get maximum PSF radius in radians
-        double delta_max = psf_delta_max(theta, phi, zenith, azimuth, srcLogEng);
+        // Get maximum PSF radius in radians. The maximum PSF radius of the
+        // event geometry applies if the true energy is the measured energy.
+        double delta_max = (srcEng == obsEng)
+                           ? geo[g_geo_delta_max]
+                           : psf_delta_max(theta, phi, zenith, azimuth,
+                                           srcLogEng);
 
         // Perform zenith angle integration if interval is valid
         if (delta_max > 0.0) {
 
-            // Compute rotation matrix to convert from coordinates (theta,phi)
+            // Get rotation matrix to convert from coordinates (theta,phi)
             // in the reference frame of the observed arrival direction into
-            // celestial coordinates
-            GMatrix ry;
-            GMatrix rz;
-            ry.eulery(dir.dir().dec_deg() - 90.0);
-            rz.eulerz(-dir.dir().ra_deg());
-            GMatrix rot = (ry * rz).transpose();
+            // celestial coordinates from event geometry
+            GMatrix rot(3,3);
+            for (int row = 0; row < 3; ++row) {
+                for (int col = 0; col < 3; ++col) {
+                    rot(row,col) = geo[g_geo_rot + 3*row + col];
+                }
+            }
 
             // Setup integration kernel
             cta_irf_diffuse_kern_theta integrand(*this,
@@ -1343,8 +1999,8 @@ double GCTAResponse::irf_diffuse(const GEvent&       event,
 
         // Put IRF value in cache
         #if defined(G_USE_IRF_CACHE)
-        if (list != NULL && atom != NULL) {
-            list->irf_cache(source.name(), atom->index(), irf);
+        if (handle != -1) {
+            irf_cache_value(*list, handle, atom->index(), irf);
         }
         #endif
 
@@ -1493,9 +2149,10 @@ double GCTAResponse::npred_radial(const GSource& source,
                                             roi_psf_radius,
                                             omega0);
 
-        // Integrate over theta
+        // Integrate over theta using the adaptive Gauss-Kronrod rule
         GIntegral integral(&integrand);
-        npred = integral.romb(rho_min, rho_max);
+        integral.max_iter(g_gk_max_iter);
+        npred = integral.gauss_kronrod(rho_min, rho_max);
 
         // Apply deadtime correction
         npred *= obs.deadc(srcTime);
@@ -1869,6 +2526,172 @@ double GCTAResponse::npred_diffuse(const GSource& source,
 }
 
 
+/***********************************************************************//**
+ * @brief Prepare source caches for a model evaluation
+ *
+ * @param[in] obs Observation.
+ * @param[in] models Models.
+ *
+ * Resolves the IRF cache handles of all sky models that apply to the
+ * observation once before the events of the observation are evaluated.
+ * For event lists, a handle is obtained for diffuse models and for radial
+ * and elliptical models with fixed parameters. For event cubes, a handle
+ * is obtained for all models other than point sources with fixed
+ * parameters. Obtaining the handle resets the cached values if the model
+ * parameters have changed since the last evaluation, and the cache values
+ * are allocated so that the per-event IRF computation can access them
+ * without locking the cache of the event list or cube.
+ *
+ * The handles remain valid until clear_source_caches() is called. The
+ * method also reserves the event views of event lists in columnar mode for
+ * all threads that may evaluate the events, and validates the event
+ * geometry cache of event lists so that event_geometry() can read the
+ * geometry without locking.
+ ***************************************************************************/
+void GCTAResponse::set_source_caches(const GObservation& obs,
+                                     const GModels&      models) const
+{
+    // Reset source caches
+    clear_source_caches(obs);
+
+    // Get event list
+    const GCTAEventList* list = dynamic_cast<const GCTAEventList*>(obs.events());
+
+    // Make sure that the event list has event views for all threads that
+    // will evaluate the events
+    if (list != NULL) {
+        list->reserve_views();
+    }
+
+    // Validate the event geometry of the event list, computing the
+    // geometry of all events if needed, so that the geometry of the
+    // individual events can be accessed without locking
+    #if defined(G_USE_GEOMETRY_CACHE)
+    const GCTAObservation* cta = dynamic_cast<const GCTAObservation*>(&obs);
+    if (list != NULL && cta != NULL) {
+        std::vector<double> key = geometry_key(*list, cta->pointing());
+        if (!list->has_geometry(key)) {
+            list_geometry(*list, cta->pointing(), key);
+        }
+        m_geo_set = true;
+    }
+    #endif
+
+    // Continue only if observation holds an event list
+    #if defined(G_USE_IRF_CACHE)
+    if (list != NULL) {
+
+        // Loop over all sky models that apply to the observation
+        for (int i = 0; i < models.size(); ++i) {
+            const GModelSky* sky = dynamic_cast<const GModelSky*>(models[i]);
+            if (sky == NULL || sky->spatial() == NULL ||
+                !sky->is_valid(obs.instrument(), obs.id())) {
+                continue;
+            }
+
+            // Get IRF cache handle for diffuse models and for radial and
+            // elliptical models with fixed parameters
+            const GModelSpatial* spatial = sky->spatial();
+            int                  handle  = -1;
+            if (dynamic_cast<const GModelSpatialDiffuse*>(spatial) != NULL) {
+                handle = list->irf_cache_handle(sky->name());
+            }
+            else if (dynamic_cast<const GModelSpatialRadial*>(spatial) != NULL ||
+                     dynamic_cast<const GModelSpatialElliptical*>(spatial) != NULL) {
+                std::vector<double> pars;
+                if (irf_cache_pars(*spatial, &pars)) {
+                    handle = list->irf_cache_handle(sky->name(), pars);
+                }
+            }
+
+            // Allocate cache values
+            if (handle != -1) {
+                list->irf_cache_prepare(handle);
+            }
+
+            // Store handle
+            m_src_models.push_back(spatial);
+            m_src_handles.push_back(handle);
+
+        } // endfor: looped over models
+
+        // Signal that source caches are set
+        m_src_set = true;
+
+    } // endif: observation held an event list
+
+    // Continue only if observation holds an event cube
+    const GCTAEventCube* cube = dynamic_cast<const GCTAEventCube*>(obs.events());
+    if (cube != NULL) {
+
+        // Loop over all sky models that apply to the observation
+        for (int i = 0; i < models.size(); ++i) {
+            const GModelSky* sky = dynamic_cast<const GModelSky*>(models[i]);
+            if (sky == NULL || sky->spatial() == NULL ||
+                !sky->is_valid(obs.instrument(), obs.id())) {
+                continue;
+            }
+
+            // Get IRF cache handle for models other than point sources
+            // with fixed parameters
+            const GModelSpatial* spatial = sky->spatial();
+            int                  handle  = -1;
+            std::vector<double>  pars;
+            if (dynamic_cast<const GModelSpatialPointSource*>(spatial) == NULL &&
+                irf_cache_pars(*spatial, &pars)) {
+                handle = cube->irf_cache_handle(sky->name(), pars);
+                cube->irf_cache_prepare(handle);
+            }
+
+            // Store handle
+            m_src_models.push_back(spatial);
+            m_src_handles.push_back(handle);
+
+        } // endfor: looped over models
+
+        // Signal that source caches are set
+        m_src_set = true;
+
+    } // endif: observation held an event cube
+    #endif
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Release source caches after a model evaluation
+ *
+ * @param[in] obs Observation.
+ *
+ * Adds the IRF cache hits and misses of the model evaluation to the
+ * counters of the event list and releases the IRF cache handles that were
+ * resolved by set_source_caches().
+ ***************************************************************************/
+void GCTAResponse::clear_source_caches(const GObservation& obs) const
+{
+    // Update cache counters of event list
+    if (m_src_set) {
+        const GCTAEventList* list = dynamic_cast<const GCTAEventList*>(obs.events());
+        if (list != NULL) {
+            list->irf_cache_count(m_src_hits, m_src_misses);
+        }
+    }
+
+    // Release source caches
+    m_src_set = false;
+    m_geo_set = false;
+    m_src_models.clear();
+    m_src_handles.clear();
+    m_src_hits   = 0;
+    m_src_misses = 0;
+
+    // Return
+    return;
+}
+
+
 /*==========================================================================
  =                                                                         =
  =                    Low-level CTA response methods                       =
@@ -2171,6 +2994,9 @@ void GCTAResponse::init_members(void)
     m_aeff  = NULL;
     m_psf   = NULL;
     m_edisp = NULL;
+    m_grid_nlogE  = 0;
+    m_grid_ntheta = 0;
+    set_psf_id();
 
     // Initialise Npred cache
     m_npred_names.clear();
@@ -2178,6 +3004,14 @@ void GCTAResponse::init_members(void)
     m_npred_times.clear();
     m_npred_values.clear();
 
+    // Initialise source caches
+    m_src_set = false;
+    m_geo_set = false;
+    m_src_models.clear();
+    m_src_handles.clear();
+    m_src_hits   = 0;
+    m_src_misses = 0;
+
     // Return
     return;
 }
@@ -2195,6 +3029,9 @@ void GCTAResponse::copy_members(const GCTAResponse& rsp)
     m_rspname = rsp.m_rspname;
     m_rmffile = rsp.m_rmffile;
     m_eps     = rsp.m_eps;
+    m_grid_nlogE  = rsp.m_grid_nlogE;
+    m_grid_ntheta = rsp.m_grid_ntheta;
+    m_psf_id      = rsp.m_psf_id;
 
     // Copy cache
     m_npred_names    = rsp.m_npred_names;
@@ -2344,3 +3181,486 @@ const GCTAInstDir& GCTAResponse::retrieve_dir(const std::string& origin,
     return *dir;
 }
 
+
+
+/***********************************************************************//**
+ * @brief Return IRF cache handle for an event list
+ *
+ * @param[in] list CTA event list.
+ * @param[in] event Event.
+ * @param[in] source Source.
+ * @return IRF cache handle (-1 if IRF cache can not be used).
+ *
+ * Returns the IRF cache handle of the event list for a source model (see
+ * irf_cache_pars() for the conditions under which the cache is used). If
+ * the source caches were set by set_source_caches(), the handle that was
+ * resolved for the source model is returned without accessing the cache
+ * of the event list.
+ ***************************************************************************/
+int GCTAResponse::irf_cache_handle(const GCTAEventList& list,
+                                   const GEvent&        event,
+                                   const GSource&       source) const
+{
+    // Initialise handle
+    int handle = -1;
+
+    // If the source caches are set then use the handle that was resolved
+    // for the source, provided that the source energy and time are the
+    // event energy and time ...
+    if (m_src_set) {
+        if (source.energy() == event.energy() && source.time() == event.time()) {
+            handle = source_cache_handle(source);
+        }
+    }
+
+    // ... otherwise get handle if cache can be used
+    else {
+        std::vector<double> pars;
+        if (irf_cache_pars(event, source, &pars)) {
+            handle = list.irf_cache_handle(source.name(), pars);
+        }
+    }
+
+    // Return handle
+    return handle;
+}
+
+
+/***********************************************************************//**
+ * @brief Get spatial model parameters for IRF cache
+ *
+ * @param[in] event Event.
+ * @param[in] source Source.
+ * @param[out] pars Spatial model parameter values.
+ * @return True if IRF cache can be used.
+ *
+ * Since the IRF depends on the spatial model parameters, the cache is only
+ * used if all spatial model parameters are fixed. The parameter values are
+ * passed to the cache, so that cached values are reset if the parameters
+ * were changed between two fits. The cache is also only used if the source
+ * energy and time equal the event energy and time, since only one value is
+ * cached per event.
+ ***************************************************************************/
+bool GCTAResponse::irf_cache_pars(const GEvent&        event,
+                                  const GSource&       source,
+                                  std::vector<double>* pars) const
+{
+    // Initialise flag
+    bool use = false;
+
+    // Continue only if source energy and time are event energy and time
+    if (source.energy() == event.energy() && source.time() == event.time()) {
+        use = irf_cache_pars(*(source.model()), pars);
+    }
+
+    // Return flag
+    return use;
+}
+
+
+/***********************************************************************//**
+ * @brief Get spatial model parameters for IRF cache
+ *
+ * @param[in] model Spatial model.
+ * @param[out] pars Spatial model parameter values.
+ * @return True if all spatial model parameters are fixed.
+ ***************************************************************************/
+bool GCTAResponse::irf_cache_pars(const GModelSpatial&  model,
+                                  std::vector<double>* pars) const
+{
+    // Initialise flag
+    bool use = true;
+
+    // Get spatial model parameter values. Signal if any of the parameters
+    // is free.
+    pars->clear();
+    for (int i = 0; i < model.size(); ++i) {
+        if (model[i].is_free()) {
+            use = false;
+            break;
+        }
+        pars->push_back(model[i].value());
+    }
+
+    // Return flag
+    return use;
+}
+
+
+/***********************************************************************//**
+ * @brief Return IRF cache handle that was resolved for a source
+ *
+ * @param[in] source Source.
+ * @return IRF cache handle (-1 if no handle was resolved).
+ *
+ * Returns the IRF cache handle that was resolved by set_source_caches() for
+ * the spatial model of the @p source.
+ ***************************************************************************/
+int GCTAResponse::source_cache_handle(const GSource& source) const
+{
+    // Initialise handle
+    int handle = -1;
+
+    // Search spatial model
+    for (int i = 0; i < m_src_models.size(); ++i) {
+        if (m_src_models[i] == source.model()) {
+            handle = m_src_handles[i];
+            break;
+        }
+    }
+
+    // Return handle
+    return handle;
+}
+
+
+/***********************************************************************//**
+ * @brief Get IRF value from event list cache
+ *
+ * @param[in] list CTA event list.
+ * @param[in] handle IRF cache handle.
+ * @param[in] index Event index.
+ * @return IRF value (-1 if no cache value found).
+ *
+ * If the source caches were set by set_source_caches(), the value is read
+ * without locking the cache and the hit or miss is counted by the
+ * response. Otherwise the locked cache access of the event list is used.
+ ***************************************************************************/
+double GCTAResponse::irf_cache_value(const GCTAEventList& list,
+                                     const int&           handle,
+                                     const int&           index) const
+{
+    // Initialise IRF value
+    double irf = -1.0;
+
+    // Get IRF value
+    if (m_src_set) {
+        if (handle != -1) {
+            irf = list.irf_cache_value(handle, index);
+            if (irf >= 0.0) {
+                m_src_hits++;
+            }
+            else {
+                m_src_misses++;
+            }
+        }
+    }
+    else {
+        irf = list.irf_cache(handle, index);
+    }
+
+    // Return IRF value
+    return irf;
+}
+
+
+/***********************************************************************//**
+ * @brief Put IRF value in event list cache
+ *
+ * @param[in] list CTA event list.
+ * @param[in] handle IRF cache handle.
+ * @param[in] index Event index.
+ * @param[in] irf IRF value.
+ *
+ * If the source caches were set by set_source_caches(), the value is
+ * stored without locking the cache. Otherwise the locked cache access of
+ * the event list is used.
+ ***************************************************************************/
+void GCTAResponse::irf_cache_value(const GCTAEventList& list,
+                                   const int&           handle,
+                                   const int&           index,
+                                   const double&        irf) const
+{
+    // Store IRF value
+    if (m_src_set) {
+        list.irf_cache_value(handle, index, irf);
+    }
+    else {
+        list.irf_cache(handle, index, irf);
+    }
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Get event geometry
+ *
+ * @param[in] event Event.
+ * @param[in] dir Instrument direction of event.
+ * @param[in] pnt CTA pointing.
+ * @param[in] obs Observation.
+ * @param[out] geo Event geometry (g_geo_size values).
+ *
+ * Returns the quantities of an event that do not depend on the source
+ * model: the offset angle of the event from the pointing direction, the
+ * log10 of the measured energy, the maximum PSF radius at the measured
+ * energy and the rotation matrix from the reference frame of the event
+ * direction into celestial coordinates.
+ *
+ * For event lists, the geometry of all events is computed once and stored
+ * in the event geometry cache of the event list, so that it is reused for
+ * all sources and all likelihood iterations. The cache is keyed by the
+ * pointing, the point spread function and the number of events (see
+ * geometry_key()). If set_source_caches() has validated the cache, the
+ * geometry is read without locking. For all other events, the geometry is
+ * computed on the fly.
+ ***************************************************************************/
+void GCTAResponse::event_geometry(const GEvent&       event,
+                                  const GCTAInstDir&  dir,
+                                  const GCTAPointing& pnt,
+                                  const GObservation& obs,
+                                  double*             geo) const
+{
+    // Initialise flag
+    bool found = false;
+
+    // Try getting the event geometry from the cache of the event list. If
+    // the geometry was validated by set_source_caches() then the values
+    // are read without locking. Otherwise, if the cache does not hold the
+    // geometry for the pointing and the point spread function then compute
+    // the geometry for all events.
+    #if defined(G_USE_GEOMETRY_CACHE)
+    const GCTAEventList* list = dynamic_cast<const GCTAEventList*>(obs.events());
+    const GCTAEventAtom* atom = dynamic_cast<const GCTAEventAtom*>(&event);
+    if (list != NULL && atom != NULL) {
+
+        // Get event geometry
+        if (m_geo_set) {
+            const double* values = list->geometry_values(atom->index());
+            if (values != NULL) {
+                for (int i = 0; i < g_geo_size; ++i) {
+                    geo[i] = values[i];
+                }
+                found = true;
+            }
+        }
+        else {
+
+            // Get event geometry, and compute the geometry of all events
+            // if the cache is not valid. The computation is done by a
+            // single thread.
+            std::vector<double> key = geometry_key(*list, pnt);
+            found = list->geometry(key, atom->index(), geo);
+            if (!found) {
+                #pragma omp critical(GCTAResponse_event_geometry)
+                {
+                    if (!list->has_geometry(key)) {
+                        list_geometry(*list, pnt, key);
+                    }
+                }
+                found = list->geometry(key, atom->index(), geo);
+            }
+
+        } // endelse: geometry was not validated
+
+        // Make sure that the geometry belongs to the event
+        if (found && int(geo[g_geo_index]) != atom->index()) {
+            found = false;
+        }
+
+    } // endif: event was an event atom of an event list
+    #endif
+
+    // Compute event geometry if it was not found in the cache
+    if (!found) {
+        compute_geometry(dir.dir(), event.energy().log10TeV(), -1.0, pnt,
+                         geo);
+    }
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Return event geometry key
+ *
+ * @param[in] list Event list.
+ * @param[in] pnt CTA pointing.
+ * @return Geometry key.
+ *
+ * Returns the key of the event geometry cache, which is composed of the
+ * pointing, the point spread function identifier and the number of events.
+ ***************************************************************************/
+std::vector<double> GCTAResponse::geometry_key(const GCTAEventList& list,
+                                               const GCTAPointing&  pnt) const
+{
+    // Set geometry key
+    std::vector<double> key;
+    key.push_back(pnt.dir().ra());
+    key.push_back(pnt.dir().dec());
+    key.push_back(pnt.zenith());
+    key.push_back(pnt.azimuth());
+    key.push_back(double(m_psf_id));
+    key.push_back(double(list.size()));
+
+    // Return key
+    return key;
+}
+
+
+/***********************************************************************//**
+ * @brief Compute event geometry for all events of an event list
+ *
+ * @param[in] list Event list.
+ * @param[in] pnt CTA pointing.
+ * @param[in] key Geometry key.
+ *
+ * Computes the event geometry for all events of an event list and stores
+ * it in the event geometry cache of the list. In columnar mode, the event
+ * columns are used directly so that the event views of the list are not
+ * changed.
+ ***************************************************************************/
+void GCTAResponse::list_geometry(const GCTAEventList&       list,
+                                 const GCTAPointing&        pnt,
+                                 const std::vector<double>& key) const
+{
+    // Get number of events
+    int num = list.size();
+
+    // Allocate geometry values
+    std::vector<double> values(num * g_geo_size, 0.0);
+
+    // Compute geometry for all events
+    if (list.columnar()) {
+        const std::vector<double>& ra      = list.ra();
+        const std::vector<double>& dec     = list.dec();
+        const std::vector<double>& logE    = list.log10TeV();
+        const std::vector<int>&    indices = list.indices();
+        GSkyDir dir;
+        for (int i = 0; i < num; ++i) {
+            dir.radec(ra[i], dec[i]);
+            compute_geometry(dir, logE[i], double(indices[i]), pnt,
+                             &(values[i * g_geo_size]));
+        }
+    }
+    else {
+        for (int i = 0; i < num; ++i) {
+            const GCTAEventAtom* atom = list[i];
+            compute_geometry(atom->dir().dir(), atom->energy().log10TeV(),
+                             double(atom->index()), pnt,
+                             &(values[i * g_geo_size]));
+        }
+    }
+
+    // Store geometry in event list
+    list.geometry(key, values, g_geo_size);
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Compute event geometry
+ *
+ * @param[in] dir Measured photon direction.
+ * @param[in] obsLogEng Log10 of measured photon energy (E/TeV).
+ * @param[in] index Event index.
+ * @param[in] pnt CTA pointing.
+ * @param[out] geo Event geometry (g_geo_size values).
+ *
+ * The rotation matrix is the transpose of the product of the Euler
+ * rotations about the y axis by \f$\delta-90^\circ\f$ and about the z
+ * axis by \f$-\alpha\f$, where \f$(\alpha,\delta)\f$ is the measured
+ * photon direction. It is stored in row-major order.
+ ***************************************************************************/
+void GCTAResponse::compute_geometry(const GSkyDir&      dir,
+                                    const double&       obsLogEng,
+                                    const double&       index,
+                                    const GCTAPointing& pnt,
+                                    double*             geo) const
+{
+    // Compute offset angle from pointing direction [radians]
+    double eta = pnt.dir().dist(dir);
+
+    // Compute sine and cosine of Euler angles
+    double arg_y = (dir.dec_deg() - 90.0) * gammalib::deg2rad;
+    double arg_z = -dir.ra_deg() * gammalib::deg2rad;
+    double cos_y = std::cos(arg_y);
+    double sin_y = std::sin(arg_y);
+    double cos_z = std::cos(arg_z);
+    double sin_z = std::sin(arg_z);
+
+    // Set geometry
+    geo[g_geo_index]     = index;
+    geo[g_geo_eta]       = eta;
+    geo[g_geo_logE]      = obsLogEng;
+    geo[g_geo_delta_max] = psf_delta_max(eta, 0.0, pnt.zenith(),
+                                         pnt.azimuth(), obsLogEng);
+
+    // Set rotation matrix
+    geo[g_geo_rot]       =  cos_y * cos_z;
+    geo[g_geo_rot+1]     =  sin_z;
+    geo[g_geo_rot+2]     = -sin_y * cos_z;
+    geo[g_geo_rot+3]     = -cos_y * sin_z;
+    geo[g_geo_rot+4]     =  cos_z;
+    geo[g_geo_rot+5]     =  sin_y * sin_z;
+    geo[g_geo_rot+6]     =  sin_y;
+    geo[g_geo_rot+7]     =  0.0;
+    geo[g_geo_rot+8]     =  cos_y;
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Set point spread function identifier
+ *
+ * Assigns a new unique identifier to the point spread function. The
+ * identifier is part of the event geometry key, hence the event geometry
+ * is recomputed after the point spread function has changed.
+ ***************************************************************************/
+void GCTAResponse::set_psf_id(void)
+{
+    // Unique identifier counter
+    static unsigned long id = 0;
+
+    // Set identifier
+    #pragma omp critical(GCTAResponse_set_psf_id)
+    {
+        m_psf_id = ++id;
+    }
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Compile response tables onto regular grids
+ *
+ * Compiles the effective area and point spread function response tables
+ * onto regular grids if the compiled response mode was enabled using
+ * compile(). Response functions that are not based on response tables
+ * are not affected.
+ ***************************************************************************/
+void GCTAResponse::compile_irfs(void)
+{
+    // Continue only if compiled response mode is enabled
+    if (m_grid_nlogE > 0) {
+
+        // Compile effective area response table
+        GCTAAeff2D* aeff = dynamic_cast<GCTAAeff2D*>(m_aeff);
+        if (aeff != NULL) {
+            aeff->compile(m_grid_nlogE, m_grid_ntheta);
+        }
+
+        // Compile point spread function response table
+        GCTAPsf2D* psf2d = dynamic_cast<GCTAPsf2D*>(m_psf);
+        if (psf2d != NULL) {
+            psf2d->compile(m_grid_nlogE, m_grid_ntheta);
+        }
+        GCTAPsfKing* king = dynamic_cast<GCTAPsfKing*>(m_psf);
+        if (king != NULL) {
+            king->compile(m_grid_nlogE, m_grid_ntheta);
+        }
+
+    } // endif: compiled response mode was enabled
+
+    // Return
+    return;
+}
@@ -48,6 +48,8 @@
 #define G_AXIS_LOG10                    "GCTAResponseTable::axis_log10(int&)"
 #define G_AXIS_RADIANS                "GCTAResponseTable::axis_radians(int&)"
 #define G_SCALE                      "GCTAResponseTable::scale(int&,double&)"
+#define G_COMPILE                     "GCTAResponseTable::compile(int&,int&)"
+#define G_COMPILE_ERROR               "GCTAResponseTable::compile_error(int&)"
 #define G_READ                         "GCTAResponseTable::read(GFitsTable*)"
 #define G_READ_COLNAMES       "GCTAResponseTable::read_colnames(GFitsTable*)"
 #define G_READ_AXES               "GCTAResponseTable::read_axes(GFitsTable*)"
@@ -216,13 +218,15 @@ std::vector<double> GCTAResponseTable::operator()(const double& arg) const
     // Initialise result vector
     std::vector<double> result(num);
     
-    // Set indices and weighting factors for interpolation
-    update(arg);
+    // Get indices and weighting factors for interpolation
+    int    inx[2];
+    double wgt[2];
+    weights(arg, inx, wgt);
 
     // Perform 1D interpolation
     for (int i = 0; i < num; ++i) {
-        result[i] = m_wgt_left  * m_pars[i][m_inx_left] +
-                    m_wgt_right * m_pars[i][m_inx_right];
+        result[i] = wgt[0] * m_pars[i][inx[0]] +
+                    wgt[1] * m_pars[i][inx[1]];
     }
     
     // Return result vector
@@ -264,15 +268,29 @@ std::vector<double> GCTAResponseTable::operator()(const double& arg1,
     // Initialise result vector
     std::vector<double> result(num);
 
-    // Set indices and weighting factors for interpolation
-    update(arg1, arg2);
+    // Initialise indices and weighting factors for interpolation
+    int    inx[4];
+    double wgt[4];
+
+    // If arguments are within the compiled grid then interpolate the grid
+    if (grid_weights(arg1, arg2, inx, wgt)) {
+        for (int i = 0; i < num; ++i) {
+            result[i] = wgt[0] * m_grid[i][inx[0]] +
+                        wgt[1] * m_grid[i][inx[1]] +
+                        wgt[2] * m_grid[i][inx[2]] +
+                        wgt[3] * m_grid[i][inx[3]];
+        }
+    }
 
-    // Perform 2D interpolation
-    for (int i = 0; i < num; ++i) {
-        result[i] = m_wgt1 * m_pars[i][m_inx1] +
-                    m_wgt2 * m_pars[i][m_inx2] +
-                    m_wgt3 * m_pars[i][m_inx3] +
-                    m_wgt4 * m_pars[i][m_inx4];
+    // ... otherwise perform 2D interpolation of the table
+    else {
+        weights(arg1, arg2, inx, wgt);
+        for (int i = 0; i < num; ++i) {
+            result[i] = wgt[0] * m_pars[i][inx[0]] +
+                        wgt[1] * m_pars[i][inx[1]] +
+                        wgt[2] * m_pars[i][inx[2]] +
+                        wgt[3] * m_pars[i][inx[3]];
+        }
     }
     
     // Return result vector
@@ -307,12 +325,14 @@ double GCTAResponseTable::operator()(const int& index, const double& arg) const
     }
     #endif
     
-    // Set indices and weighting factors for interpolation
-    update(arg);
+    // Get indices and weighting factors for interpolation
+    int    inx[2];
+    double wgt[2];
+    weights(arg, inx, wgt);
 
     // Perform 1D interpolation
-    double result = m_wgt_left  * m_pars[index][m_inx_left] +
-                    m_wgt_right * m_pars[index][m_inx_right];
+    double result = wgt[0] * m_pars[index][inx[0]] +
+                    wgt[1] * m_pars[index][inx[1]];
     
     // Return result
     return result;
@@ -348,14 +368,29 @@ double GCTAResponseTable::operator()(const int& index, const double& arg1,
     }
     #endif
 
-    // Set indices and weighting factors for interpolation
-    update(arg1, arg2);
+    // Initialise indices and weighting factors for interpolation
+    int    inx[4];
+    double wgt[4];
+
+    // Initialise result
+    double result;
+
+    // If arguments are within the compiled grid then interpolate the grid
+    if (grid_weights(arg1, arg2, inx, wgt)) {
+        result = wgt[0] * m_grid[index][inx[0]] +
+                 wgt[1] * m_grid[index][inx[1]] +
+                 wgt[2] * m_grid[index][inx[2]] +
+                 wgt[3] * m_grid[index][inx[3]];
+    }
 
-    // Perform 2D interpolation
-    double result = m_wgt1 * m_pars[index][m_inx1] +
-                    m_wgt2 * m_pars[index][m_inx2] +
-                    m_wgt3 * m_pars[index][m_inx3] +
-                    m_wgt4 * m_pars[index][m_inx4];
+    // ... otherwise perform 2D interpolation of the table
+    else {
+        weights(arg1, arg2, inx, wgt);
+        result = wgt[0] * m_pars[index][inx[0]] +
+                 wgt[1] * m_pars[index][inx[1]] +
+                 wgt[2] * m_pars[index][inx[2]] +
+                 wgt[3] * m_pars[index][inx[3]];
+    }
     
     // Return result
     return result;
@@ -522,6 +557,9 @@ void GCTAResponseTable::axis_linear(const int& index)
     // Set node array
     m_axis_nodes[index] = GNodeArray(axis_nodes);
 
+    // Remove compiled grid since the nodes have changed
+    free_grid();
+
     // Return
     return;
 }
@@ -569,6 +607,9 @@ void GCTAResponseTable::axis_log10(const int& index)
     // Set node array
     m_axis_nodes[index] = GNodeArray(axis_nodes);
 
+    // Remove compiled grid since the nodes have changed
+    free_grid();
+
     // Return
     return;
 }
@@ -614,6 +655,9 @@ void GCTAResponseTable::axis_radians(const int& index)
     // Set node array
     m_axis_nodes[index] = GNodeArray(axis_nodes);
 
+    // Remove compiled grid since the nodes have changed
+    free_grid();
+
     // Return
     return;
 }
@@ -645,11 +689,199 @@ void GCTAResponseTable::scale(const int& index, const double& scale)
         m_pars[index][i] *= scale;
     }
 
+    // Remove compiled grid since the parameters have changed
+    free_grid();
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Compile response table onto a regular grid
+ *
+ * @param[in] n1 Number of grid nodes for first axis (>=2).
+ * @param[in] n2 Number of grid nodes for second axis (>=2).
+ *
+ * @exception GCTAException::bad_rsp_table_dim
+ *            Response table is not two-dimensional.
+ * @exception GException::invalid_argument
+ *            Less than two grid nodes or less than two axis bins.
+ *
+ * Resamples all parameters of a two-dimensional response table onto a
+ * regular grid of @p n1 x @p n2 nodes that spans the range of the axis
+ * nodes. Once compiled, the interpolation operators compute the grid cell
+ * and the weighting factors by index arithmetic instead of bisecting the
+ * axis nodes. Arguments outside the grid are interpolated (or
+ * extrapolated) from the original table.
+ *
+ * The maximum interpolation error of the grid with respect to the
+ * original table is determined at all grid cell centres and at all table
+ * nodes and can be retrieved using compile_error().
+ *
+ * Changing the axis nodes or scaling the parameters removes the grid.
+ ***************************************************************************/
+void GCTAResponseTable::compile(const int& n1, const int& n2)
+{
+    // Throw an exception if the table is not two-dimensional
+    if (m_naxes != 2) {
+        throw GCTAException::bad_rsp_table_dim(G_COMPILE, m_naxes, 2);
+    }
+
+    // Throw an exception if the grid or the axes have less than two nodes
+    if (n1 < 2 || n2 < 2) {
+        std::string msg = "Grid size "+gammalib::str(n1)+" x "+
+                          gammalib::str(n2)+" is too small. Please specify"
+                          " at least two nodes per axis.";
+        throw GException::invalid_argument(G_COMPILE, msg);
+    }
+    if (m_axis_nodes[0].size() < 2 || m_axis_nodes[1].size() < 2) {
+        std::string msg = "Response table axes have "+
+                          gammalib::str(m_axis_nodes[0].size())+" and "+
+                          gammalib::str(m_axis_nodes[1].size())+" nodes."
+                          " At least two nodes per axis are required to"
+                          " compile the table.";
+        throw GException::invalid_argument(G_COMPILE, msg);
+    }
+
+    // Remove any existing grid
+    free_grid();
+
+    // Set grid boundaries
+    double min1 = m_axis_nodes[0][0];
+    double max1 = m_axis_nodes[0][m_axis_nodes[0].size()-1];
+    double min2 = m_axis_nodes[1][0];
+    double max2 = m_axis_nodes[1][m_axis_nodes[1].size()-1];
+    double step1 = (max1 - min1) / double(n1-1);
+    double step2 = (max2 - min2) / double(n2-1);
+
+    // Set grid node values
+    std::vector<double> x1(n1);
+    std::vector<double> x2(n2);
+    for (int i = 0; i < n1; ++i) {
+        x1[i] = (i < n1-1) ? min1 + i * step1 : max1;
+    }
+    for (int i = 0; i < n2; ++i) {
+        x2[i] = (i < n2-1) ? min2 + i * step2 : max2;
+    }
+
+    // Allocate grid
+    std::vector<std::vector<double> > grid(m_npars,
+                                           std::vector<double>(n1*n2, 0.0));
+
+    // Sample table at grid nodes. The first axis varies most rapidly.
+    int    inx[4];
+    double wgt[4];
+    for (int i2 = 0; i2 < n2; ++i2) {
+        for (int i1 = 0; i1 < n1; ++i1) {
+            weights(x1[i1], x2[i2], inx, wgt);
+            int igrid = i1 + i2 * n1;
+            for (int k = 0; k < m_npars; ++k) {
+                grid[k][igrid] = wgt[0] * m_pars[k][inx[0]] +
+                                 wgt[1] * m_pars[k][inx[1]] +
+                                 wgt[2] * m_pars[k][inx[2]] +
+                                 wgt[3] * m_pars[k][inx[3]];
+            }
+        }
+    }
+
+    // Set grid
+    m_grid_n1     = n1;
+    m_grid_n2     = n2;
+    m_grid_min1   = min1;
+    m_grid_max1   = max1;
+    m_grid_min2   = min2;
+    m_grid_max2   = max2;
+    m_grid_scale1 = (max1 > min1) ? double(n1-1) / (max1 - min1) : 0.0;
+    m_grid_scale2 = (max2 > min2) ? double(n2-1) / (max2 - min2) : 0.0;
+    m_grid        = grid;
+
+    // Set test values, composed of grid cell centres and table nodes
+    std::vector<double> t1;
+    std::vector<double> t2;
+    for (int i = 0; i < n1-1; ++i) {
+        t1.push_back(0.5 * (x1[i] + x1[i+1]));
+    }
+    for (int i = 0; i < m_axis_nodes[0].size(); ++i) {
+        t1.push_back(m_axis_nodes[0][i]);
+    }
+    for (int i = 0; i < n2-1; ++i) {
+        t2.push_back(0.5 * (x2[i] + x2[i+1]));
+    }
+    for (int i = 0; i < m_axis_nodes[1].size(); ++i) {
+        t2.push_back(m_axis_nodes[1][i]);
+    }
+
+    // Determine maximum absolute interpolation error and maximum absolute
+    // parameter value
+    std::vector<double> error(m_npars, 0.0);
+    std::vector<double> norm(m_npars, 0.0);
+    int    ginx[4];
+    double gwgt[4];
+    for (int i2 = 0; i2 < t2.size(); ++i2) {
+        for (int i1 = 0; i1 < t1.size(); ++i1) {
+            weights(t1[i1], t2[i2], inx, wgt);
+            grid_weights(t1[i1], t2[i2], ginx, gwgt);
+            for (int k = 0; k < m_npars; ++k) {
+                double table = wgt[0]  * m_pars[k][inx[0]] +
+                               wgt[1]  * m_pars[k][inx[1]] +
+                               wgt[2]  * m_pars[k][inx[2]] +
+                               wgt[3]  * m_pars[k][inx[3]];
+                double value = gwgt[0] * m_grid[k][ginx[0]] +
+                               gwgt[1] * m_grid[k][ginx[1]] +
+                               gwgt[2] * m_grid[k][ginx[2]] +
+                               gwgt[3] * m_grid[k][ginx[3]];
+                double diff  = std::abs(value - table);
+                if (diff > error[k]) {
+                    error[k] = diff;
+                }
+                if (std::abs(table) > norm[k]) {
+                    norm[k] = std::abs(table);
+                }
+            }
+        }
+    }
+
+    // Set maximum relative interpolation error
+    m_grid_error.assign(m_npars, 0.0);
+    for (int k = 0; k < m_npars; ++k) {
+        if (norm[k] > 0.0) {
+            m_grid_error[k] = error[k] / norm[k];
+        }
+    }
+
     // Return
     return;
 }
 
 
+/***********************************************************************//**
+ * @brief Return maximum interpolation error of compiled grid
+ *
+ * @param[in] index Parameter index [0,...,size()-1].
+ * @return Maximum relative interpolation error.
+ *
+ * @exception GException::out_of_range
+ *            Parameter index out of range.
+ *
+ * Returns the maximum absolute difference between the compiled grid and
+ * the original table for a parameter, divided by the maximum absolute
+ * parameter value. Zero is returned if the table was not compiled.
+ ***************************************************************************/
+double GCTAResponseTable::compile_error(const int& index) const
+{
+    // Optionally check if the index is valid
+    #if defined(G_RANGE_CHECK)
+    if (index < 0 || index >= size()) {
+        throw GException::out_of_range(G_COMPILE_ERROR, index, size()-1);
+    }
+    #endif
+
+    // Return error
+    return ((is_compiled()) ? m_grid_error[index] : 0.0);
+}
+
+
 /***********************************************************************//**
  * @brief Read response table from FITS table HDU
  *
@@ -745,6 +977,17 @@ std::string GCTAResponseTable::print(const GChatter& chatter) const
             result.append("\n"+gammalib::parformat("Parameter " +
                           gammalib::str(i)));
             result.append(m_colname_par[i]);
+            if (is_compiled()) {
+                result.append(" (max. grid error ");
+                result.append(gammalib::str(m_grid_error[i])+")");
+            }
+        }
+
+        // Append compiled grid information
+        if (is_compiled()) {
+            result.append("\n"+gammalib::parformat("Compiled grid"));
+            result.append(gammalib::str(m_grid_n1)+" x ");
+            result.append(gammalib::str(m_grid_n2));
         }
 
     } // endif: chatter was not silent
@@ -779,19 +1022,17 @@ void GCTAResponseTable::init_members(void)
     m_axis_nodes.clear();
     m_pars.clear();
 
-    // Initialise cache
-    m_inx_left  = 0;
-    m_inx_right = 0;
-    m_wgt_left  = 0.0;
-    m_wgt_right = 0.0;
-    m_inx1      = 0;
-    m_inx2      = 0;
-    m_inx3      = 0;
-    m_inx4      = 0;
-    m_wgt1      = 0.0;
-    m_wgt2      = 0.0;
-    m_wgt3      = 0.0;
-    m_wgt4      = 0.0;
+    // Initialise compiled grid
+    m_grid_n1     = 0;
+    m_grid_n2     = 0;
+    m_grid_min1   = 0.0;
+    m_grid_max1   = 0.0;
+    m_grid_min2   = 0.0;
+    m_grid_max2   = 0.0;
+    m_grid_scale1 = 0.0;
+    m_grid_scale2 = 0.0;
+    m_grid.clear();
+    m_grid_error.clear();
 
     // Return
     return;
@@ -819,19 +1060,17 @@ void GCTAResponseTable::copy_members(const GCTAResponseTable& table)
     m_axis_nodes  = table.m_axis_nodes;
     m_pars        = table.m_pars;
 
-    // Copy cache
-    m_inx_left  = table.m_inx_left;
-    m_inx_right = table.m_inx_right;
-    m_wgt_left  = table.m_wgt_left;
-    m_wgt_right = table.m_wgt_right;
-    m_inx1      = table.m_inx1;
-    m_inx2      = table.m_inx2;
-    m_inx3      = table.m_inx3;
-    m_inx4      = table.m_inx4;
-    m_wgt1      = table.m_wgt1;
-    m_wgt2      = table.m_wgt2;
-    m_wgt3      = table.m_wgt3;
-    m_wgt4      = table.m_wgt4;
+    // Copy compiled grid
+    m_grid_n1     = table.m_grid_n1;
+    m_grid_n2     = table.m_grid_n2;
+    m_grid_min1   = table.m_grid_min1;
+    m_grid_max1   = table.m_grid_max1;
+    m_grid_min2   = table.m_grid_min2;
+    m_grid_max2   = table.m_grid_max2;
+    m_grid_scale1 = table.m_grid_scale1;
+    m_grid_scale2 = table.m_grid_scale2;
+    m_grid        = table.m_grid;
+    m_grid_error  = table.m_grid_error;
 
     // Return
     return;
@@ -1052,9 +1291,11 @@ void GCTAResponseTable::read_axes(const GFitsTable& hdu)
         std::vector<double> axis_nodes(num);
 
         // Copy axis information into arrays
+        if (num > 0) {
+            col_lo->read_range(0, 1, &axis_lo[0]);
+            col_hi->read_range(0, 1, &axis_hi[0]);
+        }
         for (int k = 0; k < num; ++k) {
-            axis_lo[k]    = col_lo->real(0,k);
-            axis_hi[k]    = col_hi->real(0,k);
             axis_nodes[k] = 0.5*(axis_lo[k] + axis_hi[k]);
         }
 
@@ -1124,8 +1365,8 @@ void GCTAResponseTable::read_pars(const GFitsTable& hdu)
         std::vector<double> pars(num);
 
         // Copy parameter values
-        for (int k = 0; k < num; ++k) {
-            pars[k] = col->real(0,k);
+        if (num > 0) {
+            col->read_range(0, 1, &pars[0]);
         }
 
         // Push cube into storage
@@ -1139,31 +1380,26 @@ void GCTAResponseTable::read_pars(const GFitsTable& hdu)
 
 
 /***********************************************************************//**
- * @brief Update 1D cache
+ * @brief Return indices and weights for 1D interpolation
  *
  * @param[in] arg Argument.
+ * @param[out] inx Indices of the 2 table values (2 elements).
+ * @param[out] wgt Weights of the 2 table values (2 elements).
  *
- * Updates the 1D interpolation cache. The interpolation cache is composed
- * of two indices and weights that define 2 data values of the 2D table
- * that are used for linear interpolation.
- *
- * @todo Write down formula
- *
- * @todo Makes GNodeArray::set_value method const and use mutable members
+ * Determines the two indices and weights that define the data values of
+ * the table that are used for linear interpolation. The method does not
+ * modify the table and can be called simultaneously from several threads.
  ***************************************************************************/
-void GCTAResponseTable::update(const double& arg) const
+void GCTAResponseTable::weights(const double& arg, int* inx, double* wgt) const
 {
-    // Get pointer to node array (circumvent const correctness)
-    GNodeArray* nodes = const_cast<GNodeArray*>(&(m_axis_nodes[0]));
-
-    // Set value for node array
-    nodes->set_value(arg);
+    // Get indices and weighting factors from node array
+    GNodeArray::weights w = m_axis_nodes[0].lookup(arg);
 
     // Set indices and weighting factors for interpolation
-    m_inx_left  = nodes->inx_left();
-    m_inx_right = nodes->inx_right();
-    m_wgt_left  = nodes->wgt_left();
-    m_wgt_right = nodes->wgt_right();
+    inx[0] = w.inx_left;
+    inx[1] = w.inx_right;
+    wgt[0] = w.wgt_left;
+    wgt[1] = w.wgt_right;
     
     // Return
     return;
@@ -1171,46 +1407,119 @@ void GCTAResponseTable::update(const double& arg) const
 
 
 /***********************************************************************//**
- * @brief Update 2D cache
+ * @brief Return indices and weights for 2D interpolation
  *
  * @param[in] arg1 Argument for first axis.
  * @param[in] arg2 Argument for second axis.
+ * @param[out] inx Indices of the 4 table values (4 elements).
+ * @param[out] wgt Weights of the 4 table values (4 elements).
  *
- * Updates the 2D interpolation cache. The interpolation cache is composed
- * of four indices and weights that define 4 data values of the 2D table
- * that are used for bilinear interpolation.
- *
- * @todo Write down formula
- *
- * @todo Makes GNodeArray::set_value method const and use mutable members
+ * Determines the four indices and weights that define the data values of
+ * the table that are used for bilinear interpolation. The method does not
+ * modify the table and can be called simultaneously from several threads.
  ***************************************************************************/
-void GCTAResponseTable::update(const double& arg1, const double& arg2) const
+void GCTAResponseTable::weights(const double& arg1, const double& arg2,
+                                int* inx, double* wgt) const
 {
-    // Get pointers to node arrays (circumvent const correctness)
-    GNodeArray* nodes1 = const_cast<GNodeArray*>(&(m_axis_nodes[0]));
-    GNodeArray* nodes2 = const_cast<GNodeArray*>(&(m_axis_nodes[1]));
-
-    // Set values for node arrays
-    nodes1->set_value(arg1);
-    nodes2->set_value(arg2);
+    // Get indices and weighting factors from node arrays
+    GNodeArray::weights w1 = m_axis_nodes[0].lookup(arg1);
+    GNodeArray::weights w2 = m_axis_nodes[1].lookup(arg2);
 
     // Compute offsets
     int size1        = axis(0);
-    int offset_left  = nodes2->inx_left()  * size1;
-    int offset_right = nodes2->inx_right() * size1;
+    int offset_left  = w2.inx_left  * size1;
+    int offset_right = w2.inx_right * size1;
 
     // Set indices for bi-linear interpolation
-    m_inx1 = nodes1->inx_left()  + offset_left;
-    m_inx2 = nodes1->inx_left()  + offset_right;
-    m_inx3 = nodes1->inx_right() + offset_left;
-    m_inx4 = nodes1->inx_right() + offset_right;
+    inx[0] = w1.inx_left  + offset_left;
+    inx[1] = w1.inx_left  + offset_right;
+    inx[2] = w1.inx_right + offset_left;
+    inx[3] = w1.inx_right + offset_right;
 
     // Set weighting factors for bi-linear interpolation
-    m_wgt1 = nodes1->wgt_left()  * nodes2->wgt_left();
-    m_wgt2 = nodes1->wgt_left()  * nodes2->wgt_right();
-    m_wgt3 = nodes1->wgt_right() * nodes2->wgt_left();
-    m_wgt4 = nodes1->wgt_right() * nodes2->wgt_right();
+    wgt[0] = w1.wgt_left  * w2.wgt_left;
+    wgt[1] = w1.wgt_left  * w2.wgt_right;
+    wgt[2] = w1.wgt_right * w2.wgt_left;
+    wgt[3] = w1.wgt_right * w2.wgt_right;
     
     // Return
     return;
 }
+
+
+/***********************************************************************//**
+ * @brief Computes weights for bi-linear interpolation of compiled grid
+ *
+ * @param[in] arg1 Argument for first axis.
+ * @param[in] arg2 Argument for second axis.
+ * @param[out] inx Index array [4].
+ * @param[out] wgt Weight array [4].
+ * @return True if arguments are within the compiled grid.
+ *
+ * Computes the grid indices and weighting factors for a bi-linear
+ * interpolation of the compiled grid. The indices follow the same
+ * convention as weights(). False is returned if the table was not
+ * compiled or if the arguments are outside the grid; @p inx and @p wgt
+ * are not set in that case.
+ ***************************************************************************/
+bool GCTAResponseTable::grid_weights(const double& arg1, const double& arg2,
+                                     int* inx, double* wgt) const
+{
+    // Return false if table was not compiled or arguments are outside grid
+    if (m_grid_n1 == 0 ||
+        arg1 < m_grid_min1 || arg1 > m_grid_max1 ||
+        arg2 < m_grid_min2 || arg2 > m_grid_max2) {
+        return false;
+    }
+
+    // Compute grid cells and fractional positions within the cells
+    double x1 = (arg1 - m_grid_min1) * m_grid_scale1;
+    double x2 = (arg2 - m_grid_min2) * m_grid_scale2;
+    int    i1 = int(x1);
+    int    i2 = int(x2);
+    if (i1 > m_grid_n1-2) {
+        i1 = m_grid_n1-2;
+    }
+    if (i2 > m_grid_n2-2) {
+        i2 = m_grid_n2-2;
+    }
+    double w1 = x1 - double(i1);
+    double w2 = x2 - double(i2);
+
+    // Compute offsets
+    int offset_left  = i2 * m_grid_n1;
+    int offset_right = offset_left + m_grid_n1;
+
+    // Set indices for bi-linear interpolation
+    inx[0] = i1   + offset_left;
+    inx[1] = i1   + offset_right;
+    inx[2] = i1+1 + offset_left;
+    inx[3] = i1+1 + offset_right;
+
+    // Set weighting factors for bi-linear interpolation
+    wgt[0] = (1.0-w1) * (1.0-w2);
+    wgt[1] = (1.0-w1) * w2;
+    wgt[2] = w1       * (1.0-w2);
+    wgt[3] = w1       * w2;
+
+    // Return
+    return true;
+}
+
+
+/***********************************************************************//**
+ * @brief Remove compiled grid
+ ***************************************************************************/
+void GCTAResponseTable::free_grid(void)
+{
+    // Reset grid
+    m_grid_n1     = 0;
+    m_grid_n2     = 0;
+    m_grid_scale1 = 0.0;
+    m_grid_scale2 = 0.0;
+    m_grid.clear();
+    m_grid_error.clear();
+
+    // Return
+    return;
+}
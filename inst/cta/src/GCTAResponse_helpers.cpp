@@ -182,7 +182,7 @@ double cta_irf_radial_kern_rho::eval(const double& rho)
         // Integrate over phi
         GIntegral integral(&integrand);
         integral.eps(m_rsp.eps());
-        irf = integral.romb(omega_min, omega_max) * model * sin_rho;
+        irf = integral.gauss_kronrod(omega_min, omega_max) * model * sin_rho;
 
         // Compile option: Check for NaN/Inf
         #if defined(G_NAN_CHECK)
@@ -244,6 +244,53 @@ double cta_irf_radial_kern_rho::eval(const double& rho)
  * azimuthal dependence is so far implemented for the IRF computation).
  ***************************************************************************/
 double cta_irf_radial_kern_omega::eval(const double& omega)
+{
+    // Return IRF
+    return (irf(omega, m_rsp.has_edisp()));
+}
+
+
+/***********************************************************************//**
+ * @brief Kernel for radial model azimuth angle IRF integration for an array
+ *        of azimuth angles
+ *
+ * @param[in] omega Pointer to array of azimuth angles [radians].
+ * @param[out] irf Pointer to array of IRF values.
+ * @param[in] n Number of azimuth angles.
+ *
+ * Computes the kernel for @p n azimuth angles. The check whether energy
+ * dispersion is needed is done once for all azimuth angles.
+ *
+ * See cta_irf_radial_kern_omega::eval(const double&) for more information.
+ ***************************************************************************/
+void cta_irf_radial_kern_omega::eval(const double* omega, double* irf,
+                                     const int& n)
+{
+    // Signal energy dispersion
+    bool edisp = m_rsp.has_edisp();
+
+    // Evaluate IRF
+    for (int i = 0; i < n; ++i) {
+        irf[i] = this->irf(omega[i], edisp);
+    }
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief IRF for radial model azimuth angle
+ *
+ * @param[in] omega Azimuth angle (radians).
+ * @param[in] edisp Take energy dispersion into account?
+ * @return IRF value.
+ *
+ * Implements the kernel for both eval() methods.
+ ***************************************************************************/
+inline
+double cta_irf_radial_kern_omega::irf(const double& omega,
+                                      const bool&   edisp) const
 {
     // Compute PSF offset angle [radians]
     double delta = std::acos(m_cos_psf + m_sin_psf * std::cos(omega));
@@ -259,7 +306,7 @@ double cta_irf_radial_kern_omega::eval(const double& omega)
                  m_rsp.psf(delta, offset, azimuth, m_zenith, m_azimuth, m_srcLogEng);
 
     // Optionally take energy dispersion into account
-    if (m_rsp.has_edisp() && irf > 0.0) {
+    if (edisp && irf > 0.0) {
         irf *= m_rsp.edisp(m_obsLogEng, offset, azimuth, m_zenith, m_azimuth, m_srcLogEng);
     }
     
@@ -282,6 +329,216 @@ double cta_irf_radial_kern_omega::eval(const double& omega)
 }
 
 
+/***********************************************************************//**
+ * @brief Azimuthally integrated IRF for radial model zenith angle
+ *
+ * @param[in] rho Zenith angle with respect to model centre [radians].
+ * @param[in] cos_weight Weight the IRF with the cosine of the azimuth angle?
+ *
+ * Computes
+ *
+ * \f[
+ *    \sin \rho \times \int_{\omega_{\rm min}}^{\omega_{\rm max}}
+ *    IRF(\rho, \omega) \, w(\omega) d\omega
+ * \f]
+ *
+ * where \f$w(\omega)=1\f$ if @p cos_weight is false and
+ * \f$w(\omega)=\cos \omega\f$ otherwise. The azimuth angle range is the
+ * same as for the eval() method.
+ ***************************************************************************/
+double cta_irf_radial_kern_rho::arc(const double& rho,
+                                    const bool&   cos_weight) const
+{
+    // Compute half length of arc that lies within PSF validity circle
+    // (in radians)
+    double domega = 0.5 * gammalib::cta_roi_arclength(rho,
+                                                      m_zeta,
+                                                      m_cos_zeta,
+                                                      m_sin_zeta,
+                                                      m_delta_max,
+                                                      m_cos_delta_max);
+
+    // Initialise result
+    double arc = 0.0;
+
+    // Continue only if arc length is positive
+    if (domega > 0.0) {
+
+        // Precompute cosine and sine terms for azimuthal integration
+        double cos_rho = std::cos(rho);
+        double sin_rho = std::sin(rho);
+        double cos_psf = cos_rho*m_cos_zeta;
+        double sin_psf = sin_rho*m_sin_zeta;
+        double cos_ph  = cos_rho*m_cos_lambda;
+        double sin_ph  = sin_rho*m_sin_lambda;
+
+        // Integrate cosine weighted IRF over omega
+        if (cos_weight) {
+            cta_irf_radial_kern_omega_cos integrand(m_rsp,
+                                                    m_zenith,
+                                                    m_azimuth,
+                                                    m_srcLogEng,
+                                                    m_obsLogEng,
+                                                    m_zeta,
+                                                    m_lambda,
+                                                    m_omega0,
+                                                    rho,
+                                                    cos_psf,
+                                                    sin_psf,
+                                                    cos_ph,
+                                                    sin_ph);
+            GIntegral integral(&integrand);
+            integral.eps(m_rsp.eps());
+            arc = integral.romb(-domega, domega) * sin_rho;
+        }
+
+        // ... otherwise integrate IRF over omega
+        else {
+            cta_irf_radial_kern_omega integrand(m_rsp,
+                                                m_zenith,
+                                                m_azimuth,
+                                                m_srcLogEng,
+                                                m_obsLogEng,
+                                                m_zeta,
+                                                m_lambda,
+                                                m_omega0,
+                                                rho,
+                                                cos_psf,
+                                                sin_psf,
+                                                cos_ph,
+                                                sin_ph);
+            GIntegral integral(&integrand);
+            integral.eps(m_rsp.eps());
+            arc = integral.romb(-domega, domega) * sin_rho;
+        }
+
+    } // endif: arc length was positive
+
+    // Return result
+    return arc;
+}
+
+
+/***********************************************************************//**
+ * @brief Kernel for radial model azimuth angle IRF moment integration
+ *
+ * @param[in] omega Azimuth angle (radians).
+ *
+ * Computes the kernel 
+ *
+ * \f[
+ *    IRF(\rho,\omega) \cos \omega
+ * \f]
+ *
+ * See cta_irf_radial_kern_omega::eval() for more information.
+ ***************************************************************************/
+double cta_irf_radial_kern_omega_cos::eval(const double& omega)
+{
+    // Return cosine weighted IRF
+    return (cta_irf_radial_kern_omega::eval(omega) * std::cos(omega));
+}
+
+
+/***********************************************************************//**
+ * @brief Kernel for azimuthal radial model moment integration for an array
+ *        of azimuth angles
+ *
+ * @param[in] omega Pointer to array of azimuth angles [radians].
+ * @param[out] irf Pointer to array of cosine weighted IRF values.
+ * @param[in] n Number of azimuth angles.
+ *
+ * See cta_irf_radial_kern_omega_cos::eval(const double&) for more
+ * information.
+ ***************************************************************************/
+void cta_irf_radial_kern_omega_cos::eval(const double* omega, double* irf,
+                                         const int& n)
+{
+    // Compute IRF
+    cta_irf_radial_kern_omega::eval(omega, irf, n);
+
+    // Weight IRF with cosine of azimuth angle
+    for (int i = 0; i < n; ++i) {
+        irf[i] *= std::cos(omega[i]);
+    }
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Kernel for radial model zenith angle integration of IRF gradient
+ *
+ * @param[in] rho Zenith angle with respect to model centre [radians].
+ *
+ * Computes the kernel 
+ *
+ * \f[
+ *    K(\rho | E, t) = \frac{\partial S_{\rm p}(\rho | E, t)}{\partial p}
+ *                     \times \sin \rho \times
+ *                     \int_{\omega_{\rm min}}^{\omega_{\rm max}}
+ *                     IRF(\rho, \omega) \, w(\omega) d\omega
+ * \f]
+ *
+ * The model gradient is taken from the factor gradient of the model
+ * parameter after calling GModelSpatialRadial::eval_gradients(). If the
+ * parameter index is negative, the derivative of the model with respect to
+ * \f$\rho\f$ is used instead.
+ ***************************************************************************/
+double cta_irf_radial_kern_rho_grad::eval(const double& rho)
+{
+    // Initialise result
+    double grad = 0.0;
+
+    // Compute azimuthally integrated IRF
+    double irf = arc(rho, m_cos_weight);
+
+    // Continue only if IRF is non-zero
+    if (irf != 0.0) {
+
+        // Evaluate model gradients
+        m_model.eval_gradients(rho, m_srcEng, m_srcTime);
+
+        // Compute kernel
+        grad = (m_ipar < 0) ? m_model.theta_gradient() * irf
+                            : m_model[m_ipar].factor_gradient() * irf;
+
+    }
+
+    // Return result
+    return grad;
+}
+
+
+/***********************************************************************//**
+ * @brief Kernel for shell model integration of IRF gradients
+ *
+ * @param[in] t Substitution variable [radians].
+ *
+ * Computes the kernel in the substitution variable \f$t\f$ that is
+ * defined by \f$\rho = R \sin t\f$ (small angle approximation) or
+ * \f$\sin \rho = \sin R \sin t\f$.
+ ***************************************************************************/
+double cta_irf_radial_kern_shell::eval(const double& t)
+{
+    // Compute zenith angle and kernel weight
+    double rho;
+    double weight;
+    if (m_small_angle) {
+        rho    = m_radius * std::sin(t);
+        weight = (m_cos_weight) ? rho : m_radius;
+    }
+    else {
+        rho    = std::asin(m_sin_radius * std::sin(t));
+        weight = (m_cos_weight) ? std::sin(rho)
+                                : m_sin_radius * m_cos_radius / std::cos(rho);
+    }
+
+    // Return kernel value
+    return (weight * arc(rho, m_cos_weight));
+}
+
+
 /***********************************************************************//**
  * @brief Kernel for zenith angle Npred integration or radial model
  *
@@ -339,7 +596,7 @@ double cta_npred_radial_kern_rho::eval(const double& rho)
 
         // Integrate over phi
         GIntegral integral(&integrand);
-        npred = integral.romb(omega_min, omega_max) * sin_rho * model;
+        npred = integral.gauss_kronrod(omega_min, omega_max) * sin_rho * model;
 
         // Debug: Check for NaN
         #if defined(G_NAN_CHECK)
@@ -588,6 +845,103 @@ double cta_irf_elliptical_kern_omega::eval(const double& omega)
 }
 
 
+/***********************************************************************//**
+ * @brief Kernel for elliptical disk model boundary integration of IRF
+ *
+ * @param[in] omega Azimuth angle (radians).
+ *
+ * Computes the IRF on the boundary of the elliptical disk times the weight
+ * that corresponds to the kernel mode. See the class description for the
+ * available modes.
+ ***************************************************************************/
+double cta_irf_elliptical_kern_edge::eval(const double& omega)
+{
+    // Compute boundary radius and its derivative with respect to the
+    // position angle difference
+    double diff_angle = omega + m_obsOmega - m_posangle;
+    double cosinus    = std::cos(diff_angle);
+    double sinus      = std::sin(diff_angle);
+    double a2         = m_semimajor * m_semimajor;
+    double b2         = m_semiminor * m_semiminor;
+    double denom      = b2 * cosinus * cosinus + a2 * sinus * sinus;
+    double r          = m_semimajor * m_semiminor / std::sqrt(denom);
+    double dr_dphi0   = r * (a2 - b2) * sinus * cosinus / denom;
+    double sin_r      = std::sin(r);
+    double cos_r      = std::cos(r);
+
+    // Compute weight
+    double weight = 0.0;
+    switch (m_mode) {
+    case 0:
+        weight = sin_r * r * b2 * cosinus * cosinus / (m_semimajor * denom);
+        break;
+    case 1:
+        weight = sin_r * r * a2 * sinus * sinus / (m_semiminor * denom);
+        break;
+    case 2:
+        weight = sin_r * dr_dphi0;
+        break;
+    case 3:
+        weight = sin_r * std::cos(omega) - dr_dphi0 * std::sin(omega);
+        break;
+    case 4:
+        weight = sin_r * std::sin(omega) + dr_dphi0 * std::cos(omega);
+        break;
+    default:
+        break;
+    }
+
+    // Initialise IRF value
+    double irf = 0.0;
+
+    // Continue only if weight is non-zero
+    if (weight != 0.0) {
+
+        // Compute PSF offset angle [radians]
+        double delta = gammalib::acos(cos_r * m_cos_zeta +
+                                      sin_r * m_sin_zeta * std::cos(omega));
+
+        // Compute true photon offset and azimuth angle in camera system
+        // [radians]
+        double theta = gammalib::acos(cos_r * m_cos_lambda +
+                                      sin_r * m_sin_lambda *
+                                      std::cos(m_omega0 - omega));
+        double phi   = 0.0; //TODO: Implement IRF Phi dependence
+
+        // Evaluate IRF
+        irf = m_rsp.aeff(theta, phi, m_zenith, m_azimuth, m_srcLogEng) *
+              m_rsp.psf(delta, theta, phi, m_zenith, m_azimuth, m_srcLogEng);
+
+        // Optionally take energy dispersion into account
+        if (m_rsp.has_edisp() && irf > 0.0) {
+            irf *= m_rsp.edisp(m_obsLogEng, theta, phi,
+                               m_zenith, m_azimuth, m_srcLogEng);
+        }
+
+        // Apply weight
+        irf *= weight;
+
+        // Compile option: Check for NaN/Inf
+        #if defined(G_NAN_CHECK)
+        if (gammalib::is_notanumber(irf) || gammalib::is_infinite(irf)) {
+            std::cout << "*** ERROR: cta_irf_elliptical_kern_edge::eval";
+            std::cout << "(omega=" << omega << "):";
+            std::cout << " NaN/Inf encountered";
+            std::cout << " (irf=" << irf;
+            std::cout << ", weight=" << weight;
+            std::cout << ", delta=" << delta;
+            std::cout << ", theta=" << theta << ")";
+            std::cout << std::endl;
+        }
+        #endif
+
+    } // endif: weight was non-zero
+
+    // Return
+    return irf;
+}
+
+
 /***********************************************************************//**
  * @brief Kernel for zenith angle Npred integration of elliptical model
  *
@@ -154,6 +154,7 @@ public:
                             m_delta_max(delta_max),
                             m_cos_delta_max(std::cos(delta_max)) { }
     double eval(const double& rho);
+    double arc(const double& rho, const bool& cos_weight) const;
 protected:
     const GCTAResponse&        m_rsp;           //!< CTA response
     const GModelSpatialRadial& m_model;         //!< Radial spatial model
@@ -222,7 +223,9 @@ public:
                               m_cos_ph(cos_ph),
                               m_sin_ph(sin_ph) { }
     double eval(const double& omega);
+    void   eval(const double* omega, double* irf, const int& n);
 protected:
+    double irf(const double& omega, const bool& edisp) const;
     const GCTAResponse& m_rsp;           //!< CTA response
     const double&       m_zenith;        //!< Zenith angle
     const double&       m_azimuth;       //!< Azimuth angle
@@ -239,6 +242,189 @@ protected:
 };
 
 
+/***********************************************************************//**
+ * @class cta_irf_radial_kern_omega_cos
+ *
+ * @brief Kernel for radial model azimuth angle IRF moment integration
+ *
+ * This class implements the computation of
+ *
+ * \f[
+ *    IRF(\rho, \omega) \cos \omega
+ * \f]
+ *
+ * which is needed for the computation of the IRF gradients with respect to
+ * the position of the model centre.
+ ***************************************************************************/
+class cta_irf_radial_kern_omega_cos : public cta_irf_radial_kern_omega {
+public:
+    cta_irf_radial_kern_omega_cos(const GCTAResponse& rsp,
+                                  const double&       zenith,
+                                  const double&       azimuth,
+                                  const double&       srcLogEng,
+                                  const double&       obsLogEng,
+                                  const double&       zeta,
+                                  const double&       lambda,
+                                  const double&       omega0,
+                                  const double&       rho,
+                                  const double&       cos_psf,
+                                  const double&       sin_psf,
+                                  const double&       cos_ph,
+                                  const double&       sin_ph) :
+                                  cta_irf_radial_kern_omega(rsp,
+                                                            zenith,
+                                                            azimuth,
+                                                            srcLogEng,
+                                                            obsLogEng,
+                                                            zeta,
+                                                            lambda,
+                                                            omega0,
+                                                            rho,
+                                                            cos_psf,
+                                                            sin_psf,
+                                                            cos_ph,
+                                                            sin_ph) { }
+    double eval(const double& omega);
+    void   eval(const double* omega, double* irf, const int& n);
+};
+
+
+/***********************************************************************//**
+ * @class cta_irf_radial_kern_rho_grad
+ *
+ * @brief Kernel for radial model zenith angle integration of IRF gradients
+ *
+ * This class implements the integration kernel
+ *
+ * \f[
+ *    K(\rho | E, t) = \frac{\partial S_{\rm p}(\rho | E, t)}{\partial p}
+ *                     \times \sin \rho \times
+ *                     \int_{\omega_{\rm min}}^{\omega_{\rm max}}
+ *                     IRF(\rho, \omega) \, w(\omega) d\omega
+ * \f]
+ *
+ * where \f$\partial S_{\rm p} / \partial p\f$ is the gradient of the
+ * radial model with respect to the model parameter with index @p ipar, as
+ * set by GModelSpatialRadial::eval_gradients(), or the derivative with
+ * respect to \f$\rho\f$ if @p ipar is negative, and
+ * \f$w(\omega)=1\f$ or \f$w(\omega)=\cos \omega\f$. The kernel is only
+ * valid for models that are continuous in \f$\rho\f$.
+ ***************************************************************************/
+class cta_irf_radial_kern_rho_grad : public cta_irf_radial_kern_rho {
+public:
+    cta_irf_radial_kern_rho_grad(const GCTAResponse&        rsp,
+                                 const GModelSpatialRadial& model,
+                                 const double&              zenith,
+                                 const double&              azimuth,
+                                 const GEnergy&             srcEng,
+                                 const GTime&               srcTime,
+                                 const double&              srcLogEng,
+                                 const double&              obsLogEng,
+                                 const double&              zeta,
+                                 const double&              lambda,
+                                 const double&              omega0,
+                                 const double&              delta_max,
+                                 const int&                 ipar,
+                                 const bool&                cos_weight) :
+                                 cta_irf_radial_kern_rho(rsp,
+                                                         model,
+                                                         zenith,
+                                                         azimuth,
+                                                         srcEng,
+                                                         srcTime,
+                                                         srcLogEng,
+                                                         obsLogEng,
+                                                         zeta,
+                                                         lambda,
+                                                         omega0,
+                                                         delta_max),
+                                 m_ipar(ipar),
+                                 m_cos_weight(cos_weight) { }
+    double eval(const double& rho);
+protected:
+    int  m_ipar;       //!< Model parameter index (-1: rho derivative)
+    bool m_cos_weight; //!< Use cosine weighting
+};
+
+
+/***********************************************************************//**
+ * @class cta_irf_radial_kern_shell
+ *
+ * @brief Kernel for shell model integration of IRF gradients
+ *
+ * This class implements the integration kernels that are needed for the
+ * computation of the IRF gradients of the radial shell model. The shell
+ * function \f$\sqrt{R^2-\rho^2}\f$ (or
+ * \f$\sqrt{\sin^2 R - \sin^2 \rho}\f$ if the small angle approximation is
+ * not used) has an integrable singularity in its derivatives at
+ * \f$\rho=R\f$, which is removed by the substitution
+ * \f$\rho = R \sin t\f$ (or \f$\sin \rho = \sin R \sin t\f$).
+ *
+ * If @p cos_weight is false, the eval() method computes the kernel for the
+ * derivative with respect to the shell radius
+ *
+ * \f[
+ *    K(t) = w(t) \times \sin \rho \times
+ *           \int_{\omega_{\rm min}}^{\omega_{\rm max}}
+ *           IRF(\rho, \omega) d\omega
+ * \f]
+ *
+ * with \f$w(t)=R\f$ (or \f$w(t)=\sin R \cos R / \cos \rho\f$), otherwise
+ * the kernel for the derivative with respect to the model centre
+ *
+ * \f[
+ *    K(t) = s(t) \times \sin \rho \times
+ *           \int_{\omega_{\rm min}}^{\omega_{\rm max}}
+ *           IRF(\rho, \omega) \cos \omega d\omega
+ * \f]
+ *
+ * with \f$s(t)=\rho\f$ (or \f$s(t)=\sin \rho\f$).
+ ***************************************************************************/
+class cta_irf_radial_kern_shell : public cta_irf_radial_kern_rho {
+public:
+    cta_irf_radial_kern_shell(const GCTAResponse&        rsp,
+                              const GModelSpatialRadial& model,
+                              const double&              zenith,
+                              const double&              azimuth,
+                              const GEnergy&             srcEng,
+                              const GTime&               srcTime,
+                              const double&              srcLogEng,
+                              const double&              obsLogEng,
+                              const double&              zeta,
+                              const double&              lambda,
+                              const double&              omega0,
+                              const double&              delta_max,
+                              const double&              radius,
+                              const bool&                small_angle,
+                              const bool&                cos_weight) :
+                              cta_irf_radial_kern_rho(rsp,
+                                                      model,
+                                                      zenith,
+                                                      azimuth,
+                                                      srcEng,
+                                                      srcTime,
+                                                      srcLogEng,
+                                                      obsLogEng,
+                                                      zeta,
+                                                      lambda,
+                                                      omega0,
+                                                      delta_max),
+                              m_radius(radius),
+                              m_sin_radius(std::sin(radius)),
+                              m_cos_radius(std::cos(radius)),
+                              m_small_angle(small_angle),
+                              m_cos_weight(cos_weight) { }
+    double eval(const double& t);
+protected:
+    const double& m_radius;      //!< Shell radius (radians)
+    double        m_sin_radius;  //!< Sine of shell radius
+    double        m_cos_radius;  //!< Cosine of shell radius
+    bool          m_small_angle; //!< Use small angle approximation
+    bool          m_cos_weight;  //!< Compute centre derivative kernel
+};
+
+
+
 /***********************************************************************//**
  * @class cta_npred_radial_kern_rho
  *
@@ -513,6 +699,86 @@ public:
 };
 
 
+/***********************************************************************//**
+ * @class cta_irf_elliptical_kern_edge
+ *
+ * @brief Kernel for elliptical disk model boundary integration of IRF
+ *
+ * This class implements the integration kernel
+ *
+ * \f[
+ *    K(\omega) = IRF(r(\omega), \omega) \, w(\omega)
+ * \f]
+ *
+ * along the boundary \f$\rho=r(\omega)\f$ of an elliptical disk, where
+ *
+ * \f[
+ *    r(\omega) = \frac{ab}{\sqrt{b^2 \cos^2 (\phi-\phi_0) +
+ *                                  a^2 \sin^2 (\phi-\phi_0)}}
+ * \f]
+ *
+ * with \f$\phi = \omega + \omega_{\rm obs}\f$. Depending on @p mode the
+ * weight \f$w(\omega)\f$ is
+ * - 0: \f$\sin r \, \partial r / \partial a\f$ (semi-major axis),
+ * - 1: \f$\sin r \, \partial r / \partial b\f$ (semi-minor axis),
+ * - 2: \f$\sin r \, \partial r / \partial \phi_0\f$ (position angle),
+ * - 3: \f$\sin r \cos \omega + r' \sin \omega\f$ (centre shift towards
+ *      the measured photon direction), and
+ * - 4: \f$\sin r \sin \omega - r' \cos \omega\f$ (perpendicular centre
+ *      shift),
+ *
+ * where \f$r' = \partial r / \partial \omega\f$.
+ ***************************************************************************/
+class cta_irf_elliptical_kern_edge : public GFunction {
+public:
+    cta_irf_elliptical_kern_edge(const GCTAResponse& rsp,
+                                 const double&       zenith,
+                                 const double&       azimuth,
+                                 const double&       srcLogEng,
+                                 const double&       obsLogEng,
+                                 const double&       zeta,
+                                 const double&       lambda,
+                                 const double&       obsOmega,
+                                 const double&       omega0,
+                                 const double&       semimajor,
+                                 const double&       semiminor,
+                                 const double&       posangle,
+                                 const int&          mode) :
+                                 m_rsp(rsp),
+                                 m_zenith(zenith),
+                                 m_azimuth(azimuth),
+                                 m_srcLogEng(srcLogEng),
+                                 m_obsLogEng(obsLogEng),
+                                 m_cos_zeta(std::cos(zeta)),
+                                 m_sin_zeta(std::sin(zeta)),
+                                 m_cos_lambda(std::cos(lambda)),
+                                 m_sin_lambda(std::sin(lambda)),
+                                 m_obsOmega(obsOmega),
+                                 m_omega0(omega0),
+                                 m_semimajor(semimajor),
+                                 m_semiminor(semiminor),
+                                 m_posangle(posangle),
+                                 m_mode(mode) { }
+    double eval(const double& omega);
+protected:
+    const GCTAResponse& m_rsp;        //!< CTA response
+    const double&       m_zenith;     //!< Zenith angle
+    const double&       m_azimuth;    //!< Azimuth angle
+    const double&       m_srcLogEng;  //!< True photon log energy
+    const double&       m_obsLogEng;  //!< Measured photon energy
+    double              m_cos_zeta;   //!< Cosine of zeta
+    double              m_sin_zeta;   //!< Sine of zeta
+    double              m_cos_lambda; //!< Cosine of lambda
+    double              m_sin_lambda; //!< Sine of lambda
+    const double&       m_obsOmega;   //!< Measured photon position angle from model centre
+    const double&       m_omega0;     //!< Azimuth of pointing in model system
+    const double&       m_semimajor;  //!< Semi-major axis (radians)
+    const double&       m_semiminor;  //!< Semi-minor axis (radians)
+    const double&       m_posangle;   //!< Position angle (radians)
+    int                 m_mode;       //!< Kernel mode
+};
+
+
 /***********************************************************************//**
  * @class cta_npred_elliptical_kern_rho
  *
@@ -30,11 +30,18 @@
 #endif
 #include <stdlib.h>
 #include <iostream>
+#include <algorithm>
+#include <cmath>
 #include <unistd.h>
 #include "GCTALib.hpp"
 #include "GTools.hpp"
 #include "test_CTA.hpp"
 
+/* __ OpenMP section _____________________________________________________ */
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 /* __ Namespaces _________________________________________________________ */
 
 /* __ Globals ____________________________________________________________ */
@@ -70,6 +77,8 @@ void TestGCTAResponse::set(void)
     append(static_cast<pfunction>(&TestGCTAResponse::test_response_npsf), "Test integrated PSF");
     append(static_cast<pfunction>(&TestGCTAResponse::test_response_irf_diffuse), "Test diffuse IRF");
     append(static_cast<pfunction>(&TestGCTAResponse::test_response_npred_diffuse), "Test diffuse IRF integration");
+    append(static_cast<pfunction>(&TestGCTAResponse::test_response_irf_gradients), "Test radial and elliptical IRF gradients");
+    append(static_cast<pfunction>(&TestGCTAResponse::test_response_compiled), "Test compiled response");
 
     // Return
     return;
@@ -127,6 +136,13 @@ void TestGCTAObservation::set(void)
     // Append tests to test suite
     append(static_cast<pfunction>(&TestGCTAObservation::test_unbinned_obs), "Test unbinned observations");
     append(static_cast<pfunction>(&TestGCTAObservation::test_binned_obs), "Test binned observation");
+    append(static_cast<pfunction>(&TestGCTAObservation::test_irf_cache), "Test IRF cache");
+    append(static_cast<pfunction>(&TestGCTAObservation::test_binned_irf_cache), "Test binned IRF cache");
+    append(static_cast<pfunction>(&TestGCTAObservation::test_binned_shared_map), "Test event cube from shared sky map");
+    append(static_cast<pfunction>(&TestGCTAObservation::test_event_geometry), "Test event geometry cache");
+    append(static_cast<pfunction>(&TestGCTAObservation::test_columnar_events), "Test columnar event storage");
+    append(static_cast<pfunction>(&TestGCTAObservation::test_column_projection), "Test event column projection");
+    append(static_cast<pfunction>(&TestGCTAObservation::test_event_stream), "Test event stream");
 
     // Return
     return;
@@ -276,6 +292,81 @@ void TestGCTAResponse::test_response_psf_king(void)
 }
 
 
+/***********************************************************************//**
+ * @brief Test compiled CTA response
+ *
+ * Compiles the effective area and King profile PSF response tables onto
+ * regular grids and checks that the compiled response agrees with the
+ * original response within the reported maximum interpolation error.
+ ***************************************************************************/
+void TestGCTAResponse::test_response_compiled(void)
+{
+    // Load response
+    GCTAResponse rsp;
+    rsp.caldb(cta_caldb_king);
+    rsp.load(cta_irf_king);
+
+    // Compile copy of response
+    GCTAResponse compiled = rsp;
+    compiled.compile(200, 50);
+
+    // Check that response tables were compiled
+    const GCTAAeff2D*  aeff = dynamic_cast<const GCTAAeff2D*>(compiled.aeff());
+    const GCTAPsfKing* psf  = dynamic_cast<const GCTAPsfKing*>(compiled.psf());
+    test_assert(aeff != NULL && aeff->table().is_compiled(),
+                "Check that effective area was compiled");
+    test_assert(psf != NULL && psf->table().is_compiled(),
+                "Check that PSF was compiled");
+    if (aeff == NULL || psf == NULL) {
+        return;
+    }
+
+    // Check that interpolation errors are small
+    double aeff_error = aeff->table().compile_error(0);
+    test_assert(aeff_error < 0.01, "Check effective area grid error",
+                "Maximum grid error "+gammalib::str(aeff_error)+
+                " exceeds 0.01");
+
+    // Compare effective area
+    double aeff_max = 0.0;
+    for (double logE = -1.5; logE < 2.0; logE += 0.1) {
+        aeff_max = std::max(aeff_max, rsp.aeff(0.0, 0.0, 0.0, 0.0, logE));
+    }
+    for (double logE = -1.5; logE < 2.0; logE += 0.1) {
+        for (double theta = 0.0; theta < 0.05; theta += 0.01) {
+            double ref   = rsp.aeff(theta, 0.0, 0.0, 0.0, logE);
+            double value = compiled.aeff(theta, 0.0, 0.0, 0.0, logE);
+            test_value(value, ref, aeff_error * aeff_max + 1.0e-10,
+                       "Compiled effective area");
+        }
+    }
+
+    // Check PSF normalization
+    GEnergy eng;
+    for (double e = 0.1; e < 10.0; e *= 2.0) {
+        eng.TeV(e);
+        double r_max = compiled.psf()->delta_max(eng.log10TeV()) *
+                       gammalib::rad2deg;
+        double r     = 0.0;
+        double dr    = 0.0001;
+        int    steps = int(r_max / dr);
+        double sum   = 0.0;
+        for (int i = 0; i < steps; ++i) {
+            r   += dr;
+            sum += compiled.psf(r * gammalib::deg2rad, 0.0, 0.0, 0.0, 0.0,
+                                eng.log10TeV()) *
+                   gammalib::twopi * std::sin(r * gammalib::deg2rad) * dr *
+                   gammalib::deg2rad;
+        }
+        test_value(sum, 1.0, 0.001, "Compiled PSF integration for "+
+                   eng.print());
+    }
+
+    // Return
+    return;
+}
+
+
 /***********************************************************************//**
  * @brief Test CTA npsf computation
  ***************************************************************************/
@@ -401,6 +492,101 @@ void TestGCTAResponse::test_response_irf_diffuse(void)
 }
 
 
+/***********************************************************************//**
+ * @brief Test radial and elliptical IRF gradients
+ *
+ * Compares the analytical gradients that GCTAResponse::irf computes for
+ * radial and elliptical models with numerical gradients obtained by
+ * finite differences of the IRF. The effective area is made independent
+ * of the offset angle since the centre gradients neglect the variation of
+ * the effective area with the position of the model centre. The
+ * integration precision is increased so that the numerical gradients are
+ * accurate to about one percent.
+ ***************************************************************************/
+void TestGCTAResponse::test_response_irf_gradients(void)
+{
+    // Setup response with offset angle independent effective area
+    std::string        filename = cta_caldb + "/" + cta_irf + ".dat";
+    GCTAAeffPerfTable* aeff     = new GCTAAeffPerfTable(filename);
+    aeff->sigma(0.0);
+    GCTAResponse rsp;
+    rsp.aeff(aeff);
+    rsp.psf(new GCTAPsfPerfTable(filename));
+    rsp.eps(1.0e-6);
+
+    // Setup observation
+    GSkyDir crab;
+    crab.radec_deg(83.6331, 22.0145);
+    GSkyDir pointing;
+    pointing.radec_deg(84.2, 22.3);
+    GCTAObservation obs;
+    obs.ontime(1800.0);
+    obs.livetime(1600.0);
+    obs.deadc(1600.0/1800.0);
+    obs.events(GCTAEventList());
+    obs.pointing(GCTAPointing(pointing));
+    obs.response(rsp);
+
+    // Setup event
+    GSkyDir dir;
+    dir.radec_deg(83.75, 22.1);
+    GCTAEventAtom event;
+    event.dir(GCTAInstDir(dir));
+    event.energy(GEnergy(1.0, "TeV"));
+
+    // Setup models
+    GModelSpatialRadialGauss    gauss(crab, 0.2);
+    GModelSpatialRadialDisk     disk(crab, 0.2);
+    GModelSpatialRadialShell    shell(crab, 0.1, 0.1);
+    GModelSpatialEllipticalDisk ellipse(crab, 0.3, 0.1, 30.0);
+    std::vector<GModelSpatial*> models;
+    models.push_back(&gauss);
+    models.push_back(&disk);
+    models.push_back(&shell);
+    models.push_back(&ellipse);
+
+    // Loop over models
+    for (int k = 0; k < models.size(); ++k) {
+
+        // Get model and free all parameters
+        GModelSpatial& model = *(models[k]);
+        for (int i = 0; i < model.size(); ++i) {
+            model[i].free();
+        }
+
+        // Compute IRF and analytical gradients
+        GSource source("Source", &model, event.energy(), event.time());
+        const GResponse& response = obs.response();
+        double irf = response.irf(event, source, obs, true);
+        std::vector<double> gradients;
+        for (int i = 0; i < model.size(); ++i) {
+            gradients.push_back(model[i].factor_gradient());
+        }
+        test_value(response.irf(event, source, obs), irf, 1.0e-10*irf,
+                   model.type()+" IRF value without gradients");
+
+        // Compare analytical to numerical gradients
+        const double h = 1.0e-3;
+        for (int i = 0; i < model.size(); ++i) {
+            double value = model[i].value();
+            model[i].value(value + h);
+            double irf_plus = response.irf(event, source, obs);
+            model[i].value(value - h);
+            double irf_minus = response.irf(event, source, obs);
+            model[i].value(value);
+            double numerical = (irf_plus - irf_minus) / (2.0 * h);
+            test_value(gradients[i], numerical,
+                       0.05 * std::abs(numerical) + 1.0e-3 * irf,
+                       model.type()+" "+model[i].name()+" gradient");
+        }
+
+    } // endfor: looped over models
+
+    // Return
+    return;
+}
+
+
 /***********************************************************************//**
  * @brief Test CTA Npred computation
  *
@@ -678,6 +864,764 @@ void TestGCTAObservation::test_binned_obs(void)
 }
 
 
+/***********************************************************************//**
+ * @brief Test IRF cache of event list
+ *
+ * Tests the IRF cache handles, the hit and miss statistics, the precision
+ * setting, the memory ceiling with removal of the least recently used
+ * model, the reset of cached values if the model parameters change, and
+ * the cached gradients.
+ ***************************************************************************/
+void TestGCTAObservation::test_irf_cache(void)
+{
+    // Setup event list
+    GCTAEventList list;
+    for (int i = 0; i < 100; ++i) {
+        list.append(GCTAEventAtom());
+    }
+
+    // Test handles
+    int h1 = list.irf_cache_handle("Source 1");
+    int h2 = list.irf_cache_handle("Source 2");
+    test_value(list.irf_cache_handle("Source 1"), h1, "Handle of Source 1");
+    test_assert(h1 != h2, "Expected different handles for different sources");
+
+    // Test cache access and statistics
+    test_value(list.irf_cache(h1, 10), -1.0, 1.0e-10, "No cached value");
+    list.irf_cache(h1, 10, 0.5);
+    test_value(list.irf_cache(h1, 10), 0.5, 1.0e-10, "Cached value");
+    test_value(list.irf_cache("Source 1", 10), 0.5, 1.0e-10,
+               "Cached value by name");
+    test_value(int(list.irf_cache_hits()), 2, "Number of hits");
+    test_value(int(list.irf_cache_misses()), 1, "Number of misses");
+    test_value(list.irf_cache_memory(), 100.0*8.0/(1024.0*1024.0), 1.0e-10,
+               "Memory for one source in double precision");
+
+    // Test single precision storage
+    list.irf_cache_float(true);
+    test_assert(list.irf_cache_float(), "Expected float precision");
+    test_value(list.irf_cache_memory(), 0.0, 1.0e-10,
+               "No memory after precision change");
+    test_value(list.irf_cache(h1, 10), -1.0, 1.0e-10,
+               "No cached value after precision change");
+    list.irf_cache(h1, 10, 0.25);
+    test_value(list.irf_cache(h1, 10), 0.25, 1.0e-10, "Cached float value");
+
+    // Test memory ceiling that holds only one source. Accessing Source 2
+    // removes Source 1 from the cache.
+    list.irf_cache_max_memory(100.0*4.0/(1024.0*1024.0));
+    list.irf_cache(h2, 20, 2.0);
+    test_value(list.irf_cache(h2, 20), 2.0, 1.0e-10, "Value of Source 2");
+    test_value(list.irf_cache(h1, 10), -1.0, 1.0e-10,
+               "Source 1 removed from cache");
+    test_value(list.irf_cache_memory(), 100.0*4.0/(1024.0*1024.0), 1.0e-10,
+               "Memory for one source in single precision");
+
+    // Test reset of cached values for changed parameters
+    list.irf_cache_max_memory(0.0);
+    std::vector<double> pars(1, 1.0);
+    int h3 = list.irf_cache_handle("Source 3", pars);
+    list.irf_cache(h3, 30, 3.0);
+    test_value(list.irf_cache(list.irf_cache_handle("Source 3", pars), 30),
+               3.0, 1.0e-10, "Value for unchanged parameters");
+    pars[0] = 2.0;
+    test_value(list.irf_cache(list.irf_cache_handle("Source 3", pars), 30),
+               -1.0, 1.0e-10, "No value for changed parameters");
+
+    // Test prepared cache access
+    int h4 = list.irf_cache_handle("Source 4");
+    test_value(list.irf_cache_value(h4, 40), -1.0, 1.0e-10,
+               "No value before preparation");
+    list.irf_cache_value(h4, 40, 4.0);
+    test_value(list.irf_cache_value(h4, 40), -1.0, 1.0e-10,
+               "No value stored before preparation");
+    list.irf_cache_prepare(h4);
+    list.irf_cache_value(h4, 40, 4.0);
+    test_value(list.irf_cache_value(h4, 40), 4.0, 1.0e-6,
+               "Prepared cache value");
+    test_value(list.irf_cache(h4, 40), 4.0, 1.0e-6,
+               "Prepared cache value from locked access");
+    unsigned long hits   = list.irf_cache_hits();
+    unsigned long misses = list.irf_cache_misses();
+    list.irf_cache_count(3, 2);
+    test_value(int(list.irf_cache_hits()-hits), 3, "Number of added hits");
+    test_value(int(list.irf_cache_misses()-misses), 2,
+               "Number of added misses");
+
+    // Test prepared cache gradients
+    std::vector<double> grads(2, 0.5);
+    std::vector<double> cached_grads(2, 0.0);
+    grads[1] = -1.5;
+    pars.assign(2, 1.0);
+    int h5 = list.irf_cache_handle("Source 5", pars);
+    list.irf_cache_prepare(h5);
+    test_assert(!list.irf_cache_gradients(h5, 50, &cached_grads),
+                "Expected no cached gradients");
+    list.irf_cache_gradients(h5, 50, grads);
+    test_assert(list.irf_cache_gradients(h5, 50, &cached_grads),
+                "Expected cached gradients");
+    test_value(cached_grads[0], 0.5, 1.0e-10, "First cached gradient");
+    test_value(cached_grads[1], -1.5, 1.0e-10, "Second cached gradient");
+    pars[0] = 2.0;
+    list.irf_cache_handle("Source 5", pars);
+    test_assert(!list.irf_cache_gradients(h5, 50, &cached_grads),
+                "Expected no cached gradients for changed parameters");
+
+    // Test clearing of cache
+    list.irf_cache_clear();
+    test_value(list.irf_cache_memory(), 0.0, 1.0e-10, "No memory after clear");
+    test_value(int(list.irf_cache_hits()), 0, "No hits after clear");
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Test event cube from sky map with shared pixels
+ *
+ * Tests that modifying the counts of an event cube that was built from a
+ * sky map with shared or single precision pixels does not modify the sky
+ * map, and that copies of an event cube hold their own counts.
+ ***************************************************************************/
+void TestGCTAObservation::test_binned_shared_map(void)
+{
+    // Setup sky map with shared pixels
+    GSkymap  map("CAR", "CEL", 83.63, 22.01, 0.1, 0.1, 10, 10, 2);
+    GEbounds ebounds(2, GEnergy(1.0, "TeV"), GEnergy(10.0, "TeV"));
+    GGti     gti;
+    gti.append(GTime(0.0), GTime(1800.0));
+    map(17) = 3.0;
+    map.shared_pixels(true);
+    const GSkymap& ref = map;
+
+    // Test that modifying the event cube leaves the sky map unchanged
+    GCTAEventCube cube(map, ebounds, gti);
+    test_value(cube[17]->counts(), 3.0, 1.0e-10, "Counts of event bin");
+    cube[17]->counts(5.0);
+    test_value(cube[17]->counts(), 5.0, 1.0e-10, "Modified counts of event bin");
+    test_value(ref(17), 3.0, 1.0e-10, "Unchanged sky map pixel");
+
+    // Test setting the sky map of an existing event cube
+    cube.map(map);
+    cube[17]->counts(6.0);
+    test_value(cube.map()(17), 6.0, 1.0e-10, "Modified event cube pixel");
+    test_value(ref(17), 3.0, 1.0e-10, "Unchanged sky map pixel after map()");
+
+    // Test that copies of the event cube hold their own counts
+    GCTAEventCube copy = cube;
+    copy[17]->counts(7.0);
+    test_value(cube[17]->counts(), 6.0, 1.0e-10, "Unchanged original event cube");
+    test_value(copy[17]->counts(), 7.0, 1.0e-10, "Modified copy of event cube");
+
+    // Test event cube from sky map with single precision pixels
+    map.float_pixels(true);
+    GCTAEventCube fcube(map, ebounds, gti);
+    test_value(fcube[17]->counts(), 3.0, 1.0e-6,
+               "Counts of event bin from single precision sky map");
+    fcube[17]->counts(8.0);
+    test_value(fcube[17]->counts(), 8.0, 1.0e-10,
+               "Modified counts from single precision sky map");
+    test_value(ref(17), 3.0, 1.0e-6,
+               "Unchanged single precision sky map pixel");
+    test_assert(ref.float_pixels(), "Expected single precision sky map");
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Test IRF cache of event cube
+ *
+ * Tests the per-thread event bins and the IRF cache of an event cube, and
+ * the use of the cache by the CTA response for a radial source during a
+ * model evaluation for which the source caches were set.
+ ***************************************************************************/
+void TestGCTAObservation::test_binned_irf_cache(void)
+{
+    // Setup event cube
+    GSkymap  map("CAR", "CEL", 83.63, 22.01, 0.1, 0.1, 10, 10, 2);
+    GEbounds ebounds(2, GEnergy(1.0, "TeV"), GEnergy(10.0, "TeV"));
+    GGti     gti;
+    gti.append(GTime(0.0), GTime(1800.0));
+    GCTAEventCube cube(map, ebounds, gti);
+
+    // Test event bins
+    test_assert(cube.thread_safe(), "Expected thread safe event cube");
+    test_value(cube[17]->index(), 17, "Index of event bin");
+    test_value(cube[117]->index(), 117, "Index of event bin");
+
+    // Test event bins from more threads than event bins
+    #ifdef _OPENMP
+    int nthreads = omp_get_num_procs() + 4;
+    int errors   = 0;
+    #pragma omp parallel num_threads(nthreads) reduction(+:errors)
+    {
+        for (int k = 0; k < 1000; ++k) {
+            int i = (k + omp_get_thread_num()) % cube.size();
+            if (cube[i]->index() != i) {
+                errors++;
+            }
+        }
+    }
+    test_value(errors, 0, "Event bins for additional threads");
+    #endif
+
+    // Test cache access
+    std::vector<double> pars(1, 1.0);
+    int handle = cube.irf_cache_handle("Source", pars);
+    test_value(cube.irf_cache(handle, 17), -1.0, 1.0e-10, "No cached value");
+    cube.irf_cache(handle, 17, 0.5);
+    test_value(cube.irf_cache(handle, 17), 0.5, 1.0e-10, "Cached value");
+    test_value(cube.irf_cache(cube.irf_cache_handle("Source", pars), 17),
+               0.5, 1.0e-10, "Value for unchanged parameters");
+    pars[0] = 2.0;
+    test_value(cube.irf_cache(cube.irf_cache_handle("Source", pars), 17),
+               -1.0, 1.0e-10, "No value for changed parameters");
+    cube.irf_cache(handle, 17, 0.5);
+    cube.irf_cache_clear();
+    test_value(cube.irf_cache(handle, 17), -1.0, 1.0e-10,
+               "No value after clear");
+
+    // Test prepared cache access
+    handle = cube.irf_cache_handle("Source", pars);
+    cube.irf_cache_value(handle, 18, 0.75);
+    test_value(cube.irf_cache_value(handle, 18), -1.0, 1.0e-10,
+               "No value stored before preparation");
+    cube.irf_cache_prepare(handle);
+    cube.irf_cache_value(handle, 18, 0.75);
+    test_value(cube.irf_cache_value(handle, 18), 0.75, 1.0e-10,
+               "Prepared cache value");
+    test_value(cube.irf_cache(handle, 18), 0.75, 1.0e-10,
+               "Prepared cache value from locked access");
+    cube.irf_cache_clear();
+
+    // Test response cache for a radial source
+    test_try("Test response cache for a radial source");
+    try {
+        GCTAObservation obs;
+        obs.events(cube);
+        obs.pointing(GCTAPointing(map.inx2dir(0)));
+        obs.response(cta_irf, cta_caldb);
+        const GResponse&     rsp   = obs.response();
+        const GCTAEventCube* ocube = static_cast<const GCTAEventCube*>(obs.events());
+        const GCTAEventBin*  bin   = (*ocube)[55];
+        GModelSpatialRadialGauss radial(map.inx2dir(55), 0.1);
+        for (int i = 0; i < radial.size(); ++i) {
+            radial[i].fix();
+        }
+        GModels models;
+        models.append(GModelSky(radial, GModelSpectralConst()));
+        models[0]->name("Crab");
+        GModelSpatial&      model = *(static_cast<GModelSky*>(models[0])->spatial());
+        std::vector<double> values;
+        for (int i = 0; i < model.size(); ++i) {
+            values.push_back(model[i].value());
+        }
+        GSource source("Crab", &model, bin->energy(), bin->time());
+        rsp.set_source_caches(obs, models);
+        double irf    = rsp.irf(*bin, source, obs);
+        double cached = ocube->irf_cache(ocube->irf_cache_handle("Crab", values), 55);
+        test_value(cached, irf, 1.0e-10, "Cached IRF value");
+        test_value(rsp.irf(*bin, source, obs), irf, 1.0e-10,
+                   "IRF value from cache");
+        rsp.clear_source_caches(obs);
+        model[0].value(model[0].value()+0.2);
+        rsp.set_source_caches(obs, models);
+        test_assert(rsp.irf(*bin, source, obs) < irf,
+                    "Expected smaller IRF value for offset source");
+        rsp.clear_source_caches(obs);
+        test_try_success();
+    }
+    catch (std::exception &e) {
+        test_try_failure(e);
+    }
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Test event geometry cache of event list
+ *
+ * Tests the event geometry cache of an event list, and checks that the
+ * IRF values that the CTA response computes from the cached event
+ * geometry are identical to the values for events outside an event list.
+ ***************************************************************************/
+void TestGCTAObservation::test_event_geometry(void)
+{
+    // Test cache access
+    GCTAEventList list;
+    for (int i = 0; i < 10; ++i) {
+        list.append(GCTAEventAtom());
+    }
+    std::vector<double> key(1, 1.0);
+    std::vector<double> values(20, 0.0);
+    values[14] = 7.0;
+    values[15] = 8.0;
+    double geo[2];
+    test_assert(!list.has_geometry(key), "Expected no geometry");
+    test_assert(!list.geometry(key, 7, geo), "Expected no geometry values");
+    list.geometry(key, values, 2);
+    test_assert(list.has_geometry(key), "Expected geometry");
+    test_assert(list.geometry(key, 7, geo), "Expected geometry values");
+    test_value(geo[0], 7.0, 1.0e-10, "First geometry value");
+    test_value(geo[1], 8.0, 1.0e-10, "Second geometry value");
+    test_assert(!list.geometry(key, 10, geo), "Expected no geometry values");
+    const double* ptr = list.geometry_values(7);
+    test_assert(ptr != NULL, "Expected geometry value pointer");
+    test_value(ptr[1], 8.0, 1.0e-10, "Second geometry value from pointer");
+    test_assert(list.geometry_values(10) == NULL, "Expected NULL pointer");
+    key[0] = 2.0;
+    test_assert(!list.has_geometry(key), "Expected no geometry for key");
+    list.geometry_clear();
+    key[0] = 1.0;
+    test_assert(!list.has_geometry(key), "Expected no geometry after clear");
+    list.geometry(key, values, 2);
+    const GCTAEventList& clist = list;
+    test_assert(clist[7] != NULL && list.has_geometry(key),
+                "Expected geometry after const event access");
+    list[7]->energy(GEnergy(2.0, "TeV"));
+    test_assert(!list.has_geometry(key),
+                "Expected no geometry after non-const event access");
+    list.geometry(key, values, 2);
+    list.append(GCTAEventAtom());
+    test_assert(!list.has_geometry(key), "Expected no geometry after append");
+
+    // Test response for a radial source
+    test_try("Test response for a radial source");
+    try {
+        // Setup event list around Crab
+        GSkyDir crab;
+        crab.radec_deg(83.6331, 22.0145);
+        GSkyDir pointing;
+        pointing.radec_deg(84.2, 22.3);
+        GCTAEventList events;
+        for (int i = 0; i < 5; ++i) {
+            GSkyDir dir;
+            dir.radec_deg(83.6331 + 0.05*i, 22.0145 - 0.03*i);
+            GCTAEventAtom event;
+            event.dir(GCTAInstDir(dir));
+            event.energy(GEnergy(0.5 + 0.5*i, "TeV"));
+            events.append(event);
+        }
+
+        // Setup observations with and without events
+        GCTAObservation obs;
+        obs.events(events);
+        obs.pointing(GCTAPointing(pointing));
+        obs.response(cta_irf, cta_caldb);
+        GCTAObservation ref;
+        ref.events(GCTAEventList());
+        ref.pointing(GCTAPointing(pointing));
+        ref.response(cta_irf, cta_caldb);
+
+        // Compare IRF values for free model parameters, which are not
+        // cached in the IRF cache
+        GModelSpatialRadialGauss model(crab, 0.2);
+        for (int i = 0; i < model.size(); ++i) {
+            model[i].free();
+        }
+        const GCTAEventList* list = static_cast<const GCTAEventList*>(obs.events());
+        for (int i = 0; i < list->size(); ++i) {
+            GCTAEventAtom event = *((*list)[i]);
+            GSource source("Crab", &model, event.energy(), event.time());
+            double irf      = obs.response().irf(*((*list)[i]), source, obs);
+            double expected = ref.response().irf(event, source, ref);
+            test_value(irf, expected, 1.0e-10, "IRF value from event geometry");
+        }
+
+        // Compare IRF values for geometry that was validated before the
+        // model evaluation
+        GModels models;
+        models.append(GModelSky(model, GModelSpectralConst()));
+        models[0]->name("Crab");
+        obs.response().set_source_caches(obs, models);
+        for (int i = 0; i < list->size(); ++i) {
+            GCTAEventAtom event = *((*list)[i]);
+            GSource source("Crab", &model, event.energy(), event.time());
+            double irf      = obs.response().irf(*((*list)[i]), source, obs);
+            double expected = ref.response().irf(event, source, ref);
+            test_value(irf, expected, 1.0e-10, "IRF value from validated geometry");
+        }
+        obs.response().clear_source_caches(obs);
+        test_try_success();
+    }
+    catch (std::exception &e) {
+        test_try_failure(e);
+    }
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Test columnar event storage
+ *
+ * Tests the conversion of an event list into columnar storage and back,
+ * the event views, the rejection of event modifications, the columns, the
+ * unpacking of auxiliary columns and appending of events in columnar mode.
+ ***************************************************************************/
+void TestGCTAObservation::test_columnar_events(void)
+{
+    // Setup event list
+    GCTAEventList list;
+    for (int i = 0; i < 50; ++i) {
+        GCTAInstDir dir;
+        dir.dir().radec_deg(83.0+0.01*i, 22.0-0.02*i);
+        GEnergy energy;
+        energy.TeV(0.1+0.2*i);
+        GTime time;
+        time.secs(10.0*i);
+        GCTAEventAtom atom;
+        atom.dir(dir);
+        atom.energy(energy);
+        atom.time(time);
+        atom.event_id(1000+i);
+        list.append(atom);
+    }
+
+    // Convert copy into columnar form
+    GCTAEventList columns(list);
+    columns.columnar(true);
+    test_assert(columns.columnar(), "Expected columnar storage");
+    test_value(columns.size(), 50, "Number of events in columnar storage");
+    test_value(int(columns.ra().size()), 50, "Size of Right Ascension column");
+    test_value(columns.dec()[10], 21.8*gammalib::deg2rad, 1.0e-10,
+               "Declination");
+    test_value(columns.log10TeV()[10], std::log10(2.1), 1.0e-10,
+               "log10 of energy");
+    test_value(columns.times()[10], 100.0, 1.0e-10, "Time");
+    test_value(columns.indices()[10], 10, "Index");
+
+    // Test event views
+    const GCTAEventList& ref = columns;
+    for (int i = 0; i < 50; i += 7) {
+        const GCTAEventAtom* view = ref[i];
+        const GCTAEventAtom* atom = list[i];
+        test_value(view->index(), i, "Index of view");
+        test_value(view->dir().dir().ra_deg(), atom->dir().dir().ra_deg(),
+                   1.0e-10, "Right Ascension of view");
+        test_value(view->dir().dir().dec_deg(), atom->dir().dir().dec_deg(),
+                   1.0e-10, "Declination of view");
+        test_value(view->energy().TeV(), atom->energy().TeV(), 1.0e-10,
+                   "Energy of view");
+        test_value(view->time().secs(), atom->time().secs(), 1.0e-10,
+                   "Time of view");
+        test_value(int(view->event_id()), 1000+i, "Event identifier of view");
+    }
+
+    // Test that modifying an event converts the events into event atoms
+    GCTAEventList modify(columns);
+    modify[0]->energy(GEnergy(1.0, "TeV"));
+    test_assert(!modify.columnar(), "Expected atom storage after modification");
+    test_value(modify.size(), 50, "Number of events after modification");
+    test_value(modify[0]->energy().TeV(), 1.0, 1.0e-10,
+               "Energy of modified event");
+    test_value(int(modify[0]->event_id()), 1000,
+               "Event identifier of modified event");
+    test_value(modify[10]->time().secs(), 100.0, 1.0e-10,
+               "Time of unmodified event");
+
+    // Test event views from nested parallel regions and from more threads
+    // than event views
+    #ifdef _OPENMP
+    int  max_levels = omp_get_max_active_levels();
+    int  errors     = 0;
+    omp_set_max_active_levels(2);
+    #pragma omp parallel num_threads(2) reduction(+:errors)
+    {
+        #pragma omp parallel num_threads(2) reduction(+:errors)
+        {
+            int offset = 2 * omp_get_ancestor_thread_num(1) +
+                         omp_get_thread_num();
+            for (int k = 0; k < 1000; ++k) {
+                int i = (k + offset) % 50;
+                if (ref[i]->index() != i ||
+                    std::abs(ref[i]->time().secs() - 10.0*i) > 1.0e-10) {
+                    errors++;
+                }
+            }
+        }
+    }
+    omp_set_max_active_levels(max_levels);
+    test_value(errors, 0, "Event views in nested parallel regions");
+    int nthreads = omp_get_num_procs() + 4;
+    errors       = 0;
+    #pragma omp parallel num_threads(nthreads) reduction(+:errors)
+    {
+        for (int i = omp_get_thread_num(); i < 50; i += omp_get_num_threads()) {
+            if (ref[i]->index() != i) {
+                errors++;
+            }
+        }
+    }
+    test_value(errors, 0, "Event views for additional threads");
+    #endif
+
+    // Test auxiliary column
+    test_value(columns.column("EVENT_ID")[20], 1020.0, 1.0e-10,
+               "Auxiliary column");
+    test_value(columns.column("HIL_MSW")[20], 0.0, 1.0e-10,
+               "Auxiliary column without data");
+    test_try("Invalid auxiliary column");
+    try {
+        columns.column("RA");
+        test_try_failure();
+    }
+    catch (GException::invalid_argument &e) {
+        test_try_success();
+    }
+    catch (std::exception &e) {
+        test_try_failure(e);
+    }
+
+    // Test appending in columnar mode
+    GCTAEventAtom atom(*list[3]);
+    columns.append(atom);
+    test_value(columns.size(), 51, "Number of events after append");
+    test_value(ref[50]->index(), 50, "Index of appended event");
+    test_value(ref[50]->energy().TeV(), atom.energy().TeV(), 1.0e-10,
+               "Energy of appended event");
+    test_value(int(ref[50]->event_id()), 1003,
+               "Event identifier of appended event");
+
+    // Convert back into atoms
+    columns.columnar(false);
+    test_assert(!columns.columnar(), "Expected atom storage");
+    test_value(columns.size(), 51, "Number of events in atom storage");
+    test_value(int(columns.ra().size()), 0, "Empty columns in atom storage");
+    test_value(columns[25]->energy().TeV(), list[25]->energy().TeV(), 1.0e-10,
+               "Energy after conversion back into atoms");
+    test_value(int(columns[25]->event_id()), 1025,
+               "Event identifier after conversion back into atoms");
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Test event column projection
+ *
+ * Tests loading of events with a column projection, the reading of
+ * projected out columns on request, and the column projection of an
+ * unbinned observation.
+ ***************************************************************************/
+void TestGCTAObservation::test_column_projection(void)
+{
+    // Test invalid column name
+    test_try("Invalid column in projection");
+    try {
+        GCTAEventList list;
+        std::vector<std::string> columns;
+        columns.push_back("NOT_A_COLUMN");
+        list.projection(columns);
+        test_try_failure();
+    }
+    catch (GException::invalid_argument &e) {
+        test_try_success();
+    }
+    catch (std::exception &e) {
+        test_try_failure(e);
+    }
+
+    // Test loading with column projection
+    test_try("Load events with column projection");
+    try {
+        // Load events in columnar form without and with projection
+        GCTAEventList full;
+        full.columnar(true);
+        full.load(cta_events);
+        GCTAEventList list;
+        std::vector<std::string> columns;
+        columns.push_back("TIME");
+        columns.push_back("detx");
+        list.load(cta_events, columns);
+
+        // Test projection
+        test_assert(list.projected(), "Expected column projection");
+        test_assert(list.columnar(), "Expected columnar storage");
+        test_value(int(list.projection().size()), 1, "Number of projected columns");
+        test_assert(list.projection()[0] == "DETX", "Expected DETX column");
+
+        // Test that projected and full events agree
+        test_value(list.size(), full.size(), "Number of events");
+        test_value(list.log10TeV()[100], full.log10TeV()[100], 1.0e-10,
+                   "Energy of event");
+        test_value(list.column("DETX")[100], full.column("DETX")[100], 1.0e-10,
+                   "Projected column");
+        test_value(list.column("DETY")[100], full.column("DETY")[100], 1.0e-10,
+                   "Column read on request");
+
+        // Test column projection of unbinned observation
+        GCTAObservation run;
+        run.load_unbinned(cta_events, columns);
+        const GCTAEventList* events = static_cast<const GCTAEventList*>(run.events());
+        test_assert(events->projected(), "Expected column projection of observation");
+        test_value(events->size(), full.size(), "Number of events in observation");
+
+        test_try_success();
+    }
+    catch (std::exception &e) {
+        test_try_failure(e);
+    }
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Test event stream
+ *
+ * Tests reading an event file in chunks with event selection, binning
+ * events into an event cube, and the likelihood of a streamed observation.
+ ***************************************************************************/
+void TestGCTAObservation::test_event_stream(void)
+{
+    // Test invalid chunk size
+    test_try("Invalid chunk size");
+    try {
+        GCTAEventStream stream;
+        stream.chunk_size(0);
+        test_try_failure();
+    }
+    catch (GException::invalid_argument &e) {
+        test_try_success();
+    }
+    catch (std::exception &e) {
+        test_try_failure(e);
+    }
+
+    // Set up event cube with two energy bins covering [0,100] s
+    GSkymap  map("CAR", "CEL", 83.63, 22.01, 0.1, 0.1, 10, 10, 2);
+    GEbounds ebounds;
+    ebounds.append(GEnergy(0.1, "TeV"), GEnergy(1.0, "TeV"));
+    ebounds.append(GEnergy(1.0, "TeV"), GEnergy(10.0, "TeV"));
+    GGti gti;
+    gti.append(GTime(0.0), GTime(100.0));
+    GCTAEventCube cube(map, ebounds, gti);
+
+    // Fill events into cube. Only the first two events are within the
+    // cube.
+    GSkyDir centre;
+    GSkyDir outside;
+    centre.radec_deg(83.63, 22.01);
+    outside.radec_deg(0.0, 0.0);
+    double energies[] = {0.5, 5.0, 20.0, 0.5, 0.5};
+    double times[]    = {10.0, 10.0, 10.0, 10.0, 200.0};
+    GCTAEventList list;
+    for (int i = 0; i < 5; ++i) {
+        GCTAEventAtom atom;
+        atom.dir(GCTAInstDir((i == 3) ? outside : centre));
+        atom.energy(GEnergy(energies[i], "TeV"));
+        atom.time(GTime(times[i]));
+        list.append(atom);
+    }
+    cube.fill(list);
+    int inx = cube.map().dir2inx(centre);
+    test_value(cube.map()(inx, 0), 1.0, 1.0e-10, "Counts in first energy bin");
+    test_value(cube.map()(inx, 1), 1.0, 1.0e-10, "Counts in second energy bin");
+    test_value(cube.number(), 2, "Number of binned events");
+
+    // Test streaming of event file
+    test_try("Stream events");
+    try {
+        // Load full event list
+        GCTAEventList full;
+        full.load(cta_events);
+
+        // Stream events in chunks and count events
+        GCTAEventStream stream(cta_events, 1000);
+        GCTAEventList   chunk;
+        int             nevents = 0;
+        int             nchunks = 0;
+        while (stream.next(chunk)) {
+            if (nchunks == 0) {
+                test_value(chunk[100]->energy().TeV(),
+                           full[100]->energy().TeV(), 1.0e-10,
+                           "Energy of streamed event");
+            }
+            nevents += chunk.size();
+            nchunks++;
+        }
+        test_value(stream.size(), full.size(), "Number of rows");
+        test_value(nevents, full.size(), "Number of streamed events");
+        test_value(nchunks, (full.size()+999)/1000, "Number of chunks");
+
+        // Stream events with event selection
+        GCTARoi roi(GCTAInstDir(centre), 1.0);
+        GEbounds selection;
+        selection.append(GEnergy(1.0, "TeV"), GEnergy(10.0, "TeV"));
+        int nselected = 0;
+        for (int i = 0; i < full.size(); ++i) {
+            if (roi.contains(*full[i]) && selection.contains(full[i]->energy())) {
+                nselected++;
+            }
+        }
+        stream.roi(roi);
+        stream.ebounds(selection);
+        stream.rewind();
+        nevents = 0;
+        while (stream.next(chunk)) {
+            nevents += chunk.size();
+        }
+        test_value(nevents, nselected, "Number of selected events");
+
+        // Test streamed unbinned observation
+        GCTAObservation run;
+        run.stream_unbinned(cta_events, 1000);
+        test_assert(run.stream().is_open(), "Expected event stream");
+        test_value(run.events()->size(), 1000, "Number of events in first chunk");
+
+        // Test that the streamed likelihood and gradient equal the
+        // likelihood and gradient of the event list held in memory
+        GCTAObservation mem;
+        mem.load_unbinned(cta_events);
+        mem.response(cta_irf, cta_caldb);
+        run.response(cta_irf, cta_caldb);
+        GModels       models(cta_model_xml);
+        int           npars = models.npars();
+        GVector       grad_mem(npars);
+        GVector       grad_run(npars);
+        GMatrixSparse curv_mem(npars, npars);
+        GMatrixSparse curv_run(npars, npars);
+        double        npred_mem = 0.0;
+        double        npred_run = 0.0;
+        double        logL_mem  = mem.likelihood(models, &grad_mem, &curv_mem,
+                                                 &npred_mem);
+        double        logL_run  = run.likelihood(models, &grad_run, &curv_run,
+                                                 &npred_run);
+        test_value(logL_run, logL_mem, 1.0e-6*std::abs(logL_mem),
+                   "Streamed likelihood");
+        test_value(npred_run, npred_mem, 1.0e-6*npred_mem, "Streamed Npred");
+        for (int i = 0; i < npars; ++i) {
+            test_value(grad_run[i], grad_mem[i],
+                       1.0e-6*std::abs(grad_mem[i])+1.0e-10,
+                       "Streamed gradient of parameter "+gammalib::str(i));
+        }
+        test_value(run.events()->size(), 1000,
+                   "Number of events in first chunk after likelihood");
+        double logL_again = run.likelihood(models, &grad_run, &curv_run,
+                                           &npred_run);
+        test_value(logL_again, logL_run, 1.0e-10*std::abs(logL_run),
+                   "Repeated streamed likelihood");
+
+        test_try_success();
+    }
+    catch (std::exception &e) {
+        test_try_failure(e);
+    }
+
+    // Return
+    return;
+}
+
+
 /***********************************************************************//**
  * @brief Test unbinned optimizer
  ***************************************************************************/
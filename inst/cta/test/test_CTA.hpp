@@ -53,6 +53,8 @@ public:
     void                      test_response_npsf(void);
     void                      test_response_irf_diffuse(void);
     void                      test_response_npred_diffuse(void);
+    void                      test_response_irf_gradients(void);
+    void                      test_response_compiled(void);
     void                      test_response(void);
 };
 
@@ -95,6 +97,13 @@ public:
     virtual TestGCTAObservation* clone(void) const;
     void                         test_unbinned_obs(void);
     void                         test_binned_obs(void);
+    void                         test_irf_cache(void);
+    void                         test_binned_irf_cache(void);
+    void                         test_binned_shared_map(void);
+    void                         test_event_geometry(void);
+    void                         test_columnar_events(void);
+    void                         test_column_projection(void);
+    void                         test_event_stream(void);
 };
 
 
@@ -30,6 +30,7 @@
 /* __ Includes ___________________________________________________________ */
 #include <string>
 #include <vector>
+#include <map>
 #include "GEventCube.hpp"
 #include "GLATInstDir.hpp"
 #include "GLATEventBin.hpp"
@@ -46,6 +47,14 @@
  * @class GLATEventCube
  *
  * @brief Fermi/LAT event cube class
+ *
+ * The event cube holds the counts map and the source maps that provide
+ * the diffuse response for the sources of the model. Source maps are
+ * identified by name through the diffindex() method, which returns the
+ * index of the source map without scanning all source map names. The
+ * energy node indices and weighting factors that are needed to interpolate
+ * the source maps at the mean energy of each energy layer are precomputed
+ * and can be accessed through the eweights() method.
  ***************************************************************************/
 class GLATEventCube : public GEventCube {
 
@@ -88,8 +97,10 @@ public:
     int               npix(void) const;
     int               ebins(void) const;
     int               ndiffrsp(void) const;
+    int               diffindex(const std::string& name) const;
     std::string       diffname(const int& index) const;
     GSkymap*          diffrsp(const int& index) const;
+    const GNodeArray::weights& eweights(const int& ieng) const;
     double            maxrad(const GSkyDir& dir) const;
 
 protected:
@@ -104,6 +115,7 @@ protected:
     void         set_directions(void);
     virtual void set_energies(void);
     virtual void set_times(void);
+    void         set_eweights(void);
     void         set_bin(const int& index);
 
     // Protected data area
@@ -117,7 +129,9 @@ protected:
     std::vector<GEnergy>     m_ewidth;       //!< Array of energy bin widths
     std::vector<GSkymap*>    m_srcmap;       //!< Pointers to source maps
     std::vector<std::string> m_srcmap_names; //!< Source map names
+    std::map<std::string,int> m_srcmap_index; //!< Source map indices
     GNodeArray               m_enodes;       //!< Energy nodes
+    std::vector<GNodeArray::weights> m_eweights; //!< Energy layer weights
 };
 
 
@@ -143,6 +157,7 @@ inline
 void GLATEventCube::enodes(const GNodeArray& enodes)
 {
     m_enodes = enodes;
+    set_eweights();
     return;
 }
 
@@ -267,4 +282,20 @@ int GLATEventCube::ndiffrsp(void) const
     return m_srcmap.size();
 }
 
+
+/***********************************************************************//**
+ * @brief Return energy node weights of energy layer
+ *
+ * @param[in] ieng Energy layer index [0,...,ebins()-1].
+ * @return Energy node indices and weighting factors.
+ *
+ * Returns the energy node indices and weighting factors for the mean
+ * energy of an energy layer. The index is not checked for validity.
+ ***************************************************************************/
+inline
+const GNodeArray::weights& GLATEventCube::eweights(const int& ieng) const
+{
+    return m_eweights[ieng];
+}
+
 #endif /* GLATEVENTCUBE_HPP */
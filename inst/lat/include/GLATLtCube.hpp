@@ -70,6 +70,7 @@ public:
     // Methods
     void        clear(void);
     GLATLtCube* clone(void) const;
+    int         pixel(const GSkyDir& dir) const;
     void        load(const std::string& filename);
     void        save(const std::string& filename,
                      const bool& clobber=false) const;
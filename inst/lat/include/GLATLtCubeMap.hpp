@@ -78,6 +78,7 @@ public:
     double         costheta(const int& index) const;
     double         phi(const int& index) const;
     const double&  costhetamin(void) const;
+    int            pixel(const GSkyDir& dir) const;
     std::string    costhetabin(void) const;
     std::string    print(const GChatter& chatter = NORMAL) const;
 
@@ -143,4 +144,20 @@ const double& GLATLtCubeMap::costhetamin(void) const
     return m_min_ctheta;
 }
 
+
+/***********************************************************************//**
+ * @brief Return livetime cube map pixel for sky direction
+ *
+ * @param[in] dir Sky direction.
+ * @return Pixel index.
+ *
+ * Returns the index of the livetime cube map pixel that is used for the
+ * evaluation of the livetime cube at the sky direction @p dir.
+ ***************************************************************************/
+inline
+int GLATLtCubeMap::pixel(const GSkyDir& dir) const
+{
+    return (m_map.dir2pix(dir));
+}
+
 #endif /* GLATLTCUBEMAP_HPP */
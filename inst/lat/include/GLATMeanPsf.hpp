@@ -36,6 +36,7 @@
 
 /* __ Forward declarations _______________________________________________ */
 class GLATObservation;
+class GLATResponse;
 
 
 /***********************************************************************//**
@@ -66,6 +67,10 @@ public:
     GLATMeanPsf*       clone(void) const;
     int                size(void) const;
     void               set(const GSkyDir& dir, const GLATObservation& obs);
+    void               set(const GSkyDir& dir, const GLATObservation& obs,
+                           const GLATResponse& rsp);
+    void               set(const GSkyDir& dir, const GLATObservation& obs,
+                           const GLATMeanPsf& psf);
     int                noffsets(void) const;
     int                nenergies(void) const;
     const double&      offset(const int& inx) const;
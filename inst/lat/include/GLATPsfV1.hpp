@@ -71,6 +71,9 @@ private:
     void          copy_members(const GLATPsfV1& psf);
     void          free_members(void);
     static double base_fct(const double& u, const double& gamma);
+    static double base_index(const double& gamma);
+    static double base_value(const double& u, const double& gamma,
+                             const double& norm);
     static double base_int(const double& u, const double& gamma);
 
     // Integrand class. This class is used to perform the radial
@@ -80,21 +83,33 @@ private:
     public:
         base_integrand(double ncore, double ntail, double sigma,
                        double gcore, double gtail) :
-                       m_ncore(ncore), m_ntail(ntail), m_sigma(sigma),
-                       m_gcore(gcore), m_gtail(gtail) { }
+                       m_sigma(sigma),
+                       m_gcore(base_index(gcore)),
+                       m_gtail(base_index(gtail)),
+                       m_fcore(ncore * (1.0 - 1.0/m_gcore)),
+                       m_ftail(ntail * (1.0 - 1.0/m_gtail)) { }
         double eval(const double& x) {
+            return value(x);
+        }
+        void eval(const double* x, double* y, const int& n) {
+            for (int i = 0; i < n; ++i) {
+                y[i] = value(x[i]);
+            }
+            return;
+        }
+    private:
+        double value(const double& x) const {
             double r = x / m_sigma;
             double u = 0.5 * r * r;
-            double f = m_ncore * base_fct(u, m_gcore) +
-                       m_ntail * base_fct(u, m_gtail);
+            double f = base_value(u, m_gcore, m_fcore) +
+                       base_value(u, m_gtail, m_ftail);
             return (f*std::sin(x));
         }
-    private:
-        double m_ncore;
-        double m_ntail;
         double m_sigma;
         double m_gcore;
         double m_gtail;
+        double m_fcore;
+        double m_ftail;
     };
 
     // Protected members
@@ -116,4 +131,40 @@ int GLATPsfV1::version(void) const
     return 1;
 }
 
+
+/***********************************************************************//**
+ * @brief Return index used in point spread base function
+ *
+ * @param[in] gamma Index.
+ * @return Index, with the special case gamma==1 replaced by 1.001.
+ *
+ * The special case of gamma==1 is a ugly kluge because of sloppy
+ * programming in handoff response when setting boundaries of fit
+ * parameters for the PSF.
+ ***************************************************************************/
+inline
+double GLATPsfV1::base_index(const double& gamma)
+{
+    return ((gamma == 1) ? 1.001 : gamma);
+}
+
+
+/***********************************************************************//**
+ * @brief Return scaled point spread base function value
+ *
+ * @param[in] u Function argument.
+ * @param[in] gamma Index (see base_index()).
+ * @param[in] norm Normalisation.
+ * @return Scaled point spread base function value.
+ *
+ * Returns
+ * \f[norm \left(1 + \frac{u}{\Gamma} \right)^{-\Gamma}\f]
+ ***************************************************************************/
+inline
+double GLATPsfV1::base_value(const double& u, const double& gamma,
+                              const double& norm)
+{
+    return (norm * std::pow(1.0 + u/gamma, -gamma));
+}
+
 #endif /* GLATPSFV1_HPP */
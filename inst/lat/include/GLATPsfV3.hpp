@@ -75,6 +75,9 @@ private:
     void          copy_members(const GLATPsfV3& psf);
     void          free_members(void);
     static double base_fct(const double& u, const double& gamma);
+    static double base_index(const double& gamma);
+    static double base_value(const double& u, const double& gamma,
+                             const double& norm);
     static double base_int(const double& u, const double& gamma);
     double        eval_psf(const double& offset, const double& energy,
                            const int& index);
@@ -89,25 +92,38 @@ private:
         base_integrand(double ncore, double ntail,
                        double score, double stail,
                        double gcore, double gtail) :
-                       m_ncore(ncore), m_ntail(ntail),
                        m_score(score), m_stail(stail),
-                       m_gcore(gcore), m_gtail(gtail) { }
+                       m_gcore(base_index(gcore)),
+                       m_gtail(base_index(gtail)),
+                       m_fcore(1.0 - 1.0/m_gcore),
+                       m_ftail(ntail * (1.0 - 1.0/m_gtail)),
+                       m_norm(ncore) { }
         double eval(const double& x) {
+            return value(x);
+        }
+        void eval(const double* x, double* y, const int& n) {
+            for (int i = 0; i < n; ++i) {
+                y[i] = value(x[i]);
+            }
+            return;
+        }
+    private:
+        double value(const double& x) const {
             double rc = x / m_score;
             double uc = 0.5 * rc * rc;
             double rt = x / m_stail;
             double ut = 0.5 * rt * rt;
-            double f = m_ncore * (base_fct(uc, m_gcore) + 
-                                  m_ntail * base_fct(ut, m_gtail));
+            double f  = m_norm * (base_value(uc, m_gcore, m_fcore) +
+                                  base_value(ut, m_gtail, m_ftail));
             return (f*std::sin(x));
         }
-    private:
-        double m_ncore;
-        double m_ntail;
         double m_score;
         double m_stail;
         double m_gcore;
         double m_gtail;
+        double m_fcore;
+        double m_ftail;
+        double m_norm;
     };
     
     // Protected members
@@ -131,4 +147,40 @@ int GLATPsfV3::version(void) const
     return 3;
 }
 
+
+/***********************************************************************//**
+ * @brief Return index used in point spread base function
+ *
+ * @param[in] gamma Index.
+ * @return Index, with the special case gamma==1 replaced by 1.001.
+ *
+ * The special case of gamma==1 is a ugly kluge because of sloppy
+ * programming in handoff response when setting boundaries of fit
+ * parameters for the PSF.
+ ***************************************************************************/
+inline
+double GLATPsfV3::base_index(const double& gamma)
+{
+    return ((gamma == 1) ? 1.001 : gamma);
+}
+
+
+/***********************************************************************//**
+ * @brief Return scaled point spread base function value
+ *
+ * @param[in] u Function argument.
+ * @param[in] gamma Index (see base_index()).
+ * @param[in] norm Normalisation.
+ * @return Scaled point spread base function value.
+ *
+ * Returns
+ * \f[norm \left(1 + \frac{u}{\Gamma} \right)^{-\Gamma}\f]
+ ***************************************************************************/
+inline
+double GLATPsfV3::base_value(const double& u, const double& gamma,
+                              const double& norm)
+{
+    return (norm * std::pow(1.0 + u/gamma, -gamma));
+}
+
 #endif /* GLATPSFV3_HPP */
@@ -30,6 +30,7 @@
 /* __ Includes ___________________________________________________________ */
 #include <vector>
 #include <string>
+#include <map>
 #include "GLATEventAtom.hpp"
 #include "GLATEventBin.hpp"
 #include "GLATAeff.hpp"
@@ -41,11 +42,26 @@
 #include "GObservation.hpp"
 #include "GResponse.hpp"
 
+/* __ Forward declarations _______________________________________________ */
+class GModels;
+class GModelSpatial;
+class GLATObservation;
+
 
 /***********************************************************************//**
  * @class GLATResponse
  *
  * @brief Fermi/LAT Response class
+ *
+ * The response holds a mean PSF for each point source for which the
+ * response of an event bin was requested. Mean PSFs are identified by the
+ * source name and can be accessed through an integer handle that is
+ * returned by ptsrc_handle(). The precompute_psfs() method computes the
+ * mean PSFs for all point sources of a model container before a fit, so
+ * that the response computation does not need to allocate mean PSFs on
+ * the fly. The set_source_caches() method resolves the mean PSF handles
+ * and the source map indices of all sources once before the event bins of
+ * a model evaluation are computed.
  ***************************************************************************/
 class GLATResponse : public GResponse {
 
@@ -73,7 +89,11 @@ public:
     // Implemented virtual methods
     virtual double irf(const GEvent&       event,
                        const GSource&      source,
-                       const GObservation& obs) const;
+                       const GObservation& obs,
+                       const bool&         grad = false) const;
+    virtual void   set_source_caches(const GObservation& obs,
+                                     const GModels&      models) const;
+    virtual void   clear_source_caches(const GObservation& obs) const;
 
     // Other Methods
     int                size(void) const;
@@ -87,6 +107,10 @@ public:
     GLATAeff*          aeff(const int& index) const;
     GLATPsf*           psf(const int& index) const;
     GLATEdisp*         edisp(const int& index) const;
+    void               precompute_psfs(const GModels&         models,
+                                       const GLATObservation& obs);
+    int                ptsrc_handle(const std::string& name) const;
+    const GLATMeanPsf& ptsrc(const int& handle) const;
 
     // Reponse methods
     double irf(const GLATEventAtom& event,
@@ -101,6 +125,8 @@ private:
     void init_members(void);
     void copy_members(const GLATResponse& rsp);
     void free_members(void);
+    int  add_ptsrc(GLATMeanPsf* psf);
+    int  source_index(const GSource& source) const;
 
     // Private members
     std::string               m_caldb;      //!< Name of or path to the calibration database
@@ -112,6 +138,13 @@ private:
     std::vector<GLATPsf*>     m_psf;        //!< Point spread functions
     std::vector<GLATEdisp*>   m_edisp;      //!< Energy dispersions
     std::vector<GLATMeanPsf*> m_ptsrc;      //!< Mean PSFs for point sources
+    std::map<std::string,int> m_ptsrc_handles; //!< Mean PSF handles
+
+    // Source caches of current model evaluation (see set_source_caches())
+    mutable bool                              m_src_set;    //!< Caches set
+    mutable std::vector<const GModelSpatial*> m_src_models; //!< Spatial models
+    mutable std::vector<int>                  m_src_ptsrc;  //!< Mean PSF handles
+    mutable std::vector<int>                  m_src_diff;   //!< Source map indices
 };
 
 
@@ -199,4 +232,18 @@ void GLATResponse::force_mean(const bool& value)
     return;
 }
 
+
+/***********************************************************************//**
+ * @brief Return mean PSF handle for a source
+ *
+ * @param[in] name Source name.
+ * @return Mean PSF handle (-1 if no mean PSF exists for the source).
+ ***************************************************************************/
+inline
+int GLATResponse::ptsrc_handle(const std::string& name) const
+{
+    std::map<std::string,int>::const_iterator it = m_ptsrc_handles.find(name);
+    return ((it != m_ptsrc_handles.end()) ? it->second : -1);
+}
+
 #endif /* GLATRESPONSE_HPP */
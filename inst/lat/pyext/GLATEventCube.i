@@ -69,6 +69,7 @@ public:
     int               npix(void) const;
     int               ebins(void) const;
     int               ndiffrsp(void) const;
+    int               diffindex(const std::string& name) const;
     std::string       diffname(const int& index) const;
     GSkymap*          diffrsp(const int& index) const;
     double            maxrad(const GSkyDir& dir) const;
@@ -55,7 +55,8 @@ public:
     // Implemented virtual methods
     virtual double irf(const GEvent&       event,
                        const GSource&      source,
-                       const GObservation& obs) const;
+                       const GObservation& obs,
+                       const bool&         grad = false) const;
 
     // Other Methods
     int                size(void) const;
@@ -69,6 +70,10 @@ public:
     GLATAeff*          aeff(const int& index) const;
     GLATPsf*           psf(const int& index) const;
     GLATEdisp*         edisp(const int& index) const;
+    void               precompute_psfs(const GModels&         models,
+                                       const GLATObservation& obs);
+    int                ptsrc_handle(const std::string& name) const;
+    const GLATMeanPsf& ptsrc(const int& handle) const;
 
     // Reponse methods
     double irf(const GLATEventAtom& event,
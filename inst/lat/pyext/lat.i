@@ -56,6 +56,7 @@
 %import(module="gammalib.obs") "GResponse.i";
 %import(module="gammalib.obs") "GInstDir.i";
 %import(module="gammalib.obs") "GRoi.i";
+%import(module="gammalib.model") "GModels.i";
 
 /* __ LAT ________________________________________________________________ */
 %include "GLATAeff.i"
@@ -408,8 +408,11 @@ int GLATEventCube::number(void) const
  ***************************************************************************/
 void GLATEventCube::map(const GSkymap& map)
 {
-    // Store sky map
+    // Store sky map. The event bin references the sky map pixels, hence
+    // the event cube needs its own double precision pixels.
     m_map = map;
+    m_map.shared_pixels(false);
+    m_map.float_pixels(false);
 
     // Compute sky directions
     set_directions();
@@ -492,6 +495,25 @@ std::string GLATEventCube::print(const GChatter& chatter) const
 }
 
 
+/***********************************************************************//**
+ * @brief Return index of diffuse model
+ *
+ * @param[in] name Name of diffuse model.
+ * @return Diffuse model index (-1 if no source map exists for the model).
+ *
+ * Returns the index of the source map of a diffuse model. The index can
+ * be used to access the source map through diffrsp().
+ ***************************************************************************/
+int GLATEventCube::diffindex(const std::string& name) const
+{
+    // Search source map index
+    std::map<std::string,int>::const_iterator it = m_srcmap_index.find(name);
+
+    // Return index
+    return ((it != m_srcmap_index.end()) ? it->second : -1);
+}
+
+
 /***********************************************************************//**
  * @brief Return name of diffuse model
  *
@@ -620,7 +642,9 @@ void GLATEventCube::init_members(void)
     m_time.clear();
     m_srcmap.clear();
     m_srcmap_names.clear();
+    m_srcmap_index.clear();
     m_enodes.clear();
+    m_eweights.clear();
     m_dirs.clear();
     m_solidangle.clear();
     m_energies.clear(); 
@@ -645,6 +669,7 @@ void GLATEventCube::copy_members(const GLATEventCube& cube)
     m_time         = cube.m_time;
     m_ontime       = cube.m_ontime;
     m_enodes       = cube.m_enodes;
+    m_eweights     = cube.m_eweights;
     m_dirs         = cube.m_dirs;
     m_solidangle   = cube.m_solidangle;
     m_energies     = cube.m_energies;
@@ -656,6 +681,7 @@ void GLATEventCube::copy_members(const GLATEventCube& cube)
         m_srcmap.push_back(cube.m_srcmap[i]->clone());
     }
     m_srcmap_names = cube.m_srcmap_names;
+    m_srcmap_index = cube.m_srcmap_index;
 
     // Return
     return;
@@ -674,6 +700,7 @@ void GLATEventCube::free_members(void)
     }
     m_srcmap.clear();
     m_srcmap_names.clear();
+    m_srcmap_index.clear();
 
     // Return
     return;
@@ -713,6 +740,7 @@ void GLATEventCube::read_cntmap(const GFitsImage& hdu)
  *
  * This method reads a LAT source map from a FITS image. The source map is
  * stored in a GSkymap object and is given in units of counts/pixel/MeV.
+ * The source map pixels are shared between copies of the event cube.
  ***************************************************************************/
 void GLATEventCube::read_srcmap(const GFitsImage& hdu)
 {
@@ -740,7 +768,12 @@ void GLATEventCube::read_srcmap(const GFitsImage& hdu)
         throw GLATException::wcs_incompatible(G_READ_SRCMAP, hdu.extname());
     }
 
-    // Append source map to list of maps
+    // Share source map pixels between copies of the event cube since
+    // source maps are not modified
+    map->shared_pixels(true);
+
+    // Append source map to list of maps and register its index
+    m_srcmap_index[hdu.extname()] = m_srcmap.size();
     m_srcmap.push_back(map);
     m_srcmap_names.push_back(hdu.extname());
 
@@ -802,6 +835,7 @@ void GLATEventCube::read_gti(const GFitsTable& hdu)
  * This method computes the sky directions and solid angles for all event
  * cube pixels. Sky directions are stored in an array of GLATInstDir objects
  * while solid angles are stored in units of sr in a double precision array.
+ * The sky directions are computed in a single batched transformation.
  ***************************************************************************/
 void GLATEventCube::set_directions(void)
 {
@@ -819,15 +853,22 @@ void GLATEventCube::set_directions(void)
     m_dirs.reserve(npix());
     m_solidangle.reserve(npix());
 
-    // Set pixel directions and solid angles
+    // Set sky map pixels
+    std::vector<GSkyPixel> pixels;
+    pixels.reserve(npix());
     for (int iy = 0; iy < ny(); ++iy) {
         for (int ix = 0; ix < nx(); ++ix) {
-            GSkyPixel pixel = GSkyPixel(double(ix), double(iy));
-            m_dirs.push_back(GLATInstDir(m_map.pix2dir(pixel)));
-            m_solidangle.push_back(m_map.solidangle(pixel));
+            pixels.push_back(GSkyPixel(double(ix), double(iy)));
         }
     }
 
+    // Set pixel directions and solid angles
+    std::vector<GSkyDir> dirs = m_map.pix2dir(pixels);
+    for (int i = 0; i < pixels.size(); ++i) {
+        m_dirs.push_back(GLATInstDir(dirs[i]));
+        m_solidangle.push_back(m_map.solidangle(pixels[i]));
+    }
+
     // Return
     return;
 }
@@ -867,12 +908,44 @@ void GLATEventCube::set_energies(void)
         m_enodes.append(log10(ebounds().emin(i).MeV()));
     }
     m_enodes.append(log10(ebounds().emax(ebins()-1).MeV()));
+
+    // Set energy node weights of energy layers
+    set_eweights();
     
     // Return
     return;
 }
 
 
+/***********************************************************************//**
+ * @brief Set energy node weights of energy layers
+ *
+ * Computes for the log mean energy of each energy layer the indices and
+ * weighting factors of the energy nodes, so that the source maps can be
+ * interpolated without searching the energy nodes. No weights are set if
+ * less than two energy nodes exist.
+ ***************************************************************************/
+void GLATEventCube::set_eweights(void)
+{
+    // Clear weights
+    m_eweights.clear();
+
+    // Continue only if there are at least two energy nodes
+    if (m_enodes.size() > 1) {
+
+        // Set weights for all energy layers
+        m_eweights.reserve(m_energies.size());
+        for (int i = 0; i < m_energies.size(); ++i) {
+            m_eweights.push_back(m_enodes.lookup(m_energies[i].log10MeV()));
+        }
+
+    } // endif: there were at least two energy nodes
+
+    // Return
+    return;
+}
+
+
 /***********************************************************************//**
  * @brief Set mean event time and ontime of event cube.
  *
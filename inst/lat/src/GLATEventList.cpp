@@ -29,6 +29,8 @@
 #include <config.h>
 #endif
 #include <cstdio>             // std::sprintf
+#include <algorithm>          // std::min
+#include <vector>
 #include "GException.hpp"
 #include "GTools.hpp"
 #include "GLATEventList.hpp"
@@ -39,6 +41,9 @@
 #include "GFitsTableLongCol.hpp"
 #include "GFitsTableShortCol.hpp"
 
+/* __ Constants __________________________________________________________ */
+const int g_lat_read_block = 100000;  //!< Number of rows read per block
+
 /* __ Method name definitions ____________________________________________ */
 #define G_OPERATOR                          "GLATEventList::operator[](int&)"
 #define G_ROI                                     "GLATEventList::roi(GRoi&)"
@@ -476,7 +481,8 @@ void GLATEventList::free_members(void)
  *
  * @param[in] table Event table.
  *
- * Read the LAT events from the event table.
+ * Read the LAT events from the event table. The columns are read in blocks
+ * of rows using GFitsTableCol::read_range().
  ***************************************************************************/
 void GLATEventList::read_events(const GFitsTable& table)
 {
@@ -512,27 +518,70 @@ void GLATEventList::read_events(const GFitsTable& table)
         const GFitsTableCol* ptr_conv    = table["CONVERSION_TYPE"];
         const GFitsTableCol* ptr_ltime   = table["LIVETIME"];
 
+        // Allocate block buffers
+        int                    block = std::min(num, g_lat_read_block);
+        std::vector<double>    time(block);
+        std::vector<double>    energy(block);
+        std::vector<double>    ra(block);
+        std::vector<double>    dec(block);
+        std::vector<float>     theta(block);
+        std::vector<float>     phi(block);
+        std::vector<float>     zenith(block);
+        std::vector<float>     azimuth(block);
+        std::vector<long long> eid(block);
+        std::vector<long long> rid(block);
+        std::vector<long long> recon(block);
+        int                    ncalib = ptr_calib->number();
+        std::vector<long long> calib(ncalib*block);
+        std::vector<long long> evclass(block);
+        std::vector<long long> conv(block);
+        std::vector<double>    ltime(block);
+
         // Copy data from columns into GLATEventAtom objects
         GLATEventAtom event;
-        for (int i = 0; i < num; ++i) {
-            event.m_time.set(ptr_time->real(i), m_gti.reference());
-            event.m_energy.MeV(ptr_energy->real(i));
-            event.m_dir.dir().radec_deg(ptr_ra->real(i), ptr_dec->real(i));
-            event.m_theta               = ptr_theta->real(i);
-            event.m_phi                 = ptr_phi->real(i);
-            event.m_zenith_angle        = ptr_zenith->real(i);
-            event.m_earth_azimuth_angle = ptr_azimuth->real(i);
-            event.m_event_id            = ptr_eid->integer(i);
-            event.m_run_id              = ptr_rid->integer(i);
-            event.m_recon_version       = ptr_recon->integer(i);
-            event.m_calib_version[0]    = ptr_calib->integer(i,0);
-            event.m_calib_version[1]    = ptr_calib->integer(i,1);
-            event.m_calib_version[2]    = ptr_calib->integer(i,2);
-            event.m_event_class         = ptr_class->integer(i);
-            event.m_conversion_type     = ptr_conv->integer(i);
-            event.m_livetime            = ptr_ltime->real(i);
-            m_events.push_back(event);
-        }
+        for (int first = 0; first < num; first += block) {
+
+            // Read block of rows
+            int nrows = std::min(block, num-first);
+            ptr_time->read_range(first, nrows, &time[0]);
+            ptr_energy->read_range(first, nrows, &energy[0]);
+            ptr_ra->read_range(first, nrows, &ra[0]);
+            ptr_dec->read_range(first, nrows, &dec[0]);
+            ptr_theta->read_range(first, nrows, &theta[0]);
+            ptr_phi->read_range(first, nrows, &phi[0]);
+            ptr_zenith->read_range(first, nrows, &zenith[0]);
+            ptr_azimuth->read_range(first, nrows, &azimuth[0]);
+            ptr_eid->read_range(first, nrows, &eid[0]);
+            ptr_rid->read_range(first, nrows, &rid[0]);
+            ptr_recon->read_range(first, nrows, &recon[0]);
+            ptr_calib->read_range(first, nrows, &calib[0]);
+            ptr_class->read_range(first, nrows, &evclass[0]);
+            ptr_conv->read_range(first, nrows, &conv[0]);
+            ptr_ltime->read_range(first, nrows, &ltime[0]);
+
+            // Set events
+            for (int i = 0; i < nrows; ++i) {
+                event.m_time.set(time[i], m_gti.reference());
+                event.m_energy.MeV(energy[i]);
+                event.m_dir.dir().radec_deg(ra[i], dec[i]);
+                event.m_theta               = theta[i];
+                event.m_phi                 = phi[i];
+                event.m_zenith_angle        = zenith[i];
+                event.m_earth_azimuth_angle = azimuth[i];
+                event.m_event_id            = long(eid[i]);
+                event.m_run_id              = long(rid[i]);
+                event.m_recon_version       = short(recon[i]);
+                for (int k = 0; k < 3; ++k) {
+                    event.m_calib_version[k] = (k < ncalib)
+                                               ? short(calib[ncalib*i+k]) : 0;
+                }
+                event.m_event_class         = short(evclass[i]);
+                event.m_conversion_type     = short(conv[i]);
+                event.m_livetime            = ltime[i];
+                m_events.push_back(event);
+            }
+
+        } // endfor: looped over blocks
 
         // Extract number of diffuse response labels
         int num_difrsp = table.integer("NDIFRSP");
@@ -566,8 +615,10 @@ void GLATEventList::read_events(const GFitsTable& table)
                 const GFitsTableCol* ptr_dif = table[std::string(keyword)];
 
                 // Copy data from columns into GLATEventAtom objects
+                std::vector<double> values(num);
+                ptr_dif->read_range(0, num, &values[0]);
                 for (int i = 0; i < num; ++i) {
-                    m_events[i].m_difrsp[k] = ptr_dif->real(i);
+                    m_events[i].m_difrsp[k] = values[i];
                 }
 
             } // endfor: looped over diffuse columns
@@ -376,6 +376,25 @@ GLATLtCube* GLATLtCube::clone(void) const
 }
 
 
+/***********************************************************************//**
+ * @brief Return livetime cube pixel for sky direction
+ *
+ * @param[in] dir Sky direction.
+ * @return Pixel index.
+ *
+ * Returns the index of the livetime cube pixel that is used for the
+ * evaluation of the livetime cube at the sky direction @p dir. The
+ * livetime cube is evaluated at the pixel that contains the sky direction,
+ * hence all sky directions within the same pixel have the same exposure.
+ * The exposure and the weighted exposure share the same pixelisation.
+ ***************************************************************************/
+int GLATLtCube::pixel(const GSkyDir& dir) const
+{
+    // Return pixel
+    return (m_exposure.pixel(dir));
+}
+
+
 /***********************************************************************//**
  * @brief Load livetime cube from FITS file
  *
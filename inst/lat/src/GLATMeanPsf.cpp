@@ -39,7 +39,7 @@
 #include "GLATException.hpp"
 
 /* __ Method name definitions ____________________________________________ */
-#define G_SET                  "GLATMeanPsf::set(GSkyDir&, GLATObservation&)"
+#define G_SET     "GLATMeanPsf::set(GSkyDir&, GLATObservation&, GLATResponse&)"
 #define G_EXPOSURE                              "GLATMeanPsf::exposure(int&)"
 
 /* __ Macros _____________________________________________________________ */
@@ -295,14 +295,43 @@ GLATMeanPsf* GLATMeanPsf::clone(void) const
  * at which the mean PSF is computed.
  ***************************************************************************/
 void GLATMeanPsf::set(const GSkyDir& dir, const GLATObservation& obs)
+{
+    // Compute mean PSF using the response of the observation
+    set(dir, obs, obs.response());
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Compute mean PSF and exposure using a specific response
+ *
+ * @param[in] dir Source location.
+ * @param[in] obs LAT observation.
+ * @param[in] rsp LAT response.
+ *
+ * @exception GLATException::no_ltcube
+ *            Livetime cube has not been defined.
+ *
+ * Computes the mean PSF and the energy dependent exposure for a source at
+ * a given sky location using the response @p rsp instead of the response
+ * of the observation. Since the evaluation of the response functions is
+ * not thread safe, this allows to compute mean PSFs in parallel using one
+ * copy of the response per thread.
+ ***************************************************************************/
+void GLATMeanPsf::set(const GSkyDir&         dir,
+                      const GLATObservation& obs,
+                      const GLATResponse&    rsp)
 {
     // Clear PSF, exposure and energy arrays
     m_psf.clear();
     m_exposure.clear();
     m_energy.clear();
 
-    // Get pointers on response, livetime cube and energy boundaries
-    const GLATResponse& rsp = obs.response();
+    // Reset interpolation cache
+    m_last_energy = -1.0;
+    m_last_offset = -1.0;
 
     // Get pointer on livetime cube
     const GLATLtCube* ltcube = obs.ltcube();
@@ -386,6 +415,48 @@ void GLATMeanPsf::set(const GSkyDir& dir, const GLATObservation& obs)
 }
 
 
+/***********************************************************************//**
+ * @brief Set mean PSF from the tables of another mean PSF
+ *
+ * @param[in] dir Source location.
+ * @param[in] obs LAT observation.
+ * @param[in] psf Mean PSF.
+ *
+ * Sets the mean PSF for a source at a given sky location by copying the
+ * PSF and exposure tables of the mean PSF @p psf. The livetime cube is
+ * evaluated at the pixel that contains the source location, hence the
+ * tables are identical for all source locations that fall into the same
+ * livetime cube pixel (see GLATLtCube::pixel()). The mean PSF @p psf needs
+ * to be computed for the same observation and for a source location in
+ * the same livetime cube pixel. Only the map corrections, which depend on
+ * the source location, are computed.
+ ***************************************************************************/
+void GLATMeanPsf::set(const GSkyDir&         dir,
+                      const GLATObservation& obs,
+                      const GLATMeanPsf&     psf)
+{
+    // Copy PSF and exposure tables
+    m_psf       = psf.m_psf;
+    m_exposure  = psf.m_exposure;
+    m_energy    = psf.m_energy;
+    m_offset    = psf.m_offset;
+    m_theta_max = psf.m_theta_max;
+
+    // Reset interpolation cache
+    m_last_energy = -1.0;
+    m_last_offset = -1.0;
+
+    // Store source direction
+    m_dir = dir;
+
+    // Compute map corrections
+    set_map_corrections(obs);
+
+    // Return
+    return;
+}
+
+
 /***********************************************************************//**
  * @brief Return mean PSF value
  *
@@ -536,6 +536,40 @@ std::string GLATObservation::print(const GChatter& chatter) const
 }
 
 
+/***********************************************************************//**
+ * @brief Compute likelihood function
+ *
+ * @param[in] models Models.
+ * @param[in,out] gradient Pointer to gradients.
+ * @param[in,out] curvature Pointer to curvature matrix.
+ * @param[in,out] npred Pointer to Npred value.
+ * @return Likelihood.
+ *
+ * Precomputes the mean PSFs of all point sources before computing the
+ * likelihood function using GObservation::likelihood(). This avoids the
+ * allocation of mean PSFs during the event loop, and makes sure that the
+ * working copies of the observation that are used for the parallel event
+ * loop share the precomputed mean PSFs.
+ ***************************************************************************/
+double GLATObservation::likelihood(const GModels& models,
+                                   GVector*       gradient,
+                                   GMatrixSparse* curvature,
+                                   double*        npred) const
+{
+    // Precompute mean PSFs if events and livetime cube are available
+    // (circumvent const correctness)
+    if (m_events != NULL && m_ltcube != NULL) {
+        const_cast<GLATResponse&>(m_response).precompute_psfs(models, *this);
+    }
+
+    // Compute likelihood function
+    double value = GObservation::likelihood(models, gradient, curvature, npred);
+
+    // Return likelihood
+    return value;
+}
+
+
 /***********************************************************************//**
  * @brief Load data for unbinned analysis
  *
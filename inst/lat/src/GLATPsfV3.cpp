@@ -473,12 +473,9 @@ void GLATPsfV3::free_members(void)
  ***************************************************************************/
 double GLATPsfV3::base_fct(const double& u, const double& gamma)
 {
-    // Get base function value. The special case of gamma==1 is a ugly
-    // kluge because of sloppy programming in handoff response when
-    // setting boundaries of fit parameters for the PSF.
-    double base = (gamma == 1)
-                  ? (1.0 - 1.0/1.001) * std::pow(1.0 + u/1.001, -1.001)
-                  : (1.0 - 1.0/gamma) * std::pow(1.0 + u/gamma, -gamma);
+    // Get base function value
+    double index = base_index(gamma);
+    double base  = base_value(u, index, 1.0 - 1.0/index);
 
     // Return base function
     return base;
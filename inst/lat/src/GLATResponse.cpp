@@ -31,10 +31,13 @@
 #include <unistd.h>           // access() function
 #include <cstdlib>            // std::getenv() function
 #include <string>
+#include <map>
 #include "GException.hpp"
 #include "GFits.hpp"
 #include "GTools.hpp"
 #include "GCaldb.hpp"
+#include "GModels.hpp"
+#include "GModelSky.hpp"
 #include "GModelSpatialPointSource.hpp"
 #include "GLATInstDir.hpp"
 #include "GLATResponse.hpp"
@@ -52,6 +55,7 @@
 #define G_AEFF                                     "GLATResponse::aeff(int&)"
 #define G_PSF                                       "GLATResponse::psf(int&)"
 #define G_EDISP                                   "GLATResponse::edisp(int&)"
+#define G_PTSRC                                   "GLATResponse::ptsrc(int&)"
 #define G_IRF_ATOM     "GLATResponse::irf(GLATEventAtom&, GModel&, GEnergy&,"\
                                                      "GTime&, GObservation&)"
 #define G_IRF_BIN       "GLATResponse::irf(GLATEventBin&, GModel&, GEnergy&,"\
@@ -265,11 +269,8 @@ double GLATResponse::irf(const GEvent&       event,
                                 gammalib::str(srcDir.dec_deg())+")";
         psf->name(name);
 
-        // Push mean PSF on stack
-        const_cast<GLATResponse*>(this)->m_ptsrc.push_back(psf);
-
-        // Set index of mean PSF
-        ipsf = m_ptsrc.size()-1;
+        // Push mean PSF on stack (circumvent const correctness)
+        ipsf = const_cast<GLATResponse*>(this)->add_ptsrc(psf);
 
         // Debug option: dump mean PSF
         #if G_DUMP_MEAN_PSF
@@ -294,13 +295,18 @@ double GLATResponse::irf(const GEvent&       event,
  * @param[in] event Event.
  * @param[in] source Source.
  * @param[in] obs Observation.
+ * @param[in] grad Compute spatial model parameter gradients? (ignored)
  *
  * This method returns the response of the instrument to a specific source
  * model. The method handles both event atoms and event bins.
+ *
+ * Analytical gradients of spatial model parameters are not supported by
+ * the LAT response, hence the @p grad argument is ignored.
  ***************************************************************************/
 double GLATResponse::irf(const GEvent&       event,
                          const GSource&      source,
-                         const GObservation& obs) const
+                         const GObservation& obs,
+                         const bool&         grad) const
 {
     // Get IRF value
     double rsp;
@@ -360,10 +366,13 @@ double GLATResponse::irf(const GLATEventAtom& event,
  * mean PSF. Otherwise an GLATException::diffuse_not_found exception is
  * thrown.
  *
+ * Source maps and mean PSFs are looked up by source name, unless the
+ * source map index and the mean PSF handle were already resolved by
+ * set_source_caches(). Mean PSFs that were not computed beforehand by
+ * precompute_psfs() are allocated on the fly.
+ *
  * @todo Extract event cube from observation. We do not need the cube
  *       pointer in the event anymore.
- * @todo Implement more efficient method for response search (name search is
- *       not very rapid).
  * @todo Instead of calling "offset = event.dir().dist_deg(srcDir)" we can
  *       precompute and store for each PSF the offsets. This should save
  *       quite some time since the distance computation is time
@@ -386,27 +395,29 @@ double GLATResponse::irf(const GLATEventBin& event,
     // Get source energy
     GEnergy srcEng = source.energy();
 
-    // Search for diffuse response in event cube
-    int idiff = -1;
-    for (int i = 0; i < cube->ndiffrsp(); ++i) {
-        if (cube->diffname(i) == source.name()) {
-            idiff = i;
-            break;
-        }
-    }
+    // Get index of source in the source caches
+    int isrc = (m_src_set) ? source_index(source) : -1;
+
+    // Get index of diffuse response in event cube. Use the index that was
+    // resolved by set_source_caches() if available.
+    int idiff = (isrc != -1) ? m_src_diff[isrc]
+                             : cube->diffindex(source.name());
 
     // If diffuse response has been found then get response from source map
     if (idiff != -1) {
 
-        // Get srcmap indices and weighting factors
-        GNodeArray nodes = cube->enodes();
-        nodes.set_value(srcEng.log10MeV());
+        // Get srcmap indices and weighting factors. If the source energy is
+        // the energy of the event bin then use the precomputed weights of
+        // the energy layer.
+        GNodeArray::weights w = (srcEng == event.energy())
+                                ? cube->eweights(event.ieng())
+                                : cube->enodes().lookup(srcEng.log10MeV());
 
         // Compute diffuse response
         GSkymap*      map    = cube->diffrsp(idiff);
         const double* pixels = map->pixels() + event.ipix();
-        rsp                  = nodes.wgt_left()  * pixels[nodes.inx_left()  * map->npix()] +
-                               nodes.wgt_right() * pixels[nodes.inx_right() * map->npix()];
+        rsp                  = w.wgt_left  * pixels[w.inx_left  * map->npix()] +
+                               w.wgt_right * pixels[w.inx_right * map->npix()];
 
         // Divide by solid angle and ontime since source maps are given in units of
         // counts/pixel/MeV.
@@ -418,14 +429,10 @@ double GLATResponse::irf(const GLATEventBin& event,
     // then return response from mean PSF
     if ((idiff == -1 || m_force_mean) && ptsrc != NULL) {
 
-        // Search for mean PSF
-        int ipsf = -1;
-        for (int i = 0; i < m_ptsrc.size(); ++i) {
-            if (m_ptsrc[i]->name() == source.name()) {
-                ipsf = i;
-                break;
-            }
-        }
+        // Get mean PSF handle. Use the handle that was resolved by
+        // set_source_caches() if available.
+        int ipsf = (isrc != -1 && m_src_ptsrc[isrc] != -1)
+                   ? m_src_ptsrc[isrc] : ptsrc_handle(source.name());
 
         // If mean PSF has not been found then create it now
         if (ipsf == -1) {
@@ -437,11 +444,8 @@ double GLATResponse::irf(const GLATEventBin& event,
             // Set source name
             psf->name(source.name());
 
-            // Push mean PSF on stack
-            const_cast<GLATResponse*>(this)->m_ptsrc.push_back(psf);
-
-            // Set index of mean PSF
-            ipsf = m_ptsrc.size()-1;
+            // Push mean PSF on stack (circumvent const correctness)
+            ipsf = const_cast<GLATResponse*>(this)->add_ptsrc(psf);
 
             // Debug option: dump mean PSF
             #if G_DUMP_MEAN_PSF 
@@ -689,6 +693,221 @@ GLATEdisp* GLATResponse::edisp(const int& index) const
 }
 
 
+/***********************************************************************//**
+ * @brief Precompute mean PSFs for point sources
+ *
+ * @param[in] models Models.
+ * @param[in] obs LAT observation.
+ *
+ * Computes the mean PSFs for all point sources in the model container that
+ * apply to the observation and for which no mean PSF exists yet. Point
+ * sources for which a diffuse response exists in the event cube are
+ * skipped, unless the use of the mean PSF is enforced. Nothing is done if
+ * the observation has no livetime cube or no event cube.
+ *
+ * Since the livetime cube is evaluated at the pixel that contains the
+ * source, the PSF and exposure tables are only computed once for all
+ * sources that fall into the same livetime cube pixel. The tables are
+ * computed in parallel. As the evaluation of the response functions is not
+ * thread safe, each thread uses its own copy of the response.
+ ***************************************************************************/
+void GLATResponse::precompute_psfs(const GModels&         models,
+                                   const GLATObservation& obs)
+{
+    // Get pointers on livetime cube and event cube
+    const GLATLtCube*    ltcube = obs.ltcube();
+    const GLATEventCube* cube   =
+                         dynamic_cast<const GLATEventCube*>(obs.events());
+
+    // Continue only if livetime cube and event cube are available
+    if (ltcube != NULL && cube != NULL) {
+
+        // Collect all point sources that have no mean PSF
+        std::vector<std::string> names;
+        std::vector<GSkyDir>     dirs;
+        std::vector<int>         pixels;
+        for (int i = 0; i < models.size(); ++i) {
+
+            // Skip models that are no sky models or that do not apply
+            const GModelSky* model = dynamic_cast<const GModelSky*>(models[i]);
+            if (model == NULL ||
+                !model->is_valid(obs.instrument(), obs.id())) {
+                continue;
+            }
+
+            // Skip models that are no point sources or that have a mean PSF
+            const GModelSpatialPointSource* ptsrc =
+                dynamic_cast<const GModelSpatialPointSource*>(model->spatial());
+            if (ptsrc == NULL || ptsrc_handle(model->name()) != -1) {
+                continue;
+            }
+
+            // Skip models with diffuse response unless mean PSF is enforced
+            if (!m_force_mean && cube->diffindex(model->name()) != -1) {
+                continue;
+            }
+
+            // Collect point source
+            names.push_back(model->name());
+            dirs.push_back(ptsrc->dir());
+            pixels.push_back(ltcube->pixel(ptsrc->dir()));
+
+        } // endfor: looped over models
+
+        // Determine for each point source the first point source that falls
+        // in the same livetime cube pixel. The tables are only computed for
+        // these first point sources.
+        int                 nsrc = names.size();
+        std::vector<int>    first(nsrc, -1);
+        std::vector<int>    leaders;
+        std::map<int,int>   pixel_first;
+        for (int i = 0; i < nsrc; ++i) {
+            std::map<int,int>::const_iterator it = pixel_first.find(pixels[i]);
+            if (it == pixel_first.end()) {
+                pixel_first[pixels[i]] = i;
+                first[i]               = i;
+                leaders.push_back(i);
+            }
+            else {
+                first[i] = it->second;
+            }
+        }
+
+        // Allocate mean PSFs
+        std::vector<GLATMeanPsf*> psfs(nsrc, NULL);
+        for (int i = 0; i < nsrc; ++i) {
+            psfs[i] = new GLATMeanPsf;
+            psfs[i]->name(names[i]);
+        }
+
+        // Make sure that the sky map projection of the event cube is set up
+        // before entering the parallel regions
+        if (nsrc > 0) {
+            cube->maxrad(dirs[0]);
+        }
+
+        // Compute tables for the first point source in each livetime cube
+        // pixel. Each thread uses its own copy of the response.
+        int nleaders = leaders.size();
+        #pragma omp parallel if(nleaders > 1)
+        {
+            GLATResponse rsp(*this);
+            #pragma omp for schedule(dynamic)
+            for (int k = 0; k < nleaders; ++k) {
+                int i = leaders[k];
+                psfs[i]->set(dirs[i], obs, rsp);
+            }
+        }
+
+        // Set all other mean PSFs from the tables of the first point source
+        // in their livetime cube pixel
+        #pragma omp parallel for schedule(dynamic) if(nsrc > 1)
+        for (int i = 0; i < nsrc; ++i) {
+            if (first[i] != i) {
+                psfs[i]->set(dirs[i], obs, *psfs[first[i]]);
+            }
+        }
+
+        // Push mean PSFs on stack
+        for (int i = 0; i < nsrc; ++i) {
+            add_ptsrc(psfs[i]);
+        }
+
+    } // endif: livetime cube and event cube were available
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Prepare source caches for a model evaluation
+ *
+ * @param[in] obs Observation.
+ * @param[in] models Models.
+ *
+ * Resolves the mean PSF handles and the source map indices of all sky
+ * models that apply to the observation once before the event bins of the
+ * observation are evaluated. The handles remain valid until clear_source_caches() is
+ * called.
+ ***************************************************************************/
+void GLATResponse::set_source_caches(const GObservation& obs,
+                                     const GModels&      models) const
+{
+    // Reset source caches
+    clear_source_caches(obs);
+
+    // Get event cube
+    const GLATEventCube* cube = dynamic_cast<const GLATEventCube*>(obs.events());
+
+    // Loop over all sky models that apply to the observation
+    for (int i = 0; i < models.size(); ++i) {
+        const GModelSky* sky = dynamic_cast<const GModelSky*>(models[i]);
+        if (sky == NULL || sky->spatial() == NULL ||
+            !sky->is_valid(obs.instrument(), obs.id())) {
+            continue;
+        }
+
+        // Store spatial model, mean PSF handle and source map index
+        m_src_models.push_back(sky->spatial());
+        m_src_ptsrc.push_back(ptsrc_handle(sky->name()));
+        m_src_diff.push_back((cube != NULL) ? cube->diffindex(sky->name())
+                                            : -1);
+
+    } // endfor: looped over models
+
+    // Signal that source caches are set
+    m_src_set = true;
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Release source caches after a model evaluation
+ *
+ * @param[in] obs Observation.
+ *
+ * Releases the handles and indices that were resolved by
+ * set_source_caches().
+ ***************************************************************************/
+void GLATResponse::clear_source_caches(const GObservation& obs) const
+{
+    // Release source caches
+    m_src_set = false;
+    m_src_models.clear();
+    m_src_ptsrc.clear();
+    m_src_diff.clear();
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Return mean PSF
+ *
+ * @param[in] handle Mean PSF handle.
+ * @return Mean PSF.
+ *
+ * @exception GException::out_of_range
+ *            Mean PSF handle is not valid.
+ *
+ * Returns the mean PSF for a handle that was obtained by ptsrc_handle().
+ ***************************************************************************/
+const GLATMeanPsf& GLATResponse::ptsrc(const int& handle) const
+{
+    // Check if the handle is valid
+    if (handle < 0 || handle >= m_ptsrc.size()) {
+        throw GException::out_of_range(G_PTSRC, handle, 0, m_ptsrc.size()-1);
+    }
+
+    // Return mean PSF
+    return *(m_ptsrc[handle]);
+}
+
+
 /***********************************************************************//**
  * @brief Print Fermi-LAT response information
  *
@@ -763,6 +982,13 @@ void GLATResponse::init_members(void)
     m_psf.clear();
     m_edisp.clear();
     m_ptsrc.clear();
+    m_ptsrc_handles.clear();
+
+    // Initialise source caches
+    m_src_set = false;
+    m_src_models.clear();
+    m_src_ptsrc.clear();
+    m_src_diff.clear();
     
     // By default use HANDOFF response database.
     char* handoff = std::getenv("HANDOFF_IRF_DIR");
@@ -812,6 +1038,7 @@ void GLATResponse::copy_members(const GLATResponse& rsp)
     for (int i = 0; i < rsp.m_ptsrc.size(); ++i) {
         m_ptsrc.push_back(rsp.m_ptsrc[i]->clone());
     }
+    m_ptsrc_handles = rsp.m_ptsrc_handles;
 
     // Return
     return;
@@ -850,7 +1077,58 @@ void GLATResponse::free_members(void)
         m_ptsrc[i] = NULL;
     }
     m_ptsrc.clear();
+    m_ptsrc_handles.clear();
 
     // Return
     return;
 }
+
+
+/***********************************************************************//**
+ * @brief Add mean PSF
+ *
+ * @param[in] psf Pointer to mean PSF.
+ * @return Mean PSF handle.
+ *
+ * Pushes the mean PSF on the stack and registers its handle under the name
+ * of the mean PSF. The response takes over ownership of the mean PSF.
+ ***************************************************************************/
+int GLATResponse::add_ptsrc(GLATMeanPsf* psf)
+{
+    // Set handle
+    int handle = m_ptsrc.size();
+
+    // Push mean PSF on stack and register handle
+    m_ptsrc.push_back(psf);
+    m_ptsrc_handles[psf->name()] = handle;
+
+    // Return handle
+    return handle;
+}
+
+
+/***********************************************************************//**
+ * @brief Return index of source in source caches
+ *
+ * @param[in] source Source.
+ * @return Source index (-1 if source was not found).
+ *
+ * Returns the index of the spatial model of the source in the source
+ * caches that were set by set_source_caches().
+ ***************************************************************************/
+int GLATResponse::source_index(const GSource& source) const
+{
+    // Initialise index
+    int index = -1;
+
+    // Search spatial model of source
+    for (int i = 0; i < m_src_models.size(); ++i) {
+        if (m_src_models[i] == source.model()) {
+            index = i;
+            break;
+        }
+    }
+
+    // Return index
+    return index;
+}
@@ -31,6 +31,7 @@
 #include <stdlib.h>
 #include <iostream>
 #include <unistd.h>
+#include <cmath>
 #include "GLATLib.hpp"
 #include "GTools.hpp"
 #include "test_LAT.hpp"
@@ -554,6 +555,45 @@ void TestGLATObservation::test_one_binned_obs(const std::string& datadir, const
         test_try_failure(e);
     }
 
+    // Test source map indices and energy layer weights against a scan of
+    // the source map names and a lookup of the energy nodes
+    test_try("Test source map indices and energy layer weights");
+    try {
+        const GLATEventCube* cube = dynamic_cast<const GLATEventCube*>(run.events());
+        test_assert(cube != NULL, "Expected LAT event cube");
+        for (int i = 0; i < cube->ndiffrsp(); ++i) {
+            std::string name     = cube->diffname(i);
+            int         expected = -1;
+            for (int k = 0; k < cube->ndiffrsp(); ++k) {
+                if (cube->diffname(k) == name) {
+                    expected = k;
+                    break;
+                }
+            }
+            test_value(cube->diffindex(name), expected, "Source map index");
+        }
+        test_value(cube->diffindex("Unknown source"), -1,
+                   "Source map index of unknown source");
+        for (int ieng = 0; ieng < cube->ebins(); ++ieng) {
+            const GLATEventBin* bin = (*cube)[ieng * cube->npix()];
+            GNodeArray::weights expected =
+                cube->enodes().lookup(bin->energy().log10MeV());
+            const GNodeArray::weights& weights = cube->eweights(bin->ieng());
+            test_value(weights.inx_left, expected.inx_left,
+                       "Left node index of energy layer");
+            test_value(weights.inx_right, expected.inx_right,
+                       "Right node index of energy layer");
+            test_value(weights.wgt_left, expected.wgt_left, 1.0e-10,
+                       "Left node weight of energy layer");
+            test_value(weights.wgt_right, expected.wgt_right, 1.0e-10,
+                       "Right node weight of energy layer");
+        }
+        test_try_success();
+    }
+    catch (std::exception &e) {
+        test_try_failure(e);
+    }
+
     // Add observation (twice) to data
     test_try("Append observation twice");
     try {
@@ -591,6 +631,69 @@ void TestGLATObservation::test_one_binned_obs(const std::string& datadir, const
         test_try_failure(e);
     }
 
+    // Test precomputed mean PSFs. Sources "A" and "B" fall into the same
+    // livetime cube pixel, hence the mean PSF of "B" is set from the tables
+    // of "A".
+    test_try("Test precomputed mean PSFs");
+    try {
+        // Setup point sources
+        GSkyDir dirA;
+        GSkyDir dirB;
+        GSkyDir dirC;
+        dirA.radec_deg(83.6331, 22.0145);
+        dirB.radec_deg(83.6431, 22.0195);
+        dirC.radec_deg(85.0, 20.0);
+        GModelSpectralPlaw plaw(1.0e-7, -2.0, GEnergy(100.0, "MeV"));
+        GModels models;
+        models.append(GModelSky(GModelSpatialPointSource(dirA), plaw));
+        models.append(GModelSky(GModelSpatialPointSource(dirB), plaw));
+        models.append(GModelSky(GModelSpatialPointSource(dirC), plaw));
+        models[0]->name("A");
+        models[1]->name("B");
+        models[2]->name("C");
+
+        // Precompute mean PSFs
+        GLATResponse rsp = run.response();
+        rsp.force_mean(true);
+        rsp.precompute_psfs(models, run);
+        int handleA = rsp.ptsrc_handle("A");
+        int handleB = rsp.ptsrc_handle("B");
+        int handleC = rsp.ptsrc_handle("C");
+        test_assert(handleA != -1, "Expected mean PSF handle for \"A\"");
+        test_assert(handleB != -1, "Expected mean PSF handle for \"B\"");
+        test_assert(handleC != -1, "Expected mean PSF handle for \"C\"");
+        test_assert(rsp.ptsrc_handle("D") == -1, "Expected no mean PSF handle");
+
+        // Check that handles are stable
+        rsp.precompute_psfs(models, run);
+        test_value(rsp.ptsrc_handle("A"), handleA, "Stable handle for \"A\"");
+        test_value(rsp.ptsrc_handle("B"), handleB, "Stable handle for \"B\"");
+        test_value(rsp.ptsrc_handle("C"), handleC, "Stable handle for \"C\"");
+
+        // Compare precomputed mean PSFs to mean PSFs computed on the fly
+        GSkyDir dirs[]    = {dirA, dirB, dirC};
+        int     handles[] = {handleA, handleB, handleC};
+        for (int k = 0; k < 3; ++k) {
+            GLATMeanPsf psf = rsp.ptsrc(handles[k]);
+            GLATMeanPsf ref(dirs[k], run);
+            test_value(psf.noffsets(), ref.noffsets(), "Number of offsets");
+            test_value(psf.nenergies(), ref.nenergies(), "Number of energies");
+            for (int i = 0; i < ref.nenergies(); i += 5) {
+                double logE = ref.energy(i);
+                for (int j = 0; j < ref.noffsets(); j += 10) {
+                    double value    = psf(ref.offset(j), logE);
+                    double expected = ref(ref.offset(j), logE);
+                    test_value(value, expected, 1.0e-6 * std::abs(expected),
+                               "Precomputed mean PSF value");
+                }
+            }
+        }
+        test_try_success();
+    }
+    catch (std::exception &e) {
+        test_try_failure(e);
+    }
+
     // Test XML loading
     test_try("Test XML loading");
     try {
@@ -53,6 +53,9 @@ public:
     virtual void        read(const GFits& file) = 0;
     virtual void        write(GFits& file) const = 0;
     virtual int         number(void) const = 0;
+
+    // Other methods
+    virtual bool        thread_safe(void) const;
 };
 
 
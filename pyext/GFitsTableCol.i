@@ -71,6 +71,14 @@ public:
     virtual void            remove(const int& row, const int& nrows) = 0;
     virtual bool            is_loaded(void) const = 0;
 
+    // Virtual methods
+    virtual void            read_range(const int& row, const int& nrows,
+                                       double* values) const;
+    virtual void            read_range(const int& row, const int& nrows,
+                                       float* values) const;
+    virtual void            read_range(const int& row, const int& nrows,
+                                       long long* values) const;
+
     // Other methods
     void                    name(const std::string& name);
     const std::string&      name(void) const;
@@ -54,6 +54,8 @@ public:
     void             eps(const double& eps);
     void             silent(const bool& silent);
     const int&       iter(void) const;
+    const int&       calls(void) const;
+    const double&    error(void) const;
     const int&       max_iter(void) const;
     const double&    eps(void) const;
     const bool&      silent(void) const;
@@ -62,6 +64,9 @@ public:
     double           romb(const double& a, const double& b, const int& k = 5);
     double           trapzd(const double& a, const double& b, const int& n = 1,
                             double result = 0.0);
+    double           gauss_kronrod(const double& a, const double& b);
+    double           gauss_legendre(const double& a, const double& b,
+                                    const int& n = 16);
 };
 
 
@@ -74,6 +74,8 @@ public:
     void    posangle(const double& posangle);
     GSkyDir dir(void) const;
     void    dir(const GSkyDir& dir);
+    const double& theta_gradient(void) const;
+    const double& posang_gradient(void) const;
 };
 
 
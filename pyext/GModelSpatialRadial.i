@@ -71,6 +71,7 @@ public:
     void    dec(const double& dec);
     GSkyDir dir(void) const;
     void    dir(const GSkyDir& dir);
+    const double& theta_gradient(void) const;
 };
 
 
@@ -60,6 +60,9 @@ public:
     virtual void            read(const GXmlElement& xml) = 0;
     virtual void            write(GXmlElement& xml) const = 0;
 
+    // Virtual methods
+    virtual int             norm_index(void) const;
+
     // Methods
     int  size(void) const;
     void autoscale(void);
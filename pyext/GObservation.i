@@ -79,6 +79,10 @@ public:
     const std::string& id(void) const;
     const GEvents*     events(void) const;
     const std::string& statistics(void) const;
+    void               use_npred_cache(const bool& use);
+    const bool&        use_npred_cache(void) const;
+    void               keep_workspaces(const bool& keep);
+    const bool&        keep_workspaces(void) const;
     virtual double    likelihood(const GModels& models,
                                  GVector*       gradient,
                                  GMatrixSparse* curvature,
@@ -89,6 +89,7 @@ public:
     // Other methods
     void set(GObservations* obs);
     void eval(const GOptimizerPars& pars);
+    void keep_workspaces(const bool& keep);
 };
 %nestedworkaround GObservations::likelihood;
 %{
@@ -55,18 +55,22 @@ public:
                             const GObservation& obs) const = 0;
 
     // Virtual methods
+    virtual bool   has_irf_gradients(void) const;
     virtual double irf(const GEvent&       event,
                        const GSource&      source,
-                       const GObservation& obs) const;
+                       const GObservation& obs,
+                       const bool&         grad = false) const;
     virtual double irf_ptsrc(const GEvent&       event,
                              const GSource&      source,
                              const GObservation& obs) const;
     virtual double irf_radial(const GEvent&       event,
                               const GSource&      source,
-                              const GObservation& obs) const;
+                              const GObservation& obs,
+                              const bool&         grad = false) const;
     virtual double irf_elliptical(const GEvent&       event,
                                   const GSource&      source,
-                                  const GObservation& obs) const;
+                                  const GObservation& obs,
+                                  const bool&         grad = false) const;
     virtual double irf_diffuse(const GEvent&       event,
                                const GSource&      source,
                                const GObservation& obs) const;
@@ -147,6 +147,10 @@ public:
     const GSkyProjection* projection(void) const;
     void                  projection(const GSkyProjection& proj);
     const double*         pixels(void) const;
+    void                  float_pixels(const bool& use_float);
+    bool                  float_pixels(void) const;
+    void                  shared_pixels(const bool& share);
+    bool                  shared_pixels(void) const;
     void                  load(const std::string& filename);
     void                  save(const std::string& filename, bool clobber = false) const;
     void                  read(const GFitsHDU& hdu);
@@ -162,11 +166,13 @@ public:
  ***************************************************************************/
 %extend GSkymap {
     double __getitem__(int GSkymapInx[]) {
+        // Use const access so that shared pixels are not copied
+        const GSkymap& map = *self;
         if (GSkymapInx[0] == 1) {
-            return (*self)(GSkymapInx[1]);
+            return map(GSkymapInx[1]);
         }
         else {
-            return (*self)(GSkymapInx[1], GSkymapInx[2]);
+            return map(GSkymapInx[1], GSkymapInx[2]);
         }
     }
     /*
@@ -42,6 +42,7 @@
 #define G_SAVE_COLUMN_FIXED              "GFitsTableCol::save_column_fixed()"
 #define G_SAVE_COLUMN_VARIABLE        "GFitsTableCol::save_column_variable()"
 #define G_OFFSET                          "GFitsTableCol::offset(int&, int&)"
+#define G_CHECK_RANGE  "GFitsTableCol::check_range(std::string&, int&, int&)"
 
 /* __ Macros _____________________________________________________________ */
 
@@ -188,6 +189,96 @@ GFitsTableCol& GFitsTableCol::operator=(const GFitsTableCol& column)
  =                                                                         =
  ==========================================================================*/
 
+/***********************************************************************//**
+ * @brief Read range of rows into double precision array
+ *
+ * @param[in] row First row [0,...,length()-1].
+ * @param[in] nrows Number of rows.
+ * @param[out] values Output array (at least @p nrows * number() elements).
+ *
+ * Copies all elements of @p nrows rows starting from @p row into an array
+ * of double precision values. The elements are stored row by row. The
+ * method is implemented by the typed column classes as a block copy; this
+ * generic implementation converts the elements one by one using real().
+ ***************************************************************************/
+void GFitsTableCol::read_range(const int& row, const int& nrows,
+                               double* values) const
+{
+    // Check range
+    check_range(G_CHECK_RANGE, row, nrows);
+
+    // Copy elements
+    for (int i = 0, k = 0; i < nrows; ++i) {
+        for (int inx = 0; inx < m_number; ++inx, ++k) {
+            values[k] = real(row+i, inx);
+        }
+    }
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Read range of rows into single precision array
+ *
+ * @param[in] row First row [0,...,length()-1].
+ * @param[in] nrows Number of rows.
+ * @param[out] values Output array (at least @p nrows * number() elements).
+ *
+ * Copies all elements of @p nrows rows starting from @p row into an array
+ * of single precision values. The elements are stored row by row. The
+ * method is implemented by the typed column classes as a block copy; this
+ * generic implementation converts the elements one by one using real().
+ ***************************************************************************/
+void GFitsTableCol::read_range(const int& row, const int& nrows,
+                               float* values) const
+{
+    // Check range
+    check_range(G_CHECK_RANGE, row, nrows);
+
+    // Copy elements
+    for (int i = 0, k = 0; i < nrows; ++i) {
+        for (int inx = 0; inx < m_number; ++inx, ++k) {
+            values[k] = (float)real(row+i, inx);
+        }
+    }
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Read range of rows into 64 bit integer array
+ *
+ * @param[in] row First row [0,...,length()-1].
+ * @param[in] nrows Number of rows.
+ * @param[out] values Output array (at least @p nrows * number() elements).
+ *
+ * Copies all elements of @p nrows rows starting from @p row into an array
+ * of 64 bit integer values. The elements are stored row by row. The method
+ * is implemented by the typed column classes as a block copy; this generic
+ * implementation converts the elements one by one using real().
+ ***************************************************************************/
+void GFitsTableCol::read_range(const int& row, const int& nrows,
+                               long long* values) const
+{
+    // Check range
+    check_range(G_CHECK_RANGE, row, nrows);
+
+    // Copy elements
+    for (int i = 0, k = 0; i < nrows; ++i) {
+        for (int inx = 0; inx < m_number; ++inx, ++k) {
+            values[k] = (long long)real(row+i, inx);
+        }
+    }
+
+    // Return
+    return;
+}
+
+
 /***********************************************************************//**
  * @brief Set number of column elements for specific row
  *
@@ -869,6 +960,137 @@ void GFitsTableCol::save_column_variable(void)
 }
 
 
+/***********************************************************************//**
+ * @brief Check range of rows for block access
+ *
+ * @param[in] origin Method that performs the check.
+ * @param[in] row First row.
+ * @param[in] nrows Number of rows.
+ *
+ * @exception GException::out_of_range
+ *            Row range is not within the column.
+ * @exception GException::invalid_argument
+ *            Column is a variable-length column.
+ *
+ * Checks that the rows [@p row, @p row + @p nrows - 1] are within the
+ * column and that the column has a fixed length, so that the rows occupy
+ * a contiguous block of memory.
+ ***************************************************************************/
+void GFitsTableCol::check_range(const std::string& origin, const int& row,
+                                const int& nrows) const
+{
+    // Check that column has fixed length
+    if (is_variable()) {
+        std::string msg = "Block access is not supported for variable-length"
+                          " column \""+name()+"\".";
+        throw GException::invalid_argument(origin, msg);
+    }
+
+    // Check row range
+    if (nrows < 0 || row < 0 || row+nrows > length()) {
+        std::string msg = "Row range ["+gammalib::str(row)+","+
+                          gammalib::str(row+nrows)+"[ is not within column "
+                          "of length "+gammalib::str(length())+".";
+        throw GException::out_of_range(origin, "Row index", row, length(), msg);
+    }
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Read range of rows from FITS file
+ *
+ * @param[in] origin Method name of caller.
+ * @param[in] row First row [0,...,length()-1].
+ * @param[in] nrows Number of rows.
+ * @param[in] type cfitsio data type of output array.
+ * @param[out] values Output array (at least @p nrows * number() elements).
+ * @return True if rows were read from FITS file.
+ *
+ * @exception GException::out_of_range
+ *            Row range is not within the column.
+ * @exception GException::invalid_argument
+ *            Column is a variable-length column.
+ * @exception GException::fits_hdu_not_found
+ *            Specified HDU not found in FITS file.
+ * @exception GException::fits_error
+ *            An error occured while reading column data from FITS file.
+ *
+ * If the column data are not loaded and the column is attached to a FITS
+ * file, the rows [@p row, @p row + @p nrows - 1] are read directly from
+ * the file into the output array, converting them into the specified
+ * data type. The column data are not loaded in that case, so that large
+ * columns can be read in chunks with bounded memory.
+ *
+ * If the rows could not be read from the file, the column data are loaded
+ * and false is returned. The caller should then copy the rows from memory.
+ ***************************************************************************/
+bool GFitsTableCol::read_rows(const std::string& origin, const int& row,
+                              const int& nrows, const int& type,
+                              void* values) const
+{
+    // Initialise result
+    bool read = false;
+
+    // Check range
+    check_range(origin, row, nrows);
+
+    // Continue only if the column data are not loaded
+    if (!is_loaded()) {
+
+        // If a FITS file is attached then read the rows from the file
+        if (FPTR(m_fitsfile)->Fptr != NULL && m_colnum > 0) {
+
+            // Move to the HDU
+            int status = 0;
+            status     = __ffmahd(FPTR(m_fitsfile),
+                                  (FPTR(m_fitsfile)->HDUposition)+1,
+                                  NULL, &status);
+
+            // If the HDU does not yet exist we assume that no data have been
+            // written to the file and we load the initialised column
+            if (status != 252 && status != 107) {
+
+                // Break on any other cfitsio error
+                if (status != 0) {
+                    throw GException::fits_hdu_not_found(origin,
+                                      (FPTR(m_fitsfile)->HDUposition)+1,
+                                      status);
+                }
+
+                // Read rows
+                if (nrows > 0 && m_number > 0) {
+                    status = __ffgcv(FPTR(m_fitsfile), type, m_colnum,
+                                     (long long)(row)+1, 1,
+                                     (long long)(nrows)*m_number, NULL,
+                                     values, NULL, &status);
+                    if (status != 0) {
+                        throw GException::fits_error(origin, status,
+                                        "for column '"+m_name+"'.");
+                    }
+                }
+
+                // Signal that rows were read
+                read = true;
+
+            } // endif: HDU found
+
+        } // endif: there was a FITS file attached
+
+        // If rows were not read then load the column data
+        if (!read) {
+            fetch_data();
+        }
+
+    } // endif: column data were not loaded
+
+    // Return flag
+    return read;
+}
+
+
 /***********************************************************************//**
  * @brief Compute offset of column element in memory
  *
@@ -37,6 +37,12 @@
 /* __ Method name definitions ____________________________________________ */
 #define G_INSERT                  "GFitsTableLongLongCol::insert(int&, int&)"
 #define G_REMOVE                  "GFitsTableLongLongCol::remove(int&, int&)"
+#define G_READ_RANGE_DOUBLE   "GFitsTableLongLongCol::read_range(int&, int&,"\
+                                                                  " double*)"
+#define G_READ_RANGE_FLOAT    "GFitsTableLongLongCol::read_range(int&, int&,"\
+                                                                   " float*)"
+#define G_READ_RANGE_LONGLONG "GFitsTableLongLongCol::read_range(int&, int&,"\
+                                                               " long long*)"
 
 /* __ Macros _____________________________________________________________ */
 
@@ -453,6 +459,99 @@ void GFitsTableLongLongCol::remove(const int& row, const int& nrows)
 }
 
 
+/***********************************************************************//**
+ * @brief Read range of rows into double precision array
+ *
+ * @param[in] row First row [0,...,length()-1].
+ * @param[in] nrows Number of rows.
+ * @param[out] values Output array (at least @p nrows * number() elements).
+ *
+ * @exception GException::out_of_range
+ *            Row range is not within the column.
+ * @exception GException::invalid_argument
+ *            Column is a variable-length column.
+ *
+ * Copies all elements of @p nrows rows starting from @p row as one block
+ * into an array of double precision values. If the column data are not
+ * loaded, the rows are read directly from the FITS file without loading
+ * the column.
+ ***************************************************************************/
+void GFitsTableLongLongCol::read_range(const int& row, const int& nrows,
+                                       double* values) const
+{
+    // Read rows directly from the FITS file if the column data are not
+    // loaded, otherwise copy them from memory
+    if (!read_rows(G_READ_RANGE_DOUBLE, row, nrows, __TDOUBLE, values)) {
+        copy_range(m_data + row * m_number, nrows * m_number, values);
+    }
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Read range of rows into single precision array
+ *
+ * @param[in] row First row [0,...,length()-1].
+ * @param[in] nrows Number of rows.
+ * @param[out] values Output array (at least @p nrows * number() elements).
+ *
+ * @exception GException::out_of_range
+ *            Row range is not within the column.
+ * @exception GException::invalid_argument
+ *            Column is a variable-length column.
+ *
+ * Copies all elements of @p nrows rows starting from @p row as one block
+ * into an array of single precision values. If the column data are not
+ * loaded, the rows are read directly from the FITS file without loading
+ * the column.
+ ***************************************************************************/
+void GFitsTableLongLongCol::read_range(const int& row, const int& nrows,
+                                       float* values) const
+{
+    // Read rows directly from the FITS file if the column data are not
+    // loaded, otherwise copy them from memory
+    if (!read_rows(G_READ_RANGE_FLOAT, row, nrows, __TFLOAT, values)) {
+        copy_range(m_data + row * m_number, nrows * m_number, values);
+    }
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Read range of rows into 64 bit integer array
+ *
+ * @param[in] row First row [0,...,length()-1].
+ * @param[in] nrows Number of rows.
+ * @param[out] values Output array (at least @p nrows * number() elements).
+ *
+ * @exception GException::out_of_range
+ *            Row range is not within the column.
+ * @exception GException::invalid_argument
+ *            Column is a variable-length column.
+ *
+ * Copies all elements of @p nrows rows starting from @p row as one block
+ * into an array of 64 bit integer values. If the column data are not
+ * loaded, the rows are read directly from the FITS file without loading
+ * the column.
+ ***************************************************************************/
+void GFitsTableLongLongCol::read_range(const int& row, const int& nrows,
+                                       long long* values) const
+{
+    // Read rows directly from the FITS file if the column data are not
+    // loaded, otherwise copy them from memory
+    if (!read_rows(G_READ_RANGE_LONGLONG, row, nrows, __TLONGLONG, values)) {
+        copy_range(m_data + row * m_number, nrows * m_number, values);
+    }
+
+    // Return
+    return;
+}
+
+
 /***********************************************************************//**
  * @brief Set nul value
  *
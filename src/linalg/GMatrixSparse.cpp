@@ -290,13 +290,18 @@ GMatrixSparse& GMatrixSparse::operator=(const GMatrixSparse& matrix)
  * @return Matrix.
  *
  * Assigns the specified @p value to all elements of the matrix.
+ *
+ * If @p value is zero, all matrix elements are removed but the allocated
+ * memory and the fill stack are kept, so that the matrix can be refilled
+ * without memory allocation.
  ***************************************************************************/
 GMatrixSparse& GMatrixSparse::operator=(const double& value)
 {
     // Fill any pending element to have a non-pending state
     fill_pending();
     
-    // If value is 0 then simply reinitialize column start indices
+    // If value is 0 then simply reinitialize column start indices and
+    // drop all elements
     if (value == 0) {
 
         // Initialise column start indices to 0
@@ -304,6 +309,9 @@ GMatrixSparse& GMatrixSparse::operator=(const double& value)
             m_colstart[col] = 0;
         }
 
+        // Drop all elements (the memory is kept)
+        m_elements = 0;
+
     }
 
     // ... otherwise fill column-wise
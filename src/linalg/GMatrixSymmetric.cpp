@@ -710,6 +710,71 @@ void GMatrixSymmetric::add_to_column(const int& column, const GVector& vector)
 }
 
 
+/***********************************************************************//**
+ * @brief Add scaled outer product of a sparse vector to matrix
+ *
+ * @param[in] factor Scaling factor.
+ * @param[in] vector Pointer to vector elements (rows() elements).
+ * @param[in] inx Pointer to indices of non-zero vector elements.
+ * @param[in] number Number of non-zero vector elements.
+ *
+ * Adds the rank-1 update
+ *
+ * \f[M_{ij} = M_{ij} + {\tt factor} \times v_i \times v_j\f]
+ *
+ * to the matrix for all indices \f$i,j\f$ that are listed in @p inx.
+ * The indices in @p inx need to be in ascending order. The method does
+ * not check the validity of the indices.
+ *
+ * If the indices form a contiguous range, each column segment of the
+ * lower triangle is updated in a simple loop over consecutive memory
+ * locations.
+ ***************************************************************************/
+void GMatrixSymmetric::add_outer_product(const double& factor,
+                                         const double* vector,
+                                         const int*    inx,
+                                         const int&    number)
+{
+    // Continue only if there are elements
+    if (number > 0) {
+
+        // Get last index and signal if the indices are contiguous
+        int  last       = inx[number-1];
+        bool contiguous = (last - inx[0] == number - 1);
+
+        // Loop over columns
+        for (int i = 0; i < number; ++i) {
+
+            // Get column index and column factor
+            int    column = inx[i];
+            double f      = factor * vector[column];
+
+            // Get pointer to column so that the row index can be used
+            // directly for addressing the lower triangle elements
+            double* data = m_data + m_colstart[column] - column;
+
+            // Add outer product to column
+            if (contiguous) {
+                for (int row = column; row <= last; ++row) {
+                    data[row] += f * vector[row];
+                }
+            }
+            else {
+                for (int k = i; k < number; ++k) {
+                    int row    = inx[k];
+                    data[row] += f * vector[row];
+                }
+            }
+
+        } // endfor: looped over columns
+
+    } // endif: there were elements
+
+    // Return
+    return;
+}
+
+
 /***********************************************************************//**
  * @brief Return inverted matrix
  *
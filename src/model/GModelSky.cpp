@@ -28,6 +28,7 @@
 #ifdef HAVE_CONFIG_H
 #include <config.h>
 #endif
+#include <algorithm>
 #include "GTools.hpp"
 #include "GException.hpp"
 #include "GModelRegistry.hpp"
@@ -35,6 +36,7 @@
 #include "GModelSpatialPointSource.hpp"
 #include "GModelSpatialDiffuseCube.hpp"
 #include "GModelSpatialRadial.hpp"
+#include "GModelSpatialElliptical.hpp"
 #include "GModelSpatialRegistry.hpp"
 #include "GModelSpectralRegistry.hpp"
 #include "GModelTemporalRegistry.hpp"
@@ -555,54 +557,11 @@ double GModelSky::eval_gradients(const GEvent& event,
 double GModelSky::npred(const GEnergy& obsEng, const GTime& obsTime,
                         const GObservation& obs) const
 {
-    // Initialise result
-    double npred = 0.0;
-
-    // Continue only if model is valid)
-    if (valid_model()) {
-
-        // Get response function
-        const GResponse& rsp = obs.response();
-
-        // Here we make the simplifying approximations
-        // srcEng=obsEng and srcTime=obsTime. To be fully correct we should
-        // integrate over true energy and true time here ... at least true
-        // time if we want to consider energy dispersion ...
-        GEnergy srcEng  = obsEng;
-        GTime   srcTime = obsTime;
-
-        // Set source
-        GSource source(this->name(), m_spatial, srcEng, srcTime);
-
-        // Compute response components
-        double npred_spatial  = rsp.npred(source, obs);
-        double npred_spectral = spectral()->eval(srcEng, srcTime);
-        double npred_temporal = temporal()->eval(srcTime);
-
-        // Compute response
-        npred = npred_spatial * npred_spectral * npred_temporal;
-
-        // If required, apply instrument specific model scaling
-        if (!m_scales.empty()) {
-            npred *= scale(obs.instrument()).value();
-        }
-
-        // Compile option: Check for NaN/Inf
-        #if defined(G_NAN_CHECK)
-        if (gammalib::is_notanumber(npred) || gammalib::is_infinite(npred)) {
-            std::cout << "*** ERROR: GModelSky::npred:";
-            std::cout << " NaN/Inf encountered";
-            std::cout << " (npred=" << npred;
-            std::cout << ", npred_spatial=" << npred_spatial;
-            std::cout << ", npred_spectral=" << npred_spectral;
-            std::cout << ", npred_temporal=" << npred_temporal;
-            std::cout << ", srcEng=" << srcEng;
-            std::cout << ", srcTime=" << srcTime;
-            std::cout << ")" << std::endl;
-        }
-        #endif
-
-    } // endif: model was valid
+    // Here we make the simplifying approximations
+    // srcEng=obsEng and srcTime=obsTime. To be fully correct we should
+    // integrate over true energy and true time here ... at least true
+    // time if we want to consider energy dispersion ...
+    double npred = npred_kernel(obsEng, obsTime, obs, -1, NULL);
 
     // Return npred
     return npred;
@@ -942,6 +901,154 @@ GPhotons GModelSky::mc(const double& area,
 }
 
 
+/***********************************************************************//**
+ * @brief Return Npred integrand or its spectral parameter gradient
+ *
+ * @param[in] srcEng True photon energy.
+ * @param[in] srcTime True photon arrival time.
+ * @param[in] obs Observation.
+ * @param[in] ipar Spectral parameter index (-1 for the integrand).
+ * @param[in,out] npred_spatial Spatially integrated response (can be NULL).
+ * @return Npred integrand or its gradient.
+ *
+ * Computes the integrand of npred() for a given true energy and time. If
+ * @p ipar is not negative, the gradient of the integrand with respect to
+ * the spectral parameter @p ipar is returned instead.
+ *
+ * If @p npred_spatial is not NULL and points to a non-negative value, that
+ * value is used as spatially integrated response. Otherwise the response
+ * is computed by GResponse::npred() and, if @p npred_spatial is not NULL,
+ * stored in @p npred_spatial. This allows sharing the response between
+ * the integrations of Npred and its spectral gradients.
+ *
+ * Zero is returned if the model is not valid.
+ ***************************************************************************/
+double GModelSky::npred_kernel(const GEnergy&      srcEng,
+                               const GTime&        srcTime,
+                               const GObservation& obs,
+                               const int&          ipar,
+                               double*             npred_spatial) const
+{
+    // Initialise result
+    double npred = 0.0;
+
+    // Continue only if model is valid)
+    if (valid_model()) {
+
+        // Get spatially integrated response, computing it if it is not
+        // provided
+        double spatial = (npred_spatial != NULL) ? *npred_spatial : -1.0;
+        if (spatial < 0.0) {
+            GSource source(this->name(), m_spatial, srcEng, srcTime);
+            spatial = obs.response().npred(source, obs);
+            if (npred_spatial != NULL) {
+                *npred_spatial = spatial;
+            }
+        }
+
+        // Get spectral component or its gradient
+        double npred_spectral;
+        if (ipar < 0) {
+            npred_spectral = spectral()->eval(srcEng, srcTime);
+        }
+        else {
+            spectral()->eval_gradients(srcEng, srcTime);
+            npred_spectral = (*spectral())[ipar].factor_gradient();
+        }
+
+        // Get temporal component
+        double npred_temporal = temporal()->eval(srcTime);
+
+        // Compute response
+        npred = spatial * npred_spectral * npred_temporal;
+
+        // If required, apply instrument specific model scaling
+        if (!m_scales.empty()) {
+            npred *= scale(obs.instrument()).value();
+        }
+
+        // Compile option: Check for NaN/Inf
+        #if defined(G_NAN_CHECK)
+        if (gammalib::is_notanumber(npred) || gammalib::is_infinite(npred)) {
+            std::cout << "*** ERROR: GModelSky::npred_kernel:";
+            std::cout << " NaN/Inf encountered";
+            std::cout << " (npred=" << npred;
+            std::cout << ", npred_spatial=" << spatial;
+            std::cout << ", npred_spectral=" << npred_spectral;
+            std::cout << ", npred_temporal=" << npred_temporal;
+            std::cout << ", srcEng=" << srcEng;
+            std::cout << ", srcTime=" << srcTime;
+            std::cout << ")" << std::endl;
+        }
+        #endif
+
+    } // endif: model was valid
+
+    // Return npred
+    return npred;
+}
+
+
+/***********************************************************************//**
+ * @brief Pre-compute spectral model for an array of energies
+ *
+ * @param[in] logE Energies (log10 of energy in MeV, ascending order).
+ *
+ * Evaluates the spectral model values and parameter gradients for the
+ * specified energies using the batch evaluation interface of the spectral
+ * model and stores the results in a cache. The cache is used by the model
+ * evaluation for any of the specified energies as long as the spectral
+ * model parameters are unchanged. The cache is cleared by
+ * clear_spectral_cache().
+ ***************************************************************************/
+void GModelSky::spectral_cache(const std::vector<double>& logE)
+{
+    // Clear cache
+    clear_spectral_cache();
+
+    // Continue only if there is a spectral component and energies
+    if (m_spectral != NULL && !logE.empty()) {
+
+        // Get dimensions
+        int n     = logE.size();
+        int npars = m_spectral->size();
+
+        // Store energies and parameter values
+        m_cache_logE = logE;
+        for (int i = 0; i < npars; ++i) {
+            m_cache_pars.push_back((*m_spectral)[i].value());
+        }
+
+        // Evaluate spectral model values and gradients
+        m_cache_values.assign(n, 0.0);
+        m_cache_grads.assign(n*npars, 0.0);
+        m_spectral->eval(&m_cache_logE[0], n, &m_cache_values[0],
+                         (npars > 0) ? &m_cache_grads[0] : NULL);
+
+    } // endif: spectral component and energies were available
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Clear spectral model cache
+ ***************************************************************************/
+void GModelSky::clear_spectral_cache(void)
+{
+    // Clear cache
+    m_cache_logE.clear();
+    m_cache_pars.clear();
+    m_cache_values.clear();
+    m_cache_grads.clear();
+    m_cache_index = 0;
+
+    // Return
+    return;
+}
+
+
 /***********************************************************************//**
  * @brief Print model information
  *
@@ -1033,6 +1140,11 @@ void GModelSky::init_members(void)
     m_spatial  = NULL;
     m_spectral = NULL;
     m_temporal = NULL;
+    m_cache_logE.clear();
+    m_cache_pars.clear();
+    m_cache_values.clear();
+    m_cache_grads.clear();
+    m_cache_index = 0;
 
     // Return
     return;
@@ -1054,6 +1166,13 @@ void GModelSky::copy_members(const GModelSky& model)
     m_spectral = (model.m_spectral != NULL) ? model.m_spectral->clone() : NULL;
     m_temporal = (model.m_temporal != NULL) ? model.m_temporal->clone() : NULL;
 
+    // Copy spectral cache
+    m_cache_logE   = model.m_cache_logE;
+    m_cache_pars   = model.m_cache_pars;
+    m_cache_values = model.m_cache_values;
+    m_cache_grads  = model.m_cache_grads;
+    m_cache_index  = model.m_cache_index;
+
     // Set parameter pointers
     set_pointers();
 
@@ -1430,6 +1549,14 @@ double GModelSky::integrate_energy(const GEvent& event,
  * scale factors will be applied to the IRF so that they are correctly
  * taken into account in the spectral and temporal model gradient
  * computations.
+ *
+ * If gradients are requested and the response supports it (see
+ * GResponse::has_irf_gradients()), the response also computes the
+ * gradients of the IRF with respect to the parameters of radial and
+ * elliptical spatial models. These gradients are multiplied by the
+ * spectral and temporal model values as well as by the instrument
+ * dependent scale factor. Otherwise the parameters are flagged as having
+ * no gradient, so that the gradients are computed numerically.
  ***************************************************************************/
 double GModelSky::integrate_dir(const GEvent&       event,
                                 const GEnergy&      srcEng,
@@ -1448,21 +1575,48 @@ double GModelSky::integrate_dir(const GEvent&       event,
 
         // Set source
         GSource source(this->name(), m_spatial, srcEng, srcTime);
-        
+
+        // If gradients are requested for a radial or elliptical model then
+        // signal whether the response computes the gradients of the spatial
+        // model parameters. Otherwise they are computed numerically.
+        bool spatial_grad = false;
+        if (grad && (dynamic_cast<GModelSpatialRadial*>(m_spatial)     != NULL ||
+                     dynamic_cast<GModelSpatialElliptical*>(m_spatial) != NULL)) {
+            spatial_grad = rsp.has_irf_gradients();
+            for (int i = 0; i < m_spatial->size(); ++i) {
+                (*m_spatial)[i].has_grad(spatial_grad);
+            }
+        }
+
         // Get IRF value. This method returns the spatial component of the
         // source model.
-        double irf = rsp.irf(event, source, obs);
+        double irf = rsp.irf(event, source, obs, grad);
 
         // If required, apply instrument specific model scaling
+        double inst_scale = 1.0;
         if (!m_scales.empty()) {
-            irf *= scale(obs.instrument()).value();
+            inst_scale = scale(obs.instrument()).value();
+            irf       *= inst_scale;
         }
 
         // Case A: evaluate gradients
         if (grad) {
 
             // Evaluate source model
-            double spec = (spectral() != NULL) ? spectral()->eval_gradients(srcEng, srcTime) : 1.0;
+            double spec = 1.0;
+            if (m_spectral != NULL) {
+                int inx = spectral_cache_index(srcEng);
+                if (inx >= 0) {
+                    int n = m_cache_logE.size();
+                    for (int i = 0; i < m_spectral->size(); ++i) {
+                        (*m_spectral)[i].factor_gradient(m_cache_grads[i*n+inx]);
+                    }
+                    spec = m_cache_values[inx];
+                }
+                else {
+                    spec = m_spectral->eval_gradients(srcEng, srcTime);
+                }
+            }
             double temp = (temporal() != NULL) ? temporal()->eval_gradients(srcTime) : 1.0;
 
             // Set value
@@ -1501,13 +1655,29 @@ double GModelSky::integrate_dir(const GEvent&       event,
                 }
             }
 
+            // Multiply factors to spatial gradients of radial and elliptical
+            // models if the response computed the IRF gradients
+            if (spatial_grad) {
+                double fact = spec * temp * inst_scale;
+                if (fact != 1.0) {
+                    for (int i = 0; i < m_spatial->size(); ++i) {
+                        (*m_spatial)[i].factor_gradient((*m_spatial)[i].factor_gradient() * fact);
+                    }
+                }
+            }
+
         } // endif: gradient evaluation has been requested
 
         // Case B: evaluate no gradients
         else {
 
             // Evaluate source model
-            double spec = (m_spectral != NULL) ? m_spectral->eval(srcEng, srcTime) : 1.0;
+            double spec = 1.0;
+            if (m_spectral != NULL) {
+                int inx = spectral_cache_index(srcEng);
+                spec    = (inx >= 0) ? m_cache_values[inx]
+                                     : m_spectral->eval(srcEng, srcTime);
+            }
             double temp = (m_temporal != NULL) ? m_temporal->eval(srcTime) : 1.0;
 
             // Set value
@@ -1548,3 +1718,54 @@ bool GModelSky::valid_model(void) const
     // Return result
     return result;
 }
+
+
+/***********************************************************************//**
+ * @brief Return spectral cache index for energy
+ *
+ * @param[in] srcEng True photon energy.
+ * @return Cache index (-1 if energy is not cached).
+ *
+ * Returns the index of the specified energy in the spectral cache. If the
+ * energy is not in the cache, or if any of the spectral model parameters
+ * has changed since the cache was computed, -1 is returned.
+ ***************************************************************************/
+int GModelSky::spectral_cache_index(const GEnergy& srcEng) const
+{
+    // Initialise index
+    int index = -1;
+
+    // Continue only if cache is not empty
+    if (!m_cache_logE.empty()) {
+
+        // Check that spectral parameters are unchanged
+        bool valid = true;
+        for (int i = 0; i < m_cache_pars.size(); ++i) {
+            if ((*m_spectral)[i].value() != m_cache_pars[i]) {
+                valid = false;
+                break;
+            }
+        }
+
+        // If cache is valid then search energy, starting with the last hit
+        if (valid) {
+            double logE = srcEng.log10MeV();
+            if (m_cache_logE[m_cache_index] == logE) {
+                index = m_cache_index;
+            }
+            else {
+                std::vector<double>::const_iterator it =
+                    std::lower_bound(m_cache_logE.begin(), m_cache_logE.end(),
+                                     logE);
+                if (it != m_cache_logE.end() && *it == logE) {
+                    index         = it - m_cache_logE.begin();
+                    m_cache_index = index;
+                }
+            }
+        }
+
+    } // endif: cache was not empty
+
+    // Return index
+    return index;
+}
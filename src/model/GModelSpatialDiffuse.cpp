@@ -30,9 +30,14 @@
 #endif
 #include "GException.hpp"
 #include "GModelSpatialDiffuse.hpp"
+#include "GObservation.hpp"
 
 /* __ Method name definitions ____________________________________________ */
 
+/* __ Constants __________________________________________________________ */
+const int lookup_max_obs    = 1000;     //!< Maximum observations in cache
+const int lookup_max_events = 1000000;  //!< Maximum events in cache
+
 /* __ Macros _____________________________________________________________ */
 
 /* __ Coding definitions _________________________________________________ */
@@ -145,6 +150,14 @@ GModelSpatialDiffuse& GModelSpatialDiffuse::operator=(const GModelSpatialDiffuse
  ***************************************************************************/
 void GModelSpatialDiffuse::init_members(void)
 {
+    // Initialise members
+    m_lookup_ids.clear();
+    m_lookup_wgts.clear();
+    m_lookup_dirs.clear();
+    m_lookup_obs  = NULL;
+    m_lookup_slot = -1;
+    m_lookup_size = 0;
+
     // Return
     return;
 }
@@ -154,6 +167,9 @@ void GModelSpatialDiffuse::init_members(void)
  * @brief Copy class members
  *
  * @param[in] model Diffuse spatial model.
+ *
+ * The cache of sky map pixel weights is not copied, since model copies
+ * are typically made for worker threads that evaluate other events.
  ***************************************************************************/
 void GModelSpatialDiffuse::copy_members(const GModelSpatialDiffuse& model)
 {
@@ -170,3 +186,167 @@ void GModelSpatialDiffuse::free_members(void)
     // Return
     return;
 }
+
+
+/***********************************************************************//**
+ * @brief Return sky map pixel weights for event direction
+ *
+ * @param[in] map Sky map.
+ * @param[in] dir Event direction.
+ * @param[in] obs Observation (NULL if unknown).
+ * @param[in] index Event index (negative if unknown).
+ * @return Pixel indices and weighting factors.
+ *
+ * Returns the pixel indices and bi-linear interpolation weights of the
+ * sky @p map for the event direction @p dir. The weights are cached for
+ * each observation and event @p index, so that the sky projection is only
+ * performed when an event is evaluated for the first time. The cache of
+ * an observation is selected using the observation identifier (see
+ * lookup_slot()). Since observation identifiers need not be unique, the
+ * cached weights are only used if the event direction is unchanged.
+ * Otherwise the weights are recomputed and replace the cached weights. No
+ * cache is used if @p obs is NULL or if @p index is negative or not smaller
+ * than @p lookup_max_events.
+ *
+ * The cache holds at most @p lookup_max_events events and is cleared if
+ * this number would be exceeded. Cache access is guarded by the critical
+ * section GModelSpatialDiffuse_lookup, while the sky projection is done
+ * outside the critical section.
+ *
+ * The cached weights depend on the geometry of the sky map, hence derived
+ * classes need to call clear_lookup_cache() whenever the sky map changes.
+ ***************************************************************************/
+GSkymap::weights GModelSpatialDiffuse::lookup(const GSkymap&      map,
+                                              const GSkyDir&      dir,
+                                              const GObservation* obs,
+                                              const int&          index) const
+{
+    // Initialise weights
+    GSkymap::weights wgt;
+
+    // Continue only if the event can be cached
+    if (obs != NULL && index >= 0 && index < lookup_max_events) {
+
+        // Get event direction
+        double ra  = dir.ra();
+        double dec = dir.dec();
+
+        // Get cached weights if the event direction is unchanged. Unused
+        // cache entries are marked by an invalid declination.
+        bool cached = false;
+        #pragma omp critical(GModelSpatialDiffuse_lookup)
+        {
+            int                                  slot = lookup_slot(obs);
+            const std::vector<GSkymap::weights>& wgts = m_lookup_wgts[slot];
+            const std::vector<double>&           dirs = m_lookup_dirs[slot];
+            if (index < wgts.size() &&
+                dirs[2*index] == ra && dirs[2*index+1] == dec) {
+                wgt    = wgts[index];
+                cached = true;
+            }
+        }
+
+        // Otherwise compute the weights and store them in the cache. The
+        // cache is cleared if it would exceed its maximum size.
+        if (!cached) {
+            wgt = map.lookup(dir);
+            #pragma omp critical(GModelSpatialDiffuse_lookup)
+            {
+                int slot = lookup_slot(obs);
+                int grow = index + 1 - m_lookup_wgts[slot].size();
+                if (grow > 0 && m_lookup_size + grow > lookup_max_events) {
+                    m_lookup_ids.clear();
+                    m_lookup_wgts.clear();
+                    m_lookup_dirs.clear();
+                    m_lookup_obs  = NULL;
+                    m_lookup_size = 0;
+                    slot          = lookup_slot(obs);
+                    grow          = index + 1;
+                }
+                std::vector<GSkymap::weights>& wgts = m_lookup_wgts[slot];
+                std::vector<double>&           dirs = m_lookup_dirs[slot];
+                if (grow > 0) {
+                    wgts.resize(index+1);
+                    dirs.resize(2*(index+1), -10.0);
+                    m_lookup_size += grow;
+                }
+                wgts[index]     = wgt;
+                dirs[2*index]   = ra;
+                dirs[2*index+1] = dec;
+            }
+        }
+
+    } // endif: event could be cached
+
+    // ... otherwise compute the weights
+    else {
+        wgt = map.lookup(dir);
+    }
+
+    // Return weights
+    return wgt;
+}
+
+
+/***********************************************************************//**
+ * @brief Return cache slot of observation
+ *
+ * @param[in] obs Observation.
+ * @return Index of cache of observation.
+ *
+ * Returns the index of the cache of the observation @p obs. The cache is
+ * selected using the observation identifier when the observation differs
+ * from the observation of the previous call. A new cache is appended if no
+ * cache exists for the observation identifier. The caches of all
+ * observations are cleared if there are already @p lookup_max_obs caches.
+ *
+ * The method needs to be called from within the critical section
+ * GModelSpatialDiffuse_lookup.
+ ***************************************************************************/
+int GModelSpatialDiffuse::lookup_slot(const GObservation* obs) const
+{
+    // Select cache of observation if the observation has changed
+    if (obs != m_lookup_obs) {
+        m_lookup_slot = -1;
+        for (int i = 0; i < m_lookup_ids.size(); ++i) {
+            if (m_lookup_ids[i] == obs->id()) {
+                m_lookup_slot = i;
+                break;
+            }
+        }
+        if (m_lookup_slot == -1) {
+            if (m_lookup_ids.size() >= lookup_max_obs) {
+                m_lookup_ids.clear();
+                m_lookup_wgts.clear();
+                m_lookup_dirs.clear();
+                m_lookup_size = 0;
+            }
+            m_lookup_slot = m_lookup_ids.size();
+            m_lookup_ids.push_back(obs->id());
+            m_lookup_wgts.push_back(std::vector<GSkymap::weights>());
+            m_lookup_dirs.push_back(std::vector<double>());
+        }
+        m_lookup_obs = obs;
+    }
+
+    // Return cache slot
+    return m_lookup_slot;
+}
+
+
+/***********************************************************************//**
+ * @brief Clear sky map pixel weights cache
+ ***************************************************************************/
+void GModelSpatialDiffuse::clear_lookup_cache(void)
+{
+    // Clear cache
+    m_lookup_ids.clear();
+    m_lookup_wgts.clear();
+    m_lookup_dirs.clear();
+    m_lookup_obs  = NULL;
+    m_lookup_slot = -1;
+    m_lookup_size = 0;
+
+    // Return
+    return;
+}
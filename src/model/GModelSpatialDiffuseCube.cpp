@@ -32,6 +32,7 @@
 #include "GTools.hpp"
 #include "GMath.hpp"
 #include "GModelSpatialDiffuseCube.hpp"
+#include "GHealpix.hpp"
 #include "GModelSpatialRegistry.hpp"
 #include "GFitsTable.hpp"
 #include "GFitsTableCol.hpp"
@@ -284,31 +285,8 @@ GModelSpatialDiffuseCube* GModelSpatialDiffuseCube::clone(void) const
  ***************************************************************************/
 double GModelSpatialDiffuseCube::eval(const GPhoton& photon) const
 {
-    // Initialise value
-    double value = 0.0;
-
-    // Continue only if there is energy information for the map cube
-    if (m_logE.size() > 0) {
-
-        // Compute diffuse model value by interpolation in log10(energy)
-        m_logE.set_value(photon.energy().log10MeV());
-        double intensity = m_logE.wgt_left() *
-                           m_cube(photon.dir(), m_logE.inx_left()) +
-                           m_logE.wgt_right() *
-                           m_cube(photon.dir(), m_logE.inx_right());
-
-        // Set the intensity times the scaling factor as model value
-        value = intensity * m_value.value();
-
-        // Make sure that value is not negative
-        if (value < 0.0) {
-            value = 0.0;
-        }
-
-    } // endif: energy information was available
-
-    // Return value
-    return value;
+    // Return model value without using the pixel weights cache
+    return (eval(photon, NULL, -1));
 }
 
 
@@ -323,39 +301,8 @@ double GModelSpatialDiffuseCube::eval(const GPhoton& photon) const
  ***************************************************************************/
 double GModelSpatialDiffuseCube::eval_gradients(const GPhoton& photon) const
 {
-    // Initialise intensity
-    double intensity = 0.0;
-
-    // Continue only if there is energy information for the map cube
-    if (m_logE.size() > 0) {
-
-        // Compute diffuse model value by interpolation in log10(energy)
-        m_logE.set_value(photon.energy().log10MeV());
-        intensity = m_logE.wgt_left() *
-                    m_cube(photon.dir(), m_logE.inx_left()) +
-                    m_logE.wgt_right() *
-                    m_cube(photon.dir(), m_logE.inx_right());
-
-
-    } // endif: energy information was available
-
-    // Compute the model value
-    double value = intensity * m_value.value();
-
-	// Compute partial derivatives of the parameter value
-	double g_value = (m_value.is_free()) ? intensity * m_value.scale() : 0.0;
-
-    // Make sure that value is not negative
-    if (value < 0.0) {
-        value   = 0.0;
-        g_value = 0.0;
-    }
-
-	// Set gradient to 0 (circumvent const correctness)
-	const_cast<GModelSpatialDiffuseCube*>(this)->m_value.factor_gradient(g_value);
-
-    // Return value
-    return value;
+    // Return model value without using the pixel weights cache
+    return (eval_gradients(photon, NULL, -1));
 }
 
 
@@ -599,6 +546,112 @@ void GModelSpatialDiffuseCube::write(GXmlElement& xml) const
 }
 
 
+/***********************************************************************//**
+ * @brief Evaluate function for event
+ *
+ * @param[in] photon Incident photon.
+ * @param[in] obs Observation (NULL if unknown).
+ * @param[in] index Event index (negative if unknown).
+ * @return Model value.
+ *
+ * Computes the spatial diffuse model as function of photon parameters.
+ *
+ * The pixel indices and interpolation weights of the sky direction are
+ * determined once and applied to both maps that bracket the photon energy.
+ * They are also cached for the event @p index of the observation @p obs,
+ * so that repeated evaluations of the same event, for example in the iterations of a fit,
+ * skip the sky projection.
+ ***************************************************************************/
+double GModelSpatialDiffuseCube::eval(const GPhoton&      photon,
+                                      const GObservation* obs,
+                                      const int&          index) const
+{
+    // Initialise value
+    double value = 0.0;
+
+    // Continue only if there is energy information for the map cube
+    if (m_logE.size() > 0) {
+
+        // Get pixel indices and weights for sky direction
+        GSkymap::weights pix = lookup(m_cube, photon.dir(), obs, index);
+
+        // Compute diffuse model value by interpolation in log10(energy)
+        GNodeArray::weights w = m_logE.lookup(photon.energy().log10MeV());
+        double intensity = w.wgt_left  * m_cube(pix, w.inx_left) +
+                           w.wgt_right * m_cube(pix, w.inx_right);
+
+        // Set the intensity times the scaling factor as model value
+        value = intensity * m_value.value();
+
+        // Make sure that value is not negative
+        if (value < 0.0) {
+            value = 0.0;
+        }
+
+    } // endif: energy information was available
+
+    // Return value
+    return value;
+}
+
+
+/***********************************************************************//**
+ * @brief Evaluate function and gradients for event
+ *
+ * @param[in] photon Incident photon.
+ * @param[in] obs Observation (NULL if unknown).
+ * @param[in] index Event index (negative if unknown).
+ * @return Model value.
+ *
+ * Computes the spatial diffuse model as function of photon parameters and
+ * sets the value gradient.
+ *
+ * The pixel indices and interpolation weights of the sky direction are
+ * determined once and applied to both maps that bracket the photon energy.
+ * They are also cached for the event @p index of the observation @p obs,
+ * so that repeated evaluations of the same event, for example in the iterations of a fit,
+ * skip the sky projection.
+ ***************************************************************************/
+double GModelSpatialDiffuseCube::eval_gradients(const GPhoton&      photon,
+                                                const GObservation* obs,
+                                                const int&          index) const
+{
+    // Initialise intensity
+    double intensity = 0.0;
+
+    // Continue only if there is energy information for the map cube
+    if (m_logE.size() > 0) {
+
+        // Get pixel indices and weights for sky direction
+        GSkymap::weights pix = lookup(m_cube, photon.dir(), obs, index);
+
+        // Compute diffuse model value by interpolation in log10(energy)
+        GNodeArray::weights w = m_logE.lookup(photon.energy().log10MeV());
+        intensity = w.wgt_left  * m_cube(pix, w.inx_left) +
+                    w.wgt_right * m_cube(pix, w.inx_right);
+
+    } // endif: energy information was available
+
+    // Compute the model value
+    double value = intensity * m_value.value();
+
+    // Compute partial derivatives of the parameter value
+    double g_value = (m_value.is_free()) ? intensity * m_value.scale() : 0.0;
+
+    // Make sure that value is not negative
+    if (value < 0.0) {
+        value   = 0.0;
+        g_value = 0.0;
+    }
+
+    // Set gradient (circumvent const correctness)
+    const_cast<GModelSpatialDiffuseCube*>(this)->m_value.factor_gradient(g_value);
+
+    // Return value
+    return value;
+}
+
+
 /***********************************************************************//**
  * @brief Load cube into the model class
  *
@@ -611,9 +664,10 @@ void GModelSpatialDiffuseCube::write(GXmlElement& xml) const
  ***************************************************************************/
 void GModelSpatialDiffuseCube::load(const std::string& filename)
 {
-    // Initialise skymap
+    // Initialise skymap and pixel weights cache
     m_cube.clear();
     m_logE.clear();
+    clear_lookup_cache();
 
     // Store filename of cube (for XML writing). Note that we do not
     // expand any environment variable at this level, so that if we write
@@ -621,8 +675,10 @@ void GModelSpatialDiffuseCube::load(const std::string& filename)
     // variables
     m_filename = filename;
 
-    // Load cube
+    // Load cube and share its pixels between model copies, since the
+    // cube is not modified by the model
     m_cube.load(m_filename);
+    m_cube.shared_pixels(true);
 
     // Load energies
     GEnergies energies(m_filename);
@@ -762,38 +818,86 @@ void GModelSpatialDiffuseCube::set_mc_cone(const GSkyDir& centre,
         // Reserve space for all pixels in cache
         m_mc_cache.reserve((npix+1)*nmaps);
 
-        // Loop over all maps
-        for (int i = 0; i < nmaps; ++i) {
+        // Initialise the solid angles of all pixels and the flags of the
+        // pixels that overlap with the simulation cone
+        std::vector<double> solidangles(npix, 0.0);
+        std::vector<bool>   in_cone(npix, false);
+
+        // For HEALPix cubes, determine the pixels that overlap with the
+        // simulation cone using a disc query, so that only the pixels
+        // inside the cone are touched
+        const GHealpix* healpix =
+              dynamic_cast<const GHealpix*>(m_cube.projection());
+        if (healpix != NULL) {
+            std::vector<int> disc = healpix->query_disc(centre, radius, true);
+            for (int i = 0; i < disc.size(); ++i) {
+                int k          = disc[i];
+                solidangles[k] = m_cube.solidangle(k);
+                in_cone[k]     = true;
+            }
+        }
 
-            // Compute pixel offset
-            int offset = i * (npix+1);
+        // ... otherwise scan all pixels of the cube
+        else {
 
-            // Set first cache value to 0
-            m_mc_cache.push_back(0.0);
+            // Compute the directions of all pixels in a single batched
+            // transformation
+            std::vector<GSkyPixel> skypixels;
+            skypixels.reserve(npix);
+            for (int k = 0; k < npix; ++k) {
+                skypixels.push_back(GSkyPixel(k));
+            }
+            std::vector<GSkyDir> dirs = m_cube.pix2dir(skypixels);
 
-            // Initialise cache with cumulative pixel fluxes and compute
-            // total flux in skymap for normalization. Negative pixels are
-            // excluded from the cumulative map.
-            double total_flux = 0.0;
-        	for (int k = 0; k < npix; ++k) {
+            // Determine the solid angles of all pixels and flag the pixels
+            // that overlap with the simulation cone
+            for (int k = 0; k < npix; ++k) {
 
                 // Derive effective pixel radius from half opening angle
                 // that corresponds to the pixel's solid angle. For security,
                 // the radius is enhanced by 50%.
+                solidangles[k]      = m_cube.solidangle(k);
                 double pixel_radius =
-                       std::acos(1.0 - m_cube.solidangle(k)/gammalib::twopi) *
+                       std::acos(1.0 - solidangles[k]/gammalib::twopi) *
                        gammalib::rad2deg * 1.5;
 
-                // Add up flux with simulation cone radius + effective pixel
+                // Flag pixels within simulation cone radius + effective pixel
                 // radius. The effective pixel radius is added to make sure
                 // that all pixels that overlap with the simulation cone are
                 // taken into account. There is no problem of having even
                 // pixels outside the simulation cone taken into account as
                 // long as the mc() method has an explicit test of whether a
                 // simulated event is contained in the simulation cone.
-                double distance = centre.dist_deg(m_cube.pix2dir(k));
-                if (distance <= radius+pixel_radius) {
-                    double flux = m_cube(k,i) * m_cube.solidangle(k);
+                in_cone[k] = (centre.dist_deg(dirs[k]) <= radius+pixel_radius);
+
+            } // endfor: looped over pixels
+
+        } // endelse: scanned all pixels
+
+        // Get constant reference to map cube, so that reading the pixels
+        // does neither copy shared pixels nor convert single precision
+        // pixels
+        const GSkymap& cube = m_cube;
+
+        // Loop over all maps
+        for (int i = 0; i < nmaps; ++i) {
+
+            // Compute pixel offset
+            int offset = i * (npix+1);
+
+            // Set first cache value to 0
+            m_mc_cache.push_back(0.0);
+
+            // Initialise cache with cumulative pixel fluxes and compute
+            // total flux in skymap for normalization. Negative pixels are
+            // excluded from the cumulative map.
+            double total_flux = 0.0;
+        	for (int k = 0; k < npix; ++k) {
+
+                // Add up flux of pixels that overlap with the simulation
+                // cone
+                if (in_cone[k]) {
+                    double flux = cube(k,i) * solidangles[k];
                     if (flux > 0.0) {
                         total_flux += flux;
                     }
@@ -268,11 +268,8 @@ GModelSpatialDiffuseMap* GModelSpatialDiffuseMap::clone(void) const
  ***************************************************************************/
 double GModelSpatialDiffuseMap::eval(const GPhoton& photon) const
 {
-    // Get skymap intensity
-    double intensity = m_map(photon.dir());
-
-    // Return intensity times normalization factor
-    return (intensity * m_value.value());
+    // Return intensity without using the pixel weights cache
+    return (eval(photon, NULL, -1));
 }
 
 
@@ -289,17 +286,8 @@ double GModelSpatialDiffuseMap::eval(const GPhoton& photon) const
  ***************************************************************************/
 double GModelSpatialDiffuseMap::eval_gradients(const GPhoton& photon) const
 {
-    // Get skymap intensity
-    double intensity = m_map(photon.dir());
-
-    // Compute partial derivatives of the parameter values
-    double g_value = (m_value.is_free()) ? intensity * m_value.scale() : 0.0;
-
-    // Set gradient to 0 (circumvent const correctness)
-    const_cast<GModelSpatialDiffuseMap*>(this)->m_value.factor_gradient(g_value);
-
-    // Return intensity times normalization factor
-    return (intensity * m_value.value());
+    // Return intensity without using the pixel weights cache
+    return (eval_gradients(photon, NULL, -1));
 }
 
 
@@ -507,6 +495,71 @@ std::string GModelSpatialDiffuseMap::print(const GChatter& chatter) const
 }
 
 
+/***********************************************************************//**
+ * @brief Return intensity of skymap for event
+ *
+ * @param[in] photon Incident photon.
+ * @param[in] obs Observation (NULL if unknown).
+ * @param[in] index Event index (negative if unknown).
+ * @return Sky map intensity.
+ *
+ * Returns the intensity of the skymap at the specified sky direction
+ * multiplied by the normalization factor. If the sky direction falls outside
+ * the skymap, an intensity of 0 is returned.
+ *
+ * The pixel indices and interpolation weights of the sky direction are
+ * cached for the event @p index of the observation @p obs, so that
+ * repeated evaluations of the same event, for example in the iterations of
+ * a fit, skip the sky projection.
+ ***************************************************************************/
+double GModelSpatialDiffuseMap::eval(const GPhoton&      photon,
+                                     const GObservation* obs,
+                                     const int&          index) const
+{
+    // Get skymap intensity
+    double intensity = m_map(lookup(m_map, photon.dir(), obs, index));
+
+    // Return intensity times normalization factor
+    return (intensity * m_value.value());
+}
+
+
+/***********************************************************************//**
+ * @brief Return intensity of skymap and gradient for event
+ *
+ * @param[in] photon Incident photon.
+ * @param[in] obs Observation (NULL if unknown).
+ * @param[in] index Event index (negative if unknown).
+ * @return Sky map intensity.
+ *
+ * Returns the intensity of the skymap at the specified sky direction
+ * multiplied by the normalization factor. The method also sets the gradient
+ * with respect to the normalization factor. If the sky direction falls
+ * outside the skymap, an intensity of 0 is returned.
+ *
+ * The pixel indices and interpolation weights of the sky direction are
+ * cached for the event @p index of the observation @p obs, so that
+ * repeated evaluations of the same event, for example in the iterations of
+ * a fit, skip the sky projection.
+ ***************************************************************************/
+double GModelSpatialDiffuseMap::eval_gradients(const GPhoton&      photon,
+                                               const GObservation* obs,
+                                               const int&          index) const
+{
+    // Get skymap intensity
+    double intensity = m_map(lookup(m_map, photon.dir(), obs, index));
+
+    // Compute partial derivatives of the parameter values
+    double g_value = (m_value.is_free()) ? intensity * m_value.scale() : 0.0;
+
+    // Set gradient to 0 (circumvent const correctness)
+    const_cast<GModelSpatialDiffuseMap*>(this)->m_value.factor_gradient(g_value);
+
+    // Return intensity times normalization factor
+    return (intensity * m_value.value());
+}
+
+
 /***********************************************************************//**
  * @brief Load skymap into the model class
  *
@@ -620,8 +673,13 @@ void GModelSpatialDiffuseMap::free_members(void)
  ***************************************************************************/
 void GModelSpatialDiffuseMap::prepare_map(void)
 {
-    // Initialise cache
+    // Initialise caches
     m_mc_cache.clear();
+    clear_lookup_cache();
+
+    // Remember pixel precision since normalizing the skymap converts the
+    // pixels into double precision
+    bool use_float = m_map.float_pixels();
 
     // Determine number of skymap pixels
     int npix = m_map.npix();
@@ -686,6 +744,11 @@ void GModelSpatialDiffuseMap::prepare_map(void)
 
     } // endif: there were skymap pixels
 
+    // Restore pixel precision and share the skymap pixels between model
+    // copies, since the skymap is not modified after preparation
+    m_map.float_pixels(use_float);
+    m_map.shared_pixels(true);
+
     // Return
     return;
 }
@@ -28,7 +28,9 @@
 #ifdef HAVE_CONFIG_H
 #include <config.h>
 #endif
+#include <cmath>
 #include "GException.hpp"
+#include "GMath.hpp"
 #include "GModelSpatialElliptical.hpp"
 
 /* __ Method name definitions ____________________________________________ */
@@ -187,18 +189,70 @@ double GModelSpatialElliptical::eval(const GPhoton& photon) const
  *
  * Evaluates the elliptical spatial model value and analytical model
  * parameter gradients for a specific incident @p photon.
+ *
+ * The eval_gradients(theta,posangle,energy,time) method of the derived
+ * class sets the gradients of the model shape parameters, and stores the
+ * derivatives \f$\partial S / \partial \theta\f$ and
+ * \f$\partial S / \partial \phi\f$ (per radian) that are returned by
+ * theta_gradient() and posang_gradient(). These are converted here into
+ * the gradients of the model centre using
+ *
+ * \f[
+ *    \frac{\partial \theta}{\partial \delta_0} = -\cos \phi, \quad
+ *    \frac{\partial \theta}{\partial \alpha_0} = -\sin \phi \cos \delta_0,
+ *    \quad
+ *    \frac{\partial \phi}{\partial \delta_0} =
+ *    \frac{\sin \phi}{\sin \theta}, \quad
+ *    \frac{\partial \phi}{\partial \alpha_0} =
+ *    -\frac{\cos \phi \cos \delta_0}{\sin \theta}
+ * \f]
+ *
+ * where \f$(\alpha_0,\delta_0)\f$ is the model centre and \f$\phi\f$ is
+ * the position angle of the photon direction with respect to the model
+ * centre.
  ***************************************************************************/
 double GModelSpatialElliptical::eval_gradients(const GPhoton& photon) const
 {
     // Compute distance from source and position angle (in radians)
+    GSkyDir        centre = dir();
     const GSkyDir& srcDir = photon.dir();
-    double theta          = dir().dist(srcDir);
-    double posang         = dir().posang(srcDir);
+    double theta          = centre.dist(srcDir);
+    double posang         = centre.posang(srcDir);
 
     // Evaluate model and set gradients
     double value = eval_gradients(theta, posang, photon.energy(),
                                   photon.time());
 
+    // Get derivatives with respect to theta and position angle
+    double g_theta  = m_theta_grad;
+    double g_posang = m_posang_grad;
+
+    // Compute position gradients
+    double g_ra  = 0.0;
+    double g_dec = 0.0;
+    if (g_theta != 0.0 || g_posang != 0.0) {
+        double sin_phi   = std::sin(posang);
+        double cos_phi   = std::cos(posang);
+        double cos_dec   = std::cos(centre.dec());
+        double sin_theta = std::sin(theta);
+        double d_ra      = -g_theta * sin_phi * cos_dec;
+        double d_dec     = -g_theta * cos_phi;
+        if (sin_theta > 0.0) {
+            d_ra  -= g_posang * cos_phi * cos_dec / sin_theta;
+            d_dec += g_posang * sin_phi / sin_theta;
+        }
+        if (m_ra.is_free()) {
+            g_ra = d_ra * gammalib::deg2rad * m_ra.scale();
+        }
+        if (m_dec.is_free()) {
+            g_dec = d_dec * gammalib::deg2rad * m_dec.scale();
+        }
+    }
+
+    // Set gradients (circumvent const correctness)
+    const_cast<GModelSpatialElliptical*>(this)->m_ra.factor_gradient(g_ra);
+    const_cast<GModelSpatialElliptical*>(this)->m_dec.factor_gradient(g_dec);
+
     // Return result
     return value;
 }
@@ -447,7 +501,7 @@ void GModelSpatialElliptical::init_members(void)
     m_ra.fix();
     m_ra.scale(1.0);
     m_ra.gradient(0.0);
-    m_ra.has_grad(false);
+    m_ra.has_grad(true);
 
     // Initialise Declination
     m_dec.clear();
@@ -456,7 +510,7 @@ void GModelSpatialElliptical::init_members(void)
     m_dec.fix();
     m_dec.scale(1.0);
     m_dec.gradient(0.0);
-    m_dec.has_grad(false);
+    m_dec.has_grad(true);
 
     // Initialise Position Angle
     m_posangle.clear();
@@ -465,7 +519,7 @@ void GModelSpatialElliptical::init_members(void)
     m_posangle.fix();
     m_posangle.scale(1.0);
     m_posangle.gradient(0.0);
-    m_posangle.has_grad(false);
+    m_posangle.has_grad(true);
 
     // Set parameter pointer(s)
     m_pars.clear();
@@ -473,6 +527,10 @@ void GModelSpatialElliptical::init_members(void)
     m_pars.push_back(&m_dec);
     m_pars.push_back(&m_posangle);
 
+    // Initialise theta and position angle derivatives
+    m_theta_grad  = 0.0;
+    m_posang_grad = 0.0;
+
     // Return
     return;
 }
@@ -486,9 +544,11 @@ void GModelSpatialElliptical::init_members(void)
 void GModelSpatialElliptical::copy_members(const GModelSpatialElliptical& model)
 {
     // Copy members
-    m_ra       = model.m_ra;
-    m_dec      = model.m_dec;
-    m_posangle = model.m_posangle;
+    m_ra          = model.m_ra;
+    m_dec         = model.m_dec;
+    m_posangle    = model.m_posangle;
+    m_theta_grad  = model.m_theta_grad;
+    m_posang_grad = model.m_posang_grad;
 
     // Set parameter pointer(s)
     m_pars.clear();
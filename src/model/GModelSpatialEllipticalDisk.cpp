@@ -337,9 +337,22 @@ double GModelSpatialEllipticalDisk::eval(const double&  theta,
  * @param[in] time Photon arrival time.
  * @return Model value.
  *
- * Evaluates the function value. No gradient computation is implemented as
- * Elliptical models will be convolved with the instrument response and thus
- * require the numerical computation of the derivatives.
+ * Evaluates the function value and sets the gradients of the semi-major
+ * and semi-minor axes using
+ *
+ * \f[
+ *    \frac{\partial S_{\rm p}}{\partial a} =
+ *    -\frac{{\tt m\_norm}}{2} \frac{\sin a}{1 - \cos a}
+ *    \quad {\rm and} \quad
+ *    \frac{\partial S_{\rm p}}{\partial b} =
+ *    -\frac{{\tt m\_norm}}{2} \frac{\sin b}{1 - \cos b}
+ * \f]
+ *
+ * within the ellipse, and zero outside. As for the radial disk model, the
+ * contribution of the ellipse boundary is only defined for a convolution
+ * of the model, and is added by the instrument response (see e.g.
+ * GCTAResponse::irf_elliptical). The derivatives with respect to the
+ * position angle and to the model centre are hence zero.
  *
  * See the eval() method for more information.
  ***************************************************************************/
@@ -348,8 +361,38 @@ double GModelSpatialEllipticalDisk::eval_gradients(const double&  theta,
                                                    const GEnergy& energy,
                                                    const GTime&   time) const
 {
+    // Evaluate function
+    double value = eval(theta, posangle, energy, time);
+
+    // Compute partial derivatives
+    double g_semiminor = 0.0;
+    double g_semimajor = 0.0;
+    if (value > 0.0) {
+        if (m_semiminor.is_free()) {
+            g_semiminor = -0.5 * value * std::sin(m_semiminor_rad) /
+                          (1.0 - std::cos(m_semiminor_rad)) *
+                          gammalib::deg2rad * m_semiminor.scale();
+        }
+        if (m_semimajor.is_free()) {
+            g_semimajor = -0.5 * value * std::sin(m_semimajor_rad) /
+                          (1.0 - std::cos(m_semimajor_rad)) *
+                          gammalib::deg2rad * m_semimajor.scale();
+        }
+    }
+
+    // Set gradients (circumvent const correctness)
+    GModelSpatialEllipticalDisk* ptr =
+        const_cast<GModelSpatialEllipticalDisk*>(this);
+    ptr->m_semiminor.factor_gradient(g_semiminor);
+    ptr->m_semimajor.factor_gradient(g_semimajor);
+    ptr->m_posangle.factor_gradient(0.0);
+    ptr->m_ra.factor_gradient(0.0);
+    ptr->m_dec.factor_gradient(0.0);
+    ptr->m_theta_grad  = 0.0;
+    ptr->m_posang_grad = 0.0;
+
     // Return value
-    return (eval(theta, posangle, energy, time));
+    return value;
 }
 
 
@@ -643,7 +686,7 @@ void GModelSpatialEllipticalDisk::init_members(void)
     m_semiminor.free();
     m_semiminor.scale(1.0);
     m_semiminor.gradient(0.0);
-    m_semiminor.has_grad(false);  // Elliptical components never have gradients
+    m_semiminor.has_grad(true);
 
     // Initialise semi-major axis
     m_semimajor.clear();
@@ -654,7 +697,7 @@ void GModelSpatialEllipticalDisk::init_members(void)
     m_semimajor.free();
     m_semimajor.scale(1.0);
     m_semimajor.gradient(0.0);
-    m_semimajor.has_grad(false);  // Elliptical components never have gradients
+    m_semimajor.has_grad(true);
 
     // Set parameter pointer(s)
     m_pars.push_back(&m_semiminor);
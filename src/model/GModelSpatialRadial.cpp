@@ -28,7 +28,9 @@
 #ifdef HAVE_CONFIG_H
 #include <config.h>
 #endif
+#include <cmath>
 #include "GException.hpp"
+#include "GMath.hpp"
 #include "GModelSpatialRadial.hpp"
 
 /* __ Method name definitions ____________________________________________ */
@@ -186,15 +188,56 @@ double GModelSpatialRadial::eval(const GPhoton& photon) const
  *
  * Evaluates the radial spatial model value and analytical model parameter
  * gradients for a specific incident @p photon.
+ *
+ * The eval_gradients(theta,energy,time) method of the derived class sets
+ * the gradients of the model shape parameters. As it does not know about
+ * the photon direction, it stores the derivative \f$\partial S / \partial
+ * \theta\f$ (per radian) that is returned by theta_gradient(). This
+ * derivative is converted here into the position gradients using
+ *
+ * \f[
+ *    \frac{\partial \theta}{\partial \delta_0} = -\cos \phi
+ *    \quad {\rm and} \quad
+ *    \frac{\partial \theta}{\partial \alpha_0} = -\sin \phi \cos \delta_0
+ * \f]
+ *
+ * where \f$(\alpha_0,\delta_0)\f$ is the model centre and \f$\phi\f$ is
+ * the position angle of the photon direction with respect to the model
+ * centre.
  ***************************************************************************/
 double GModelSpatialRadial::eval_gradients(const GPhoton& photon) const
 {
+    // Get model centre
+    GSkyDir centre = dir();
+
     // Compute distance from source (in radians)
-    double theta = photon.dir().dist(dir());
+    double theta = photon.dir().dist(centre);
 
     // Evaluate model and set gradients
     double value = eval_gradients(theta, photon.energy(), photon.time());
 
+    // Get derivative with respect to theta
+    double g_theta = m_theta_grad;
+
+    // Compute position gradients
+    double g_ra  = 0.0;
+    double g_dec = 0.0;
+    if (g_theta != 0.0 && (m_ra.is_free() || m_dec.is_free())) {
+        double phi = centre.posang(photon.dir());
+        if (m_ra.is_free()) {
+            g_ra = -g_theta * std::sin(phi) * std::cos(centre.dec()) *
+                   gammalib::deg2rad * m_ra.scale();
+        }
+        if (m_dec.is_free()) {
+            g_dec = -g_theta * std::cos(phi) * gammalib::deg2rad *
+                    m_dec.scale();
+        }
+    }
+
+    // Set gradients (circumvent const correctness)
+    const_cast<GModelSpatialRadial*>(this)->m_ra.factor_gradient(g_ra);
+    const_cast<GModelSpatialRadial*>(this)->m_dec.factor_gradient(g_dec);
+
     // Return result
     return value;
 }
@@ -427,7 +470,7 @@ void GModelSpatialRadial::init_members(void)
     m_ra.fix();
     m_ra.scale(1.0);
     m_ra.gradient(0.0);
-    m_ra.has_grad(false);
+    m_ra.has_grad(true);
 
     // Initialise Declination
     m_dec.clear();
@@ -436,13 +479,16 @@ void GModelSpatialRadial::init_members(void)
     m_dec.fix();
     m_dec.scale(1.0);
     m_dec.gradient(0.0);
-    m_dec.has_grad(false);
+    m_dec.has_grad(true);
 
     // Set parameter pointer(s)
     m_pars.clear();
     m_pars.push_back(&m_ra);
     m_pars.push_back(&m_dec);
 
+    // Initialise theta derivative
+    m_theta_grad = 0.0;
+
     // Return
     return;
 }
@@ -456,8 +502,9 @@ void GModelSpatialRadial::init_members(void)
 void GModelSpatialRadial::copy_members(const GModelSpatialRadial& model)
 {
     // Copy members
-    m_ra  = model.m_ra;
-    m_dec = model.m_dec;
+    m_ra         = model.m_ra;
+    m_dec        = model.m_dec;
+    m_theta_grad = model.m_theta_grad;
 
     // Set parameter pointer(s)
     m_pars.clear();
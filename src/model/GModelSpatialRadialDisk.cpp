@@ -288,9 +288,28 @@ double GModelSpatialRadialDisk::eval(const double&  theta,
  * @param[in] time Photon arrival time.
  * @return Model value.
  *
- * Evaluates the function value. No gradient computation is implemented as
- * radial models will be convolved with the instrument response and thus
- * require the numerical computation of the derivatives.
+ * Evaluates the function value and sets the gradient of the disk radius
+ * using
+ *
+ * \f[
+ *    \frac{\partial S_{\rm p}}{\partial r} = \left \{
+ *    \begin{array}{l l}
+ *       \displaystyle
+ *       -{\tt m\_norm} \frac{\sin r}{1 - \cos r}
+ *       & \mbox{if $\theta \le $ radius} \\
+ *       \\
+ *      \displaystyle
+ *      0 & \mbox{if $\theta > $ radius}
+ *    \end{array}
+ *    \right .
+ * \f]
+ *
+ * The derivatives are those of the disk interior. The contribution of
+ * the disk edge, which is a Dirac function in the radius and position
+ * derivatives, is only defined for a convolution of the model, and is
+ * added by the instrument response (see e.g. GCTAResponse::irf_radial).
+ * Consequently, the derivative with respect to \f$\theta\f$ that is
+ * returned by theta_gradient() is zero.
  *
  * See the eval() method for more information.
  ***************************************************************************/
@@ -298,8 +317,28 @@ double GModelSpatialRadialDisk::eval_gradients(const double&  theta,
                                                const GEnergy& energy,
                                                const GTime&   time) const
 {
+    // Update precomputation cache
+    update();
+
+    // Set value
+    double value = (theta <= m_radius_rad) ? m_norm : 0.0;
+
+    // Compute partial derivatives
+    double g_radius = (m_radius.is_free() && value > 0.0)
+                      ? -value * std::sin(m_radius_rad) /
+                        (1.0 - std::cos(m_radius_rad)) *
+                        gammalib::deg2rad * m_radius.scale()
+                      : 0.0;
+
+    // Set gradients (circumvent const correctness)
+    GModelSpatialRadialDisk* ptr = const_cast<GModelSpatialRadialDisk*>(this);
+    ptr->m_radius.factor_gradient(g_radius);
+    ptr->m_ra.factor_gradient(0.0);
+    ptr->m_dec.factor_gradient(0.0);
+    ptr->m_theta_grad = 0.0;
+
     // Return value
-    return (eval(theta, energy, time));
+    return value;
 }
 
 
@@ -538,7 +577,7 @@ void GModelSpatialRadialDisk::init_members(void)
     m_radius.free();
     m_radius.scale(1.0);
     m_radius.gradient(0.0);
-    m_radius.has_grad(false);  // Radial components never have gradients
+    m_radius.has_grad(true);
 
     // Set parameter pointer(s)
     m_pars.push_back(&m_radius);
@@ -282,15 +282,54 @@ double GModelSpatialRadialGauss::eval(const double&  theta,
  * @param[in] time Photon arrival time.
  * @return Model value.
  *
- * This method simply calls the eval() method as no analytical gradients
- * will be computed. See the eval() method for more details.
+ * Evaluates the function value and sets the gradient of the Gaussian
+ * width using
+ *
+ * \f[
+ *    \frac{\partial S_{\rm p}}{\partial \sigma} =
+ *    S_{\rm p}(\vec{p} | E, t) \frac{1}{\sigma}
+ *    \left( \frac{\theta^2}{\sigma^2} - 2 \right)
+ * \f]
+ *
+ * The derivative with respect to \f$\theta\f$
+ *
+ * \f[
+ *    \frac{\partial S_{\rm p}}{\partial \theta} =
+ *    -S_{\rm p}(\vec{p} | E, t) \frac{\theta}{\sigma^2}
+ * \f]
+ *
+ * is stored so that GModelSpatialRadial::eval_gradients(const GPhoton&)
+ * can convert it into position gradients.
+ *
+ * See the eval() method for more details.
  ***************************************************************************/
 double GModelSpatialRadialGauss::eval_gradients(const double&  theta,
                                                 const GEnergy& energy,
                                                 const GTime&   time) const
 {
+    // Compute value
+    double sigma_rad = sigma() * gammalib::deg2rad;
+    double sigma2    = sigma_rad * sigma_rad;
+    double theta2    = theta   * theta;
+    double value     = std::exp(-0.5 * theta2 / sigma2) /
+                       (gammalib::twopi * sigma2);
+
+    // Compute partial derivatives
+    double g_sigma = (m_sigma.is_free())
+                     ? value * (theta2 / sigma2 - 2.0) / sigma_rad *
+                       gammalib::deg2rad * m_sigma.scale()
+                     : 0.0;
+    double g_theta = -value * theta / sigma2;
+
+    // Set gradients (circumvent const correctness)
+    GModelSpatialRadialGauss* ptr = const_cast<GModelSpatialRadialGauss*>(this);
+    ptr->m_sigma.factor_gradient(g_sigma);
+    ptr->m_ra.factor_gradient(0.0);
+    ptr->m_dec.factor_gradient(0.0);
+    ptr->m_theta_grad = g_theta;
+
     // Return value
-    return (eval(theta, energy, time));
+    return value;
 }
 
 
@@ -538,7 +577,7 @@ void GModelSpatialRadialGauss::init_members(void)
     m_sigma.free();
     m_sigma.scale(1.0);
     m_sigma.gradient(0.0);
-    m_sigma.has_grad(false);  // Radial components never have gradients
+    m_sigma.has_grad(true);
 
     // Set parameter pointer(s)
     m_pars.push_back(&m_sigma);
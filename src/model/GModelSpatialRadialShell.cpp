@@ -350,15 +350,105 @@ double GModelSpatialRadialShell::eval(const double&  theta,
  * @param[in] time Photon arrival time.
  * @return Model value.
  *
- * This method simply calls the eval() method as no analytical gradients will
- * be computed. See the eval() method for details.
+ * Evaluates the function value and sets the gradients of the shell radius
+ * and width. Writing the model as
+ * \f$S_{\rm p} = {\tt m\_norm} \, (P_{\rm out} - P_{\rm in})\f$ with
+ * \f$P = \sqrt{x_{\rm r} - x}\f$ (see eval()), the derivatives with
+ * respect to the inner and outer shell radii are
+ *
+ * \f[
+ *    \frac{\partial S_{\rm p}}{\partial \theta_{\rm out}} =
+ *    \frac{\partial {\tt m\_norm}}{\partial \theta_{\rm out}}
+ *    (P_{\rm out} - P_{\rm in}) +
+ *    {\tt m\_norm} \frac{\partial P_{\rm out}}{\partial \theta_{\rm out}}
+ *    \quad {\rm and} \quad
+ *    \frac{\partial S_{\rm p}}{\partial \theta_{\rm in}} =
+ *    \frac{\partial {\tt m\_norm}}{\partial \theta_{\rm in}}
+ *    (P_{\rm out} - P_{\rm in}) -
+ *    {\tt m\_norm} \frac{\partial P_{\rm in}}{\partial \theta_{\rm in}}
+ * \f]
+ *
+ * where the normalization derivatives are computed by norm_gradient().
+ * As the radius parameter is the inner radius and the width parameter is
+ * the difference between outer and inner radius, the radius gradient is
+ * the sum of both derivatives while the width gradient is the derivative
+ * with respect to the outer radius.
+ *
+ * The derivative with respect to \f$\theta\f$ is stored so that
+ * GModelSpatialRadial::eval_gradients(const GPhoton&) can convert it into
+ * position gradients.
+ *
+ * The derivatives diverge at the inner and outer shell radius. They are
+ * set to zero exactly on these radii.
  ***************************************************************************/
 double GModelSpatialRadialShell::eval_gradients(const double&  theta,
                                                 const GEnergy& energy,
                                                 const GTime&   time) const
 {
-    // Return value
-    return (eval(theta, energy, time));
+    // Update precomputation cache
+    update();
+
+    // Set x and the derivative of x with respect to theta (divided by two)
+    // appropriately for the small angle approximation or not
+    double x;
+    double dx;
+    double r_in;
+    double r_out;
+    if (m_small_angle) {
+        x     = theta * theta;
+        dx    = theta;
+        r_in  = m_theta_in;
+        r_out = m_theta_out;
+    }
+    else {
+        x     = std::sin(theta);
+        dx    = x * std::cos(theta);
+        x    *= x;
+        r_in  = std::sin(m_theta_in)  * std::cos(m_theta_in);
+        r_out = std::sin(m_theta_out) * std::cos(m_theta_out);
+    }
+
+    // Compute value and derivatives of the shell profiles with respect to
+    // the outer and inner radius and with respect to theta
+    double value   = 0.0;
+    double d_out   = 0.0;
+    double d_in    = 0.0;
+    double d_theta = 0.0;
+    if (x < m_x_out) {
+        double p_out = std::sqrt(m_x_out - x);
+        value        = p_out;
+        d_out        = r_out / p_out;
+        d_theta      = -dx / p_out;
+        if (x < m_x_in) {
+            double p_in  = std::sqrt(m_x_in - x);
+            value       -= p_in;
+            d_in         = r_in / p_in;
+            d_theta     += dx / p_in;
+        }
+    }
+
+    // Compute derivatives with respect to outer and inner radius
+    double g_out = m_norm * (norm_gradient(m_theta_out, -1.0) * value + d_out);
+    double g_in  = m_norm * (norm_gradient(m_theta_in,  +1.0) * value - d_in);
+
+    // Compute parameter gradients
+    double g_radius = (m_radius.is_free())
+                      ? (g_in + g_out) * gammalib::deg2rad * m_radius.scale()
+                      : 0.0;
+    double g_width  = (m_width.is_free())
+                      ? g_out * gammalib::deg2rad * m_width.scale()
+                      : 0.0;
+
+    // Set gradients (circumvent const correctness)
+    GModelSpatialRadialShell* ptr = const_cast<GModelSpatialRadialShell*>(this);
+    ptr->m_radius.factor_gradient(g_radius);
+    ptr->m_width.factor_gradient(g_width);
+    ptr->m_ra.factor_gradient(0.0);
+    ptr->m_dec.factor_gradient(0.0);
+    ptr->m_theta_grad = m_norm * d_theta;
+
+    // Return normalised value
+    return (m_norm * value);
 }
 
 
@@ -647,7 +737,7 @@ void GModelSpatialRadialShell::init_members(void)
     m_radius.free();
     m_radius.scale(1.0);
     m_radius.gradient(0.0);
-    m_radius.has_grad(false);  // Radial components never have gradients
+    m_radius.has_grad(true);
 
     // Initialise Width
     m_width.clear();
@@ -658,7 +748,7 @@ void GModelSpatialRadialShell::init_members(void)
     m_width.free();
     m_width.scale(1.0);
     m_width.gradient(0.0);
-    m_width.has_grad(false);  // Radial components never have gradients
+    m_width.has_grad(true);
 
     // Set parameter pointer(s)
     m_pars.push_back(&m_radius);
@@ -844,3 +934,45 @@ double GModelSpatialRadialShell::f2(double x)
     // Return value
     return f2;
 }
+
+
+/***********************************************************************//**
+ * @brief Return relative normalization derivative
+ *
+ * @param[in] theta Shell radius (radians).
+ * @param[in] sign Sign of the radius contribution to the solid angle.
+ * @return Relative normalization derivative (per radian).
+ *
+ * Computes the derivative of the shell normalization with respect to the
+ * inner (@p sign=+1) or outer (@p sign=-1) shell radius, divided by the
+ * normalization:
+ *
+ * \f[
+ *    \frac{1}{\tt m\_norm}
+ *    \frac{\partial {\tt m\_norm}}{\partial \theta} =
+ *    {\rm sign} \times 2 \pi \, {\tt m\_norm} \, h(\theta)
+ * \f]
+ *
+ * where \f$h(\theta) = \theta^2\f$ in the small angle approximation and
+ * \f$h(\theta) = \sin \theta \cos \theta
+ *  \ln \left( \frac{1 + \sin \theta}{\cos \theta} \right)\f$ in the
+ * general case. \f$2 \pi h(\theta)\f$ is the derivative of the shell
+ * solid angle integral with respect to the radius.
+ ***************************************************************************/
+double GModelSpatialRadialShell::norm_gradient(const double& theta,
+                                               const double& sign) const
+{
+    // Compute derivative of solid angle integral
+    double h;
+    if (m_small_angle) {
+        h = theta * theta;
+    }
+    else {
+        double sin_theta = std::sin(theta);
+        double cos_theta = std::cos(theta);
+        h = sin_theta * cos_theta * std::log((1.0 + sin_theta) / cos_theta);
+    }
+
+    // Return relative normalization derivative
+    return (sign * gammalib::twopi * m_norm * h);
+}
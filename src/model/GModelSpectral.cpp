@@ -238,6 +238,80 @@ int GModelSpectral::size(void) const
 }
 
 
+/***********************************************************************//**
+ * @brief Evaluate model for an array of energies
+ *
+ * @param[in] logE Array of true photon energies (log10 of energy in MeV).
+ * @param[in] n Number of energies.
+ * @param[out] values Array of model values (n elements).
+ * @param[out] gradients Array of parameter gradients (n*size() elements,
+ *                       optional).
+ *
+ * Evaluates the spectral model for @p n energies. If @p gradients is not
+ * NULL, the parameter gradients with respect to the parameter factors are
+ * also computed. The gradients are stored parameter by parameter, i.e. the
+ * gradient of parameter @p ipar for energy @p i is stored in
+ * @p gradients[ipar*n+i]. Gradients of fixed parameters are zero.
+ *
+ * The base class implementation calls eval() or eval_gradients() for each
+ * energy. As a side effect, the parameter gradients of the model are set
+ * to the values for the last energy if gradients are requested.
+ ***************************************************************************/
+void GModelSpectral::eval(const double* logE, const int& n,
+                          double* values, double* gradients) const
+{
+    // Initialise energy and time
+    GEnergy srcEng;
+    GTime   srcTime;
+
+    // Case A: evaluate model values and gradients
+    if (gradients != NULL) {
+
+        // Get non-const pointer to model (circumvent const correctness)
+        GModelSpectral* model = const_cast<GModelSpectral*>(this);
+
+        // Loop over energies
+        for (int i = 0; i < n; ++i) {
+            srcEng.log10MeV(logE[i]);
+            values[i] = model->eval_gradients(srcEng, srcTime);
+            for (int ipar = 0; ipar < size(); ++ipar) {
+                gradients[ipar*n+i] = m_pars[ipar]->factor_gradient();
+            }
+        }
+
+    } // endif: gradients were requested
+
+    // Case B: evaluate model values only
+    else {
+        for (int i = 0; i < n; ++i) {
+            srcEng.log10MeV(logE[i]);
+            values[i] = eval(srcEng, srcTime);
+        }
+    }
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Return index of normalization parameter
+ *
+ * @return Index of normalization parameter (-1 if the model has none).
+ *
+ * Returns the index of the parameter to which the spectral model is
+ * proportional. Clients may use this information to rescale quantities
+ * that were computed for a given normalization instead of recomputing
+ * them. The base class implementation returns -1, signalling that the
+ * model has no such parameter.
+ ***************************************************************************/
+int GModelSpectral::norm_index(void) const
+{
+    // Return
+    return (-1);
+}
+
+
 /***********************************************************************//**
  * @brief Autoscale parameters
  *
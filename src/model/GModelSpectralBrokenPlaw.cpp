@@ -31,6 +31,7 @@
 #include <cmath>
 #include "GException.hpp"
 #include "GTools.hpp"
+#include "GMath.hpp"
 #include "GModelSpectralBrokenPlaw.hpp"
 #include "GModelSpectralRegistry.hpp"
 
@@ -387,6 +388,86 @@ double GModelSpectralBrokenPlaw::eval_gradients(const GEnergy& srcEng,
 }
 
 
+/***********************************************************************//**
+ * @brief Evaluate function for an array of energies
+ *
+ * @param[in] logE Array of true photon energies (log10 of energy in MeV).
+ * @param[in] n Number of energies.
+ * @param[out] values Array of model values (n elements).
+ * @param[out] gradients Array of parameter gradients (4*n elements,
+ *                       optional).
+ *
+ * Evaluates the broken power law for @p n energies. The method is
+ * equivalent to calling eval_gradients() for each energy, but it avoids
+ * the construction of GEnergy objects and the evaluation cache checks. The
+ * gradients are stored in the order of the parameters (normalisation,
+ * first index, break energy, second index), with @p n consecutive values
+ * for each parameter. The parameter gradients of the model are not
+ * modified.
+ ***************************************************************************/
+void GModelSpectralBrokenPlaw::eval(const double* logE, const int& n,
+                                    double* values, double* gradients) const
+{
+    // Get parameter values
+    double norm      = m_norm.value();
+    double index1    = m_index1.value();
+    double index2    = m_index2.value();
+    double log_break = std::log(m_breakenergy.value());
+
+    // Compute function values without normalisation. If gradients are
+    // requested then these values are stored in the normalisation gradient
+    // array.
+    double* power = (gradients != NULL) ? gradients : values;
+    for (int i = 0; i < n; ++i) {
+        double log_e_norm = logE[i] * gammalib::ln10 - log_break;
+        double index      = (log_e_norm < 0.0) ? index1 : index2;
+        power[i]          = std::exp(index * log_e_norm);
+    }
+
+    // Compute function values
+    for (int i = 0; i < n; ++i) {
+        values[i] = norm * power[i];
+    }
+
+    // Optionally compute partial derivatives of the parameter values
+    if (gradients != NULL) {
+
+        // Set gradient array pointers
+        double* g_norm   = gradients;
+        double* g_index1 = gradients + n;
+        double* g_break  = gradients + 2*n;
+        double* g_index2 = gradients + 3*n;
+
+        // Get gradient factors
+        double s_norm   = (m_norm.is_free())   ? m_norm.scale()   : 0.0;
+        double s_index1 = (m_index1.is_free()) ? m_index1.scale() : 0.0;
+        double s_index2 = (m_index2.is_free()) ? m_index2.scale() : 0.0;
+        double s_break  = (m_breakenergy.is_free())
+                          ? -1.0 / m_breakenergy.factor_value() : 0.0;
+
+        // Compute gradients
+        for (int i = 0; i < n; ++i) {
+            double log_e_norm = logE[i] * gammalib::ln10 - log_break;
+            g_norm[i] *= s_norm;
+            if (log_e_norm < 0.0) {
+                g_index1[i] = values[i] * s_index1 * log_e_norm;
+                g_index2[i] = 0.0;
+                g_break[i]  = values[i] * s_break * index1;
+            }
+            else {
+                g_index1[i] = 0.0;
+                g_index2[i] = values[i] * s_index2 * log_e_norm;
+                g_break[i]  = values[i] * s_break * index2;
+            }
+        }
+
+    } // endif: gradients were requested
+
+    // Return
+    return;
+}
+
+
 /***********************************************************************//**
  * @brief Returns model photon flux between [emin, emax] (units: ph/cm2/s)
  *
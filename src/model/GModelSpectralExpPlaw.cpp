@@ -31,6 +31,7 @@
 #include <cmath>
 #include "GException.hpp"
 #include "GTools.hpp"
+#include "GMath.hpp"
 #include "GIntegral.hpp"
 #include "GModelSpectralExpPlaw.hpp"
 #include "GModelSpectralRegistry.hpp"
@@ -384,6 +385,80 @@ double GModelSpectralExpPlaw::eval_gradients(const GEnergy& srcEng,
 }
 
 
+/***********************************************************************//**
+ * @brief Evaluate function for an array of energies
+ *
+ * @param[in] logE Array of true photon energies (log10 of energy in MeV).
+ * @param[in] n Number of energies.
+ * @param[out] values Array of model values (n elements).
+ * @param[out] gradients Array of parameter gradients (4*n elements,
+ *                       optional).
+ *
+ * Evaluates the exponentially cut off power law for @p n energies. The
+ * method is equivalent to calling eval_gradients() for each energy, but it
+ * avoids the construction of GEnergy objects and the evaluation cache
+ * checks. The gradients are stored in the order of the parameters
+ * (normalisation, index, cut-off energy, pivot energy), with @p n
+ * consecutive values for each parameter. The parameter gradients of the
+ * model are not modified.
+ ***************************************************************************/
+void GModelSpectralExpPlaw::eval(const double* logE, const int& n,
+                                 double* values, double* gradients) const
+{
+    // Get parameter values
+    double norm      = m_norm.value();
+    double index     = m_index.value();
+    double ecut      = m_ecut.value();
+    double log_pivot = std::log(m_pivot.value());
+
+    // Compute function values without normalisation. If gradients are
+    // requested then these values are stored in the normalisation gradient
+    // array.
+    double* power = (gradients != NULL) ? gradients : values;
+    for (int i = 0; i < n; ++i) {
+        double log_eng = logE[i] * gammalib::ln10;
+        power[i] = std::exp(index * (log_eng - log_pivot) -
+                            std::exp(log_eng) / ecut);
+    }
+
+    // Compute function values
+    for (int i = 0; i < n; ++i) {
+        values[i] = norm * power[i];
+    }
+
+    // Optionally compute partial derivatives of the parameter values
+    if (gradients != NULL) {
+
+        // Set gradient array pointers
+        double* g_norm  = gradients;
+        double* g_index = gradients + n;
+        double* g_ecut  = gradients + 2*n;
+        double* g_pivot = gradients + 3*n;
+
+        // Get gradient factors
+        double s_norm  = (m_norm.is_free())  ? m_norm.scale() : 0.0;
+        double s_index = (m_index.is_free()) ? m_index.scale() : 0.0;
+        double s_ecut  = (m_ecut.is_free())
+                         ? 1.0 / (ecut * m_ecut.factor_value()) : 0.0;
+        double s_pivot = (m_pivot.is_free())
+                         ? -index / m_pivot.factor_value() : 0.0;
+
+        // Compute gradients
+        for (int i = 0; i < n; ++i) {
+            double log_eng = logE[i] * gammalib::ln10;
+            g_norm[i] *= s_norm;
+            g_index[i] = values[i] * s_index * (log_eng - log_pivot);
+            g_ecut[i]  = values[i] * s_ecut  * std::exp(log_eng);
+            g_pivot[i] = values[i] * s_pivot;
+        }
+
+    } // endif: gradients were requested
+
+    // Return
+    return;
+}
+
+
 /***********************************************************************//**
  * @brief Returns model photon flux between [emin, emax] (units: ph/cm2/s)
  *
@@ -335,6 +335,54 @@ double GModelSpectralFunc::eval_gradients(const GEnergy& srcEng,
 }
 
 
+/***********************************************************************//**
+ * @brief Evaluate function for an array of energies
+ *
+ * @param[in] logE Array of true photon energies (log10 of energy in MeV).
+ * @param[in] n Number of energies.
+ * @param[out] values Array of model values (n elements).
+ * @param[out] gradients Array of parameter gradients (n elements,
+ *                       optional).
+ *
+ * Evaluates the file function for @p n energies. The method is equivalent
+ * to calling eval_gradients() for each energy, but it avoids the
+ * construction of GEnergy objects. The parameter gradients of the model
+ * are not modified.
+ ***************************************************************************/
+void GModelSpectralFunc::eval(const double* logE, const int& n,
+                              double* values, double* gradients) const
+{
+    // Get normalisation
+    double norm = m_norm.value();
+
+    // Interpolate function values without normalisation. This is done in
+    // log10-log10 space, but the linear value is returned. If gradients are
+    // requested then these values are stored in the normalisation gradient
+    // array.
+    double* func = (gradients != NULL) ? gradients : values;
+    for (int i = 0; i < n; ++i) {
+        double arg = m_log_nodes.interpolate(logE[i], m_log_values);
+        func[i]    = std::pow(10.0, arg);
+    }
+
+    // Compute function values
+    for (int i = 0; i < n; ++i) {
+        values[i] = norm * func[i];
+    }
+
+    // Optionally compute normalisation gradient
+    if (gradients != NULL) {
+        double s_norm = (m_norm.is_free()) ? m_norm.scale() : 0.0;
+        for (int i = 0; i < n; ++i) {
+            gradients[i] *= s_norm;
+        }
+    }
+
+    // Return
+    return;
+}
+
+
 /***********************************************************************//**
  * @brief Returns model photon flux between [emin, emax] (units: ph/cm2/s)
  *
@@ -365,12 +413,10 @@ double GModelSpectralFunc::flux(const GEnergy& emin, const GEnergy& emax) const
         double e_max = emax.MeV();
     
         // Determine left node index for minimum energy
-        m_lin_nodes.set_value(e_min);
-        int inx_emin = m_lin_nodes.inx_left();
+        int inx_emin = m_lin_nodes.lookup(e_min).inx_left;
 
         // Determine left node index for maximum energy
-        m_lin_nodes.set_value(e_max);
-        int inx_emax = m_lin_nodes.inx_left();
+        int inx_emax = m_lin_nodes.lookup(e_max).inx_left;
     
         // If both energies are within the same nodes then simply
         // integrate over the energy interval using the appropriate power
@@ -453,12 +499,10 @@ double GModelSpectralFunc::eflux(const GEnergy& emin, const GEnergy& emax) const
         double e_max = emax.MeV();
     
         // Determine left node index for minimum energy
-        m_lin_nodes.set_value(e_min);
-        int inx_emin = m_lin_nodes.inx_left();
+        int inx_emin = m_lin_nodes.lookup(e_min).inx_left;
 
         // Determine left node index for maximum energy
-        m_lin_nodes.set_value(e_max);
-        int inx_emax = m_lin_nodes.inx_left();
+        int inx_emax = m_lin_nodes.lookup(e_max).inx_left;
     
         // If both energies are within the same nodes then simply
         // integrate over the energy interval using the appropriate power
@@ -1015,12 +1059,10 @@ void GModelSpectralFunc::mc_update(const GEnergy& emin,
             double flux;
     
             // Determine left node index for minimum energy
-            m_lin_nodes.set_value(e_min);
-            int inx_emin = m_lin_nodes.inx_left();
+            int inx_emin = m_lin_nodes.lookup(e_min).inx_left;
 
             // Determine left node index for maximum energy
-            m_lin_nodes.set_value(e_max);
-            int inx_emax = m_lin_nodes.inx_left();
+            int inx_emax = m_lin_nodes.lookup(e_max).inx_left;
     
             // If both energies are within the same node then just
             // add this one node on the stack
@@ -31,6 +31,7 @@
 #include <cmath>
 #include "GException.hpp"
 #include "GTools.hpp"
+#include "GMath.hpp"
 #include "GIntegral.hpp"
 #include "GModelSpectralLogParabola.hpp"
 #include "GModelSpectralRegistry.hpp"
@@ -387,6 +388,80 @@ double GModelSpectralLogParabola::eval_gradients(const GEnergy& srcEng,
 }
 
 
+/***********************************************************************//**
+ * @brief Evaluate function for an array of energies
+ *
+ * @param[in] logE Array of true photon energies (log10 of energy in MeV).
+ * @param[in] n Number of energies.
+ * @param[out] values Array of model values (n elements).
+ * @param[out] gradients Array of parameter gradients (4*n elements,
+ *                       optional).
+ *
+ * Evaluates the log parabola for @p n energies. The method is equivalent
+ * to calling eval_gradients() for each energy, but it avoids the
+ * construction of GEnergy objects and the evaluation cache checks. The
+ * gradients are stored in the order of the parameters (normalisation,
+ * index, curvature, pivot energy), with @p n consecutive values for each
+ * parameter. The parameter gradients of the model are not modified.
+ ***************************************************************************/
+void GModelSpectralLogParabola::eval(const double* logE, const int& n,
+                                     double* values, double* gradients) const
+{
+    // Get parameter values
+    double norm      = m_norm.value();
+    double index     = m_index.value();
+    double curvature = m_curvature.value();
+    double log_pivot = std::log(m_pivot.value());
+
+    // Compute function values without normalisation. If gradients are
+    // requested then these values are stored in the normalisation gradient
+    // array.
+    double* power = (gradients != NULL) ? gradients : values;
+    for (int i = 0; i < n; ++i) {
+        double log_e_norm = logE[i] * gammalib::ln10 - log_pivot;
+        power[i] = std::exp((index + curvature * log_e_norm) * log_e_norm);
+    }
+
+    // Compute function values
+    for (int i = 0; i < n; ++i) {
+        values[i] = norm * power[i];
+    }
+
+    // Optionally compute partial derivatives of the parameter values
+    if (gradients != NULL) {
+
+        // Set gradient array pointers
+        double* g_norm      = gradients;
+        double* g_index     = gradients + n;
+        double* g_curvature = gradients + 2*n;
+        double* g_pivot     = gradients + 3*n;
+
+        // Get gradient factors
+        double s_norm      = (m_norm.is_free()) ? m_norm.scale() : 0.0;
+        double s_index     = (m_index.is_free()) ? m_index.scale() : 0.0;
+        double s_curvature = (m_curvature.is_free())
+                             ? m_curvature.scale() : 0.0;
+        double s_pivot     = (m_pivot.is_free())
+                             ? -1.0 / m_pivot.factor_value() : 0.0;
+
+        // Compute gradients
+        for (int i = 0; i < n; ++i) {
+            double log_e_norm = logE[i] * gammalib::ln10 - log_pivot;
+            g_norm[i]        *= s_norm;
+            g_index[i]        = values[i] * s_index * log_e_norm;
+            g_curvature[i]    = values[i] * s_curvature * log_e_norm *
+                                log_e_norm;
+            g_pivot[i]        = values[i] * s_pivot *
+                                (index + 2.0 * curvature * log_e_norm);
+        }
+
+    } // endif: gradients were requested
+
+    // Return
+    return;
+}
+
+
 /***********************************************************************//**
  * @brief Returns model photon flux between [emin, emax] (units: ph/cm2/s)
  *
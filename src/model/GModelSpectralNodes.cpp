@@ -305,14 +305,12 @@ double GModelSpectralNodes::eval_gradients(const GEnergy& srcEng,
     // Update evaluation cache
     update_eval_cache();
 
-    // Set interpolation value
-    m_log_energies.set_value(srcEng.log10MeV());
-
     // Get indices and weights for interpolation
-    int    inx_left  = m_log_energies.inx_left();
-    int    inx_right = m_log_energies.inx_right();
-    double wgt_left  = m_log_energies.wgt_left();
-    double wgt_right = m_log_energies.wgt_right();
+    GNodeArray::weights w = m_log_energies.lookup(srcEng.log10MeV());
+    int    inx_left  = w.inx_left;
+    int    inx_right = w.inx_right;
+    double wgt_left  = w.wgt_left;
+    double wgt_right = w.wgt_right;
 
     // Interpolate function
     double exponent = m_log_values[inx_left]  * wgt_left +
@@ -356,6 +354,70 @@ double GModelSpectralNodes::eval_gradients(const GEnergy& srcEng,
 }
 
 
+/***********************************************************************//**
+ * @brief Evaluate function for an array of energies
+ *
+ * @param[in] logE Array of true photon energies (log10 of energy in MeV).
+ * @param[in] n Number of energies.
+ * @param[out] values Array of model values (n elements).
+ * @param[out] gradients Array of parameter gradients (size()*n elements,
+ *                       optional).
+ *
+ * Evaluates the node function for @p n energies. The method is equivalent
+ * to calling eval_gradients() for each energy, but it updates the
+ * evaluation cache only once and avoids the construction of GEnergy
+ * objects. The gradients are stored in the order of the parameters (energy
+ * and intensity of the first node, energy and intensity of the second
+ * node, ...), with @p n consecutive values for each parameter. Only the
+ * intensity gradients of the two nodes that bracket an energy are
+ * non-zero. The parameter gradients of the model are not modified.
+ ***************************************************************************/
+void GModelSpectralNodes::eval(const double* logE, const int& n,
+                               double* values, double* gradients) const
+{
+    // Update evaluation cache
+    update_eval_cache();
+
+    // Initialise gradients
+    if (gradients != NULL) {
+        int num = size() * n;
+        for (int i = 0; i < num; ++i) {
+            gradients[i] = 0.0;
+        }
+    }
+
+    // Loop over energies
+    for (int i = 0; i < n; ++i) {
+
+        // Get indices and weights for interpolation
+        GNodeArray::weights w = m_log_energies.lookup(logE[i]);
+
+        // Interpolate function. This is done in log10-log10 space, but the
+        // linear value is returned.
+        double exponent = m_log_values[w.inx_left]  * w.wgt_left +
+                          m_log_values[w.inx_right] * w.wgt_right;
+        values[i]       = std::pow(10.0, exponent);
+
+        // Optionally compute gradients for left and right node. The
+        // intensity of node k is parameter 2*k+1.
+        if (gradients != NULL) {
+            if (m_values[w.inx_left].is_free()) {
+                gradients[(2*w.inx_left+1)*n+i] = values[i] * w.wgt_left /
+                    m_values[w.inx_left].factor_value();
+            }
+            if (m_values[w.inx_right].is_free()) {
+                gradients[(2*w.inx_right+1)*n+i] = values[i] * w.wgt_right /
+                    m_values[w.inx_right].factor_value();
+            }
+        }
+
+    } // endfor: looped over energies
+
+    // Return
+    return;
+}
+
+
 /***********************************************************************//**
  * @brief Returns model photon flux between [emin, emax] (units: ph/cm2/s)
  *
@@ -389,12 +451,10 @@ double GModelSpectralNodes::flux(const GEnergy& emin, const GEnergy& emax) const
         double e_max = emax.MeV();
     
         // Determine left node index for minimum energy
-        m_lin_energies.set_value(e_min);
-        int inx_emin = m_lin_energies.inx_left();
+        int inx_emin = m_lin_energies.lookup(e_min).inx_left;
 
         // Determine left node index for maximum energy
-        m_lin_energies.set_value(e_max);
-        int inx_emax = m_lin_energies.inx_left();
+        int inx_emax = m_lin_energies.lookup(e_max).inx_left;
     
         // If both energies are within the same nodes then simply
         // integrate over the energy interval using the appropriate power
@@ -476,12 +536,10 @@ double GModelSpectralNodes::eflux(const GEnergy& emin, const GEnergy& emax) cons
         double e_max = emax.MeV();
     
         // Determine left node index for minimum energy
-        m_lin_energies.set_value(e_min);
-        int inx_emin = m_lin_energies.inx_left();
+        int inx_emin = m_lin_energies.lookup(e_min).inx_left;
 
         // Determine left node index for maximum energy
-        m_lin_energies.set_value(e_max);
-        int inx_emax = m_lin_energies.inx_left();
+        int inx_emax = m_lin_energies.lookup(e_max).inx_left;
     
         // If both energies are within the same nodes then simply
         // integrate over the energy interval using the appropriate power
@@ -1576,12 +1634,10 @@ void GModelSpectralNodes::mc_update(const GEnergy& emin, const GEnergy& emax) co
             double flux;
     
             // Determine left node index for minimum energy
-            m_lin_energies.set_value(e_min);
-            int inx_emin = m_lin_energies.inx_left();
+            int inx_emin = m_lin_energies.lookup(e_min).inx_left;
 
             // Determine left node index for maximum energy
-            m_lin_energies.set_value(e_max);
-            int inx_emax = m_lin_energies.inx_left();
+            int inx_emax = m_lin_energies.lookup(e_max).inx_left;
     
             // If both energies are within the same node then just
             // add this one node on the stack
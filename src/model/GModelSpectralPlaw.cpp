@@ -31,6 +31,7 @@
 #include <cmath>
 #include "GException.hpp"
 #include "GTools.hpp"
+#include "GMath.hpp"
 #include "GModelSpectralPlaw.hpp"
 #include "GModelSpectralRegistry.hpp"
 
@@ -365,6 +366,78 @@ double GModelSpectralPlaw::eval_gradients(const GEnergy& srcEng,
 }
 
 
+/***********************************************************************//**
+ * @brief Evaluate function for an array of energies
+ *
+ * @param[in] logE Array of true photon energies (log10 of energy in MeV).
+ * @param[in] n Number of energies.
+ * @param[out] values Array of model values (n elements).
+ * @param[out] gradients Array of parameter gradients (3*n elements,
+ *                       optional).
+ *
+ * Evaluates the power law for @p n energies. The method is equivalent to
+ * calling eval_gradients() for each energy, but it avoids the construction
+ * of GEnergy objects and the evaluation cache checks. The loops have no
+ * dependencies between the iterations and can be vectorised by the
+ * compiler. The gradients are stored in the order of the parameters
+ * (normalisation, index, pivot energy), with @p n consecutive values for
+ * each parameter. The parameter gradients of the model are not modified.
+ ***************************************************************************/
+void GModelSpectralPlaw::eval(const double* logE, const int& n,
+                              double* values, double* gradients) const
+{
+    // Get parameter values
+    double norm      = m_norm.value();
+    double index     = m_index.value();
+    double log_pivot = std::log(m_pivot.value());
+
+    // Compute power law values. If gradients are requested then the power
+    // law values are stored in the normalisation gradient array.
+    double* power = (gradients != NULL) ? gradients : values;
+    for (int i = 0; i < n; ++i) {
+        power[i] = std::exp(index * (logE[i] * gammalib::ln10 - log_pivot));
+    }
+
+    // Compute function values
+    for (int i = 0; i < n; ++i) {
+        values[i] = norm * power[i];
+    }
+
+    // Optionally compute partial derivatives of the parameter values
+    if (gradients != NULL) {
+
+        // Set gradient array pointers
+        double* g_norm  = gradients;
+        double* g_index = gradients + n;
+        double* g_pivot = gradients + 2*n;
+
+        // Normalisation gradient
+        double s_norm = (m_norm.is_free()) ? m_norm.scale() : 0.0;
+        for (int i = 0; i < n; ++i) {
+            g_norm[i] *= s_norm;
+        }
+
+        // Index gradient
+        double s_index = (m_index.is_free()) ? m_index.scale() : 0.0;
+        for (int i = 0; i < n; ++i) {
+            g_index[i] = values[i] * s_index *
+                         (logE[i] * gammalib::ln10 - log_pivot);
+        }
+
+        // Pivot energy gradient
+        double s_pivot = (m_pivot.is_free())
+                         ? -index / m_pivot.factor_value() : 0.0;
+        for (int i = 0; i < n; ++i) {
+            g_pivot[i] = values[i] * s_pivot;
+        }
+
+    } // endif: gradients were requested
+
+    // Return
+    return;
+}
+
+
 /***********************************************************************//**
  * @brief Returns model photon flux between [emin, emax] (units: ph/cm2/s)
  *
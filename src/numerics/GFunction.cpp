@@ -125,6 +125,30 @@ GFunction& GFunction::operator=(const GFunction& function)
  =                                                                         =
  ==========================================================================*/
 
+/***********************************************************************//**
+ * @brief Evaluate function for an array of values
+ *
+ * @param[in] x Pointer to array of function arguments.
+ * @param[out] y Pointer to array of function values.
+ * @param[in] n Number of function arguments.
+ *
+ * Evaluates the function for @p n arguments, e.g. y[i]=eval(x[i]). This
+ * default implementation calls the eval() method for every argument.
+ * Derived classes may implement the method to share computations between
+ * arguments or to allow the compiler to vectorise the evaluation.
+ ***************************************************************************/
+void GFunction::eval(const double* x, double* y, const int& n)
+{
+    // Evaluate function for all arguments
+    for (int i = 0; i < n; ++i) {
+        y[i] = eval(x[i]);
+    }
+
+    // Return
+    return;
+}
+
+
 /*==========================================================================
  =                                                                         =
  =                             Private methods                             =
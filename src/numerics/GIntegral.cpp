@@ -28,12 +28,74 @@
 #include <cmath>            // For std::abs()
 #include <vector>
 #include "GIntegral.hpp"
+#include "GException.hpp"
 #include "GTools.hpp"
 
 /* __ Method name definitions ____________________________________________ */
 #define G_ROMB                      "GIntegral::romb(double&, double&, int&)"
 #define G_TRAPZD          "GIntegral::trapzd(double&, double&, int&, double)"
 #define G_POLINT  "GIntegral::polint(double*, double*, int, double, double*)"
+#define G_GAUSS_KRONROD          "GIntegral::gauss_kronrod(double&, double&)"
+#define G_GAUSS_LEGENDRE  "GIntegral::gauss_legendre(double&, double&, int&)"
+
+/* __ Constants __________________________________________________________ */
+const int block_size = 64;           //!< Number of abscissae per kernel call
+
+/* Gauss-Kronrod 15-point abscissae and weights, and weights of the embedded
+   7-point Gauss rule (abscissae xgk15[1], xgk15[3], xgk15[5], xgk15[7]) */
+const double xgk15[8] = {0.991455371120812639206854697526329,
+                         0.949107912342758524526189684047851,
+                         0.864864423359769072789712788640926,
+                         0.741531185599394439863864773280788,
+                         0.586087235467691130294144845693013,
+                         0.405845151377397166906606412076961,
+                         0.207784955007898467600689403773245,
+                         0.000000000000000000000000000000000};
+const double wgk15[8] = {0.022935322010529224963732008058970,
+                         0.063092092629978553290700663189204,
+                         0.104790010322250183839876322541518,
+                         0.140653259715525918745189590510238,
+                         0.169004726639267902826583426598550,
+                         0.190350578064785409913256402421014,
+                         0.204432940075298892414161999234649,
+                         0.209482141084727828012999174891714};
+const double wg7[4]   = {0.129484966168869693270611432679082,
+                         0.279705391489276667901467771423780,
+                         0.381830050505118944950369775488975,
+                         0.417959183673469387755102040816327};
+
+/* Gauss-Legendre abscissae and weights for the positive abscissae of
+   orders 4, 8, 16 and 32 */
+const double xgl4[2]   = {0.86113631159405257522, 0.33998104358485626480};
+const double wgl4[2]   = {0.34785484513745385737, 0.65214515486254614263};
+const double xgl8[4]   = {0.96028985649753623168, 0.79666647741362673959,
+                          0.52553240991632898582, 0.18343464249564980494};
+const double wgl8[4]   = {0.10122853629037625915, 0.22238103445337447054,
+                          0.31370664587788728734, 0.36268378337836198297};
+const double xgl16[8]  = {0.98940093499164993260, 0.94457502307323257608,
+                          0.86563120238783174388, 0.75540440835500303390,
+                          0.61787624440264374845, 0.45801677765722738634,
+                          0.28160355077925891323, 0.09501250983763744019};
+const double wgl16[8]  = {0.02715245941175409485, 0.06225352393864789286,
+                          0.09515851168249278481, 0.12462897125553387205,
+                          0.14959598881657673208, 0.16915651939500253819,
+                          0.18260341504492358887, 0.18945061045506849629};
+const double xgl32[16] = {0.99726386184948156354, 0.98561151154526833540,
+                          0.96476225558750643077, 0.93490607593773968917,
+                          0.89632115576605212397, 0.84936761373256997013,
+                          0.79448379596794240696, 0.73218211874028968039,
+                          0.66304426693021520098, 0.58771575724076232904,
+                          0.50689990893222939002, 0.42135127613063534536,
+                          0.33186860228212764978, 0.23928736225213707454,
+                          0.14447196158279649349, 0.04830766568773831623};
+const double wgl32[16] = {0.00701861000947009660, 0.01627439473090567061,
+                          0.02539206530926205946, 0.03427386291302143310,
+                          0.04283589802222668066, 0.05099805926237617620,
+                          0.05868409347853554715, 0.06582222277636184684,
+                          0.07234579410884850623, 0.07819389578707030647,
+                          0.08331192422694675522, 0.08765209300440381114,
+                          0.09117387869576388471, 0.09384439908080456564,
+                          0.09563872007927485942, 0.09654008851472780057};
 
 /* __ Macros _____________________________________________________________ */
 
@@ -197,8 +259,10 @@ GIntegral* GIntegral::clone(void) const
  ***************************************************************************/
 double GIntegral::romb(const double& a, const double& b, const int& k)
 {
-    // Initialise result
+    // Initialise result, error estimate and number of kernel calls
     double result = 0.0;
+    m_error       = 0.0;
+    m_calls       = 0;
     
     // Continue only if integration range is valid
     if (b > a) {
@@ -248,6 +312,9 @@ double GIntegral::romb(const double& a, const double& b, const int& k)
 
         } // endfor: iterative loop
 
+        // Store error estimate
+        m_error = std::abs(dss);
+
         // Free temporal storage
         delete [] s;
         delete [] h;
@@ -285,11 +352,21 @@ double GIntegral::romb(const double& a, const double& b, const int& k)
  * The original Numerical Recipes function had result declared as a static
  * variable, yet this led to some untrackable integration problems. For this
  * reason, previous results are now passed using an argument.
- * Result initialisation is done if n=1.
+ * Result initialisation is done if n=1. Since n=1 starts a new sequence of
+ * refinement steps, the number of kernel calls and the error estimate are
+ * also reset in that case, so that calls() reports the kernel calls of the
+ * current sequence also if trapzd() is called directly.
  ***************************************************************************/
 double GIntegral::trapzd(const double& a, const double& b, const int& n,
                          double result)
 {
+    // Reset kernel call counter and error estimate at the start of a new
+    // sequence of refinement steps
+    if (n == 1) {
+        m_calls = 0;
+        m_error = 0.0;
+    }
+
     // Handle case of identical boundaries
     if (a == b) {
         result = 0.0;
@@ -304,6 +381,7 @@ double GIntegral::trapzd(const double& a, const double& b, const int& n,
             // Evaluate integrand at boundaries
             double y_a = m_kernel->eval(a);
             double y_b = m_kernel->eval(b);
+            m_calls  += 2;
             
             // Compute result
             result = 0.5*(b-a)*(y_a + y_b);
@@ -347,18 +425,30 @@ double GIntegral::trapzd(const double& a, const double& b, const int& n,
                 gammalib::warning(G_TRAPZD, msg);
             }
 
-            // Sum up values
+            // Sum up values. The new abscissae are evaluated in blocks so
+            // that the kernel can evaluate many abscissae at once.
             double x   = a + 0.5*del;
             double sum = 0.0;
-            for (int j = 0; j < it; ++j, x+=del) {
-                
+            double xs[block_size];
+            double ys[block_size];
+            for (int j = 0; j < it; j += block_size) {
+
+                // Set abscissae of block
+                int num = (it-j < block_size) ? it-j : block_size;
+                for (int k = 0; k < num; ++k, x+=del) {
+                    xs[k] = x;
+                }
+
                 // Evaluate integrand
-                double y = m_kernel->eval(x);
+                m_kernel->eval(xs, ys, num);
 
                 // Add integrand
-                sum += y;
+                for (int k = 0; k < num; ++k) {
+                    sum += ys[k];
+                }
                 
-            } // endfor: looped over steps
+            } // endfor: looped over blocks of steps
+            m_calls += it;
 
             // Set result
             result = 0.5*(result + (b-a)*sum/tnm);
@@ -371,6 +461,197 @@ double GIntegral::trapzd(const double& a, const double& b, const int& n,
 }
 
 
+/***********************************************************************//**
+ * @brief Perform adaptive Gauss-Kronrod integration
+ *
+ * @param[in] a Left integration boundary.
+ * @param[in] b Right integration boundary.
+ * @return Integral of kernel from @p a to @p b.
+ *
+ * Returns the integral of the kernel from @p a to @p b using an adaptive
+ * 15-point Gauss-Kronrod rule. The integration interval with the largest
+ * error estimate is bisected until the sum of the error estimates of all
+ * intervals does not exceed m_eps times the absolute value of the
+ * integral, or until m_max_iter bisections were performed. The number of
+ * bisections is returned by iter(), the sum of the error estimates is
+ * returned by error().
+ *
+ * For smooth kernels the method needs considerably fewer kernel calls
+ * than romb() for the same accuracy.
+ ***************************************************************************/
+double GIntegral::gauss_kronrod(const double& a, const double& b)
+{
+    // Initialise result, number of iterations and number of kernel calls
+    double result = 0.0;
+    m_error       = 0.0;
+    m_iter        = 0;
+    m_calls       = 0;
+
+    // Continue only if integration range is valid
+    if (b > a) {
+
+        // Integrate over full interval
+        double              error = 0.0;
+        double              value = gk15(a, b, &error);
+        std::vector<double> lower(1, a);
+        std::vector<double> upper(1, b);
+        std::vector<double> values(1, value);
+        std::vector<double> errors(1, error);
+
+        // Initialise result and error
+        result  = value;
+        m_error = error;
+
+        // Bisect intervals until convergence
+        while (m_error > m_eps * std::abs(result) && m_iter < m_max_iter) {
+
+            // Find interval with largest error
+            int imax = 0;
+            for (int i = 1; i < errors.size(); ++i) {
+                if (errors[i] > errors[imax]) {
+                    imax = i;
+                }
+            }
+
+            // Bisect interval
+            double centre = 0.5 * (lower[imax] + upper[imax]);
+            double error1 = 0.0;
+            double error2 = 0.0;
+            double value1 = gk15(lower[imax], centre, &error1);
+            double value2 = gk15(centre, upper[imax], &error2);
+
+            // Replace interval by both halves
+            lower.push_back(centre);
+            upper.push_back(upper[imax]);
+            values.push_back(value2);
+            errors.push_back(error2);
+            upper[imax]  = centre;
+            values[imax] = value1;
+            errors[imax] = error1;
+
+            // Sum values and errors of all intervals
+            result  = 0.0;
+            m_error = 0.0;
+            for (int i = 0; i < values.size(); ++i) {
+                result  += values[i];
+                m_error += errors[i];
+            }
+
+            // Increment number of iterations
+            m_iter++;
+
+        } // endwhile: bisected intervals
+
+        // Dump warning
+        if (!m_silent) {
+            if (m_error > m_eps * std::abs(result)) {
+                std::string msg = "Integration uncertainty "+
+                                  gammalib::str(m_error)+
+                                  " exceeds tolerance of "+
+                                  gammalib::str(m_eps * std::abs(result))+
+                                  " after "+gammalib::str(m_iter)+
+                                  " bisections. Result "+
+                                  gammalib::str(result)+
+                                  " is inaccurate.";
+                gammalib::warning(G_GAUSS_KRONROD, msg);
+            }
+        }
+
+    } // endif: integration range was valid
+
+    // Return result
+    return result;
+}
+
+
+/***********************************************************************//**
+ * @brief Perform Gauss-Legendre integration
+ *
+ * @param[in] a Left integration boundary.
+ * @param[in] b Right integration boundary.
+ * @param[in] n Order of Gauss-Legendre rule (4, 8, 16 or 32; default: 16).
+ * @return Integral of kernel from @p a to @p b.
+ *
+ * @exception GException::invalid_argument
+ *            Unsupported order specified.
+ *
+ * Returns the integral of the kernel from @p a to @p b using a fixed-order
+ * Gauss-Legendre rule with @p n precomputed nodes. The rule is exact for
+ * polynomials of degree up to 2n-1. No error estimate is computed, hence
+ * the method is suited for smooth kernels for which the required order is
+ * known, such as kernels that are integrated many times.
+ ***************************************************************************/
+double GIntegral::gauss_legendre(const double& a, const double& b,
+                                 const int& n)
+{
+    // Select abscissae and weights
+    const double* x = NULL;
+    const double* w = NULL;
+    switch (n) {
+    case 4:
+        x = xgl4;
+        w = wgl4;
+        break;
+    case 8:
+        x = xgl8;
+        w = wgl8;
+        break;
+    case 16:
+        x = xgl16;
+        w = wgl16;
+        break;
+    case 32:
+        x = xgl32;
+        w = wgl32;
+        break;
+    default:
+        std::string msg = "Gauss-Legendre order "+gammalib::str(n)+" is not"
+                          " supported. Please specify an order of 4, 8, 16"
+                          " or 32.";
+        throw GException::invalid_argument(G_GAUSS_LEGENDRE, msg);
+        break;
+    }
+
+    // Initialise result, error estimate and number of kernel calls
+    double result = 0.0;
+    m_error       = 0.0;
+    m_calls       = 0;
+
+    // Continue only if integration range is non-empty
+    if (a != b) {
+
+        // Compute centre and half length of interval
+        double centre = 0.5 * (a + b);
+        double half   = 0.5 * (b - a);
+
+        // Set symmetric abscissae
+        double xs[32];
+        double ys[32];
+        for (int i = 0; i < n/2; ++i) {
+            double dx = half * x[i];
+            xs[2*i]   = centre - dx;
+            xs[2*i+1] = centre + dx;
+        }
+
+        // Evaluate kernel
+        m_kernel->eval(xs, ys, n);
+        m_calls = n;
+
+        // Sum kernel values
+        for (int i = 0; i < n/2; ++i) {
+            result += w[i] * (ys[2*i] + ys[2*i+1]);
+        }
+
+        // Scale result
+        result *= half;
+
+    } // endif: integration range was non-empty
+
+    // Return result
+    return result;
+}
+
+
 /***********************************************************************//**
  * @brief Print integral information
  *
@@ -424,6 +705,8 @@ void GIntegral::init_members(void)
     m_eps       = 1.0e-6;
     m_max_iter  = 20;
     m_iter      = 0;
+    m_calls     = 0;
+    m_error     = 0.0;
     m_silent    = false;
 
     // Return
@@ -443,6 +726,8 @@ void GIntegral::copy_members(const GIntegral& integral)
     m_eps      = integral.m_eps;
     m_max_iter = integral.m_max_iter;
     m_iter     = integral.m_iter;
+    m_calls    = integral.m_calls;
+    m_error    = integral.m_error;
     m_silent   = integral.m_silent;
 
     // Return
@@ -535,3 +820,88 @@ double GIntegral::polint(double* xa, double* ya, int n, double x, double* dy)
     // Return
     return y;
 }
+
+
+/***********************************************************************//**
+ * @brief Perform 15-point Gauss-Kronrod integration
+ *
+ * @param[in] a Left integration boundary.
+ * @param[in] b Right integration boundary.
+ * @param[out] error Error estimate.
+ * @return Integral of kernel from @p a to @p b.
+ *
+ * Computes the integral using the 15-point Kronrod rule. The error is
+ * estimated from the difference to the embedded 7-point Gauss rule,
+ * following the QUADPACK QK15 prescription.
+ ***************************************************************************/
+double GIntegral::gk15(const double& a, const double& b, double* error)
+{
+    // Compute centre and half length of interval
+    double centre = 0.5 * (a + b);
+    double half   = 0.5 * (b - a);
+
+    // Set abscissae (centre, followed by symmetric abscissae)
+    double xs[15];
+    double ys[15];
+    xs[0] = centre;
+    for (int j = 0; j < 7; ++j) {
+        double dx = half * xgk15[j];
+        xs[2*j+1] = centre - dx;
+        xs[2*j+2] = centre + dx;
+    }
+
+    // Evaluate kernel
+    m_kernel->eval(xs, ys, 15);
+    m_calls += 15;
+
+    // Sum kernel values at centre
+    double fc     = ys[0];
+    double resg   = fc * wg7[3];
+    double resk   = fc * wgk15[7];
+    double resabs = std::abs(resk);
+
+    // Sum kernel values at symmetric abscissae
+    double fv1[7];
+    double fv2[7];
+    for (int j = 0; j < 7; ++j) {
+        double f1   = ys[2*j+1];
+        double f2   = ys[2*j+2];
+        double fsum = f1 + f2;
+        fv1[j]      = f1;
+        fv2[j]      = f2;
+        resk       += wgk15[j] * fsum;
+        resabs     += wgk15[j] * (std::abs(f1) + std::abs(f2));
+        if (j % 2 == 1) {
+            resg += wg7[j/2] * fsum;
+        }
+    }
+
+    // Compute integral of absolute deviation from mean
+    double mean   = 0.5 * resk;
+    double resasc = wgk15[7] * std::abs(fc - mean);
+    for (int j = 0; j < 7; ++j) {
+        resasc += wgk15[j] * (std::abs(fv1[j] - mean) + std::abs(fv2[j] - mean));
+    }
+
+    // Scale results
+    double result = resk * half;
+    resabs       *= std::abs(half);
+    resasc       *= std::abs(half);
+
+    // Compute error estimate
+    double err = std::abs((resk - resg) * half);
+    if (resasc != 0.0 && err != 0.0) {
+        double scale = std::pow(200.0 * err / resasc, 1.5);
+        err          = (scale < 1.0) ? resasc * scale : resasc;
+    }
+    if (resabs > 2.2250738585072014e-308 / (50.0 * 2.220446049250313e-16)) {
+        double min_err = 50.0 * 2.220446049250313e-16 * resabs;
+        if (err < min_err) {
+            err = min_err;
+        }
+    }
+    *error = err;
+
+    // Return result
+    return result;
+}
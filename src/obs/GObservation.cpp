@@ -28,6 +28,7 @@
 #ifdef HAVE_CONFIG_H
 #include <config.h>
 #endif
+#include <algorithm>
 #include "GException.hpp"
 #include "GObservation.hpp"
 #include "GModelSky.hpp"
@@ -39,6 +40,11 @@
 #include "GEventList.hpp"
 #include "GEventBin.hpp"
 
+/* __ OpenMP section _____________________________________________________ */
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 /* __ Method name definitions ____________________________________________ */
 #define G_LIKELIHOOD           "GObservation::likelihood(GModels&, GVector*,"\
                                                   " GMatrixSparse*, double*)"
@@ -47,6 +53,8 @@
 #define G_EVENTS                                     "GObservation::events()"
 #define G_NPRED_TEMP                 "GObservation::npred_temp(GModel&, int)"
 #define G_NPRED_SPEC              "GObservation::npred_spec(GModel&, GTime&)"
+#define G_NPRED_SPEC_GRAD    "GObservation::npred_spec_grad(GModelSky&, GTime&,"\
+                                 " std::vector<double>&, std::vector<bool>&)"
 #define G_NPRED_SPAT       "GObservation::npred_spat(GModel&, int, GEnergy&,"\
                                                                    " GTime&)"
 #define G_NPRED_KERN            "GObservation::npred_kern(GModel&, GSkyDir&,"\
@@ -62,6 +70,9 @@
 /* __ Constants __________________________________________________________ */
 const double minmod = 1.0e-100;                      //!< Minimum model value
 const double minerr = 1.0e-100;                //!< Minimum statistical error
+const int    minchunk = 1000;             //!< Minimum number of events per chunk
+const int    dense_max_pars = 1000;    //!< Maximum parameters for dense curv.
+const double dense_min_fill = 0.01;        //!< Minimum fill for dense curv.
 
 /* __ Macros _____________________________________________________________ */
 
@@ -240,6 +251,12 @@ double GObservation::likelihood(const GModels& models,
 
     } // endelse: binned analysis
 
+    // Free dense curvature accumulator unless the workspaces should be
+    // kept for further evaluations
+    if (!m_keep_chunks) {
+        free_dense_curvature();
+    }
+
     // Return likelihood
     return value;
 }
@@ -340,6 +357,9 @@ double GObservation::model(const GModels& models, const GEvent& event,
  * The method will only operate on models for which the list of instruments
  * and observation identifiers matches those of the observation. Models that
  * do not match will be skipped.
+ *
+ * If the Npred cache is used (see use_npred_cache()), Npred and its
+ * gradients are obtained from npred_cached().
  ***************************************************************************/
 double GObservation::npred(const GModels& models, GVector* gradient) const
 {
@@ -374,14 +394,16 @@ double GObservation::npred(const GModels& models, GVector* gradient) const
             // observation identifier
             if (mptr->is_valid(instrument(), id())) {
 
-                // Determine Npred for model
-                npred += npred_temp(*mptr);
+                // If the Npred cache is used then determine Npred and
+                // optionally Npred gradients using the cache
+                if (m_use_npred_cache) {
+                    npred += npred_cached(*mptr, gradient, igrad);
+                }
 
-                // Optionally determine Npred gradients
-                if (gradient != NULL) {
-                    for (int k = 0; k < mptr->size(); ++k) {
-                        (*gradient)[igrad+k] = npred_grad(*mptr, k);
-                    }
+                // ... otherwise compute Npred and optionally Npred
+                // gradients for model
+                else {
+                    npred += npred_gradients(*mptr, gradient, igrad);
                 }
 
             } // endif: model component was valid for instrument
@@ -647,6 +669,267 @@ double GObservation::npred_grad(const GModel& model, const int& ipar) const
 }
 
 
+/***********************************************************************//**
+ * @brief Return Npred and optionally Npred gradients of a model
+ *
+ * @param[in] model Model.
+ * @param[out] gradient Model parameter gradients (optional).
+ * @param[in] igrad Index of first model parameter in gradient vector.
+ * @return Number of predicted counts for model.
+ *
+ * Returns the number of predicted counts for a model, and if @p gradient
+ * is not NULL, the gradients with respect to all model parameters.
+ *
+ * For sky models with a constant temporal component, Npred and the
+ * gradients with respect to all spectral parameters are obtained from a
+ * single spectral integration pass using npred_spec_grad(). Gradients of
+ * other sky models with respect to the spectral normalization (see
+ * GModelSpectral::norm_index()) are computed as Npred divided by the
+ * parameter factor value, since Npred is proportional to the
+ * normalization. All remaining gradients are computed numerically using
+ * npred_grad().
+ ***************************************************************************/
+double GObservation::npred_gradients(const GModel& model, GVector* gradient,
+                                     const int& igrad) const
+{
+    // If no gradients are requested then simply return Npred
+    if (gradient == NULL) {
+        return (npred_temp(model));
+    }
+
+    // Initialise Npred and spectral gradient information
+    double              npred  = 0.0;
+    int                 ispec  = 0;
+    bool                done   = false;
+    std::vector<double> gradients;
+    std::vector<bool>   analytic;
+
+    // Get sky model pointer
+    const GModelSky* sky = dynamic_cast<const GModelSky*>(&model);
+
+    // Case A: sky model with constant temporal component: compute Npred
+    // and spectral gradients in one spectral integration pass
+    if (sky != NULL && sky->is_constant() && sky->spatial() != NULL &&
+        sky->spectral() != NULL && sky->temporal() != NULL) {
+
+        // Get ontime
+        double ontime = events()->gti().ontime();
+
+        // Compute Npred and spectral gradients only if ontime is positive
+        if (ontime > 0.0) {
+            npred = npred_spec_grad(*sky, events()->gti().tstart(),
+                                    gradients, analytic) * ontime;
+            for (int i = 0; i < gradients.size(); ++i) {
+                gradients[i] *= ontime;
+            }
+        }
+        else {
+            gradients.assign(sky->spectral()->size(), 0.0);
+            analytic.assign(sky->spectral()->size(), true);
+        }
+        ispec = sky->spatial()->size();
+        done  = true;
+
+    } // endif: sky model with constant temporal component
+
+    // Case B: otherwise compute Npred by temporal integration
+    else {
+        npred = npred_temp(model);
+    }
+
+    // Get index of normalization parameter for sky models
+    int inorm = -1;
+    if (sky != NULL && sky->spectral() != NULL &&
+        sky->spectral()->norm_index() >= 0) {
+        int nspat = (sky->spatial() != NULL) ? sky->spatial()->size() : 0;
+        inorm     = nspat + sky->spectral()->norm_index();
+    }
+
+    // Compute gradients
+    for (int k = 0; k < model.size(); ++k) {
+
+        // Initialise gradient
+        double grad = 0.0;
+
+        // Use spectral gradient if it was computed analytically
+        int ipar = k - ispec;
+        if (done && ipar >= 0 && ipar < analytic.size() && analytic[ipar]) {
+            grad = gradients[ipar];
+        }
+
+        // ... otherwise if parameter is the normalization then divide Npred
+        // by the parameter factor value
+        else if (k == inorm && model[k].factor_value() != 0.0) {
+            if (model[k].is_free()) {
+                grad = npred / model[k].factor_value();
+            }
+        }
+
+        // ... otherwise compute gradient numerically
+        else {
+            grad = npred_grad(model, k);
+        }
+
+        // Store gradient
+        (*gradient)[igrad+k] = grad;
+
+    } // endfor: looped over parameters
+
+    // Return Npred
+    return npred;
+}
+
+
+/***********************************************************************//**
+ * @brief Return Npred (and optionally gradients) of a model using the cache
+ *
+ * @param[in] model Model.
+ * @param[out] gradient Model parameter gradients (optional).
+ * @param[in] igrad Index of first model parameter in gradient vector.
+ * @return Number of predicted counts for model.
+ *
+ * Returns the number of predicted counts for a model, using the Npred cache
+ * of the observation. Cache entries are identified by the model name and
+ * hold the parameter values, scales and free flags for which they were
+ * computed. Npred and the gradients are only recomputed if any of them
+ * differs from the cached values.
+ *
+ * For sky models with a spectral component that is proportional to a
+ * normalization parameter (see GModelSpectral::norm_index()), Npred is
+ * proportional to that parameter. In this case the normalization is
+ * excluded from the comparison, the cache stores Npred and the gradients
+ * per unit normalization and rescales them. The gradient with respect to
+ * the normalization does not depend on the normalization and is returned
+ * as is.
+ ***************************************************************************/
+double GObservation::npred_cached(const GModel& model, GVector* gradient,
+                                  const int& igrad) const
+{
+    // Initialise result
+    double npred = 0.0;
+
+    // Determine index of normalization parameter
+    int inorm = -1;
+    const GModelSky* sky = dynamic_cast<const GModelSky*>(&model);
+    if (sky != NULL && sky->spectral() != NULL &&
+        sky->spectral()->norm_index() >= 0) {
+        int nspat = (sky->spatial() != NULL) ? sky->spatial()->size() : 0;
+        inorm     = nspat + sky->spectral()->norm_index();
+    }
+
+    // Get normalization. If the normalization is zero, Npred cannot be
+    // rescaled and the normalization is treated like any other parameter
+    double norm = 1.0;
+    if (inorm >= 0) {
+        if (model[inorm].value() != 0.0) {
+            norm = model[inorm].value();
+        }
+        else {
+            inorm = -1;
+        }
+    }
+
+    // Find cache entry for model
+    int entry = -1;
+    for (int i = 0; i < m_npred_names.size(); ++i) {
+        if (m_npred_names[i] == model.name()) {
+            entry = i;
+            break;
+        }
+    }
+
+    // Check whether cache entry is valid. The entry is invalid if any
+    // parameter value (except the normalization), scale or free flag
+    // differs, if the normalization index differs, or if gradients are
+    // requested but were not cached.
+    bool valid = (entry != -1);
+    if (valid) {
+        const std::vector<double>& pars = m_npred_pars[entry];
+        if (pars.size() != 3*model.size()+1 || pars.back() != inorm) {
+            valid = false;
+        }
+        else if (gradient != NULL &&
+                 m_npred_grads[entry].size() != model.size()) {
+            valid = false;
+        }
+        else {
+            for (int k = 0, i = 0; k < model.size(); ++k, i += 3) {
+                if ((k != inorm && pars[i] != model[k].value()) ||
+                    pars[i+1] != model[k].scale()               ||
+                    pars[i+2] != double(model[k].is_free())) {
+                    valid = false;
+                    break;
+                }
+            }
+        }
+    }
+
+    // If the cache entry is valid then rescale the cached values
+    if (valid) {
+
+        // Compute Npred
+        npred = m_npred_values[entry] * norm;
+
+        // Optionally compute gradients
+        if (gradient != NULL) {
+            const std::vector<double>& grads = m_npred_grads[entry];
+            for (int k = 0; k < model.size(); ++k) {
+                (*gradient)[igrad+k] = (k == inorm) ? grads[k]
+                                                    : grads[k] * norm;
+            }
+        }
+
+    } // endif: cache entry was valid
+
+    // ... otherwise compute Npred and gradients and store them in the cache
+    else {
+
+        // Compute Npred and optionally gradients
+        npred = npred_gradients(model, gradient, igrad);
+
+        // Gather gradients per unit normalization. The gradient with
+        // respect to the normalization does not depend on the
+        // normalization, hence it is cached as is.
+        std::vector<double> grads;
+        if (gradient != NULL) {
+            grads.reserve(model.size());
+            for (int k = 0; k < model.size(); ++k) {
+                double grad = (*gradient)[igrad+k];
+                grads.push_back((k == inorm) ? grad : grad / norm);
+            }
+        }
+
+        // Gather parameter values, scales and free flags, with the
+        // normalization index appended
+        std::vector<double> pars;
+        pars.reserve(3*model.size()+1);
+        for (int k = 0; k < model.size(); ++k) {
+            pars.push_back(model[k].value());
+            pars.push_back(model[k].scale());
+            pars.push_back(double(model[k].is_free()));
+        }
+        pars.push_back(inorm);
+
+        // Store cache entry
+        if (entry == -1) {
+            m_npred_names.push_back(model.name());
+            m_npred_pars.push_back(pars);
+            m_npred_values.push_back(npred / norm);
+            m_npred_grads.push_back(grads);
+        }
+        else {
+            m_npred_pars[entry]   = pars;
+            m_npred_values[entry] = npred / norm;
+            m_npred_grads[entry]  = grads;
+        }
+
+    } // endelse: cache entry was not valid
+
+    // Return Npred
+    return npred;
+}
+
+
 /***********************************************************************//**
  * @brief Set event container
  *
@@ -657,53 +940,626 @@ double GObservation::npred_grad(const GModel& model, const int& ipar) const
  ***************************************************************************/
 void GObservation::events(const GEvents& events)
 {
+    // Free chunk workspaces since they may reference the event container
+    free_chunks();
+
     // Remove an existing event container
     if (m_events != NULL) delete m_events;
 
-    // Clone events
-    m_events = events.clone();
+    // Clone events
+    m_events = events.clone();
+
+    // Clear Npred cache since Npred depends on the events
+    m_npred_names.clear();
+    m_npred_pars.clear();
+    m_npred_values.clear();
+    m_npred_grads.clear();
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Set usage of Npred cache
+ *
+ * @param[in] use Use Npred cache?
+ *
+ * Enables or disables the Npred cache. In any case the cache is cleared.
+ *
+ * While the cache is used, npred() stores the Npred and gradients of each
+ * model and recomputes them only if a model parameter other than the
+ * spectral normalization has changed. The cache assumes that the
+ * observation, its response and the model components are not altered
+ * while it is used, hence it should only be enabled over a sequence of
+ * evaluations where only the model parameter values change, such as a
+ * model fit. GObservations::optimize() enables the cache for the duration
+ * of a fit.
+ ***************************************************************************/
+void GObservation::use_npred_cache(const bool& use)
+{
+    // Set flag
+    m_use_npred_cache = use;
+
+    // Clear cache
+    m_npred_names.clear();
+    m_npred_pars.clear();
+    m_npred_values.clear();
+    m_npred_grads.clear();
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Keep chunk workspaces between likelihood evaluations
+ *
+ * @param[in] keep Keep chunk workspaces?
+ *
+ * Signals whether the chunk workspaces of the parallel likelihood
+ * evaluation should be kept for further likelihood evaluations. The chunk
+ * workspaces hold the model and observation copies and the gradient and
+ * curvature accumulators of all but the first event chunk, and the dense
+ * curvature accumulator of the observation (see dense_curvature()). Keeping them
+ * avoids their allocation for every likelihood evaluation. The workspaces
+ * are reallocated if the models, the number of chunks or parameters, or
+ * the event container change (see chunks_valid()).
+ *
+ * As for the Npred cache, the observation and its response should not be
+ * altered while the workspaces are kept. GObservations::optimize() keeps
+ * the workspaces for the duration of a fit.
+ *
+ * Any existing workspaces are freed by this method.
+ ***************************************************************************/
+void GObservation::keep_workspaces(const bool& keep)
+{
+    // Free existing workspaces
+    free_chunks();
+    free_dense_curvature();
+
+    // Set flag
+    m_keep_chunks = keep;
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Return event container
+ *
+ * @exception GException::no_events
+ *            No event container defined for observation.
+ *
+ * Returns pointer to event container.
+ ***************************************************************************/
+const GEvents* GObservation::events(void) const
+{
+    // Throw an exception if the event container is not valid
+    if (m_events == NULL) {
+        throw GException::no_events(G_EVENTS);
+    }
+
+    // Return pointer to event container
+    return m_events;
+}
+
+
+/*==========================================================================
+ =                                                                         =
+ =                             Private methods                             =
+ =                                                                         =
+ ==========================================================================*/
+
+/***********************************************************************//**
+ * @brief Initialise class members
+ ***************************************************************************/
+void GObservation::init_members(void)
+{
+    // Initialise members
+    m_name.clear();
+    m_id.clear();
+    m_statistics = "Poisson";
+    m_events     = NULL;
+
+    // Initialise Npred cache
+    m_use_npred_cache = false;
+    m_npred_names.clear();
+    m_npred_pars.clear();
+    m_npred_values.clear();
+    m_npred_grads.clear();
+
+    // Initialise chunk workspaces
+    m_keep_chunks  = false;
+    m_chunk_share  = false;
+    m_chunk_events = NULL;
+    m_chunk_keys.clear();
+    m_chunk_models.clear();
+    m_chunk_obs.clear();
+    m_chunk_grad.clear();
+    m_chunk_curvature.clear();
+
+    // Initialise dense curvature accumulator
+    m_dense_curv.clear();
+    m_dense_used.clear();
+    m_dense_inx.clear();
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Copy class members
+ *
+ * @param[in] obs Observation.
+ *
+ * Copy members from an observation. The Npred cache, the chunk workspaces
+ * and the dense curvature accumulator are not copied.
+ ***************************************************************************/
+void GObservation::copy_members(const GObservation& obs)
+{
+    // Copy members
+    m_name       = obs.m_name;
+    m_id         = obs.m_id;
+    m_statistics = obs.m_statistics;
+
+    // Clone members
+    m_events = (obs.m_events != NULL) ? obs.m_events->clone() : NULL;
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Delete class members
+ ***************************************************************************/
+void GObservation::free_members(void)
+{
+    // Free chunk workspaces before the event container they may reference
+    free_chunks();
+
+    // Free members
+    if (m_events != NULL) delete m_events;
+
+    // Signal free pointers
+    m_events = NULL;
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Return number of chunks for parallel event processing
+ *
+ * @param[in] nevents Number of events or bins.
+ * @return Number of chunks.
+ *
+ * Returns the number of chunks into which the event or bin loop of the
+ * likelihood computation is split. The number of chunks equals the maximum
+ * number of OpenMP threads, but is limited so that each chunk holds at
+ * least @p minchunk events. If the method is called from within an active
+ * parallel region (e.g. when the observations are already processed in
+ * parallel) a single chunk is returned.
+ ***************************************************************************/
+int GObservation::nchunks(const int& nevents) const
+{
+    // Initialise number of chunks
+    int nchunks = 1;
+
+    // Determine number of chunks
+    #ifdef _OPENMP
+    if (!omp_in_parallel()) {
+        nchunks = omp_get_max_threads();
+        if (nchunks > nevents / minchunk) {
+            nchunks = nevents / minchunk;
+        }
+        if (nchunks < 1) {
+            nchunks = 1;
+        }
+    }
+    #endif
+
+    // Return number of chunks
+    return nchunks;
+}
+
+
+/***********************************************************************//**
+ * @brief Clone observation for use by a worker thread
+ *
+ * @param[in] share_events Share event container with this observation?
+ * @return Pointer to deep copy of observation.
+ *
+ * Returns a deep copy of the observation that can be used by a worker
+ * thread without interfering with the mutable state of the response of
+ * this observation. If @p share_events is true the copy references the
+ * event container of this observation instead of holding a clone of it.
+ * The copy has to be released using free_thread_clone() with the same
+ * value of @p share_events.
+ ***************************************************************************/
+GObservation* GObservation::clone_for_thread(const bool& share_events) const
+{
+    // Temporarily detach event container so that it is not cloned
+    // (circumvent const correctness)
+    GObservation* ptr    = const_cast<GObservation*>(this);
+    GEvents*      events = m_events;
+    ptr->m_events = NULL;
+
+    // Clone observation without events
+    GObservation* obs = NULL;
+    try {
+        obs = clone();
+    }
+    catch (...) {
+        ptr->m_events = events;
+        throw;
+    }
+
+    // Re-attach event container
+    ptr->m_events = events;
+
+    // Set events of copy
+    if (share_events) {
+        obs->m_events = events;
+    }
+    else {
+        obs->m_events = (events != NULL) ? events->clone() : NULL;
+    }
+
+    // Return copy
+    return obs;
+}
+
+
+/***********************************************************************//**
+ * @brief Free observation that was cloned for a worker thread
+ *
+ * @param[in] obs Observation copy returned by clone_for_thread().
+ * @param[in] share_events Copy shares event container?
+ ***************************************************************************/
+void GObservation::free_thread_clone(GObservation* obs,
+                                     const bool&   share_events) const
+{
+    // Continue only if pointer is valid
+    if (obs != NULL) {
+
+        // Detach shared event container to avoid its destruction
+        if (share_events) {
+            obs->m_events = NULL;
+        }
+
+        // Delete copy
+        delete obs;
+
+    } // endif: pointer was valid
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Prepare chunk workspaces for a likelihood evaluation
+ *
+ * @param[in] models Models.
+ * @param[in] nchunks Number of event chunks.
+ * @param[in] npars Number of parameters.
+ * @param[in] share_events Copies share event container with observation?
+ *
+ * Prepares the workspaces of the chunks 1 to @p nchunks-1 for a likelihood
+ * evaluation. Chunk 0 works directly on the observation and the models.
+ * Each workspace holds a copy of the models, a copy of the observation
+ * (see clone_for_thread()), a gradient vector and a curvature matrix with
+ * an initialised fill stack.
+ *
+ * If the existing workspaces can be reused (see chunks_valid()), only the
+ * model parameter values are transferred to the model copies and the
+ * accumulators are reset. Otherwise the workspaces are reallocated.
+ ***************************************************************************/
+void GObservation::prepare_chunks(const GModels& models,
+                                  const int&     nchunks,
+                                  const int&     npars,
+                                  const bool&    share_events) const
+{
+    // If the workspaces can be reused then set the model parameters and
+    // reset the accumulators ...
+    if (chunks_valid(models, nchunks, npars, share_events)) {
+        for (int k = 0; k < m_chunk_models.size(); ++k) {
+            GModels* copy = m_chunk_models[k];
+            for (int i = 0; i < models.size(); ++i) {
+                for (int ipar = 0; ipar < models[i]->size(); ++ipar) {
+                    (*(*copy)[i])[ipar] = (*models[i])[ipar];
+                }
+            }
+            *(m_chunk_grad[k])      = 0.0;
+            *(m_chunk_curvature[k]) = 0.0;
+        }
+    }
+
+    // ... otherwise allocate workspaces
+    else {
+
+        // Free existing workspaces
+        free_chunks();
+
+        // Set stack size and number of entries
+        int stack_size  = (2*npars > 100000) ? 2*npars : 100000;
+        int max_entries =  2*npars;
+
+        // Store models and event container for which the workspaces are
+        // allocated
+        for (int i = 0; i < models.size(); ++i) {
+            m_chunk_keys.push_back(models[i]);
+        }
+        m_chunk_share  = share_events;
+        m_chunk_events = m_events;
+
+        // Allocate workspaces
+        for (int k = 1; k < nchunks; ++k) {
+            GMatrixSparse* curvature = new GMatrixSparse(npars,npars);
+            curvature->stack_init(stack_size, max_entries);
+            m_chunk_models.push_back(new GModels(models));
+            m_chunk_obs.push_back(clone_for_thread(share_events));
+            m_chunk_grad.push_back(new GVector(npars));
+            m_chunk_curvature.push_back(curvature);
+        }
+
+    } // endelse: allocated workspaces
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Check whether chunk workspaces can be reused
+ *
+ * @param[in] models Models.
+ * @param[in] nchunks Number of event chunks.
+ * @param[in] npars Number of parameters.
+ * @param[in] share_events Copies share event container with observation?
+ * @return True if the existing workspaces can be reused.
+ *
+ * The workspaces can be reused if there are workspaces for @p nchunks-1
+ * chunks and @p npars parameters that were allocated for the same event
+ * container and the same models, i.e. the model pointers are unchanged and
+ * the model copies of the first workspace agree with the models in type,
+ * name, instruments, observation identifiers and parameter names.
+ ***************************************************************************/
+bool GObservation::chunks_valid(const GModels& models,
+                                const int&     nchunks,
+                                const int&     npars,
+                                const bool&    share_events) const
+{
+    // Check number of workspaces. Nothing needs to be checked if no
+    // workspaces are needed.
+    bool valid = (m_chunk_obs.size() == nchunks-1);
+    if (!valid || m_chunk_obs.empty()) {
+        return valid;
+    }
+
+    // Check dimension and event container of workspaces
+    valid = (m_chunk_grad[0]->size()   == npars         &&
+             m_chunk_share             == share_events  &&
+             m_chunk_events            == m_events      &&
+             m_chunk_keys.size()       == models.size() &&
+             m_chunk_models[0]->size() == models.size());
+
+    // Check models
+    for (int i = 0; valid && i < models.size(); ++i) {
+        const GModel* model = models[i];
+        const GModel* copy  = (*m_chunk_models[0])[i];
+        valid = (model                == m_chunk_keys[i]     &&
+                 model->type()        == copy->type()        &&
+                 model->name()        == copy->name()        &&
+                 model->instruments() == copy->instruments() &&
+                 model->ids()         == copy->ids()         &&
+                 model->size()        == copy->size());
+        for (int ipar = 0; valid && ipar < model->size(); ++ipar) {
+            valid = ((*model)[ipar].name() == (*copy)[ipar].name());
+        }
+    }
+
+    // Return
+    return valid;
+}
+
+
+/***********************************************************************//**
+ * @brief Free chunk workspaces
+ ***************************************************************************/
+void GObservation::free_chunks(void) const
+{
+    // Free workspaces
+    for (int k = 0; k < m_chunk_obs.size(); ++k) {
+        m_chunk_curvature[k]->stack_destroy();
+        delete m_chunk_curvature[k];
+        delete m_chunk_grad[k];
+        delete m_chunk_models[k];
+        free_thread_clone(m_chunk_obs[k], m_chunk_share);
+    }
+
+    // Clear workspaces
+    m_chunk_events = NULL;
+    m_chunk_keys.clear();
+    m_chunk_models.clear();
+    m_chunk_obs.clear();
+    m_chunk_grad.clear();
+    m_chunk_curvature.clear();
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Set spectral caches of sky models for event cube energies
+ *
+ * @param[in] models Models.
+ *
+ * Pre-computes the spectral model values and gradients of all sky models
+ * that apply to the observation for the energy bins of the event cube.
+ * The energies are the logarithmic mean energies of the energy boundaries
+ * of the events. Sky models then use the cached values for all event bins
+ * at these energies, avoiding the evaluation of the spectral model for
+ * every bin.
+ ***************************************************************************/
+void GObservation::set_spectral_caches(const GModels& models) const
+{
+    // Set energies of event cube
+    const GEbounds&     ebounds = events()->ebounds();
+    std::vector<double> logE;
+    for (int i = 0; i < ebounds.size(); ++i) {
+        logE.push_back(ebounds.elogmean(i).log10MeV());
+    }
+
+    // Set spectral caches of all sky models that apply to the observation
+    for (int i = 0; i < models.size(); ++i) {
+        const GModelSky* sky = dynamic_cast<const GModelSky*>(models[i]);
+        if (sky != NULL && sky->is_valid(instrument(), id())) {
+
+            // Set cache (circumvent const correctness)
+            const_cast<GModelSky*>(sky)->spectral_cache(logE);
+
+        }
+    }
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Clear spectral caches of sky models
+ *
+ * @param[in] models Models.
+ ***************************************************************************/
+void GObservation::clear_spectral_caches(const GModels& models) const
+{
+    // Clear spectral caches of all sky models
+    for (int i = 0; i < models.size(); ++i) {
+        const GModelSky* sky = dynamic_cast<const GModelSky*>(models[i]);
+        if (sky != NULL) {
+
+            // Clear cache (circumvent const correctness)
+            const_cast<GModelSky*>(sky)->clear_spectral_cache();
+
+        }
+    }
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Return dense curvature accumulator
+ *
+ * @param[in] models Models.
+ * @param[in] npars Number of parameters.
+ * @return Pointer to dense curvature accumulator (NULL if the sparse
+ *         curvature matrix should be used).
+ *
+ * Returns a symmetric matrix that is used by the likelihood methods to
+ * accumulate the curvature matrix of an event range by rank-1 updates
+ * (see accumulate_dense_curvature()). A dense accumulator is returned if
+ * the number of parameters does not exceed @p dense_max_pars and if the
+ * expected fill of the curvature matrix, estimated as the square of the
+ * fraction of free parameters, is at least @p dense_min_fill. Otherwise a
+ * NULL pointer is returned and the columns are directly added to the
+ * sparse curvature matrix.
+ *
+ * The accumulator is a member of the observation that is only allocated
+ * if the number of parameters changes, and that is zero on return. It
+ * needs to be added to the curvature matrix using add_dense_curvature().
+ ***************************************************************************/
+GMatrixSymmetric* GObservation::dense_curvature(const GModels& models,
+                                                const int&     npars) const
+{
+    // Initialise dense curvature accumulator
+    GMatrixSymmetric* dense = NULL;
+
+    // Continue only if the number of parameters is not too large
+    if (npars > 0 && npars <= dense_max_pars) {
+
+        // Count number of free parameters
+        int nfree = 0;
+        for (int i = 0; i < models.size(); ++i) {
+            for (int k = 0; k < models[i]->size(); ++k) {
+                if ((*models[i])[k].is_free()) {
+                    nfree++;
+                }
+            }
+        }
+
+        // Use dense accumulator if the expected fill is sufficient
+        double frac = double(nfree) / double(npars);
+        if (frac * frac >= dense_min_fill) {
+
+            // Allocate accumulator if the number of parameters changed ...
+            if (m_dense_curv.columns() != npars) {
+                m_dense_curv = GMatrixSymmetric(npars, npars);
+                m_dense_used.assign(npars, false);
+                m_dense_inx.clear();
+            }
+
+            // ... otherwise zero elements that were left over by an
+            // interrupted accumulation
+            else {
+                for (int i = 0; i < m_dense_inx.size(); ++i) {
+                    int col = m_dense_inx[i];
+                    for (int k = i; k < m_dense_inx.size(); ++k) {
+                        m_dense_curv(m_dense_inx[k], col) = 0.0;
+                    }
+                    m_dense_used[col] = false;
+                }
+                m_dense_inx.clear();
+            }
 
-    // Return
-    return;
+            // Set accumulator
+            dense = &m_dense_curv;
+
+        } // endif: expected fill was sufficient
+
+    } // endif: number of parameters was not too large
+
+    // Return dense curvature accumulator
+    return dense;
 }
 
 
 /***********************************************************************//**
- * @brief Return event container
+ * @brief Accumulate rank-1 update in dense curvature accumulator
  *
- * @exception GException::no_events
- *            No event container defined for observation.
+ * @param[in] factor Factor of update.
+ * @param[in] grad Gradient vector.
+ * @param[in] inx Indices of non-zero gradient elements.
+ * @param[in] number Number of non-zero gradient elements.
  *
- * Returns pointer to event container.
+ * Adds @p factor times the outer product of the non-zero gradient elements
+ * to the dense curvature accumulator and records the parameters for which
+ * elements were updated, so that add_dense_curvature() only needs to visit
+ * these elements. The indices @p inx need to be in ascending order.
  ***************************************************************************/
-const GEvents* GObservation::events(void) const
+void GObservation::accumulate_dense_curvature(const double&  factor,
+                                              const GVector& grad,
+                                              const int*     inx,
+                                              const int&     number) const
 {
-    // Throw an exception if the event container is not valid
-    if (m_events == NULL) {
-        throw GException::no_events(G_EVENTS);
+    // Record parameters with updated elements
+    for (int i = 0; i < number; ++i) {
+        if (!m_dense_used[inx[i]]) {
+            m_dense_used[inx[i]] = true;
+            m_dense_inx.push_back(inx[i]);
+        }
     }
 
-    // Return pointer to event container
-    return m_events;
-}
-
-
-/*==========================================================================
- =                                                                         =
- =                             Private methods                             =
- =                                                                         =
- ==========================================================================*/
-
-/***********************************************************************//**
- * @brief Initialise class members
- ***************************************************************************/
-void GObservation::init_members(void)
-{
-    // Initialise members
-    m_name.clear();
-    m_id.clear();
-    m_statistics = "Poisson";
-    m_events     = NULL;
+    // Add outer product
+    m_dense_curv.add_outer_product(factor, &(grad[0]), inx, number);
 
     // Return
     return;
@@ -711,21 +1567,62 @@ void GObservation::init_members(void)
 
 
 /***********************************************************************//**
- * @brief Copy class members
+ * @brief Add dense curvature accumulator to curvature matrix
  *
- * @param[in] obs Observation.
+ * @param[in] dense Dense curvature accumulator.
+ * @param[in,out] curvature Curvature matrix.
  *
- * Copy members from an observation.
+ * Adds the non-zero elements of the dense curvature accumulator to the
+ * curvature matrix and zeros them in the accumulator. Only the elements of
+ * parameters that were recorded by accumulate_dense_curvature() are
+ * visited. Nothing is done if @p dense is NULL.
  ***************************************************************************/
-void GObservation::copy_members(const GObservation& obs)
+void GObservation::add_dense_curvature(GMatrixSymmetric* dense,
+                                       GMatrixSparse*    curvature) const
 {
-    // Copy members
-    m_name       = obs.m_name;
-    m_id         = obs.m_id;
-    m_statistics = obs.m_statistics;
+    // Continue only if there is a dense accumulator with updated elements
+    if (dense != NULL && !m_dense_inx.empty()) {
+
+        // Sort parameters with updated elements
+        std::sort(m_dense_inx.begin(), m_dense_inx.end());
+
+        // Get number of parameters with updated elements
+        int nused = m_dense_inx.size();
+
+        // Allocate some working arrays
+        std::vector<int>    inx(nused);
+        std::vector<double> values(nused);
+
+        // Add all columns with non-zero elements to curvature matrix and
+        // zero the elements in the accumulator
+        for (int i = 0; i < nused; ++i) {
+            int col   = m_dense_inx[i];
+            int nrows = 0;
+            for (int k = 0; k < nused; ++k) {
+                int     row     = m_dense_inx[k];
+                double& element = (*dense)(row, col);
+                if (element != 0.0) {
+                    inx[nrows]    = row;
+                    values[nrows] = element;
+                    nrows++;
+                }
+            }
+            if (nrows > 0) {
+                curvature->add_to_column(col, &(values[0]), &(inx[0]), nrows);
+            }
+        }
+        for (int i = 0; i < nused; ++i) {
+            int col = m_dense_inx[i];
+            for (int k = i; k < nused; ++k) {
+                (*dense)(m_dense_inx[k], col) = 0.0;
+            }
+            m_dense_used[col] = false;
+        }
 
-    // Clone members
-    m_events = (obs.m_events != NULL) ? obs.m_events->clone() : NULL;
+        // Clear parameters with updated elements
+        m_dense_inx.clear();
+
+    } // endif: there were updated elements
 
     // Return
     return;
@@ -733,27 +1630,20 @@ void GObservation::copy_members(const GObservation& obs)
 
 
 /***********************************************************************//**
- * @brief Delete class members
+ * @brief Free dense curvature accumulator
  ***************************************************************************/
-void GObservation::free_members(void)
+void GObservation::free_dense_curvature(void) const
 {
-    // Free members
-    if (m_events != NULL) delete m_events;
-
-    // Signal free pointers
-    m_events = NULL;
+    // Free accumulator
+    m_dense_curv.clear();
+    m_dense_used.clear();
+    m_dense_inx.clear();
 
     // Return
     return;
 }
 
 
-/*==========================================================================
- =                                                                         =
- =                           Likelihood methods                            =
- =                                                                         =
- ==========================================================================*/
-
 /***********************************************************************//**
  * @brief Evaluate log-likelihood function for Poisson statistics and
  *        unbinned analysis (version with working arrays)
@@ -789,21 +1679,165 @@ double GObservation::likelihood_poisson_unbinned(const GModels& models,
     // Get number of parameters
     int npars = gradient->size();
 
-    // Allocate some working arrays
-    int*    inx    = new int[npars];
-    double* values = new double[npars];
-    GVector wrk_grad(npars);
-
     // Determine Npred value and gradient for this observation
-    double npred_value = this->npred(models, &wrk_grad);
+    GVector wrk_grad(npars);
+    double  npred_value = this->npred(models, &wrk_grad);
 
     // Update likelihood, Npred and gradient
     value     += npred_value;
     *npred    += npred_value;
     *gradient += wrk_grad;
 
+    // Update likelihood, gradient and curvature matrix for all events
+    value += likelihood_poisson_events(models, gradient, curvature);
+
+    // Return
+    return value;
+}
+
+
+/***********************************************************************//**
+ * @brief Evaluate event term of log-likelihood function for Poisson
+ *        statistics and unbinned analysis
+ *
+ * @param[in] models Models.
+ * @param[in,out] gradient Gradient.
+ * @param[in,out] curvature Curvature matrix.
+ * @return Likelihood value (without Npred term).
+ *
+ * This method evaluates the event term
+ *
+ * \f$L = - \sum_i \log e_i\f$
+ *
+ * of the -(log-likelihood) function for all events of the observation and
+ * updates the parameter gradients and the curvature matrix accordingly.
+ * The events are split into contiguous chunks that are processed in
+ * parallel.
+ ***************************************************************************/
+double GObservation::likelihood_poisson_events(const GModels& models,
+                                               GVector*       gradient,
+                                               GMatrixSparse* curvature) const
+{
+    // Initialise likelihood value
+    double value = 0.0;
+
+    // Get number of parameters and number of events
+    int npars   = gradient->size();
+    int nevents = events()->size();
+
+    // Determine the number of event chunks
+    int nchunks = this->nchunks(nevents);
+
+    // Prepare working copies and accumulators for all chunks. Chunk 0
+    // works directly on the observation and the models, all other chunks
+    // work on their own copies of the models and the observation (see
+    // prepare_chunks()). The copies share the event list with this
+    // observation.
+    prepare_chunks(models, nchunks, npars, true);
+    std::vector<const GModels*>      chunk_models(nchunks, &models);
+    std::vector<const GObservation*> chunk_obs(nchunks, this);
+    std::vector<double>              chunk_value(nchunks, 0.0);
+    std::vector<GVector*>            chunk_grad(nchunks, gradient);
+    std::vector<GMatrixSparse*>      chunk_curvature(nchunks, curvature);
+    for (int k = 1; k < nchunks; ++k) {
+        chunk_models[k]    = m_chunk_models[k-1];
+        chunk_obs[k]       = m_chunk_obs[k-1];
+        chunk_grad[k]      = m_chunk_grad[k-1];
+        chunk_curvature[k] = m_chunk_curvature[k-1];
+    }
+
+    // Prepare the response source caches of all chunks before entering
+    // the parallel region so that the per-event response computation
+    // needs no cache lookups
+    for (int k = 0; k < nchunks; ++k) {
+        chunk_obs[k]->response().set_source_caches(*chunk_obs[k],
+                                                   *chunk_models[k]);
+    }
+
+    // Iterate over all event chunks. Each chunk covers a contiguous range
+    // of events and updates its own likelihood value, gradient and
+    // curvature matrix. The static schedule assigns the chunks to the
+    // threads.
+    #pragma omp parallel for schedule(static,1) if(nchunks > 1)
+    for (int k = 0; k < nchunks; ++k) {
+
+        // Determine event range of chunk
+        int ifirst = int((long long)(nevents) * k / nchunks);
+        int ilast  = int((long long)(nevents) * (k+1) / nchunks);
+
+        // Update likelihood for chunk
+        chunk_value[k] = chunk_obs[k]->likelihood_poisson_unbinned(*chunk_models[k],
+                                                                   chunk_grad[k],
+                                                                   chunk_curvature[k],
+                                                                   ifirst,
+                                                                   ilast);
+
+    } // endfor: looped over event chunks
+
+    // Reduce chunk results in chunk order so that the results are
+    // independent of the way the chunks were distributed over the threads
+    for (int k = 0; k < nchunks; ++k) {
+        value += chunk_value[k];
+        chunk_obs[k]->response().clear_source_caches(*chunk_obs[k]);
+        if (k > 0) {
+            chunk_curvature[k]->stack_flush();
+            *gradient  += *(chunk_grad[k]);
+            *curvature += *(chunk_curvature[k]);
+        }
+    }
+
+    // Free chunk workspaces unless they should be kept for further
+    // evaluations
+    if (!m_keep_chunks) {
+        free_chunks();
+    }
+
+    // Return
+    return value;
+}
+
+
+/***********************************************************************//**
+ * @brief Evaluate log-likelihood function for Poisson statistics and
+ *        unbinned analysis for a range of events
+ *
+ * @param[in] models Models.
+ * @param[in,out] gradient Gradient.
+ * @param[in,out] curvature Curvature matrix.
+ * @param[in] ifirst Index of first event.
+ * @param[in] ilast Index after last event.
+ * @return Likelihood value (without Npred term).
+ *
+ * This method evaluates the event term
+ *
+ * \f$L = - \sum_i \log e_i\f$
+ *
+ * of the -(log-likelihood) function for the events
+ * \f$i \in [i_{\rm first}, i_{\rm last}[\f$ and updates the parameter
+ * gradients and the curvature matrix accordingly.
+ ***************************************************************************/
+double GObservation::likelihood_poisson_unbinned(const GModels& models,
+                                                 GVector*       gradient,
+                                                 GMatrixSparse* curvature,
+                                                 const int&     ifirst,
+                                                 const int&     ilast) const
+{
+    // Initialise likelihood value
+    double value = 0.0;
+
+    // Get number of parameters
+    int npars = gradient->size();
+
+    // Allocate some working arrays
+    int*    inx    = new int[npars];
+    double* values = new double[npars];
+    GVector wrk_grad(npars);
+
+    // Allocate dense curvature accumulator
+    GMatrixSymmetric* dense = dense_curvature(models, npars);
+
     // Iterate over all events
-    for (int i = 0; i < events()->size(); ++i) {
+    for (int i = ifirst; i < ilast; ++i) {
 
         // Get event pointer
         const GEvent* event = (*events())[i];
@@ -839,6 +1873,17 @@ double GObservation::likelihood_poisson_unbinned(const GModels& models,
         // Update gradient vector and curvature matrix.
         double fb = 1.0 / model;
         double fa = fb / model;
+
+        // Use dense curvature accumulator if available
+        if (dense != NULL) {
+            for (int jdev = 0; jdev < ndev; ++jdev) {
+                (*gradient)[inx[jdev]] -= fb * wrk_grad[inx[jdev]];
+            }
+            accumulate_dense_curvature(fa, wrk_grad, inx, ndev);
+            continue;
+        }
+
+        // Otherwise add columns to sparse curvature matrix
         for (int jdev = 0; jdev < ndev; ++jdev) {
 
             // Initialise computation
@@ -863,6 +1908,9 @@ double GObservation::likelihood_poisson_unbinned(const GModels& models,
 
     } // endfor: iterated over all events
 
+    // Add dense curvature accumulator to curvature matrix
+    add_dense_curvature(dense, curvature);
+
     // Free temporary memory
     if (values != NULL) delete [] values;
     if (inx    != NULL) delete [] inx;
@@ -895,9 +1943,117 @@ double GObservation::likelihood_poisson_unbinned(const GModels& models,
  * and also updates the total number of predicted events m_npred.
  ***************************************************************************/
 double GObservation::likelihood_poisson_binned(const GModels& models,
-                                             GVector*       gradient,
-                                             GMatrixSparse* curvature,
-                                             double*        npred) const
+                                               GVector*       gradient,
+                                               GMatrixSparse* curvature,
+                                               double*        npred) const
+{
+    // Initialise likelihood value
+    double value = 0.0;
+
+    // Get number of parameters and number of bins
+    int npars = gradient->size();
+    int nbins = events()->size();
+
+    // Determine the number of bin chunks
+    int nchunks = this->nchunks(nbins);
+
+    // Prepare working copies and accumulators for all chunks. Chunk 0
+    // works directly on the observation and the models, all other chunks
+    // work on their own copies of the models and the observation (see
+    // prepare_chunks()). Since accessing an event bin may modify the event
+    // cube, each copy holds its own event cube unless the event cube
+    // signals that its bins can be accessed from several threads.
+    bool share = static_cast<const GEventCube*>(events())->thread_safe();
+    prepare_chunks(models, nchunks, npars, share);
+    std::vector<const GModels*>      chunk_models(nchunks, &models);
+    std::vector<const GObservation*> chunk_obs(nchunks, this);
+    std::vector<double>              chunk_value(nchunks, 0.0);
+    std::vector<double>              chunk_npred(nchunks, 0.0);
+    std::vector<GVector*>            chunk_grad(nchunks, gradient);
+    std::vector<GMatrixSparse*>      chunk_curvature(nchunks, curvature);
+    for (int k = 1; k < nchunks; ++k) {
+        chunk_models[k]    = m_chunk_models[k-1];
+        chunk_obs[k]       = m_chunk_obs[k-1];
+        chunk_grad[k]      = m_chunk_grad[k-1];
+        chunk_curvature[k] = m_chunk_curvature[k-1];
+    }
+
+    // Prepare the response source caches of all chunks before entering
+    // the parallel region so that the per-bin response computation
+    // needs no cache lookups
+    for (int k = 0; k < nchunks; ++k) {
+        chunk_obs[k]->response().set_source_caches(*chunk_obs[k],
+                                                   *chunk_models[k]);
+    }
+
+    // Iterate over all bin chunks. Each chunk covers a contiguous range
+    // of bins and updates its own likelihood value, Npred, gradient and
+    // curvature matrix. The static schedule assigns the chunks to the
+    // threads.
+    #pragma omp parallel for schedule(static,1) if(nchunks > 1)
+    for (int k = 0; k < nchunks; ++k) {
+
+        // Determine bin range of chunk
+        int ifirst = int((long long)(nbins) * k / nchunks);
+        int ilast  = int((long long)(nbins) * (k+1) / nchunks);
+
+        // Update likelihood for chunk
+        chunk_value[k] = chunk_obs[k]->likelihood_poisson_binned(*chunk_models[k],
+                                                                 chunk_grad[k],
+                                                                 chunk_curvature[k],
+                                                                 &chunk_npred[k],
+                                                                 ifirst,
+                                                                 ilast);
+
+    } // endfor: looped over bin chunks
+
+    // Reduce chunk results in chunk order so that the results are
+    // independent of the way the chunks were distributed over the threads
+    for (int k = 0; k < nchunks; ++k) {
+        value  += chunk_value[k];
+        *npred += chunk_npred[k];
+        chunk_obs[k]->response().clear_source_caches(*chunk_obs[k]);
+        if (k > 0) {
+            chunk_curvature[k]->stack_flush();
+            *gradient  += *(chunk_grad[k]);
+            *curvature += *(chunk_curvature[k]);
+        }
+    }
+
+    // Free chunk workspaces unless they should be kept for further
+    // evaluations
+    if (!m_keep_chunks) {
+        free_chunks();
+    }
+
+    // Return
+    return value;
+}
+
+
+/***********************************************************************//**
+ * @brief Evaluate log-likelihood function for Poisson statistics and
+ *        binned analysis for a range of bins
+ *
+ * @param[in] models Models.
+ * @param[in,out] gradient Gradient.
+ * @param[in,out] curvature Curvature matrix.
+ * @param[in,out] npred Number of predicted events.
+ * @param[in] ifirst Index of first bin.
+ * @param[in] ilast Index after last bin.
+ * @return Likelihood value.
+ *
+ * This method evaluates the -(log-likelihood) function for the bins
+ * \f$i \in [i_{\rm first}, i_{\rm last}[\f$ and updates the parameter
+ * gradients, the curvature matrix and the number of predicted events
+ * accordingly.
+ ***************************************************************************/
+double GObservation::likelihood_poisson_binned(const GModels& models,
+                                               GVector*       gradient,
+                                               GMatrixSparse* curvature,
+                                               double*        npred,
+                                               const int&     ifirst,
+                                               const int&     ilast) const
 {
     // Initialise likelihood value
     double value = 0.0;
@@ -921,8 +2077,14 @@ double GObservation::likelihood_poisson_binned(const GModels& models,
     double* values = new double[npars];
     GVector wrk_grad(npars);
 
+    // Allocate dense curvature accumulator
+    GMatrixSymmetric* dense = dense_curvature(models, npars);
+
+    // Pre-compute spectral models for the energies of the event cube
+    set_spectral_caches(models);
+
     // Iterate over all bins
-    for (int i = 0; i < events()->size(); ++i) {
+    for (int i = ifirst; i < ilast; ++i) {
 
         // Update number of bins
         #if defined(G_OPT_DEBUG)
@@ -995,7 +2157,16 @@ double GObservation::likelihood_poisson_binned(const GModels& models,
             double fc = (1.0 - fb);
             double fa = fb / model;
 
-            // Loop over columns
+            // Use dense curvature accumulator if available
+            if (dense != NULL) {
+                for (int jdev = 0; jdev < ndev; ++jdev) {
+                    (*gradient)[inx[jdev]] += fc * wrk_grad[inx[jdev]];
+                }
+                accumulate_dense_curvature(fa, wrk_grad, inx, ndev);
+                continue;
+            }
+
+            // Otherwise loop over columns
             for (int jdev = 0; jdev < ndev; ++jdev) {
 
                 // Initialise computation
@@ -1046,6 +2217,12 @@ double GObservation::likelihood_poisson_binned(const GModels& models,
 
     } // endfor: iterated over all events
 
+    // Clear spectral model caches
+    clear_spectral_caches(models);
+
+    // Add dense curvature accumulator to curvature matrix
+    add_dense_curvature(dense, curvature);
+
     // Free temporary memory
     if (values != NULL) delete [] values;
     if (inx    != NULL) delete [] inx;
@@ -1106,6 +2283,15 @@ double GObservation::likelihood_gaussian_binned(const GModels& models,
     double* values = new double[npars];
     GVector wrk_grad(npars);
 
+    // Allocate dense curvature accumulator
+    GMatrixSymmetric* dense = dense_curvature(models, npars);
+
+    // Pre-compute spectral models for the energies of the event cube
+    set_spectral_caches(models);
+
+    // Prepare response source caches
+    response().set_source_caches(*this, models);
+
     // Iterate over all bins
     for (int i = 0; i < events()->size(); ++i) {
 
@@ -1164,7 +2350,16 @@ double GObservation::likelihood_gaussian_binned(const GModels& models,
             continue;
         }
 
-        // Loop over columns
+        // Use dense curvature accumulator if available
+        if (dense != NULL) {
+            for (int jdev = 0; jdev < ndev; ++jdev) {
+                (*gradient)[inx[jdev]] -= fa * wrk_grad[inx[jdev]] * weight;
+            }
+            accumulate_dense_curvature(weight, wrk_grad, inx, ndev);
+            continue;
+        }
+
+        // Otherwise loop over columns
         for (int jdev = 0; jdev < ndev; ++jdev) {
 
             // Initialise computation
@@ -1187,6 +2382,15 @@ double GObservation::likelihood_gaussian_binned(const GModels& models,
 
     } // endfor: iterated over all events
 
+    // Clear spectral model caches
+    clear_spectral_caches(models);
+
+    // Release response source caches
+    response().clear_source_caches(*this);
+
+    // Add dense curvature accumulator to curvature matrix
+    add_dense_curvature(dense, curvature);
+
     // Free temporary memory
     if (values != NULL) delete [] values;
     if (inx    != NULL) delete [] inx;
@@ -1429,6 +2633,95 @@ double GObservation::npred_spec(const GModel& model,
 }
 
 
+/***********************************************************************//**
+ * @brief Integrates Npred kernel and its spectral gradients spectrally
+ *
+ * @param[in] model Sky model.
+ * @param[in] obsTime Measured photon arrival time.
+ * @param[out] gradients Spectral parameter gradients.
+ * @param[out] analytic Signals which spectral gradients were computed.
+ * @return Spectrally integrated Npred.
+ *
+ * @exception GException::erange_invalid
+ *            Energy range is invalid.
+ *
+ * Computes the same spectral integral as npred_spec() and in addition the
+ * integrals of the spectral parameter gradients, which are obtained from
+ * GModelSpectral::eval_gradients(). Since the spectral gradients are
+ * proportional to the spatially integrated response at a given energy,
+ * the response is computed only once per energy node and is shared by all
+ * integrations. The gradient integrations use the same Romberg nodes as
+ * the Npred integration, hence the response is only computed again for
+ * gradients that need more nodes to converge. The gradient integrations
+ * are limited to one iteration more than the Npred integration.
+ *
+ * On return, @p gradients and @p analytic have one element per spectral
+ * parameter. Gradients of fixed parameters are zero. If the integration of
+ * a gradient did not converge, the corresponding element of @p analytic is
+ * false.
+ ***************************************************************************/
+double GObservation::npred_spec_grad(const GModelSky&     model,
+                                     const GTime&         obsTime,
+                                     std::vector<double>& gradients,
+                                     std::vector<bool>&   analytic) const
+{
+    // Set integration energy interval in MeV
+    double emin = events()->ebounds().emin().MeV();
+    double emax = events()->ebounds().emax().MeV();
+
+    // Throw exception if energy range is not valid
+    if (emax <= emin) {
+        throw GException::erange_invalid(G_NPRED_SPEC_GRAD, emin, emax);
+    }
+
+    // Set integration interval
+    #if defined(G_LN_ENERGY_INT)
+    emin = log(emin);
+    emax = log(emax);
+    #endif
+
+    // Initialise spatially integrated response per energy node
+    std::map<double,double> spatial;
+
+    // Integrate Npred
+    GObservation::npred_spec_grad_kern integrand(this, &model, &obsTime, -1,
+                                                 &spatial);
+    GIntegral integral(&integrand);
+    integral.eps(1.0e-5);
+    double result = integral.romb(emin, emax);
+
+    // Initialise gradients
+    int npars = model.spectral()->size();
+    gradients.assign(npars, 0.0);
+    analytic.assign(npars, true);
+
+    // Set maximum number of iterations for gradient integration. At most
+    // one more iteration than for the Npred integration is allowed, so
+    // that the gradients require at most as many new response
+    // computations as were needed for Npred.
+    int max_iter = std::min(integral.iter(), integral.max_iter()) + 1;
+
+    // Integrate gradients of free spectral parameters. Convergence is
+    // checked using the number of iterations, since romb() signals a
+    // failure to converge by a zero result.
+    for (int i = 0; i < npars; ++i) {
+        if ((*(model.spectral()))[i].is_free()) {
+            GObservation::npred_spec_grad_kern kernel(this, &model, &obsTime,
+                                                      i, &spatial);
+            GIntegral grad_integral(&kernel);
+            grad_integral.eps(1.0e-5);
+            grad_integral.max_iter(max_iter);
+            grad_integral.silent(true);
+            gradients[i] = grad_integral.romb(emin, emax);
+            analytic[i]  = (grad_integral.iter() <= grad_integral.max_iter());
+        }
+    }
+
+    // Return result
+    return result;
+}
+
+
 /***********************************************************************//**
  * @brief Integration kernel for npred_spec() method
  *
@@ -1480,3 +2773,52 @@ double GObservation::npred_spec_kern::eval(const double& x)
     // Return value
     return value;
 }
+
+
+/***********************************************************************//**
+ * @brief Integration kernel for npred_spec_grad() method
+ *
+ * @param[in] x Function value.
+ *
+ * Returns the Npred kernel of the sky model if the parameter index is
+ * negative, or the gradient of the Npred kernel with respect to the
+ * spectral parameter otherwise. The spatially integrated response is
+ * taken from the node map if it was already computed for @p x, and is
+ * stored in the map otherwise. If G_LN_ENERGY_INT is defined the
+ * integration is done logarithmically, i.e. @p x is given in ln(energy)
+ * instead of energy.
+ ***************************************************************************/
+double GObservation::npred_spec_grad_kern::eval(const double& x)
+{
+    // Set energy
+    GEnergy eng;
+    #if defined(G_LN_ENERGY_INT)
+    double expx = std::exp(x);
+    eng.MeV(expx);
+    #else
+    eng.MeV(x);
+    #endif
+
+    // Get spatially integrated response for this node if it is already
+    // known
+    std::map<double,double>::const_iterator node = m_spatial->find(x);
+    double npred_spatial = (node != m_spatial->end()) ? node->second : -1.0;
+
+    // Get Npred kernel or its gradient, sharing the spatially integrated
+    // response between all integrations
+    double value = m_model->npred_kernel(eng, *m_time, *m_parent, m_ipar,
+                                         &npred_spatial);
+
+    // Store spatially integrated response if it was computed
+    if ((node == m_spatial->end()) && (npred_spatial >= 0.0)) {
+        (*m_spatial)[x] = npred_spatial;
+    }
+
+    // Correct for variable substitution
+    #if defined(G_LN_ENERGY_INT)
+    value *= expx;
+    #endif
+
+    // Return value
+    return value;
+}
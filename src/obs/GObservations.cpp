@@ -713,7 +713,10 @@ void GObservations::optimize(GOptimizer& opt)
     // Extract optimizer parameter container from model container
     GOptimizerPars pars = m_models.pars();
 
-    // Optimize model parameters
+    // Optimize model parameters. The likelihood workspaces are kept and
+    // the Npred caches of the observations are used for all function
+    // evaluations of the fit. Both are released by the guard.
+    optimize_guard guard(this);
     opt.optimize(m_fct, pars);
 
     // Return
@@ -862,3 +865,59 @@ int GObservations::get_index(const std::string& instrument,
     // Return index
     return index;
 }
+
+
+/*==========================================================================
+ =                                                                         =
+ =                           Fit state guard                               =
+ =                                                                         =
+ ==========================================================================*/
+
+/***********************************************************************//**
+ * @brief Fit state guard constructor
+ *
+ * @param[in] obs Pointer to observation container.
+ *
+ * Signals the likelihood function of the observation container to keep
+ * its workspaces between function evaluations, enables the Npred caches
+ * of all observations and signals all observations to keep their chunk
+ * workspaces.
+ ***************************************************************************/
+GObservations::optimize_guard::optimize_guard(GObservations* obs) :
+                               m_this(obs)
+{
+    // Keep likelihood workspaces
+    m_this->m_fct.keep_workspaces(true);
+
+    // Use Npred caches and keep chunk workspaces of all observations
+    for (int i = 0; i < m_this->size(); ++i) {
+        m_this->m_obs[i]->use_npred_cache(true);
+        m_this->m_obs[i]->keep_workspaces(true);
+    }
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Fit state guard destructor
+ *
+ * Disables the Npred caches of all observations and releases the chunk
+ * workspaces of all observations and the likelihood workspaces.
+ ***************************************************************************/
+GObservations::optimize_guard::~optimize_guard(void)
+{
+    // Stop using Npred caches and release chunk workspaces of all
+    // observations
+    for (int i = 0; i < m_this->size(); ++i) {
+        m_this->m_obs[i]->use_npred_cache(false);
+        m_this->m_obs[i]->keep_workspaces(false);
+    }
+
+    // Release likelihood workspaces
+    m_this->m_fct.keep_workspaces(false);
+
+    // Return
+    return;
+}
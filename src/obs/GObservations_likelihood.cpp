@@ -183,6 +183,11 @@ GObservations::likelihood& GObservations::likelihood::operator=(const likelihood
  * Poisson and Gaussian statistics. 
  * Note that different statistics and different analysis methods
  * (binned/unbinned) may be combined.
+ *
+ * If there are at least as many observations as OpenMP threads, the
+ * observations are processed in parallel. Otherwise, the observations are
+ * processed sequentially and the event or bin loop of each observation is
+ * split over the threads.
  ***************************************************************************/
 void GObservations::likelihood::eval(const GOptimizerPars& pars) 
 {
@@ -210,50 +215,54 @@ void GObservations::likelihood::eval(const GOptimizerPars& pars)
         if (m_gradient  != NULL) delete m_gradient;
         if (m_curvature != NULL) delete m_curvature;
 
-        // Initialise value, gradient vector and curvature matrix
-        m_value     = 0.0;
-        m_npred     = 0.0;
-        m_gradient  = new GVector(npars);
-        m_curvature = new GMatrixSparse(npars,npars);
-
-        // Set stack size and number of entries
-        int stack_size  = (2*npars > 100000) ? 2*npars : 100000;
-        int max_entries =  2*npars;
-        m_curvature->stack_init(stack_size, max_entries);
+        // Decide whether to parallelise over observations. This is only
+        // done if there are at least as many observations as threads.
+        // Otherwise the observations are processed sequentially and each
+        // observation parallelises its event or bin loop.
+        #ifdef _OPENMP
+        bool obs_parallel = (m_this->size() >= omp_get_max_threads());
+        int  nwrk         = (obs_parallel) ? omp_get_max_threads() : 1;
+        #else
+        bool obs_parallel = false;
+        int  nwrk         = 1;
+        #endif
+
+        // Allocate one workspace per thread unless the workspaces of a
+        // previous evaluation can be reused
+        if (!workspaces_valid(nwrk, npars)) {
+            alloc_workspaces(nwrk, npars);
+        }
 
-        // Allocate vectors to save working variables of each thread
-        std::vector<GVector*>       vect_cpy_grad;
-        std::vector<GMatrixSparse*> vect_cpy_curvature;
-        std::vector<double*>        vect_cpy_value;
-        std::vector<double*>        vect_cpy_npred;
+        // Reset workspaces
+        for (int k = 0; k < nwrk; ++k) {
+            *(m_wrk_gradient[k])  = 0.0;
+            *(m_wrk_curvature[k]) = 0.0;
+            m_wrk_value[k]        = 0.0;
+            m_wrk_npred[k]        = 0.0;
+        }
 
         // Here OpenMP will paralellize the execution. The following code will
         // be executed by the differents threads. In order to avoid protecting
-        // attributes ( m_value,m_npred, m_gradient and m_curvature), each thread
-        // works with its own working variables (cpy_*). When a thread starts,
-        // we add working variables in a vector (vect_cpy_*). When computation
-        // is finished we just add all elements contain in the vector to the
-        // attributes value.
-        #pragma omp parallel
+        // attributes (m_value, m_npred, m_gradient and m_curvature), each
+        // thread works with its own workspace, which is selected by the
+        // thread number. Each thread first sets the parameters of its model
+        // copy to the current model parameters.
+        #pragma omp parallel if(obs_parallel)
         {
-            // Allocate and initialize variable copies for multi-threading
-            GModels        cpy_model(m_this->models());
-            GVector*       cpy_gradient  = new GVector(npars);
-            GMatrixSparse* cpy_curvature = new GMatrixSparse(npars,npars);
-            double*        cpy_npred     = new double(0.0);
-            double*        cpy_value     = new double(0.0);
-
-            // Set stack size and number of entries
-            cpy_curvature->stack_init(stack_size, max_entries);
-
-            // Push variable copies into vector. This is a critical zone to
-            // avoid multiple thread pushing simultaneously.
-            #pragma omp critical
-            {
-                vect_cpy_grad.push_back(cpy_gradient);
-                vect_cpy_curvature.push_back(cpy_curvature); 
-                vect_cpy_value.push_back(cpy_value);
-                vect_cpy_npred.push_back(cpy_npred);
+            // Get workspace index
+            #ifdef _OPENMP
+            int k = omp_get_thread_num();
+            #else
+            int k = 0;
+            #endif
+
+            // Set model parameters of workspace
+            const GModels& models = m_this->models();
+            GModels*       model  = m_wrk_models[k];
+            for (int i = 0; i < models.size(); ++i) {
+                for (int ipar = 0; ipar < models[i]->size(); ++ipar) {
+                    (*(*model)[i])[ipar] = (*models[i])[ipar];
+                }
             }
 
             // Loop over all observations. The omp for directive will deal
@@ -262,57 +271,42 @@ void GObservations::likelihood::eval(const GOptimizerPars& pars)
             for (int i = 0; i < m_this->size(); ++i) {
 
                 // Compute likelihood
-                *cpy_value += m_this->m_obs[i]->likelihood(cpy_model,
-                                                           cpy_gradient,
-                                                           cpy_curvature,
-                                                           cpy_npred);
+                m_wrk_value[k] += m_this->m_obs[i]->likelihood(*model,
+                                                               m_wrk_gradient[k],
+                                                               m_wrk_curvature[k],
+                                                               &(m_wrk_npred[k]));
 
             } // endfor: looped over observations
 
-            // Release stack
-            cpy_curvature->stack_destroy();
+            // Flush stack
+            m_wrk_curvature[k]->stack_flush();
 
         } // end pragma omp parallel
 
-        // Now the computation is finished, update attributes.
-        // For each omp section, a thread will be created.
-        #pragma omp sections
-        {
-            #pragma omp section
-            {
-                for (int i = 0; i < vect_cpy_curvature.size() ; ++i) {
-                    *m_curvature += *(vect_cpy_curvature.at(i));
-                    delete vect_cpy_curvature.at(i);
-                }
-            }
-
-            #pragma omp section
-            {
-                for (int i = 0; i < vect_cpy_grad.size(); ++i){
-                    *m_gradient += *(vect_cpy_grad.at(i));
-                    delete vect_cpy_grad.at(i);
-                }
+        // Now the computation is finished, reduce the workspaces pairwise
+        // into the first workspace. The reduction order only depends on
+        // the number of workspaces.
+        for (int step = 1; step < nwrk; step *= 2) {
+            #pragma omp parallel for if(nwrk > 2*step)
+            for (int k = 0; k < nwrk-step; k += 2*step) {
+                *(m_wrk_gradient[k])  += *(m_wrk_gradient[k+step]);
+                *(m_wrk_curvature[k]) += *(m_wrk_curvature[k+step]);
+                m_wrk_value[k]        += m_wrk_value[k+step];
+                m_wrk_npred[k]        += m_wrk_npred[k+step];
             }
+        }
 
-            #pragma omp section
-            {
-                for(int i = 0; i < vect_cpy_npred.size(); ++i){
-                    m_npred += *(vect_cpy_npred.at(i));
-                    delete vect_cpy_npred.at(i);
-                }
-            }
+        // Update attributes
+        m_value     = m_wrk_value[0];
+        m_npred     = m_wrk_npred[0];
+        m_gradient  = new GVector(*(m_wrk_gradient[0]));
+        m_curvature = new GMatrixSparse(*(m_wrk_curvature[0]));
 
-            #pragma omp section
-            {
-                for (int i = 0; i < vect_cpy_value.size(); ++i){
-                    m_value += *(vect_cpy_value.at(i));
-                    delete vect_cpy_value.at(i);
-                }
-            }
-        } // end of pragma omp sections
-
-        // Release stack
-        m_curvature->stack_destroy();
+        // Free workspaces unless they should be kept for further
+        // evaluations
+        if (!m_keep_wrk) {
+            free_workspaces();
+        }
 
     } while(0); // endwhile: main loop
 
@@ -352,6 +346,34 @@ void GObservations::likelihood::eval(const GOptimizerPars& pars)
 }
 
 
+/***********************************************************************//**
+ * @brief Keep workspaces between function evaluations
+ *
+ * @param[in] keep Keep workspaces?
+ *
+ * Signals whether the workspaces that are used by eval() should be kept
+ * for further function evaluations. Keeping the workspaces avoids the
+ * allocation of the model copies, gradient vectors and curvature matrices
+ * for every function evaluation, which is relevant for fits with many
+ * short observations. The workspaces are reallocated if the models of
+ * the observation container are replaced or changed in structure (see
+ * workspaces_valid()).
+ *
+ * Any existing workspaces are freed by this method.
+ ***************************************************************************/
+void GObservations::likelihood::keep_workspaces(const bool& keep)
+{
+    // Free existing workspaces
+    free_workspaces();
+
+    // Set flag
+    m_keep_wrk = keep;
+
+    // Return
+    return;
+}
+
+
 /*==========================================================================
  =                                                                         =
  =                            Private methods                              =
@@ -369,6 +391,13 @@ void GObservations::likelihood::init_members(void)
     m_this      = NULL;
     m_gradient  = NULL;
     m_curvature = NULL;
+    m_keep_wrk  = false;
+    m_wrk_keys.clear();
+    m_wrk_models.clear();
+    m_wrk_gradient.clear();
+    m_wrk_curvature.clear();
+    m_wrk_value.clear();
+    m_wrk_npred.clear();
 
     // Return
     return;
@@ -379,6 +408,9 @@ void GObservations::likelihood::init_members(void)
  * @brief Copy class members
  *
  * @param[in] fct Optimizer.
+ *
+ * The workspaces are not copied. They are allocated by the first call of
+ * eval().
  ***************************************************************************/
 void GObservations::likelihood::copy_members(const likelihood& fct)
 {
@@ -407,6 +439,9 @@ void GObservations::likelihood::free_members(void)
     if (m_gradient  != NULL) delete m_gradient;
     if (m_curvature != NULL) delete m_curvature;
 
+    // Free workspaces
+    free_workspaces();
+
     // Signal free pointers
     m_gradient  = NULL;
     m_curvature = NULL;
@@ -414,3 +449,118 @@ void GObservations::likelihood::free_members(void)
     // Return
     return;
 }
+
+
+/***********************************************************************//**
+ * @brief Allocate workspaces
+ *
+ * @param[in] number Number of workspaces.
+ * @param[in] npars Number of parameters.
+ *
+ * Allocates @p number workspaces for the parallel likelihood evaluation.
+ * Each workspace holds a copy of the models, a gradient vector and a
+ * curvature matrix with an initialised fill stack, and the function value
+ * and number of predicted events.
+ ***************************************************************************/
+void GObservations::likelihood::alloc_workspaces(const int& number,
+                                                 const int& npars)
+{
+    // Free existing workspaces
+    free_workspaces();
+
+    // Set stack size and number of entries
+    int stack_size  = (2*npars > 100000) ? 2*npars : 100000;
+    int max_entries =  2*npars;
+
+    // Store models for which the workspaces are allocated
+    const GModels& models = m_this->models();
+    for (int i = 0; i < models.size(); ++i) {
+        m_wrk_keys.push_back(models[i]);
+    }
+
+    // Allocate workspaces
+    for (int k = 0; k < number; ++k) {
+        GModels*       models    = new GModels(m_this->models());
+        GVector*       gradient  = new GVector(npars);
+        GMatrixSparse* curvature = new GMatrixSparse(npars,npars);
+        curvature->stack_init(stack_size, max_entries);
+        m_wrk_models.push_back(models);
+        m_wrk_gradient.push_back(gradient);
+        m_wrk_curvature.push_back(curvature);
+    }
+    m_wrk_value.assign(number, 0.0);
+    m_wrk_npred.assign(number, 0.0);
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Free workspaces
+ ***************************************************************************/
+void GObservations::likelihood::free_workspaces(void)
+{
+    // Free workspaces
+    for (int k = 0; k < m_wrk_models.size(); ++k) {
+        m_wrk_curvature[k]->stack_destroy();
+        delete m_wrk_curvature[k];
+        delete m_wrk_gradient[k];
+        delete m_wrk_models[k];
+    }
+
+    // Clear workspaces
+    m_wrk_keys.clear();
+    m_wrk_models.clear();
+    m_wrk_gradient.clear();
+    m_wrk_curvature.clear();
+    m_wrk_value.clear();
+    m_wrk_npred.clear();
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Check whether workspaces can be reused
+ *
+ * @param[in] number Number of workspaces.
+ * @param[in] npars Number of parameters.
+ * @return True if the existing workspaces can be reused.
+ *
+ * The workspaces can be reused if there are @p number workspaces for
+ * @p npars parameters that were allocated for the same models, i.e. the
+ * model pointers of the observation container are unchanged and the model
+ * copies of the first workspace agree with the models in type, name,
+ * instruments, observation identifiers and parameter names. Only the
+ * parameter values are then transferred to the workspaces by eval().
+ ***************************************************************************/
+bool GObservations::likelihood::workspaces_valid(const int& number,
+                                                 const int& npars) const
+{
+    // Check number and dimension of workspaces
+    const GModels& models = m_this->models();
+    bool valid = (m_wrk_models.size()      == number        &&
+                  m_wrk_gradient[0]->size() == npars         &&
+                  m_wrk_keys.size()        == models.size() &&
+                  m_wrk_models[0]->size()  == models.size());
+
+    // Check models
+    for (int i = 0; valid && i < models.size(); ++i) {
+        const GModel* model = models[i];
+        const GModel* copy  = (*m_wrk_models[0])[i];
+        valid = (model                == m_wrk_keys[i]       &&
+                 model->type()        == copy->type()        &&
+                 model->name()        == copy->name()        &&
+                 model->instruments() == copy->instruments() &&
+                 model->ids()         == copy->ids()         &&
+                 model->size()        == copy->size());
+        for (int ipar = 0; valid && ipar < model->size(); ++ipar) {
+            valid = ((*model)[ipar].name() == (*copy)[ipar].name());
+        }
+    }
+
+    // Return
+    return valid;
+}
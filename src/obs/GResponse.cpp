@@ -45,9 +45,9 @@
 
 /* __ Method name definitions ____________________________________________ */
 #define G_IRF_RADIAL               "GResponse::irf_radial(GEvent&, GSource&,"\
-                                                            " GObservation&)"
+                                                     " GObservation&, bool&)"
 #define G_IRF_ELLIPTICAL       "GResponse::irf_elliptical(GEvent&, GSource&,"\
-                                                            " GObservation&)"
+                                                     " GObservation&, bool&)"
 #define G_IRF_DIFFUSE             "GResponse::irf_diffuse(GEvent&, GSource&,"\
                                                             " GObservation&)"
 #define G_NPRED_RADIAL     "GResponse::npred_radial(GSource&, GObservation&)"
@@ -152,22 +152,47 @@ GResponse& GResponse::operator= (const GResponse& rsp)
  =                                                                         =
  ==========================================================================*/
 
+/***********************************************************************//**
+ * @brief Signal if response computes spatial model parameter gradients
+ *
+ * @return False.
+ *
+ * Signals whether the irf() method sets the factor gradients of the
+ * parameters of radial and elliptical spatial models if gradients are
+ * requested. The base class implementation does not compute these
+ * gradients, hence they need to be determined numerically.
+ ***************************************************************************/
+bool GResponse::has_irf_gradients(void) const
+{
+    // Return
+    return false;
+}
+
+
 /***********************************************************************//**
  * @brief Return value of instrument response function
  *
  * @param[in] event Event.
  * @param[in] source Source.
  * @param[in] obs Observation.
+ * @param[in] grad Compute spatial model parameter gradients?
  *
  * Returns the instrument response function for a given event, source and
  * observation.
  *
  * The method applies the deadtime correction, so that the response function
  * can be directly multiplied by the exposure time (also known as ontime).
+ *
+ * If @p grad is true, the response of radial and elliptical models also
+ * sets the factor gradients of the spatial model parameters to the
+ * derivatives of the response function with respect to these parameters.
+ * Response implementations that do not support analytical gradients leave
+ * the gradients unchanged and signal this through has_irf_gradients().
  ***************************************************************************/
 double GResponse::irf(const GEvent&       event,
                       const GSource&      source,
-                      const GObservation& obs) const
+                      const GObservation& obs,
+                      const bool&         grad) const
 {
     // Initialise IRF value
     double irf = 0.0;
@@ -179,12 +204,12 @@ double GResponse::irf(const GEvent&       event,
 
     // Is spatial model a radial source?
     else if (dynamic_cast<const GModelSpatialRadial*>(source.model()) != NULL) {
-        irf = irf_radial(event, source, obs);
+        irf = irf_radial(event, source, obs, grad);
     }
 
     // Is spatial model an elliptical source?
     else if (dynamic_cast<const GModelSpatialElliptical*>(source.model()) != NULL) {
-        irf = irf_elliptical(event, source, obs);
+        irf = irf_elliptical(event, source, obs, grad);
     }
 
     // Is spatial model a diffuse source?
@@ -241,13 +266,15 @@ double GResponse::irf_ptsrc(const GEvent&       event,
  * @param[in] event Observed event.
  * @param[in] source Source.
  * @param[in] obs Observation.
+ * @param[in] grad Compute spatial model parameter gradients?
  *
  * @exception GException::feature_not_implemented
  *            Method is not implemented.
  ***************************************************************************/
 double GResponse::irf_radial(const GEvent&       event,
                              const GSource&      source,
-                             const GObservation& obs) const
+                             const GObservation& obs,
+                             const bool&         grad) const
 {
     // Feature not yet implemented
     throw GException::feature_not_implemented(G_IRF_RADIAL,
@@ -264,13 +291,15 @@ double GResponse::irf_radial(const GEvent&       event,
  * @param[in] event Observed event.
  * @param[in] source Source.
  * @param[in] obs Observation.
+ * @param[in] grad Compute spatial model parameter gradients?
  *
  * @exception GException::feature_not_implemented
  *            Method is not implemented.
  ***************************************************************************/
 double GResponse::irf_elliptical(const GEvent&       event,
                                  const GSource&      source,
-                                 const GObservation& obs) const
+                                 const GObservation& obs,
+                                 const bool&         grad) const
 {
     // Feature not yet implemented
     throw GException::feature_not_implemented(G_IRF_ELLIPTICAL,
@@ -560,6 +589,43 @@ double GResponse::npred_diffuse(const GSource& source,
 }
 
 
+/***********************************************************************//**
+ * @brief Prepare source caches for a model evaluation
+ *
+ * @param[in] obs Observation.
+ * @param[in] models Models.
+ *
+ * This method is called once by the likelihood evaluation before the
+ * response is evaluated for the events of an observation. Derived classes
+ * may use it to resolve any per-source cache state (handles, parameter
+ * checks, ...) once so that the per-event methods can access their caches
+ * without lookups or locking. The base class implementation does nothing.
+ ***************************************************************************/
+void GResponse::set_source_caches(const GObservation& obs,
+                                  const GModels&      models) const
+{
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Release source caches after a model evaluation
+ *
+ * @param[in] obs Observation.
+ *
+ * This method is called once by the likelihood evaluation after all events
+ * of an observation have been evaluated. It ends the validity of the state
+ * that was set up by set_source_caches(). The base class implementation
+ * does nothing.
+ ***************************************************************************/
+void GResponse::clear_source_caches(const GObservation& obs) const
+{
+    // Return
+    return;
+}
+
+
 /*==========================================================================
  =                                                                         =
  =                            Protected methods                            =
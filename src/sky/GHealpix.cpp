@@ -29,6 +29,7 @@
 #include <config.h>
 #endif
 #include <cmath>
+#include <algorithm>
 #include "GException.hpp"
 #include "GTools.hpp"
 #include "GMath.hpp"
@@ -42,6 +43,9 @@
 #define G_PIX2ANG_RING        "GHealpix::pix2ang_ring(int, double*, double*)"
 #define G_PIX2ANG_NEST        "GHealpix::pix2ang_nest(int, double*, double*)"
 #define G_ORDERING_SET                     "GHealpix::ordering(std::string&)"
+#define G_NEST2RING                             "GHealpix::nest2ring(int&)"
+#define G_RING2NEST                             "GHealpix::ring2nest(int&)"
+#define G_NEIGHBOURS                     "GHealpix::neighbours(GSkyPixel&)"
 
 /* __ Macros _____________________________________________________________ */
 
@@ -432,6 +436,97 @@ GSkyPixel GHealpix::dir2pix(const GSkyDir& dir) const
 }
 
 
+/***********************************************************************//**
+ * @brief Transform array of pixels into sky coordinates
+ *
+ * @param[in] x Array [n] of pixel indices.
+ * @param[in] y Array [n] of pixel y coordinates (ignored).
+ * @param[in] n Number of pixels.
+ * @param[out] lon Array [n] of longitudes (deg).
+ * @param[out] lat Array [n] of latitudes (deg).
+ *
+ * Transforms an array of pixel indices into sky coordinates without
+ * allocating sky directions or pixels.
+ ***************************************************************************/
+void GHealpix::pix2dir(const double* x, const double* y,
+                       const int& n,
+                       double* lon, double* lat) const
+{
+    // Loop over pixels
+    for (int i = 0; i < n; ++i) {
+
+        // Perform ordering dependent conversion
+        double theta = 0.0;
+        double phi   = 0.0;
+        switch (m_ordering) {
+        case 0:
+            pix2ang_ring(int(x[i]), &theta, &phi);
+            break;
+        case 1:
+            pix2ang_nest(int(x[i]), &theta, &phi);
+            break;
+        default:
+            break;
+        }
+
+        // Store sky coordinates
+        lon[i] = phi * gammalib::rad2deg;
+        lat[i] = (gammalib::pihalf - theta) * gammalib::rad2deg;
+
+    } // endfor: looped over pixels
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Transform array of sky coordinates into pixels
+ *
+ * @param[in] lon Array [n] of longitudes (deg).
+ * @param[in] lat Array [n] of latitudes (deg).
+ * @param[in] n Number of sky coordinates.
+ * @param[out] x Array [n] of pixel indices.
+ * @param[out] y Array [n] of zeros.
+ *
+ * Transforms an array of sky coordinates into pixel indices without
+ * allocating sky directions or pixels.
+ ***************************************************************************/
+void GHealpix::dir2pix(const double* lon, const double* lat,
+                       const int& n,
+                       double* x, double* y) const
+{
+    // Loop over sky coordinates
+    for (int i = 0; i < n; ++i) {
+
+        // Compute (z,phi)
+        double z   = cos(gammalib::pihalf - lat[i] * gammalib::deg2rad);
+        double phi = lon[i] * gammalib::deg2rad;
+
+        // Perform ordering dependent conversion
+        int index = 0;
+        switch (m_ordering) {
+        case 0:
+            index = ang2pix_z_phi_ring(z, phi);
+            break;
+        case 1:
+            index = ang2pix_z_phi_nest(z, phi);
+            break;
+        default:
+            break;
+        }
+
+        // Store pixel
+        x[i] = double(index);
+        y[i] = 0.0;
+
+    } // endfor: looped over sky coordinates
+
+    // Return
+    return;
+}
+
+
 /***********************************************************************//**
  * @brief Returns ordering parameter.
  ***************************************************************************/
@@ -485,6 +580,509 @@ void GHealpix::ordering(const std::string& ordering)
 }
 
 
+/***********************************************************************//**
+ * @brief Convert nested pixel index into ring pixel index
+ *
+ * @param[in] ipix Pixel index in nested scheme.
+ * @return Pixel index in ring scheme.
+ *
+ * @exception GException::out_of_range
+ *            Pixel index is out of range.
+ ***************************************************************************/
+int GHealpix::nest2ring(const int& ipix) const
+{
+    // Check if ipix is in range
+    if (ipix < 0 || ipix >= m_num_pixels) {
+        throw GException::out_of_range(G_NEST2RING, ipix, 0, m_num_pixels-1);
+    }
+
+    // Convert pixel index
+    int ix;
+    int iy;
+    int face;
+    nest2xyf(ipix, &ix, &iy, &face);
+
+    // Return ring pixel index
+    return (xyf2ring(ix, iy, face));
+}
+
+
+/***********************************************************************//**
+ * @brief Convert ring pixel index into nested pixel index
+ *
+ * @param[in] ipix Pixel index in ring scheme.
+ * @return Pixel index in nested scheme.
+ *
+ * @exception GException::out_of_range
+ *            Pixel index is out of range.
+ ***************************************************************************/
+int GHealpix::ring2nest(const int& ipix) const
+{
+    // Check if ipix is in range
+    if (ipix < 0 || ipix >= m_num_pixels) {
+        throw GException::out_of_range(G_RING2NEST, ipix, 0, m_num_pixels-1);
+    }
+
+    // Convert pixel index
+    int ix;
+    int iy;
+    int face;
+    ring2xyf(ipix, &ix, &iy, &face);
+
+    // Return nested pixel index
+    return (xyf2nest(ix, iy, face));
+}
+
+
+/***********************************************************************//**
+ * @brief Return neighbouring pixels of a pixel
+ *
+ * @param[in] pixel Sky map pixel.
+ * @return Vector of 8 neighbouring pixel indices.
+ *
+ * @exception GException::invalid_argument
+ *            Sky map pixel is not 1-dimensional.
+ * @exception GException::out_of_range
+ *            Pixel index is out of range.
+ *
+ * Returns the indices of the 8 neighbouring pixels of the specified
+ * @p pixel in the pixel ordering of the projection. The neighbours are
+ * returned in the order SW, W, NW, N, NE, E, SE and S. Some pixels at the
+ * borders of the base pixels have only 7 neighbours; the missing neighbour
+ * is flagged by an index of -1.
+ ***************************************************************************/
+std::vector<int> GHealpix::neighbours(const GSkyPixel& pixel) const
+{
+    // Neighbour offsets in the face coordinates
+    static const int xoffset[] = {-1,-1, 0, 1, 1, 1, 0,-1};
+    static const int yoffset[] = { 0, 1, 1, 1, 0,-1,-1,-1};
+
+    // Face of neighbour and coordinate swapping for pixels beyond the face
+    // border. The first index is 4 + dx + 3*dy, where dx and dy are the
+    // number of faces crossed in x and y.
+    static const int facearray[][12] =
+          { {  8, 9,10,11,-1,-1,-1,-1,10,11, 8, 9 },   // S
+            {  5, 6, 7, 4, 8, 9,10,11, 9,10,11, 8 },   // SE
+            { -1,-1,-1,-1, 5, 6, 7, 4,-1,-1,-1,-1 },   // E
+            {  4, 5, 6, 7,11, 8, 9,10,11, 8, 9,10 },   // SW
+            {  0, 1, 2, 3, 4, 5, 6, 7, 8, 9,10,11 },   // centre
+            {  1, 2, 3, 0, 0, 1, 2, 3, 5, 6, 7, 4 },   // NE
+            { -1,-1,-1,-1, 7, 4, 5, 6,-1,-1,-1,-1 },   // W
+            {  3, 0, 1, 2, 3, 0, 1, 2, 4, 5, 6, 7 },   // NW
+            {  2, 3, 0, 1,-1,-1,-1,-1, 0, 1, 2, 3 } }; // N
+    static const int swaparray[][3] =
+          { { 0,0,3 },   // S
+            { 0,0,6 },   // SE
+            { 0,0,0 },   // E
+            { 0,0,5 },   // SW
+            { 0,0,0 },   // centre
+            { 5,0,0 },   // NE
+            { 0,0,0 },   // W
+            { 6,0,0 },   // NW
+            { 3,0,0 } }; // N
+
+    // Throw an exception if sky map pixel is not 1D
+    if (!pixel.is_1D()) {
+        std::string msg = "Sky map pixel "+pixel.print()+" is not"
+                          " 1-dimensional.\n"
+                          "Only 1-dimensional pixels are supported by the"
+                          " Healpix projection.";
+        throw GException::invalid_argument(G_NEIGHBOURS, msg);
+    }
+
+    // Check if pixel index is in range
+    int ipix = int(pixel);
+    if (ipix < 0 || ipix >= m_num_pixels) {
+        throw GException::out_of_range(G_NEIGHBOURS, ipix, 0, m_num_pixels-1);
+    }
+
+    // Allocate result
+    std::vector<int> result(8, -1);
+
+    // Get face coordinates of pixel
+    int ix;
+    int iy;
+    int face;
+    if (m_ordering == 0) {
+        ring2xyf(ipix, &ix, &iy, &face);
+    }
+    else {
+        nest2xyf(ipix, &ix, &iy, &face);
+    }
+
+    // Loop over neighbours
+    for (int i = 0; i < 8; ++i) {
+
+        // Get face coordinates of neighbour
+        int x = ix + xoffset[i];
+        int y = iy + yoffset[i];
+
+        // If the neighbour is beyond the face border then determine the
+        // face of the neighbour and the coordinates in that face
+        int nbnum = 4;
+        if (x < 0) {
+            x     += m_nside;
+            nbnum -= 1;
+        }
+        else if (x >= m_nside) {
+            x     -= m_nside;
+            nbnum += 1;
+        }
+        if (y < 0) {
+            y     += m_nside;
+            nbnum -= 3;
+        }
+        else if (y >= m_nside) {
+            y     -= m_nside;
+            nbnum += 3;
+        }
+
+        // Set pixel index of neighbour if the neighbour exists
+        int f = facearray[nbnum][face];
+        if (f >= 0) {
+            int bits = swaparray[nbnum][face>>2];
+            if (bits & 1) {
+                x = m_nside - x - 1;
+            }
+            if (bits & 2) {
+                y = m_nside - y - 1;
+            }
+            if (bits & 4) {
+                std::swap(x, y);
+            }
+            result[i] = (m_ordering == 0) ? xyf2ring(x, y, f)
+                                          : xyf2nest(x, y, f);
+        }
+
+    } // endfor: looped over neighbours
+
+    // Return neighbours
+    return result;
+}
+
+
+/***********************************************************************//**
+ * @brief Return pixels within a disc
+ *
+ * @param[in] dir Centre of disc.
+ * @param[in] radius Radius of disc (degrees).
+ * @param[in] inclusive Include all pixels that overlap with the disc?
+ * @return Vector of pixel indices.
+ *
+ * Returns the indices of all pixels whose centres lie within the disc of
+ * the specified @p radius around @p dir. If @p inclusive is true, all
+ * pixels that overlap with the disc are returned. In that case the disc
+ * radius is enlarged by the maximum pixel radius, hence a few pixels that
+ * are close to but do not overlap with the disc may also be returned.
+ *
+ * Only the rings that intersect with the disc are scanned, hence the
+ * computing time scales with the number of pixels in the disc and not
+ * with the number of pixels in the map. The pixel indices are returned
+ * in ascending order.
+ ***************************************************************************/
+std::vector<int> GHealpix::query_disc(const GSkyDir& dir,
+                                      const double&  radius,
+                                      const bool&    inclusive) const
+{
+    // Allocate result
+    std::vector<int> result;
+
+    // Continue only if the radius is not negative
+    if (radius >= 0.0) {
+
+        // Compute disc radius in radians
+        double rdisc = radius * gammalib::deg2rad;
+        if (inclusive) {
+            rdisc += max_pixrad();
+        }
+
+        // Get (theta,phi) of disc centre
+        double theta = 0.0;
+        double phi   = 0.0;
+        dir2ang(dir, &theta, &phi);
+        phi = gammalib::modulo(phi, gammalib::twopi);
+
+        // Limit disc radius to the full sphere
+        if (rdisc > gammalib::pi) {
+            rdisc = gammalib::pi;
+        }
+
+        // Setup
+        int    nrings  = 4 * m_nside;
+        double z0      = std::cos(theta);
+        double xa      = 1.0 / std::sqrt((1.0-z0)*(1.0+z0));
+        double cosdisc = std::cos(rdisc);
+
+        // Determine northern most ring. If the North pole is in the disc
+        // then add all rings above
+        double rlat1 = theta - rdisc;
+        int    irmin = ring_above(std::cos(rlat1)) + 1;
+        if (rlat1 <= 0.0 && irmin > 1) {
+            int startpix;
+            int ringpix;
+            bool shifted;
+            get_ring_info(irmin-1, &startpix, &ringpix, &shifted);
+            for (int i = 0; i < startpix+ringpix; ++i) {
+                result.push_back(i);
+            }
+        }
+
+        // Determine southern most ring
+        double rlat2 = theta + rdisc;
+        int    irmax = ring_above(std::cos(rlat2));
+
+        // Loop over rings that intersect with the disc
+        for (int iz = irmin; iz <= irmax; ++iz) {
+
+            // Compute half opening angle of ring within disc
+            double z    = ring2z(iz);
+            double x    = (cosdisc - z*z0) * xa;
+            double ysq  = 1.0 - z*z - x*x;
+            double dphi = (ysq <= 0.0) ? gammalib::pi - 1.0e-15
+                                       : std::atan2(std::sqrt(ysq), x);
+
+            // Continue only if ring intersects with the disc
+            if (dphi > 0.0) {
+
+                // Get ring information
+                int  startpix;
+                int  ringpix;
+                bool shifted;
+                get_ring_info(iz, &startpix, &ringpix, &shifted);
+                double shift = (shifted) ? 0.5 : 0.0;
+
+                // Determine pixel range within ring
+                double fac   = ringpix / gammalib::twopi;
+                int    ip_lo = int(std::floor(fac*(phi-dphi) - shift)) + 1;
+                int    ip_hi = int(std::floor(fac*(phi+dphi) - shift));
+                if (ip_hi - ip_lo >= ringpix) {
+                    ip_lo = 0;
+                    ip_hi = ringpix - 1;
+                }
+
+                // Append pixels, taking care of wrap arounds
+                if (ip_lo <= ip_hi) {
+                    if (ip_hi >= ringpix) {
+                        ip_lo -= ringpix;
+                        ip_hi -= ringpix;
+                    }
+                    if (ip_lo < 0) {
+                        for (int i = 0; i <= ip_hi; ++i) {
+                            result.push_back(startpix + i);
+                        }
+                        for (int i = ip_lo + ringpix; i < ringpix; ++i) {
+                            result.push_back(startpix + i);
+                        }
+                    }
+                    else {
+                        for (int i = ip_lo; i <= ip_hi; ++i) {
+                            result.push_back(startpix + i);
+                        }
+                    }
+                }
+
+            } // endif: ring intersected with disc
+
+        } // endfor: looped over rings
+
+        // If the South pole is in the disc then add all rings below
+        if (rlat2 >= gammalib::pi && irmax+1 < nrings) {
+            int  startpix;
+            int  ringpix;
+            bool shifted;
+            get_ring_info(irmax+1, &startpix, &ringpix, &shifted);
+            for (int i = startpix; i < m_num_pixels; ++i) {
+                result.push_back(i);
+            }
+        }
+
+        // Convert pixels into nested scheme if required
+        if (m_ordering == 1) {
+            for (int i = 0; i < result.size(); ++i) {
+                int ix;
+                int iy;
+                int face;
+                ring2xyf(result[i], &ix, &iy, &face);
+                result[i] = xyf2nest(ix, iy, face);
+            }
+        }
+
+        // Sort pixel indices
+        std::sort(result.begin(), result.end());
+
+    } // endif: radius was not negative
+
+    // Return pixels
+    return result;
+}
+
+
+/***********************************************************************//**
+ * @brief Return interpolation pixels and weights for a sky direction
+ *
+ * @param[in] dir Sky direction.
+ * @param[out] index Array [4] of pixel indices.
+ * @param[out] weight Array [4] of interpolation weights.
+ *
+ * Determines the four pixels whose centres surround the sky direction
+ * @p dir and the bilinear interpolation weights in (theta,phi) for these
+ * pixels. Two pixels lie on the ring above and two pixels on the ring
+ * below the sky direction. Close to the poles, where there is no ring above
+ * or below, the four pixels of the polar ring share the remaining weight.
+ * The weights sum up to one. The pixel indices are given in the pixel
+ * ordering of the projection.
+ ***************************************************************************/
+void GHealpix::interpolator(const GSkyDir& dir, int* index, double* weight) const
+{
+    // Get (theta,phi) of sky direction
+    double theta = 0.0;
+    double phi   = 0.0;
+    dir2ang(dir, &theta, &phi);
+    phi = gammalib::modulo(phi, gammalib::twopi);
+
+    // Determine rings above and below
+    int    nrings = 4 * m_nside;
+    int    ir1    = ring_above(std::cos(theta));
+    int    ir2    = ir1 + 1;
+    double theta1 = 0.0;
+    double theta2 = 0.0;
+
+    // Get pixels and phi weights of ring above
+    if (ir1 > 0) {
+        int  startpix;
+        int  ringpix;
+        bool shifted;
+        get_ring_info(ir1, &startpix, &ringpix, &shifted, &theta1);
+        double dphi = gammalib::twopi / ringpix;
+        double tmp  = phi/dphi - 0.5*shifted;
+        int    i1   = (tmp < 0.0) ? int(tmp)-1 : int(tmp);
+        double w1   = (phi - (i1+0.5*shifted)*dphi) / dphi;
+        int    i2   = i1 + 1;
+        if (i1 < 0) {
+            i1 += ringpix;
+        }
+        if (i2 >= ringpix) {
+            i2 -= ringpix;
+        }
+        index[0]  = startpix + i1;
+        index[1]  = startpix + i2;
+        weight[0] = 1.0 - w1;
+        weight[1] = w1;
+    }
+
+    // Get pixels and phi weights of ring below
+    if (ir2 < nrings) {
+        int  startpix;
+        int  ringpix;
+        bool shifted;
+        get_ring_info(ir2, &startpix, &ringpix, &shifted, &theta2);
+        double dphi = gammalib::twopi / ringpix;
+        double tmp  = phi/dphi - 0.5*shifted;
+        int    i1   = (tmp < 0.0) ? int(tmp)-1 : int(tmp);
+        double w1   = (phi - (i1+0.5*shifted)*dphi) / dphi;
+        int    i2   = i1 + 1;
+        if (i1 < 0) {
+            i1 += ringpix;
+        }
+        if (i2 >= ringpix) {
+            i2 -= ringpix;
+        }
+        index[2]  = startpix + i1;
+        index[3]  = startpix + i2;
+        weight[2] = 1.0 - w1;
+        weight[3] = w1;
+    }
+
+    // Handle sky directions north of the first ring
+    if (ir1 == 0) {
+        double wtheta = theta / theta2;
+        double fac    = (1.0 - wtheta) * 0.25;
+        weight[0]     = fac;
+        weight[1]     = fac;
+        weight[2]     = weight[2] * wtheta + fac;
+        weight[3]     = weight[3] * wtheta + fac;
+        index[0]      = (index[2] + 2) & 3;
+        index[1]      = (index[3] + 2) & 3;
+    }
+
+    // Handle sky directions south of the last ring
+    else if (ir2 == nrings) {
+        double wtheta = (theta - theta1) / (gammalib::pi - theta1);
+        double fac    = wtheta * 0.25;
+        weight[0]     = weight[0] * (1.0 - wtheta) + fac;
+        weight[1]     = weight[1] * (1.0 - wtheta) + fac;
+        weight[2]     = fac;
+        weight[3]     = fac;
+        index[2]      = ((index[0] + 2) & 3) + m_num_pixels - 4;
+        index[3]      = ((index[1] + 2) & 3) + m_num_pixels - 4;
+    }
+
+    // Handle sky directions between two rings
+    else {
+        double wtheta = (theta - theta1) / (theta2 - theta1);
+        weight[0]    *= (1.0 - wtheta);
+        weight[1]    *= (1.0 - wtheta);
+        weight[2]    *= wtheta;
+        weight[3]    *= wtheta;
+    }
+
+    // Convert pixels into nested scheme if required
+    if (m_ordering == 1) {
+        for (int i = 0; i < 4; ++i) {
+            int ix;
+            int iy;
+            int face;
+            ring2xyf(index[i], &ix, &iy, &face);
+            index[i] = xyf2nest(ix, iy, face);
+        }
+    }
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Return maximum angular distance between pixel centre and corners
+ *
+ * @return Maximum angular distance between any pixel centre and its
+ *         corners (radians).
+ ***************************************************************************/
+double GHealpix::max_pixrad(void) const
+{
+    // Initialise result
+    double result = 0.0;
+
+    // Continue only if resolution is set
+    if (m_nside > 0) {
+
+        // Set vector of pixel centre at z=2/3, phi=pi/(4 nside)
+        double za   = gammalib::twothird;
+        double sa   = std::sqrt((1.0-za)*(1.0+za));
+        double pa   = gammalib::pi / (4.0*m_nside);
+        double xa   = sa * std::cos(pa);
+        double ya   = sa * std::sin(pa);
+
+        // Set vector of pixel corner at phi=0
+        double t1   = 1.0 - 1.0/m_nside;
+        double zb   = 1.0 - t1*t1/3.0;
+        double xb   = std::sqrt((1.0-zb)*(1.0+zb));
+
+        // Compute angle between both vectors
+        double cx   = ya*zb;
+        double cy   = za*xb - xa*zb;
+        double cz   = -ya*xb;
+        double sinv = std::sqrt(cx*cx + cy*cy + cz*cz);
+        double cosv = xa*xb + za*zb;
+        result      = std::atan2(sinv, cosv);
+
+    } // endif: resolution was set
+
+    // Return result
+    return result;
+}
+
+
 /***********************************************************************//**
  * @brief Print WCS information
  *
@@ -928,3 +1526,291 @@ unsigned int GHealpix::isqrt(unsigned int arg) const
     // Return
     return unsigned(std::sqrt(arg+0.5));
 }
+
+
+/***********************************************************************//**
+ * @brief Compute (theta,phi) angles of sky direction
+ *
+ * @param[in] dir Sky direction.
+ * @param[out] theta Pointer to zenith angle in radians.
+ * @param[out] phi Pointer to azimuth angle in radians.
+ *
+ * Computes the angles in the coordinate system of the projection.
+ ***************************************************************************/
+void GHealpix::dir2ang(const GSkyDir& dir, double* theta, double* phi) const
+{
+    // Compute coordinate system dependent (theta,phi)
+    switch (m_coordsys) {
+    case 0:
+        *theta = gammalib::pihalf - dir.dec();
+        *phi   = dir.ra();
+        break;
+    case 1:
+        *theta = gammalib::pihalf - dir.b();
+        *phi   = dir.l();
+        break;
+    default:
+        *theta = 0.0;
+        *phi   = 0.0;
+        break;
+    }
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Convert nested pixel index into face coordinates
+ *
+ * @param[in] ipix Pixel index in nested scheme.
+ * @param[out] ix Pointer to x coordinate within face.
+ * @param[out] iy Pointer to y coordinate within face.
+ * @param[out] face Pointer to face number.
+ ***************************************************************************/
+void GHealpix::nest2xyf(const int& ipix, int* ix, int* iy, int* face) const
+{
+    // Compute face and coordinates within face
+    *face = ipix / m_npface;
+    pix2xy(ipix - *face * m_npface, ix, iy);
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Convert face coordinates into nested pixel index
+ *
+ * @param[in] ix x coordinate within face.
+ * @param[in] iy y coordinate within face.
+ * @param[in] face Face number.
+ * @return Pixel index in nested scheme.
+ ***************************************************************************/
+int GHealpix::xyf2nest(const int& ix, const int& iy, const int& face) const
+{
+    // Return pixel index
+    return (face * m_npface + xy2pix(ix, iy));
+}
+
+
+/***********************************************************************//**
+ * @brief Convert ring pixel index into face coordinates
+ *
+ * @param[in] ipix Pixel index in ring scheme.
+ * @param[out] ix Pointer to x coordinate within face.
+ * @param[out] iy Pointer to y coordinate within face.
+ * @param[out] face Pointer to face number.
+ ***************************************************************************/
+void GHealpix::ring2xyf(const int& ipix, int* ix, int* iy, int* face) const
+{
+    // Initialise ring information
+    int iring;
+    int iphi;
+    int kshift;
+    int nr;
+    int nl2 = 2 * m_nside;
+
+    // Handle North Polar cap
+    if (ipix < m_ncap) {
+        iring  = int(0.5*(1+isqrt(1+2*ipix)));
+        iphi   = (ipix+1) - 2*iring*(iring-1);
+        kshift = 0;
+        nr     = iring;
+        *face  = (iphi-1) / nr;
+    }
+
+    // Handle Equatorial region
+    else if (ipix < (m_num_pixels - m_ncap)) {
+        int ip  = ipix - m_ncap;
+        int tmp = ip / (4*m_nside);
+        iring   = tmp + m_nside;
+        iphi    = ip - tmp*4*m_nside + 1;
+        kshift  = (iring+m_nside) & 1;
+        nr      = m_nside;
+        int ire = iring - m_nside + 1;
+        int irm = nl2 + 2 - ire;
+        int ifm = (iphi - ire/2 + m_nside - 1) / m_nside;
+        int ifp = (iphi - irm/2 + m_nside - 1) / m_nside;
+        *face   = (ifp == ifm) ? (ifp | 4) : ((ifp < ifm) ? ifp : (ifm + 8));
+    }
+
+    // Handle South Polar cap
+    else {
+        int ip = m_num_pixels - ipix;
+        iring  = int(0.5*(1+isqrt(2*ip-1)));
+        iphi   = 4*iring + 1 - (ip - 2*iring*(iring-1));
+        kshift = 0;
+        nr     = iring;
+        iring  = 2*nl2 - iring;
+        *face  = 8 + (iphi-1) / nr;
+    }
+
+    // Compute coordinates within face
+    int irt = iring - (jrll[*face] * m_nside) + 1;
+    int ipt = 2*iphi - jpll[*face]*nr - kshift - 1;
+    if (ipt >= nl2) {
+        ipt -= 8*m_nside;
+    }
+    *ix = (ipt - irt) >> 1;
+    *iy = (-(ipt + irt)) >> 1;
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Convert face coordinates into ring pixel index
+ *
+ * @param[in] ix x coordinate within face.
+ * @param[in] iy y coordinate within face.
+ * @param[in] face Face number.
+ * @return Pixel index in ring scheme.
+ ***************************************************************************/
+int GHealpix::xyf2ring(const int& ix, const int& iy, const int& face) const
+{
+    // Compute ring number
+    int nl4 = 4 * m_nside;
+    int jr  = (jrll[face] * m_nside) - ix - iy - 1;
+
+    // Compute ring information
+    int nr;
+    int kshift;
+    int n_before;
+    if (jr < m_nside) {
+        nr       = jr;
+        n_before = 2*nr*(nr-1);
+        kshift   = 0;
+    }
+    else if (jr > 3*m_nside) {
+        nr       = nl4 - jr;
+        n_before = m_num_pixels - 2*(nr+1)*nr;
+        kshift   = 0;
+    }
+    else {
+        nr       = m_nside;
+        n_before = m_ncap + (jr-m_nside)*nl4;
+        kshift   = (jr-m_nside) & 1;
+    }
+
+    // Compute pixel number in ring
+    int jp = (jpll[face]*nr + ix - iy + 1 + kshift) / 2;
+    if (jp > nl4) {
+        jp -= nl4;
+    }
+    else if (jp < 1) {
+        jp += nl4;
+    }
+
+    // Return pixel index
+    return (n_before + jp - 1);
+}
+
+
+/***********************************************************************//**
+ * @brief Return number of next ring to the north of a given z
+ *
+ * @param[in] z Cosine of zenith angle.
+ * @return Ring number (0 if z lies north of the first ring).
+ ***************************************************************************/
+int GHealpix::ring_above(const double& z) const
+{
+    // Initialise result
+    int iring;
+
+    // Handle equatorial region
+    double az = std::abs(z);
+    if (az <= gammalib::twothird) {
+        iring = int(m_nside*(2.0-1.5*z));
+    }
+
+    // Handle polar caps
+    else {
+        iring = int(m_nside*std::sqrt(3.0*(1.0-az)));
+        if (z <= 0.0) {
+            iring = 4*m_nside - iring - 1;
+        }
+    }
+
+    // Return ring number
+    return iring;
+}
+
+
+/***********************************************************************//**
+ * @brief Return cosine of zenith angle of a ring
+ *
+ * @param[in] ring Ring number (1 - 4 nside-1).
+ * @return Cosine of zenith angle of ring.
+ ***************************************************************************/
+double GHealpix::ring2z(const int& ring) const
+{
+    // Initialise result
+    double z;
+
+    // Compute z
+    if (ring < m_nside) {
+        z = 1.0 - ring*ring*m_fact2;
+    }
+    else if (ring <= 3*m_nside) {
+        z = (2*m_nside-ring) * m_fact1;
+    }
+    else {
+        int nr = 4*m_nside - ring;
+        z = nr*nr*m_fact2 - 1.0;
+    }
+
+    // Return z
+    return z;
+}
+
+
+/***********************************************************************//**
+ * @brief Return information about a ring
+ *
+ * @param[in] ring Ring number (1 - 4 nside-1).
+ * @param[out] startpix Pointer to first ring pixel index.
+ * @param[out] ringpix Pointer to number of pixels in ring.
+ * @param[out] shifted Pointer to flag signalling that the pixel centres
+ *                     are shifted by half a pixel in phi.
+ * @param[out] theta Pointer to zenith angle of ring in radians (optional).
+ ***************************************************************************/
+void GHealpix::get_ring_info(const int& ring, int* startpix, int* ringpix,
+                             bool* shifted, double* theta) const
+{
+    // Get ring number counted from the closest pole
+    int northring = (ring > 2*m_nside) ? 4*m_nside - ring : ring;
+
+    // Handle polar caps
+    if (northring < m_nside) {
+        *ringpix  = 4 * northring;
+        *shifted  = true;
+        *startpix = 2 * northring * (northring-1);
+        if (theta != NULL) {
+            double tmp = northring * northring * m_fact2;
+            *theta     = std::atan2(std::sqrt(tmp*(2.0-tmp)), 1.0-tmp);
+        }
+    }
+
+    // Handle equatorial region
+    else {
+        *ringpix  = 4 * m_nside;
+        *shifted  = (((northring-m_nside) & 1) == 0);
+        *startpix = m_ncap + (northring-m_nside) * *ringpix;
+        if (theta != NULL) {
+            *theta = std::acos((2*m_nside-northring) * m_fact1);
+        }
+    }
+
+    // Handle southern hemisphere
+    if (northring != ring) {
+        *startpix = m_num_pixels - *startpix - *ringpix;
+        if (theta != NULL) {
+            *theta = gammalib::pi - *theta;
+        }
+    }
+
+    // Return
+    return;
+}
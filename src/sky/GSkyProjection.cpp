@@ -199,6 +199,102 @@ void GSkyProjection::coordsys(const std::string& coordsys)
 }
 
 
+/***********************************************************************//**
+ * @brief Transform array of pixels into sky coordinates
+ *
+ * @param[in] x Array [n] of pixel x coordinates (pixel index for
+ *              1-dimensional projections).
+ * @param[in] y Array [n] of pixel y coordinates (ignored for
+ *              1-dimensional projections).
+ * @param[in] n Number of pixels.
+ * @param[out] lon Array [n] of longitudes (deg).
+ * @param[out] lat Array [n] of latitudes (deg).
+ *
+ * Transforms an array of sky map pixels into sky coordinates. The sky
+ * coordinates are given in the coordinate system of the projection. This
+ * implementation transforms the pixels one by one using
+ * pix2dir(const GSkyPixel&).
+ ***************************************************************************/
+void GSkyProjection::pix2dir(const double* x, const double* y,
+                             const int& n,
+                             double* lon, double* lat) const
+{
+    // Loop over pixels
+    for (int i = 0; i < n; ++i) {
+
+        // Transform pixel
+        GSkyDir dir = (size() == 1) ? pix2dir(GSkyPixel(x[i]))
+                                    : pix2dir(GSkyPixel(x[i], y[i]));
+
+        // Store coordinate system-dependent sky coordinates
+        if (m_coordsys == 0) {
+            lon[i] = dir.ra_deg();
+            lat[i] = dir.dec_deg();
+        }
+        else {
+            lon[i] = dir.l_deg();
+            lat[i] = dir.b_deg();
+        }
+
+    } // endfor: looped over pixels
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Transform array of sky coordinates into pixels
+ *
+ * @param[in] lon Array [n] of longitudes (deg).
+ * @param[in] lat Array [n] of latitudes (deg).
+ * @param[in] n Number of sky coordinates.
+ * @param[out] x Array [n] of pixel x coordinates (pixel index for
+ *               1-dimensional projections).
+ * @param[out] y Array [n] of pixel y coordinates (zero for 1-dimensional
+ *               projections).
+ *
+ * Transforms an array of sky coordinates into sky map pixels. The sky
+ * coordinates are given in the coordinate system of the projection. This
+ * implementation transforms the sky coordinates one by one using
+ * dir2pix(const GSkyDir&).
+ ***************************************************************************/
+void GSkyProjection::dir2pix(const double* lon, const double* lat,
+                             const int& n,
+                             double* x, double* y) const
+{
+    // Loop over sky coordinates
+    for (int i = 0; i < n; ++i) {
+
+        // Set coordinate system-dependent sky direction
+        GSkyDir dir;
+        if (m_coordsys == 0) {
+            dir.radec_deg(lon[i], lat[i]);
+        }
+        else {
+            dir.lb_deg(lon[i], lat[i]);
+        }
+
+        // Transform sky direction
+        GSkyPixel pixel = dir2pix(dir);
+
+        // Store pixel
+        if (pixel.is_1D()) {
+            x[i] = double(pixel);
+            y[i] = 0.0;
+        }
+        else {
+            x[i] = pixel.x();
+            y[i] = pixel.y();
+        }
+
+    } // endfor: looped over sky coordinates
+
+    // Return
+    return;
+}
+
+
 /*==========================================================================
  =                                                                         =
  =                            Protected methods                            =
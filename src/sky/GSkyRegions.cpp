@@ -29,6 +29,7 @@
 #include <config.h>
 #include <fstream>
 #endif
+#include <algorithm>
 #include "GBase.hpp"
 #include "GSkyRegion.hpp"
 #include "GSkyRegionCircle.hpp"
@@ -55,6 +56,10 @@
 
 /* __ Debug definitions __________________________________________________ */
 
+/* __ Constants __________________________________________________________ */
+const int g_index_min_regions = 16;  //!< Minimum number of regions for index
+const int g_index_max_nside   = 256; //!< Maximum resolution of index
+
 
 /*==========================================================================
  =                                                                         =
@@ -180,6 +185,9 @@ GSkyRegion* GSkyRegions::operator[](const std::string& name)
         throw GException::invalid_argument(G_ACCESS, msg);
     }
 
+    // Invalidate spatial index since the region may be modified
+    m_index_valid = false;
+
     // Return pointer
     return m_regions[index];
 }
@@ -265,6 +273,9 @@ GSkyRegion* GSkyRegions::at(const int& index)
         throw GException::out_of_range(G_AT, index, 0, size()-1);
     }
 
+    // Invalidate spatial index since the region may be modified
+    m_index_valid = false;
+
     // Return pointer
     return m_regions[index];
 }
@@ -333,6 +344,9 @@ GSkyRegion* GSkyRegions::set(const int& index, const GSkyRegion& region)
     // Assign new region by cloning
     m_regions[index] = region.clone();
 
+    // Invalidate spatial index
+    m_index_valid = false;
+
     // Return pointer to region
     return m_regions[index];
 }
@@ -380,6 +394,9 @@ GSkyRegion* GSkyRegions::set(const std::string& name, const GSkyRegion& region)
     // Assign new region by cloning
     m_regions[index] = region.clone();
 
+    // Invalidate spatial index
+    m_index_valid = false;
+
     // Return pointer to region
     return m_regions[index];
 }
@@ -416,6 +433,9 @@ GSkyRegion* GSkyRegions::append(const GSkyRegion& region)
     // Append deep copy of region
     m_regions.push_back(ptr);
 
+    // Invalidate spatial index
+    m_index_valid = false;
+
     // Return pointer to region
     return ptr;
 }
@@ -470,6 +490,9 @@ GSkyRegion* GSkyRegions::insert(const int& index, const GSkyRegion& region)
     // Inserts deep copy of region
     m_regions.insert(m_regions.begin()+index, ptr);
 
+    // Invalidate spatial index
+    m_index_valid = false;
+
     // Return pointer to region
     return ptr;
 }
@@ -518,6 +541,9 @@ GSkyRegion* GSkyRegions::insert(const std::string& name, const GSkyRegion& regio
     // Inserts deep copy of region
     m_regions.insert(m_regions.begin()+index, ptr);
 
+    // Invalidate spatial index
+    m_index_valid = false;
+
     // Return pointer to region
     return ptr;
 }
@@ -547,6 +573,9 @@ void GSkyRegions::remove(const int& index)
 
     // Erase region component from container
     m_regions.erase(m_regions.begin() + index);
+
+    // Invalidate spatial index
+    m_index_valid = false;
     
     // Return
     return;
@@ -578,6 +607,9 @@ void GSkyRegions::remove(const std::string& name)
 
     // Erase region component from container
     m_regions.erase(m_regions.begin() + index);
+
+    // Invalidate spatial index
+    m_index_valid = false;
     
     // Return
     return;
@@ -624,6 +656,9 @@ void GSkyRegions::extend(const GSkyRegions& regions)
 
         } // endfor: looped over all regions
 
+        // Invalidate spatial index
+        m_index_valid = false;
+
     } // endif: region container was not empty
     
     // Return
@@ -823,24 +858,76 @@ std::string GSkyRegions::print(const GChatter& chatter) const
  * @param[in] dir A sky direction
  * @return True or False
  *
- * Tells if direction is contained in one of the regions
- ***************************************************************************/
- bool GSkyRegions::contains(const GSkyDir& dir) const
- {
-	 // Initialise return value
-	 bool dir_is_in = false;
-	 
-	 // Loop over regions
-	 for (int i = 0; i < size(); ++i) {
-		 dir_is_in=m_regions[i]->contains(dir);
-		 if (dir_is_in) break;
-	 }
-	 
-	 // Return result
-	 return dir_is_in;
- }
-
- 
+ * Tells if direction is contained in one of the regions. For containers
+ * with many regions the test is done using the spatial index.
+ ***************************************************************************/
+bool GSkyRegions::contains(const GSkyDir& dir) const
+{
+    // Initialise return value
+    bool dir_is_in = false;
+
+    // Use spatial index for large containers
+    if (size() >= g_index_min_regions) {
+        update_index();
+        dir_is_in = index_contains(dir);
+    }
+
+    // ... otherwise loop over regions
+    else {
+        for (int i = 0; i < size(); ++i) {
+            dir_is_in = m_regions[i]->contains(dir);
+            if (dir_is_in) {
+                break;
+            }
+        }
+    }
+
+    // Return result
+    return dir_is_in;
+}
+
+
+/***********************************************************************//**
+ * @brief Tells which directions are contained in one of the regions
+ *
+ * @param[in] dirs Sky directions.
+ * @return Vector of flags that signal if the sky directions are contained
+ *         in one of the regions.
+ *
+ * Tells for each of the sky directions @p dirs if it is contained in one of
+ * the regions. For containers with many regions the spatial index is built
+ * once and used for all sky directions.
+ ***************************************************************************/
+std::vector<bool> GSkyRegions::contains(const std::vector<GSkyDir>& dirs) const
+{
+    // Allocate result
+    std::vector<bool> mask(dirs.size(), false);
+
+    // Use spatial index for large containers
+    if (size() >= g_index_min_regions) {
+        update_index();
+        for (int k = 0; k < dirs.size(); ++k) {
+            mask[k] = index_contains(dirs[k]);
+        }
+    }
+
+    // ... otherwise loop over regions
+    else {
+        for (int k = 0; k < dirs.size(); ++k) {
+            for (int i = 0; i < size(); ++i) {
+                if (m_regions[i]->contains(dirs[k])) {
+                    mask[k] = true;
+                    break;
+                }
+            }
+        }
+    }
+
+    // Return mask
+    return mask;
+}
+
+
 /***********************************************************************//**
  * @brief Tells if region overlaps one of the regions
  *
@@ -879,6 +966,11 @@ void GSkyRegions::init_members(void)
     // Initialise members
     m_filename.clear();
     m_regions.clear();
+    m_index_valid = false;
+    m_index_proj.clear();
+    m_index_start.clear();
+    m_index_regions.clear();
+    m_index_other.clear();
 
     // Return
     return;
@@ -954,3 +1046,167 @@ int GSkyRegions::get_index(const std::string& name) const
     // Return index
     return index;
 }
+
+
+/***********************************************************************//**
+ * @brief Build spatial index
+ *
+ * Builds a spatial index that lists for each pixel of a HEALPix
+ * pixelisation the circular regions that overlap with the pixel. The
+ * resolution of the pixelisation is chosen so that the pixel size is
+ * comparable to the median radius of the circular regions, with a maximum
+ * Nside of 256. Regions that are not circles are tested for every sky
+ * direction.
+ *
+ * The index is stored in compressed row format: the indices of the regions
+ * that overlap with pixel @p k are stored in m_index_regions between the
+ * positions m_index_start[k] and m_index_start[k+1].
+ ***************************************************************************/
+void GSkyRegions::build_index(void) const
+{
+    // Clear index
+    m_index_start.clear();
+    m_index_regions.clear();
+    m_index_other.clear();
+
+    // Collect circular regions and their radii, and put all other regions
+    // into the list of regions that are always tested
+    std::vector<const GSkyRegionCircle*> circles(size(), NULL);
+    std::vector<double>                  radii;
+    for (int i = 0; i < size(); ++i) {
+        circles[i] = dynamic_cast<const GSkyRegionCircle*>(m_regions[i]);
+        if (circles[i] != NULL) {
+            radii.push_back(circles[i]->radius());
+        }
+        else {
+            m_index_other.push_back(i);
+        }
+    }
+
+    // Determine index resolution from the median radius of the circles.
+    // The resolution is the smallest Nside for which the typical pixel
+    // size of 58.6/Nside degrees does not exceed the median radius.
+    int nside = 1;
+    if (!radii.empty()) {
+        std::nth_element(radii.begin(), radii.begin()+radii.size()/2,
+                         radii.end());
+        double radius = radii[radii.size()/2];
+        while (nside < g_index_max_nside &&
+               58.6/double(nside) > radius) {
+            nside *= 2;
+        }
+    }
+    m_index_proj = GHealpix(nside, "RING", "EQU");
+
+    // Determine the pixels that overlap with each circle
+    int                           npix = m_index_proj.npix();
+    std::vector<std::vector<int> > discs(size());
+    std::vector<int>              counts(npix, 0);
+    for (int i = 0; i < size(); ++i) {
+        if (circles[i] != NULL) {
+            discs[i] = m_index_proj.query_disc(circles[i]->centre(),
+                                               circles[i]->radius(),
+                                               true);
+            for (int k = 0; k < discs[i].size(); ++k) {
+                counts[discs[i][k]]++;
+            }
+        }
+    }
+
+    // Set first entry of each pixel
+    m_index_start.assign(npix+1, 0);
+    for (int k = 0; k < npix; ++k) {
+        m_index_start[k+1] = m_index_start[k] + counts[k];
+    }
+
+    // Fill region indices
+    m_index_regions.assign(m_index_start[npix], 0);
+    std::vector<int> next(m_index_start.begin(), m_index_start.end()-1);
+    for (int i = 0; i < size(); ++i) {
+        for (int k = 0; k < discs[i].size(); ++k) {
+            m_index_regions[next[discs[i][k]]++] = i;
+        }
+    }
+
+    // Signal that index is valid. The flush makes the index visible to
+    // other threads before the flag is set.
+    #pragma omp flush
+    #pragma omp atomic write
+    m_index_valid = true;
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Update spatial index
+ *
+ * Builds the spatial index if it is not valid. The validity flag is read
+ * atomically and followed by a flush, so that threads that find a valid
+ * index do not lock and see the index. Only the building of the index is
+ * done within a critical region, where the flag is checked again so that
+ * the index is built by a single thread.
+ ***************************************************************************/
+void GSkyRegions::update_index(void) const
+{
+    // Atomically read validity flag and make the index visible
+    bool valid;
+    #pragma omp atomic read
+    valid = m_index_valid;
+    #pragma omp flush
+
+    // Build spatial index if it is not valid
+    if (!valid) {
+        #pragma omp critical(GSkyRegions_update_index)
+        {
+            if (!m_index_valid) {
+                build_index();
+            }
+        }
+    }
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Tells if direction is contained in one of the regions using the
+ *        spatial index
+ *
+ * @param[in] dir A sky direction
+ * @return True or False
+ *
+ * Tells if direction is contained in one of the regions by testing only the
+ * regions that are listed in the spatial index for the pixel that contains
+ * the sky direction. The spatial index needs to be validated before using
+ * update_index().
+ ***************************************************************************/
+bool GSkyRegions::index_contains(const GSkyDir& dir) const
+{
+    // Initialise return value
+    bool dir_is_in = false;
+
+    // Test the regions that overlap with the pixel of the sky direction
+    int pixel = int(m_index_proj.dir2pix(dir));
+    for (int k = m_index_start[pixel]; k < m_index_start[pixel+1]; ++k) {
+        if (m_regions[m_index_regions[k]]->contains(dir)) {
+            dir_is_in = true;
+            break;
+        }
+    }
+
+    // Test all regions that are not in the spatial index
+    if (!dir_is_in) {
+        for (int i = 0; i < m_index_other.size(); ++i) {
+            if (m_regions[m_index_other[i]]->contains(dir)) {
+                dir_is_in = true;
+                break;
+            }
+        }
+    }
+
+    // Return result
+    return dir_is_in;
+}
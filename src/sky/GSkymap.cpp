@@ -46,10 +46,14 @@
 #define G_OP_ACCESS_1D                        "GSkymap::operator(int&, int&)"
 #define G_OP_ACCESS_2D                  "GSkymap::operator(GSkyPixel&, int&)"
 #define G_OP_VALUE                        "GSkymap::operator(GSkyDir&, int&)"
+#define G_OP_WEIGHTS                     "GSkymap::operator(weights&, int&)"
 #define G_INX2DIR                                    "GSkymap::inx2dir(int&)"
 #define G_PIX2DIR                              "GSkymap::pix2dir(GSkyPixel&)"
 #define G_DIR2INX                                "GSkymap::dir2inx(GSkyDir&)"
 #define G_DIR2PIX                                "GSkymap::dir2pix(GSkyDir&)"
+#define G_PIX2DIR_VECTOR          "GSkymap::pix2dir(std::vector<GSkyPixel>&)"
+#define G_DIR2PIX_VECTOR            "GSkymap::dir2pix(std::vector<GSkyDir>&)"
+#define G_PIXELS                                    "GSkymap::pixels()"
 #define G_SOLIDANGLE1                             "GSkymap::solidangle(int&)"
 #define G_SOLIDANGLE2                       "GSkymap::solidangle(GSkyPixel&)"
 #define G_READ                               "GSkymap::read(const GFitsHDU&)"
@@ -315,6 +319,13 @@ double& GSkymap::operator()(const int& index, const int& map)
     }
     #endif
 
+    // Make sure that pixels can be modified. A reference counter of one
+    // can only change through this sky map, hence it is read without
+    // locking.
+    if (m_fpixels != NULL || (m_refs != NULL && *m_refs != 1)) {
+        unshare_pixels();
+    }
+
     // Return reference to pixel value
     return m_pixels[index+m_num_pixels*map];
 }
@@ -332,7 +343,7 @@ double& GSkymap::operator()(const int& index, const int& map)
  * Access sky map pixel by its index, where the most quickly varying axis is
  * the x axis of the map.
  ***************************************************************************/
-const double& GSkymap::operator()(const int& index, const int& map) const
+double GSkymap::operator()(const int& index, const int& map) const
 {
     // Throw an error if pixel index or map index is not in valid range
     #if defined(G_RANGE_CHECK)
@@ -348,8 +359,11 @@ const double& GSkymap::operator()(const int& index, const int& map) const
     }
     #endif
 
-    // Return reference to pixel value
-    return m_pixels[index+m_num_pixels*map];
+    // Get pixel index in pixel array
+    int inx = index+m_num_pixels*map;
+
+    // Return pixel value
+    return ((m_fpixels != NULL) ? double(m_fpixels[inx]) : m_pixels[inx]);
 }
 
 
@@ -386,6 +400,13 @@ double& GSkymap::operator()(const GSkyPixel& pixel, const int& map)
     // Get pixel index
     int index = pix2inx(pixel);
 
+    // Make sure that pixels can be modified. A reference counter of one
+    // can only change through this sky map, hence it is read without
+    // locking.
+    if (m_fpixels != NULL || (m_refs != NULL && *m_refs != 1)) {
+        unshare_pixels();
+    }
+
     // Return reference to pixel value
     return m_pixels[index+m_num_pixels*map];
 }
@@ -405,7 +426,7 @@ double& GSkymap::operator()(const GSkyPixel& pixel, const int& map)
  *
  * @todo Implement proper skymap exception (actual is for matrix elements)
  ***************************************************************************/
-const double& GSkymap::operator()(const GSkyPixel& pixel, const int& map) const
+double GSkymap::operator()(const GSkyPixel& pixel, const int& map) const
 {
     // Throw an error if pixel index or map index is not in valid range
     #if defined(G_RANGE_CHECK)
@@ -421,11 +442,11 @@ const double& GSkymap::operator()(const GSkyPixel& pixel, const int& map) const
     }
     #endif
 
-    // Get pixel index
-    int index = pix2inx(pixel);
+    // Get pixel index in pixel array
+    int inx = pix2inx(pixel)+m_num_pixels*map;
 
-    // Return reference to pixel value
-    return m_pixels[index+m_num_pixels*map];
+    // Return pixel value
+    return ((m_fpixels != NULL) ? double(m_fpixels[inx]) : m_pixels[inx]);
 }
 
 
@@ -441,9 +462,6 @@ const double& GSkymap::operator()(const GSkyPixel& pixel, const int& map) const
  * Returns the skymap value for a given sky direction, obtained by bi-linear
  * interpolation of the neighbouring pixels. If the sky direction falls
  * outside the area covered by the skymap, a value of 0 is returned.
- *
- * @todo The actual method only works on 2D images. It will fail for Healpix
- *       pixelisations.
  ***************************************************************************/
 double GSkymap::operator()(const GSkyDir& dir, const int& map) const
 {
@@ -456,61 +474,65 @@ double GSkymap::operator()(const GSkyDir& dir, const int& map) const
     }
     #endif
 
-    // Initialise intensity
-    double intensity = 0.0;
+    // Determine pixel indices and weighting factors for bi-linear
+    // interpolation and compute interpolated skymap value
+    double intensity = (*this)(lookup(dir), map);
 
-    // Determine sky pixel
-    GSkyPixel pixel = dir2pix(dir);
+    // Return intensity
+    return intensity;
+}
 
-    // Continue only if pixel is within the map
-    if (contains(pixel)) {
 
-        // Set left indices for interpolation. The left index is comprised
-        // between 0 and npixels-2. By definition, the right index is then
-        // the left index + 1
-        int inx_x = int(pixel.x());
-        int inx_y = int(pixel.y());
-        if (inx_x < 0) {
-            inx_x = 0;
-        }
-        else if (inx_x > m_num_x-2) {
-            inx_x = m_num_x - 2;
-        }
-        if (inx_y < 0) {
-            inx_y = 0;
-        }
-        else if (inx_y > m_num_y-2) {
-            inx_y = m_num_y - 2;
-        }
+/***********************************************************************//**
+ * @brief Return interpolated skymap value for pixel weights
+ *
+ * @param[in] wgt Pixel indices and weighting factors.
+ * @param[in] map Map index [0,...,nmaps()-1].
+ *
+ * @exception GException::out_of_range
+ *            Map index lies outside valid range.
+ *
+ * Returns the skymap value obtained by applying the pixel indices and
+ * weighting factors returned by lookup() to the specified map. Since no
+ * sky projection is involved, the same weights can be applied at low cost
+ * to all maps of the skymap. A value of 0 is returned for weights of a sky
+ * direction outside the area covered by the skymap.
+ ***************************************************************************/
+double GSkymap::operator()(const weights& wgt, const int& map) const
+{
+    // Throw an error if the map index is not in valid range
+    #if defined(G_RANGE_CHECK)
+    if (map < 0 || map >= m_num_maps) {
+        throw GException::out_of_range(G_OP_WEIGHTS,
+                                       "Sky map map index",
+                                       map, m_num_maps);
+    }
+    #endif
 
-        // Set weighting factors for interpolation
-        double wgt_x_right = (pixel.x() - inx_x);
-        double wgt_x_left  = 1.0 - wgt_x_right;
-        double wgt_y_right = (pixel.y() - inx_y);
-        double wgt_y_left  = 1.0 - wgt_y_right;
-
-        // Compute skymap pixel indices for bi-linear interpolation
-        int inx1 = inx_x + inx_y * m_num_x;
-        int inx2 = inx1 + m_num_x;
-        int inx3 = inx1 + 1;
-        int inx4 = inx2 + 1;
-
-        // Compute weighting factors for bi-linear interpolation
-        double wgt1 = wgt_x_left  * wgt_y_left;
-        double wgt2 = wgt_x_left  * wgt_y_right;
-        double wgt3 = wgt_x_right * wgt_y_left;
-        double wgt4 = wgt_x_right * wgt_y_right;
-
-        // Compute map offset
-        int offset = m_num_pixels * map;
+    // Initialise intensity
+    double intensity = 0.0;
+
+    // Continue only if weights are for a sky direction within the map
+    if (wgt.inx[0] >= 0) {
 
         // Compute interpolated skymap value
-        intensity = wgt1 * m_pixels[inx1 + offset] +
-                    wgt2 * m_pixels[inx2 + offset] +
-                    wgt3 * m_pixels[inx3 + offset] +
-                    wgt4 * m_pixels[inx4 + offset];
+        int offset = m_num_pixels * map;
+        if (m_fpixels != NULL) {
+            const float* pixels = m_fpixels + offset;
+            intensity = wgt.wgt[0] * pixels[wgt.inx[0]] +
+                        wgt.wgt[1] * pixels[wgt.inx[1]] +
+                        wgt.wgt[2] * pixels[wgt.inx[2]] +
+                        wgt.wgt[3] * pixels[wgt.inx[3]];
+        }
+        else {
+            const double* pixels = m_pixels + offset;
+            intensity = wgt.wgt[0] * pixels[wgt.inx[0]] +
+                        wgt.wgt[1] * pixels[wgt.inx[1]] +
+                        wgt.wgt[2] * pixels[wgt.inx[2]] +
+                        wgt.wgt[3] * pixels[wgt.inx[3]];
+        }
 
-    } // endif: pixel was within map
+    } // endif: sky direction was within map
 
     // Return intensity
     return intensity;
@@ -750,6 +772,279 @@ GSkyPixel GSkymap::dir2pix(const GSkyDir& dir) const
 }
 
 
+/***********************************************************************//**
+ * @brief Returns sky directions of pixels
+ *
+ * @param[in] pixels Sky map pixels.
+ * @return Sky directions.
+ *
+ * @exception GException::invalid_value
+ *            No valid sky projection found.
+ * @exception GException::invalid_argument
+ *            2D sky map pixel used to access 1D projection.
+ *
+ * Returns the sky directions for a vector of sky map @p pixels. The pixels
+ * are interpreted as in pix2dir(const GSkyPixel&), and are transformed in
+ * a single batched call of the sky projection.
+ ***************************************************************************/
+std::vector<GSkyDir> GSkymap::pix2dir(const std::vector<GSkyPixel>& pixels) const
+{
+    // Throw error if WCS is not valid
+    if (m_proj == NULL) {
+        std::string msg = "Sky projection has not been defined.";
+        throw GException::invalid_value(G_PIX2DIR_VECTOR, msg);
+    }
+
+    // Allocate pixel and sky coordinates
+    int                 n = pixels.size();
+    std::vector<double> x(n);
+    std::vector<double> y(n);
+    std::vector<double> lon(n);
+    std::vector<double> lat(n);
+
+    // Set pixel coordinates
+    for (int i = 0; i < n; ++i) {
+
+        // Get pixel
+        const GSkyPixel& pixel = pixels[i];
+
+        // If pixel size matches the projection size then take the pixel
+        // as it is
+        if (m_proj->size() == pixel.size()) {
+            if (pixel.is_1D()) {
+                x[i] = pixel.index();
+                y[i] = 0.0;
+            }
+            else {
+                x[i] = pixel.x();
+                y[i] = pixel.y();
+            }
+        }
+
+        // ... otherwise, if we have a 2D projection but a 1D pixel then
+        // interpret the pixel as the linear index in the pixel array
+        else if (m_proj->size() == 2) {
+            GSkyPixel pixel2D = inx2pix(int(pixel));
+            x[i] = pixel2D.x();
+            y[i] = pixel2D.y();
+        }
+
+        // ... otherwise we have a 1D projection but a 2D pixel
+        else {
+            std::string msg = "A 2-dimensional sky map pixel "+pixel.print()+
+                              " is used to determine the sky direction for"
+                              " the 1-dimensional sky projection \""+
+                              m_proj->name()+"\"\n"
+                              "Please specify a 1-dimensional sky map pixel.";
+            throw GException::invalid_argument(G_PIX2DIR_VECTOR, msg);
+        }
+
+    } // endfor: looped over pixels
+
+    // Transform pixels into sky coordinates
+    if (n > 0) {
+        m_proj->pix2dir(&x[0], &y[0], n, &lon[0], &lat[0]);
+    }
+
+    // Set sky directions
+    std::vector<GSkyDir> dirs(n);
+    bool                 equ = (m_proj->coordsys() != "GAL");
+    for (int i = 0; i < n; ++i) {
+        if (equ) {
+            dirs[i].radec_deg(lon[i], lat[i]);
+        }
+        else {
+            dirs[i].lb_deg(lon[i], lat[i]);
+        }
+    }
+
+    // Return sky directions
+    return dirs;
+}
+
+
+/***********************************************************************//**
+ * @brief Returns pixel indices for sky directions
+ *
+ * @param[in] dirs Sky directions.
+ * @return Pixel indices [0,...,npix()-1].
+ *
+ * @exception GException::invalid_value
+ *            No valid sky projection found.
+ *
+ * Returns the sky map pixel indices for a vector of sky directions. The
+ * sky directions are transformed in a single batched call of the sky
+ * projection.
+ ***************************************************************************/
+std::vector<int> GSkymap::dir2inx(const std::vector<GSkyDir>& dirs) const
+{
+    // Determine pixels for sky directions
+    std::vector<GSkyPixel> pixels = dir2pix(dirs);
+
+    // Convert pixels into indices
+    std::vector<int> indices(pixels.size());
+    for (int i = 0; i < pixels.size(); ++i) {
+        indices[i] = pix2inx(pixels[i]);
+    }
+
+    // Return pixel indices
+    return indices;
+}
+
+
+/***********************************************************************//**
+ * @brief Returns sky map pixels for sky directions
+ *
+ * @param[in] dirs Sky directions.
+ * @return Sky map pixels.
+ *
+ * @exception GException::invalid_value
+ *            No valid sky projection found.
+ *
+ * Returns the sky map pixels for a vector of sky directions. The sky
+ * directions are transformed in a single batched call of the sky
+ * projection.
+ ***************************************************************************/
+std::vector<GSkyPixel> GSkymap::dir2pix(const std::vector<GSkyDir>& dirs) const
+{
+    // Throw error if WCS is not valid
+    if (m_proj == NULL) {
+        std::string msg = "Sky projection has not been defined.";
+        throw GException::invalid_value(G_DIR2PIX_VECTOR, msg);
+    }
+
+    // Allocate sky and pixel coordinates
+    int                 n = dirs.size();
+    std::vector<double> lon(n);
+    std::vector<double> lat(n);
+    std::vector<double> x(n);
+    std::vector<double> y(n);
+
+    // Set coordinate system dependent sky coordinates
+    bool equ = (m_proj->coordsys() != "GAL");
+    for (int i = 0; i < n; ++i) {
+        if (equ) {
+            lon[i] = dirs[i].ra_deg();
+            lat[i] = dirs[i].dec_deg();
+        }
+        else {
+            lon[i] = dirs[i].l_deg();
+            lat[i] = dirs[i].b_deg();
+        }
+    }
+
+    // Transform sky coordinates into pixels
+    if (n > 0) {
+        m_proj->dir2pix(&lon[0], &lat[0], n, &x[0], &y[0]);
+    }
+
+    // Set sky map pixels
+    std::vector<GSkyPixel> pixels(n);
+    bool                   is_1D = (m_proj->size() == 1);
+    for (int i = 0; i < n; ++i) {
+        if (is_1D) {
+            pixels[i].index(x[i]);
+        }
+        else {
+            pixels[i].xy(x[i], y[i]);
+        }
+    }
+
+    // Return sky map pixels
+    return pixels;
+}
+
+
+/***********************************************************************//**
+ * @brief Returns pixel indices and weights for bi-linear interpolation
+ *
+ * @param[in] dir Sky direction.
+ * @return Pixel indices and weighting factors.
+ *
+ * @exception GException::invalid_value
+ *            No valid sky projection found.
+ *
+ * Returns the indices and weighting factors of the four pixels that
+ * neighbour the sky direction @p dir. Applying the weights to the pixels
+ * using operator()(const weights&, const int&) gives the bi-linearly
+ * interpolated skymap value at the sky direction. If the sky direction
+ * falls outside the area covered by the skymap, all pixel indices are set
+ * to -1 and all weights are zero.
+ *
+ * For HEALPix pixelisations, the four pixels are the two pixels on the
+ * ring above and the two pixels on the ring below the sky direction that
+ * are returned by GHealpix::interpolator(). A HEALPix map covers the full
+ * sky, hence the weights are always valid.
+ ***************************************************************************/
+GSkymap::weights GSkymap::lookup(const GSkyDir& dir) const
+{
+    // Initialise weights for a sky direction outside the map
+    weights wgt;
+    for (int i = 0; i < 4; ++i) {
+        wgt.inx[i] = -1;
+        wgt.wgt[i] = 0.0;
+    }
+
+    // Handle HEALPix pixelisation
+    if (m_proj != NULL && m_proj->size() == 1) {
+        static_cast<const GHealpix*>(m_proj)->interpolator(dir, wgt.inx,
+                                                           wgt.wgt);
+    }
+
+    // Handle 2D pixelisations
+    else {
+
+        // Determine sky pixel
+        GSkyPixel pixel = dir2pix(dir);
+
+        // Continue only if pixel is within the map
+        if (contains(pixel)) {
+
+            // Set left indices for interpolation. The left index is comprised
+            // between 0 and npixels-2. By definition, the right index is then
+            // the left index + 1
+            int inx_x = int(pixel.x());
+            int inx_y = int(pixel.y());
+            if (inx_x < 0) {
+                inx_x = 0;
+            }
+            else if (inx_x > m_num_x-2) {
+                inx_x = m_num_x - 2;
+            }
+            if (inx_y < 0) {
+                inx_y = 0;
+            }
+            else if (inx_y > m_num_y-2) {
+                inx_y = m_num_y - 2;
+            }
+
+            // Set weighting factors for interpolation
+            double wgt_x_right = (pixel.x() - inx_x);
+            double wgt_x_left  = 1.0 - wgt_x_right;
+            double wgt_y_right = (pixel.y() - inx_y);
+            double wgt_y_left  = 1.0 - wgt_y_right;
+
+            // Set skymap pixel indices for bi-linear interpolation
+            wgt.inx[0] = inx_x + inx_y * m_num_x;
+            wgt.inx[1] = wgt.inx[0] + m_num_x;
+            wgt.inx[2] = wgt.inx[0] + 1;
+            wgt.inx[3] = wgt.inx[1] + 1;
+
+            // Set weighting factors for bi-linear interpolation
+            wgt.wgt[0] = wgt_x_left  * wgt_y_left;
+            wgt.wgt[1] = wgt_x_left  * wgt_y_right;
+            wgt.wgt[2] = wgt_x_right * wgt_y_left;
+            wgt.wgt[3] = wgt_x_right * wgt_y_right;
+
+        } // endif: pixel was within map
+
+    } // endelse: handled 2D pixelisations
+
+    // Return weights
+    return wgt;
+}
+
+
 /***********************************************************************//**
  * @brief Returns solid angle of pixel
  *
@@ -913,6 +1208,139 @@ bool GSkymap::contains(const GSkyPixel& pixel) const
 }
 
 
+/***********************************************************************//**
+ * @brief Returns pointer to pixel data
+ *
+ * @return Pointer to pixel data.
+ *
+ * @exception GException::invalid_value
+ *            Pixels are stored in single precision.
+ *
+ * Returns a pointer to the double precision pixels of the sky map. Note
+ * that for a sky map with shared pixels the pixels must not be modified
+ * using the returned pointer, since the modification would affect all
+ * copies of the sky map.
+ ***************************************************************************/
+const double* GSkymap::pixels(void) const
+{
+    // Throw an exception if pixels are stored in single precision
+    if (m_fpixels != NULL) {
+        std::string msg = "Sky map pixels are stored in single precision."
+                          " Please use float_pixels(false) to convert the"
+                          " pixels into double precision before accessing"
+                          " the pixel data.";
+        throw GException::invalid_value(G_PIXELS, msg);
+    }
+
+    // Return pointer to pixels
+    return m_pixels;
+}
+
+
+/***********************************************************************//**
+ * @brief Set single precision pixel storage
+ *
+ * @param[in] use_float Store pixels in single precision?
+ *
+ * Converts the sky map pixels into single precision if @p use_float is
+ * true, which halves the memory that is needed to store the pixels, or
+ * back into double precision if @p use_float is false. Single precision
+ * storage is meant for sky maps that are only read. The pixels are
+ * converted back into double precision when the sky map is modified.
+ *
+ * The method has no effect on a sky map without pixels. Loading or reading
+ * a sky map restores double precision storage.
+ ***************************************************************************/
+void GSkymap::float_pixels(const bool& use_float)
+{
+    // Compute data size
+    int size = m_num_pixels * m_num_maps;
+
+    // Convert pixels into single precision
+    if (use_float && m_pixels != NULL && size > 0) {
+
+        // Allocate and set single precision pixels
+        float* fpixels = new float[size];
+        for (int i = 0; i < size; ++i) {
+            fpixels[i] = float(m_pixels[i]);
+        }
+
+        // Replace pixels and keep pixel sharing
+        bool share = (m_refs != NULL);
+        release_pixels();
+        m_fpixels = fpixels;
+        m_refs    = (share) ? new int(1) : NULL;
+
+    }
+
+    // ... or convert pixels back into double precision
+    else if (!use_float && m_fpixels != NULL) {
+        unshare_pixels();
+    }
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Set sharing of pixels between copies
+ *
+ * @param[in] share Share pixels between copies of the sky map?
+ *
+ * If @p share is true, copies of the sky map reference the pixels of the
+ * sky map instead of holding their own copy of the pixels. The pixels are
+ * copied when the sky map or one of its copies is modified, hence sharing
+ * is transparent for clients (copy-on-write). Sharing is meant for large
+ * sky maps that are only read, such as diffuse model templates, which are
+ * then held only once in memory irrespective of the number of copies.
+ *
+ * If @p share is false, the sky map obtains its own copy of the pixels,
+ * and copies of the sky map will again copy the pixels.
+ *
+ * The method has no effect on a sky map without pixels. Loading or reading
+ * a sky map disables pixel sharing.
+ ***************************************************************************/
+void GSkymap::shared_pixels(const bool& share)
+{
+    // Enable pixel sharing
+    if (share && m_refs == NULL && (m_pixels != NULL || m_fpixels != NULL)) {
+        m_refs = new int(1);
+    }
+
+    // ... or disable pixel sharing. The pixels are copied if they are
+    // referenced by other sky maps.
+    else if (!share && m_refs != NULL) {
+
+        // Compute data size
+        int size = m_num_pixels * m_num_maps;
+
+        // Copy pixels and release shared pixels. Single precision pixels
+        // stay in single precision.
+        if (m_fpixels != NULL) {
+            float* fpixels = new float[size];
+            for (int i = 0; i < size; ++i) {
+                fpixels[i] = m_fpixels[i];
+            }
+            release_pixels();
+            m_fpixels = fpixels;
+        }
+        else {
+            double* pixels = new double[size];
+            for (int i = 0; i < size; ++i) {
+                pixels[i] = m_pixels[i];
+            }
+            release_pixels();
+            m_pixels = pixels;
+        }
+
+    } // endelse: disabled pixel sharing
+
+    // Return
+    return;
+}
+
+
 /***********************************************************************//**
  * @brief Load skymap from FITS file.
  *
@@ -1167,6 +1595,8 @@ void GSkymap::init_members(void)
     m_num_y      = 0;
     m_proj       = NULL;
     m_pixels     = NULL;
+    m_fpixels    = NULL;
+    m_refs       = NULL;
 
     // Return
     return;
@@ -1216,8 +1646,28 @@ void GSkymap::copy_members(const GSkymap& map)
     // Compute data size
     int size = m_num_pixels * m_num_maps;
 
-    // Copy pixels
-    if (size > 0 && map.m_pixels != NULL) {
+    // Reference shared pixels. The reference counter is shared by all
+    // threads, hence it is protected by a critical region.
+    if (map.m_refs != NULL) {
+        #pragma omp critical(GSkymap_pixels)
+        {
+            (*map.m_refs)++;
+        }
+        m_pixels  = map.m_pixels;
+        m_fpixels = map.m_fpixels;
+        m_refs    = map.m_refs;
+    }
+
+    // ... otherwise copy single precision pixels
+    else if (size > 0 && map.m_fpixels != NULL) {
+        m_fpixels = new float[size];
+        for (int i = 0; i < size; ++i) {
+            m_fpixels[i] = map.m_fpixels[i];
+        }
+    }
+
+    // ... otherwise copy pixels
+    else if (size > 0 && map.m_pixels != NULL) {
         alloc_pixels();
         for (int i = 0; i < size; ++i) {
             m_pixels[i] = map.m_pixels[i];
@@ -1236,11 +1686,10 @@ void GSkymap::free_members(void)
 {
     // Free memory
     if (m_proj   != NULL) delete m_proj;
-    if (m_pixels != NULL) delete [] m_pixels;
+    release_pixels();
 
     // Signal free pointers
     m_proj       = NULL;
-    m_pixels     = NULL;
 
     // Reset number of pixels
     m_num_pixels = 0;
@@ -1253,6 +1702,98 @@ void GSkymap::free_members(void)
 }
 
 
+/***********************************************************************//**
+ * @brief Release pixels
+ *
+ * Releases the sky map pixels. Shared pixels are only deleted if no other
+ * sky map references them.
+ ***************************************************************************/
+void GSkymap::release_pixels(void)
+{
+    // Determine whether the pixels should be deleted. The reference counter
+    // of shared pixels is shared by all threads, hence it is protected by
+    // a critical region.
+    bool last = true;
+    if (m_refs != NULL) {
+        #pragma omp critical(GSkymap_pixels)
+        {
+            (*m_refs)--;
+            last = (*m_refs == 0);
+        }
+        if (last) {
+            delete m_refs;
+        }
+    }
+
+    // Delete pixels
+    if (last) {
+        if (m_pixels  != NULL) delete [] m_pixels;
+        if (m_fpixels != NULL) delete [] m_fpixels;
+    }
+
+    // Signal free pointers
+    m_pixels  = NULL;
+    m_fpixels = NULL;
+    m_refs    = NULL;
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Make pixels modifiable
+ *
+ * Makes sure that the sky map holds double precision pixels that are not
+ * referenced by any other sky map, so that the pixels can be modified.
+ * Single precision pixels are converted into double precision, and shared
+ * pixels that are referenced by other sky maps are copied. The sky map
+ * keeps sharing its pixels with future copies.
+ ***************************************************************************/
+void GSkymap::unshare_pixels(void)
+{
+    // Compute data size
+    int size = m_num_pixels * m_num_maps;
+
+    // Determine whether pixels are referenced by other sky maps
+    bool referenced = false;
+    if (m_refs != NULL) {
+        #pragma omp critical(GSkymap_pixels)
+        {
+            referenced = (*m_refs > 1);
+        }
+    }
+
+    // Copy pixels into double precision if they are stored in single
+    // precision or if they are referenced by other sky maps
+    if (m_fpixels != NULL || referenced) {
+
+        // Allocate and set double precision pixels
+        double* pixels = new double[size];
+        if (m_fpixels != NULL) {
+            for (int i = 0; i < size; ++i) {
+                pixels[i] = double(m_fpixels[i]);
+            }
+        }
+        else {
+            for (int i = 0; i < size; ++i) {
+                pixels[i] = m_pixels[i];
+            }
+        }
+
+        // Replace pixels and keep pixel sharing
+        bool share = (m_refs != NULL);
+        release_pixels();
+        m_pixels = pixels;
+        m_refs   = (share) ? new int(1) : NULL;
+
+    } // endif: pixels were copied
+
+    // Return
+    return;
+}
+
+
 /***********************************************************************//**
  * @brief Set World Coordinate System
  *
@@ -1581,10 +2122,9 @@ GFitsBinTable* GSkymap::create_healpix_hdu(void) const
         GFitsTableDoubleCol column = GFitsTableDoubleCol("DATA", rows, number);
 
         // Fill data into column
-        double* ptr = m_pixels;
         for (int inx = 0; inx < number; ++inx) {
             for (int row = 0; row < rows; ++row) {
-                column(row,inx) = *ptr++;
+                column(row,inx) = (*this)(row,inx);
             }
         }
 
@@ -1641,19 +2181,19 @@ GFitsImageDouble* GSkymap::create_wcs_hdu(void) const
 
         // Store data in image
         if (naxis == 2) {
-            double* ptr = m_pixels;
+            int index = 0;
             for (int iy = 0; iy < m_num_y; ++iy) {
                 for (int ix = 0; ix < m_num_x; ++ix) {
-                    (*hdu)(ix,iy) = *ptr++;
+                    (*hdu)(ix,iy) = (*this)(index++);
                 }
             }
         }
         else {
-            double* ptr = m_pixels;
             for (int imap = 0; imap < m_num_maps; ++imap) {
+                int index = 0;
                 for (int iy = 0; iy < m_num_y; ++iy) {
                     for (int ix = 0; ix < m_num_x; ++ix) {
-                        (*hdu)(ix,iy,imap) = *ptr++;
+                        (*hdu)(ix,iy,imap) = (*this)(index++,imap);
                     }
                 }
             }
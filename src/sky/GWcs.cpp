@@ -66,6 +66,7 @@
 
 /* __ Constants __________________________________________________________ */
 const double GWcs::UNDEFINED = 987654321.0e99;
+const int    g_block_size    = 1024;   //!< Batched transformation block size
 
 
 /*==========================================================================
@@ -739,6 +740,126 @@ GSkyPixel GWcs::dir2pix(const GSkyDir& dir) const
 }
 
 
+/***********************************************************************//**
+ * @brief Transform array of pixels into sky coordinates
+ *
+ * @param[in] x Array [n] of pixel x coordinates.
+ * @param[in] y Array [n] of pixel y coordinates.
+ * @param[in] n Number of pixels.
+ * @param[out] lon Array [n] of longitudes (deg).
+ * @param[out] lat Array [n] of latitudes (deg).
+ *
+ * @exception GException::wcs_invalid_x_y
+ *            At least one pixel lies outside the valid projection region.
+ *
+ * Transforms an array of sky map pixels into sky coordinates. The pixels
+ * are transformed in blocks by the vectorised wcs_p2s() method, hence the
+ * projection setup and the linear transformation are done once per block
+ * instead of once per pixel. The results are identical to those of
+ * pix2dir(const GSkyPixel&).
+ ***************************************************************************/
+void GWcs::pix2dir(const double* x, const double* y,
+                   const int& n,
+                   double* lon, double* lat) const
+{
+    // Allocate memory for transformation
+    int                 nblock = (n < g_block_size) ? n : g_block_size;
+    std::vector<double> pixcrd(2*nblock);
+    std::vector<double> imgcrd(2*nblock);
+    std::vector<double> phi(nblock);
+    std::vector<double> theta(nblock);
+    std::vector<double> world(2*nblock);
+    std::vector<int>    stat(nblock);
+
+    // Loop over blocks
+    for (int first = 0; first < n; first += nblock) {
+
+        // Determine block size
+        int num = (n-first < nblock) ? n-first : nblock;
+
+        // Set pixels. We have to add 1.0 here as the WCS pixel reference
+        // (CRPIX) starts from one while GSkyPixel starts from 0.
+        for (int i = 0, k = first; i < num; ++i, ++k) {
+            pixcrd[2*i]   = x[k] + 1.0;
+            pixcrd[2*i+1] = y[k] + 1.0;
+        }
+
+        // Transform pixel-to-world coordinates
+        wcs_p2s(num, 2, &pixcrd[0], &imgcrd[0], &phi[0], &theta[0],
+                &world[0], &stat[0]);
+
+        // Store sky coordinates
+        for (int i = 0, k = first; i < num; ++i, ++k) {
+            lon[k] = world[2*i];
+            lat[k] = world[2*i+1];
+        }
+
+    } // endfor: looped over blocks
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Transform array of sky coordinates into pixels
+ *
+ * @param[in] lon Array [n] of longitudes (deg).
+ * @param[in] lat Array [n] of latitudes (deg).
+ * @param[in] n Number of sky coordinates.
+ * @param[out] x Array [n] of pixel x coordinates.
+ * @param[out] y Array [n] of pixel y coordinates.
+ *
+ * @exception GException::wcs_invalid_phi_theta
+ *            At least one sky coordinate can not be projected.
+ *
+ * Transforms an array of sky coordinates into sky map pixels. The sky
+ * coordinates are transformed in blocks by the vectorised wcs_s2p()
+ * method. The results are identical to those of dir2pix(const GSkyDir&).
+ ***************************************************************************/
+void GWcs::dir2pix(const double* lon, const double* lat,
+                   const int& n,
+                   double* x, double* y) const
+{
+    // Allocate memory for transformation
+    int                 nblock = (n < g_block_size) ? n : g_block_size;
+    std::vector<double> world(2*nblock);
+    std::vector<double> phi(nblock);
+    std::vector<double> theta(nblock);
+    std::vector<double> imgcrd(2*nblock);
+    std::vector<double> pixcrd(2*nblock);
+    std::vector<int>    stat(nblock);
+
+    // Loop over blocks
+    for (int first = 0; first < n; first += nblock) {
+
+        // Determine block size
+        int num = (n-first < nblock) ? n-first : nblock;
+
+        // Set world coordinates
+        for (int i = 0, k = first; i < num; ++i, ++k) {
+            world[2*i]   = lon[k];
+            world[2*i+1] = lat[k];
+        }
+
+        // Transform world-to-pixel coordinates
+        wcs_s2p(num, 2, &world[0], &phi[0], &theta[0], &imgcrd[0],
+                &pixcrd[0], &stat[0]);
+
+        // Store pixels. We have to subtract 1 here as GSkyPixel starts from
+        // zero while the WCS reference (CRPIX) starts from one.
+        for (int i = 0, k = first; i < num; ++i, ++k) {
+            x[k] = pixcrd[2*i]   - 1.0;
+            y[k] = pixcrd[2*i+1] - 1.0;
+        }
+
+    } // endfor: looped over blocks
+
+    // Return
+    return;
+}
+
+
 /***********************************************************************//**
  * @brief Set World Coordinate System parameters
  *
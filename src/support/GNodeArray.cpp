@@ -40,6 +40,7 @@
 #define G_INTERPOLATE                      "GNodeArray::interpolate(double&,"\
                                                      " std::vector<double>&)"
 #define G_SET_VALUE                          "GNodeArray::set_value(double&)"
+#define G_LOOKUP                                "GNodeArray::lookup(double&)"
 
 /* __ Macros _____________________________________________________________ */
 
@@ -251,7 +252,7 @@ double& GNodeArray::at(const int& index)
     #endif
 
     // Signal that setup needs to be called
-    m_need_setup = false;
+    m_need_setup = true;
 
     // Return node
     return m_node[index];
@@ -279,9 +280,6 @@ const double& GNodeArray::at(const int& index) const
     }
     #endif
 
-    // Signal that setup needs to be called
-    m_need_setup = false;
-
     // Return node
     return m_node[index];
 }
@@ -520,12 +518,12 @@ double GNodeArray::interpolate(const double& value,
                                           vector.size());
     }
     
-    // Set interpolation value (circumvent const correctness)
-    set_value(value);
+    // Get indices and weighting factors
+    weights w = lookup(value);
 
     // Interpolate
-    double y = vector[inx_left()]  * wgt_left() +
-               vector[inx_right()] * wgt_right();
+    double y = vector[w.inx_left]  * w.wgt_left +
+               vector[w.inx_right] * w.wgt_right;
 
     // Return
     return y;
@@ -547,91 +545,138 @@ double GNodeArray::interpolate(const double& value,
  * boundary indices are searched by bisection.
  ***************************************************************************/
 void GNodeArray::set_value(const double& value) const
+{
+    // Throw an exception if less than 2 nodes are available
+    if (m_node.size() < 2) {
+        throw GException::not_enough_nodes(G_SET_VALUE, m_node.size());
+    }
+
+    // Continue only if value has changed or if the node array was
+    // modified since the last call
+    if (m_need_setup || !m_has_last_value || value != m_last_value) {
+
+        // Get indices and weighting factors
+        weights w = lookup(value);
+
+        // Store indices and weighting factors
+        m_inx_left  = w.inx_left;
+        m_inx_right = w.inx_right;
+        m_wgt_left  = w.wgt_left;
+        m_wgt_right = w.wgt_right;
+
+    } // endif: computation was required
+
+    // Store last value and signal availability
+    m_last_value     = value;
+    m_has_last_value = true;
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Return indices and weighting factors for interpolation
+ *
+ * @param[in] value Value for which the interpolation should be done.
+ * @return Node indices and weighting factors.
+ *
+ * @exception GException::not_enough_nodes
+ *            At least two nodes are required for setting up the factors
+ *
+ * Returns the indices that bound the specified value and the corresponding
+ * weighting factors for linear interpolation. Contrary to set_value(), the
+ * method does not modify the node array, and hence it can be called
+ * simultaneously by several threads that share the node array.
+ ***************************************************************************/
+GNodeArray::weights GNodeArray::lookup(const double& value) const
+{
+    // Throw an exception if less than 2 nodes are available
+    if (m_node.size() < 2) {
+        throw GException::not_enough_nodes(G_LOOKUP, m_node.size());
+    }
+
+    // Make sure that node distances are set up
+    check_setup();
+
+    // Set indices and weighting factors
+    weights w;
+    w.inx_left  = left_index(value);
+    w.inx_right = w.inx_left + 1;
+    w.wgt_right = (value - m_node[w.inx_left]) / m_step[w.inx_left];
+    w.wgt_left  = 1.0 - w.wgt_right;
+
+    // Return indices and weighting factors
+    return w;
+}
+
+
+/***********************************************************************//**
+ * @brief Return indices and weighting factors for an array of values
+ *
+ * @param[in] num Number of values.
+ * @param[in] values Values for which the interpolation should be done.
+ * @param[out] inx_left Indices of left nodes (@p num elements).
+ * @param[out] wgt_left Weights of left nodes (@p num elements).
+ * @param[out] wgt_right Weights of right nodes (@p num elements).
+ *
+ * @exception GException::not_enough_nodes
+ *            At least two nodes are required for setting up the factors
+ *
+ * Determines the left node indices and the weighting factors for linear
+ * interpolation for an array of @p values in a single pass. The right
+ * node index is given by @p inx_left + 1. The @p values need to be sorted
+ * in ascending order. If the node array is not linear, the node indices
+ * are found by walking along the nodes, which requires of the order of
+ * @p num plus the number of nodes comparisons.
+ *
+ * The method does not modify the node array and can be called
+ * simultaneously by several threads that share the node array.
+ ***************************************************************************/
+void GNodeArray::lookup(const int&    num,
+                        const double* values,
+                        int*          inx_left,
+                        double*       wgt_left,
+                        double*       wgt_right) const
 {
     // Get number of nodes
     int nodes = m_node.size();
 
     // Throw an exception if less than 2 nodes are available
     if (nodes < 2) {
-        throw GException::not_enough_nodes(G_SET_VALUE, nodes);
+        throw GException::not_enough_nodes(G_LOOKUP, nodes);
     }
 
-    // Initialize computation flag
-    bool compute = true;
+    // Make sure that node distances are set up
+    check_setup();
 
-    // Update cache if required. If cache was updated, computation is
-    // enforced. Otherwise we check if the value has changed. The value
-    // check is only done when a last value has been recorded.
-    if (m_need_setup) {
-        setup();
-    }
-    else {
-        if (m_has_last_value && value == m_last_value) {
-            compute = false;
-        }
-    }
+    // Initialise left index for walking along the nodes
+    int inx = 0;
 
-    // Continue only if computation is required
-    if (compute) {
+    // Loop over values
+    for (int i = 0; i < num; ++i) {
+
+        // Get value
+        double value = values[i];
 
         // If array is linear then get left index from analytic formula
         if (m_is_linear) {
+            inx = left_index(value);
+        }
 
-            // Set left index
-            m_inx_left = int(m_linear_slope * value + m_linear_offset);
-        
-            // Keep index in valid range
-            if (m_inx_left < 0) {
-                m_inx_left = 0;
-            }
-            else if (m_inx_left >= nodes-1) {
-                m_inx_left = nodes - 2;
-            }
-
-        } // endif: array is linear
-
-        // ... otherwise search the relevant indices by bisection
+        // ... otherwise walk along the nodes starting from the last index
         else {
-    
-            // Set left index if value is before first node
-            if (value < m_node[0]) {
-                m_inx_left = 0;
+            while (inx < nodes-2 && value >= m_node[inx+1]) {
+                inx++;
             }
-
-            // Set left index if value is after last node
-            else if (value >  m_node[nodes-1]) {
-                m_inx_left = nodes - 2;
-            }
-
-            // Set left index by bisection
-            else {
-                int low  = 0;
-                int high = nodes - 1;
-                while ((high - low) > 1) {
-                    int mid = (low+high) / 2;
-                    if (m_node[mid] > value) {
-                        high = mid;
-                    }
-                    else {
-                        low = mid;
-                    }
-                }
-                m_inx_left = low;
-            } // endelse: did bisection
         }
 
-        // Set right index
-        m_inx_right = m_inx_left + 1;
+        // Set index and weighting factors
+        inx_left[i]  = inx;
+        wgt_right[i] = (value - m_node[inx]) / m_step[inx];
+        wgt_left[i]  = 1.0 - wgt_right[i];
 
-        // Set weighting factors
-        m_wgt_right = (value - m_node[m_inx_left]) / m_step[m_inx_left];
-        m_wgt_left  = 1.0 - m_wgt_right;
-
-    } // endif: computation was required
-
-    // Store last value and signal availability
-    m_last_value     = value;
-    m_has_last_value = true;
+    } // endfor: looped over values
 
     // Return
     return;
@@ -802,9 +847,116 @@ void GNodeArray::setup(void) const
 
     } // endif: there were at least two nodes
 
-    // Signal that setup has been called
+    // Signal that setup has been called. The flush makes the node
+    // distances visible to other threads before the flag is released.
+    #pragma omp flush
+    #pragma omp atomic write
     m_need_setup = false;
 
     // Return
     return;
 }
+
+
+/***********************************************************************//**
+ * @brief Set up node distances if the node array has been modified
+ *
+ * Calls setup() if nodes have been modified through the node access
+ * operators since the last setup. The setup is done within a critical
+ * region so that concurrent lookups do not set up the array twice. The
+ * setup flag is read atomically and followed by a flush, so that a thread
+ * that finds the array set up also sees the node distances.
+ ***************************************************************************/
+void GNodeArray::check_setup(void) const
+{
+    // Atomically read setup flag and make the node distances visible
+    bool need_setup;
+    #pragma omp atomic read
+    need_setup = m_need_setup;
+    #pragma omp flush
+
+    // Setup node distances if required
+    if (need_setup) {
+        #pragma omp critical(GNodeArray_setup)
+        {
+            if (m_need_setup) {
+                setup();
+            }
+        }
+    }
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Return index of left node for interpolation
+ *
+ * @param[in] value Value for which the interpolation should be done.
+ * @return Index of left node [0,...,size()-2].
+ *
+ * Determines the index of the left node that bounds @p value. If the array
+ * is linear the index is computed using an analytic formula, otherwise it
+ * is searched by bisection. Values outside the node range give the index
+ * of the first or last node interval. The method requires at least two
+ * nodes and the node distances to be set up.
+ ***************************************************************************/
+int GNodeArray::left_index(const double& value) const
+{
+    // Get number of nodes
+    int nodes = m_node.size();
+
+    // Initialise index
+    int inx_left = 0;
+
+    // If array is linear then get left index from analytic formula
+    if (m_is_linear) {
+
+        // Set left index
+        inx_left = int(m_linear_slope * value + m_linear_offset);
+
+        // Keep index in valid range
+        if (inx_left < 0) {
+            inx_left = 0;
+        }
+        else if (inx_left >= nodes-1) {
+            inx_left = nodes - 2;
+        }
+
+    } // endif: array is linear
+
+    // ... otherwise search the relevant indices by bisection
+    else {
+
+        // Set left index if value is before first node
+        if (value < m_node[0]) {
+            inx_left = 0;
+        }
+
+        // Set left index if value is after last node
+        else if (value >  m_node[nodes-1]) {
+            inx_left = nodes - 2;
+        }
+
+        // Set left index by bisection
+        else {
+            int low  = 0;
+            int high = nodes - 1;
+            while ((high - low) > 1) {
+                int mid = (low+high) / 2;
+                if (m_node[mid] > value) {
+                    high = mid;
+                }
+                else {
+                    low = mid;
+                }
+            }
+            inx_left = low;
+        } // endelse: did bisection
+
+    } // endelse: array was not linear
+
+    // Return index
+    return inx_left;
+}
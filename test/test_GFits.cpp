@@ -391,6 +391,7 @@ void TestGFits::set(void)
     append(static_cast<pfunction>(&TestGFits::test_bintable_ulong), "Test bintable ulong");
     append(static_cast<pfunction>(&TestGFits::test_bintable_long), "Test bintable long");
     append(static_cast<pfunction>(&TestGFits::test_bintable_longlong), "Test bintable longlong");
+    append(static_cast<pfunction>(&TestGFits::test_column_range), "Test column range access");
 
     // Return
     return;
@@ -1689,6 +1690,77 @@ void TestGFits::test_bintable_bit(void)
 }
 
 
+/***************************************************************************
+ * @brief Test bulk range access to table columns
+ ***************************************************************************/
+void TestGFits::test_column_range(void)
+{
+    // Set column dimensions
+    int nrows = 20;
+    int nvec  = 3;
+
+    // Fill vector columns of different types
+    GFitsTableDoubleCol col1("DOUBLE", nrows, nvec);
+    GFitsTableFloatCol  col2("FLOAT", nrows, nvec);
+    GFitsTableShortCol  col3("SHORT", nrows, nvec);
+    GFitsTableStringCol col4("STRING", nrows, 10, nvec);
+    for (int i = 0; i < nrows; ++i) {
+        for (int j = 0; j < nvec; ++j) {
+            int k     = i*nvec+j;
+            col1(i,j) = 0.5  * double(k);
+            col2(i,j) = 0.25 * float(k);
+            col3(i,j) = short(k);
+            col4(i,j) = gammalib::str(k);
+        }
+    }
+
+    // Read range of rows through the typed implementations
+    int                    row = 5;
+    int                    num = 4;
+    std::vector<double>    dbl(num*nvec);
+    std::vector<float>     flt(num*nvec);
+    std::vector<long long> lng(num*nvec);
+    col1.read_range(row, num, &dbl[0]);
+    col2.read_range(row, num, &flt[0]);
+    col3.read_range(row, num, &lng[0]);
+    for (int i = 0; i < num*nvec; ++i) {
+        int k = row*nvec+i;
+        test_value(dbl[i], 0.5 * double(k), 1.0e-10, "Double column read_range");
+        test_value(flt[i], 0.25 * float(k), 1.0e-6, "Float column read_range");
+        test_value(int(lng[i]), k, "Short column read_range");
+    }
+
+    // Read range of rows through the generic implementation
+    col4.read_range(row, num, &dbl[0]);
+    for (int i = 0; i < num*nvec; ++i) {
+        test_value(dbl[i], double(row*nvec+i), 1.0e-10,
+                   "String column read_range");
+    }
+
+    // Check zero-copy data access
+    const GFitsTableDoubleCol& ccol1 = col1;
+    test_assert(ccol1.data() != NULL, "Check const data access");
+    test_value(ccol1.data()[nvec], 0.5 * double(nvec), 1.0e-10,
+               "Check const data content");
+
+    // Check that invalid ranges are rejected
+    test_try("Check invalid row range");
+    try {
+        col1.read_range(nrows-1, 2, &dbl[0]);
+        test_try_failure("Invalid row range not detected.");
+    }
+    catch (GException::out_of_range &e) {
+        test_try_success();
+    }
+    catch (std::exception &e) {
+        test_try_failure(e);
+    }
+
+    // Return
+    return;
+}
+
+
 /***************************************************************************
  * @brief Main entry point for test executable
  ***************************************************************************/
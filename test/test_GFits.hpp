@@ -66,6 +66,7 @@ public:
     void               test_bintable_ulong(void);
     void               test_bintable_long(void);
     void               test_bintable_longlong(void);
+    void               test_column_range(void);
 };
 
 #endif /* TEST_GFITS_HPP */
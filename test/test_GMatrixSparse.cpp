@@ -443,6 +443,8 @@ void TestGMatrixSparse::assign_values(void)
             test_value(test(i,k), 0.0, 1.0e-10, "Test matrix element assignment");
         }
     }
+    test_value(test.sum(), 0.0, 1.0e-10, "Test matrix sum after zero assignment");
+    test_value(test.fill(), 0.0, 1.0e-10, "Test matrix fill after zero assignment");
 
     // Verify range checking
     #ifdef G_RANGE_CHECK
@@ -247,6 +247,7 @@ void TestGMatrixSymmetric::set(void)
     append(static_cast<pfunction>(&TestGMatrixSymmetric::matrix_functions), "Test matrix functions");
     append(static_cast<pfunction>(&TestGMatrixSymmetric::matrix_compare), "Test matrix comparisons");
     append(static_cast<pfunction>(&TestGMatrixSymmetric::matrix_cholesky), "Test matrix Cholesky decomposition");
+    append(static_cast<pfunction>(&TestGMatrixSymmetric::matrix_outer_product), "Test matrix outer product update");
     append(static_cast<pfunction>(&TestGMatrixSymmetric::matrix_print), "Test matrix printing");
 
     // Set members
@@ -788,6 +789,53 @@ void TestGMatrixSymmetric::matrix_cholesky(void)
 }
 
 
+/***********************************************************************//**
+ * @brief Test outer product update
+ *
+ * Checks that the outer product update gives the same result as an
+ * explicit computation, both for contiguous and non-contiguous indices.
+ ***************************************************************************/
+void TestGMatrixSymmetric::matrix_outer_product(void)
+{
+    // Set vector with a zero element
+    double vector[5] = {1.0, 2.0, 0.0, -3.0, 4.0};
+
+    // Contiguous indices
+    int              inx1[3] = {0, 1, 2};
+    GMatrixSymmetric result1(5,5);
+    result1.add_outer_product(2.0, vector, inx1, 3);
+    result1.add_outer_product(0.5, vector, inx1, 3);
+    for (int row = 0; row < 5; ++row) {
+        for (int col = 0; col < 5; ++col) {
+            double ref = (row < 3 && col < 3) ? 2.5 * vector[row] * vector[col]
+                                              : 0.0;
+            test_value(result1(row,col), ref, 1.0e-10,
+                       "Contiguous outer product element");
+        }
+    }
+
+    // Non-contiguous indices (skipping the zero element)
+    int              inx2[4] = {0, 1, 3, 4};
+    GMatrixSymmetric result2(5,5);
+    result2.add_outer_product(-1.5, vector, inx2, 4);
+    for (int row = 0; row < 5; ++row) {
+        for (int col = 0; col < 5; ++col) {
+            double ref = -1.5 * vector[row] * vector[col];
+            test_value(result2(row,col), ref, 1.0e-10,
+                       "Non-contiguous outer product element");
+        }
+    }
+
+    // Check that matrix is unchanged for no indices
+    GMatrixSymmetric result3(5,5);
+    result3.add_outer_product(1.0, vector, inx2, 0);
+    test_value(result3.sum(), 0.0, 1.0e-10, "Empty outer product");
+
+    // Return
+    return;
+}
+
+
 /***************************************************************************
  * @brief Test matrix printing
  ***************************************************************************/
@@ -58,6 +58,7 @@ public:
     void                          matrix_functions(void);
     void                          matrix_compare(void);
     void                          matrix_cholesky(void);
+    void                          matrix_outer_product(void);
     void                          matrix_print(void);
 
 private:
@@ -32,6 +32,7 @@
 #include <ostream>
 #include <stdexcept>
 #include <stdlib.h>
+#include "testinst/GTestLib.hpp"
 #include "test_GModel.hpp"
 #include "GTools.hpp"
 
@@ -79,6 +80,7 @@ void TestGModel::set(void)
     append(static_cast<pfunction>(&TestGModel::test_diffuse_cube), "Test GModelSpatialDiffuseCube");
     append(static_cast<pfunction>(&TestGModel::test_diffuse_map), "Test GModelSpatialDiffuseMap");
     append(static_cast<pfunction>(&TestGModel::test_spatial_model), "Test spatial model XML I/O");
+    append(static_cast<pfunction>(&TestGModel::test_spatial_gradients), "Test spatial model gradients");
 
     // Append spectral model tests
     append(static_cast<pfunction>(&TestGModel::test_const), "Test GModelSpectralConst");
@@ -91,6 +93,7 @@ void TestGModel::set(void)
     append(static_cast<pfunction>(&TestGModel::test_nodes), "Test GModelSpectralNodes");
     append(static_cast<pfunction>(&TestGModel::test_filefct), "Test GModelSpectralFunc");
     append(static_cast<pfunction>(&TestGModel::test_spectral_model), "Test spectral model XML I/O");
+    append(static_cast<pfunction>(&TestGModel::test_spectral_batch), "Test spectral model batch evaluation");
 
     // Append temporal model tests
     append(static_cast<pfunction>(&TestGModel::test_temp_const), "Test GModelTemporalConst");
@@ -716,6 +719,56 @@ void TestGModel::test_diffuse_map(void)
         test_try_failure(e);
     }
 
+    // Test sky map pixel weights cache for events of two observations
+    // that share the same event indices, and for a model copy that is
+    // evaluated by several threads
+    test_try("Test pixel weights cache");
+    try {
+        GSkymap map("CAR", "CEL", 83.63, 22.01, -0.1, 0.1, 20, 10, 1);
+        for (int i = 0; i < map.npix(); ++i) {
+            map(i) = double(i);
+        }
+        GModelSpatialDiffuseMap model(map, 2.0);
+        GTestObservation        obs1;
+        GTestObservation        obs2;
+        obs1.id("0001");
+        obs2.id("0002");
+        for (int pass = 0; pass < 2; ++pass) {
+            for (int i = 0; i < 5; ++i) {
+                GSkyDir dir1;
+                GSkyDir dir2;
+                dir1.radec_deg(83.0 + 0.2*i, 21.8 + 0.1*i);
+                dir2.radec_deg(84.5 - 0.3*i, 22.3 - 0.05*i);
+                GPhoton photon1(dir1, GEnergy(1.0, "TeV"), GTime());
+                GPhoton photon2(dir2, GEnergy(1.0, "TeV"), GTime());
+                test_value(model.eval(photon1, &obs1, i), model.eval(photon1),
+                           1.0e-10, "Cached value of first observation");
+                test_value(model.eval(photon2, &obs2, i), model.eval(photon2),
+                           1.0e-10, "Cached value of second observation");
+            }
+        }
+
+        // Check that a model copy that starts with an empty cache gives
+        // the correct values if it is evaluated by several threads
+        GModelSpatialDiffuseMap copy(model);
+        int                     nerr = 0;
+        #pragma omp parallel for reduction(+:nerr)
+        for (int i = 0; i < 200; ++i) {
+            GSkyDir dir;
+            dir.radec_deg(83.0 + 0.005*i, 21.6 + 0.004*i);
+            GPhoton photon(dir, GEnergy(1.0, "TeV"), GTime());
+            double  cached = copy.eval(photon, &obs1, i % 50);
+            if (std::abs(cached - copy.eval(photon)) > 1.0e-10) {
+                nerr++;
+            }
+        }
+        test_value(nerr, 0, "Cached values of concurrently evaluated copy");
+        test_try_success();
+    }
+    catch (std::exception &e) {
+        test_try_failure(e);
+    }
+
     // Exit test
     return;
 }
@@ -1911,6 +1964,107 @@ void TestGModel::test_temp_const(void)
 }
 
 
+/***********************************************************************//**
+ * @brief Test analytical spatial model gradients
+ *
+ * @param[in] name Model name.
+ * @param[in] model Spatial model.
+ * @param[in] photon Photon.
+ *
+ * Compares the analytical gradients of all model parameters that have
+ * analytical gradients to numerical gradients.
+ ***************************************************************************/
+void TestGModel::test_spatial_grad(const std::string& name,
+                                   GModelSpatial&     model,
+                                   const GPhoton&     photon)
+{
+    // Set step size
+    const double h = 1.0e-4;
+
+    // Loop over all model parameters
+    for (int i = 0; i < model.size(); ++i) {
+
+        // Skip parameters without analytical gradient
+        if (!model[i].has_grad()) {
+            continue;
+        }
+
+        // Free parameter so that its gradient is computed
+        model[i].free();
+
+        // Compute analytical gradient
+        model.eval_gradients(photon);
+        double analytic = model[i].factor_gradient();
+
+        // Compute numerical gradient
+        double x = model[i].factor_value();
+        model[i].factor_value(x + h);
+        double f_plus = model.eval(photon);
+        model[i].factor_value(x - h);
+        double f_minus = model.eval(photon);
+        model[i].factor_value(x);
+        double numeric = (f_plus - f_minus) / (2.0 * h);
+
+        // Test gradient
+        double eps = 1.0e-5 * (std::abs(numeric) + 1.0);
+        test_value(analytic, numeric, eps,
+                   name+" "+model[i].name()+" gradient");
+
+    } // endfor: looped over model parameters
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Test spectral model batch evaluation
+ *
+ * @param[in] name Test name.
+ * @param[in] model Spectral model.
+ *
+ * Compares the model values and gradients of the batch evaluation to the
+ * values and gradients obtained by eval_gradients() for each energy.
+ ***************************************************************************/
+void TestGModel::test_spectral_eval(const std::string& name,
+                                    GModelSpectral&    model)
+{
+    // Set energies (log10 MeV); the energies are not sorted
+    const int n = 9;
+    double logE[n] = {-0.5, 0.0, 0.5, 1.0, 2.0, 5.5, 3.0, 4.0, 4.5};
+
+    // Free all parameters so that their gradients are computed
+    for (int i = 0; i < model.size(); ++i) {
+        model[i].free();
+    }
+
+    // Batch evaluation with and without gradients
+    std::vector<double> values(n, 0.0);
+    std::vector<double> values_nograd(n, 0.0);
+    std::vector<double> gradients(n*model.size(), 0.0);
+    model.eval(logE, n, &values[0], &gradients[0]);
+    model.eval(logE, n, &values_nograd[0]);
+
+    // Compare to individual evaluations
+    for (int i = 0; i < n; ++i) {
+        GEnergy energy;
+        energy.log10MeV(logE[i]);
+        double value = model.eval_gradients(energy, GTime());
+        double eps   = 1.0e-10 * std::abs(value);
+        test_value(values[i], value, eps, name+" value");
+        test_value(values_nograd[i], value, eps, name+" value (no gradients)");
+        for (int k = 0; k < model.size(); ++k) {
+            double grad = model[k].factor_gradient();
+            test_value(gradients[k*n+i], grad, 1.0e-10 * std::abs(grad),
+                       name+" "+model[k].name()+" gradient");
+        }
+    }
+
+    // Return
+    return;
+}
+
+
 /***********************************************************************//**
  * @brief Test XML model.
  *
@@ -1972,6 +2126,44 @@ void TestGModel::test_spatial_model(void)
 }
 
 
+/***********************************************************************//**
+ * @brief Test analytical spatial model gradients
+ *
+ * Compares the analytical gradients of the radial and elliptical models
+ * to numerical gradients for a photon that is located within the models.
+ ***************************************************************************/
+void TestGModel::test_spatial_gradients(void)
+{
+    // Set model centre and photon
+    GSkyDir centre;
+    GSkyDir dir;
+    centre.radec_deg(83.6331, 22.0145);
+    dir.radec_deg(83.9, 22.2);
+    GPhoton photon(dir, GEnergy(1.0, "TeV"), GTime(0.0));
+
+    // Test radial Gaussian
+    GModelSpatialRadialGauss gauss(centre, 0.3);
+    test_spatial_grad("GModelSpatialRadialGauss", gauss, photon);
+
+    // Test radial disk
+    GModelSpatialRadialDisk disk(centre, 0.5);
+    test_spatial_grad("GModelSpatialRadialDisk", disk, photon);
+
+    // Test radial shell (small angle approximation and exact formulae)
+    GModelSpatialRadialShell shell(centre, 0.4, 0.3, true);
+    test_spatial_grad("GModelSpatialRadialShell (small angle)", shell, photon);
+    shell.small_angle(false);
+    test_spatial_grad("GModelSpatialRadialShell", shell, photon);
+
+    // Test elliptical disk
+    GModelSpatialEllipticalDisk ellipse(centre, 0.6, 0.3, 45.0);
+    test_spatial_grad("GModelSpatialEllipticalDisk", ellipse, photon);
+
+    // Return
+    return;
+}
+
+
 /***********************************************************************//**
  * @brief Test spectral model XML reading and writing
  ***************************************************************************/
@@ -1991,6 +2183,46 @@ void TestGModel::test_spectral_model(void)
     return;
 }
 
+/***********************************************************************//**
+ * @brief Test spectral model batch evaluation
+ ***************************************************************************/
+void TestGModel::test_spectral_batch(void)
+{
+    // Test power laws
+    GModelSpectralPlaw plaw(5.7e-16, -2.48, GEnergy(0.3, "TeV"));
+    test_spectral_eval("GModelSpectralPlaw", plaw);
+    GModelSpectralExpPlaw eplaw(5.7e-16, -2.48, GEnergy(0.3, "TeV"),
+                                GEnergy(1.0, "TeV"));
+    test_spectral_eval("GModelSpectralExpPlaw", eplaw);
+    GModelSpectralLogParabola logparabola(2.0, -2.48, GEnergy(0.3, "TeV"),
+                                          -0.1);
+    test_spectral_eval("GModelSpectralLogParabola", logparabola);
+
+    // Test broken power law
+    GXml                     xml(m_xml_model_point_bplaw);
+    GXmlElement*             element = xml.element(0)->element(0)->element("spectrum", 0);
+    GModelSpectralBrokenPlaw bplaw(*element);
+    test_spectral_eval("GModelSpectralBrokenPlaw", bplaw);
+
+    // Test node function
+    GModelSpectralNodes nodes;
+    nodes.append(GEnergy(0.1, "MeV"), 1.0);
+    nodes.append(GEnergy(10.0, "MeV"), 0.1);
+    nodes.append(GEnergy(1.0, "TeV"), 1.0e-6);
+    test_spectral_eval("GModelSpectralNodes", nodes);
+
+    // Test file function
+    GModelSpectralFunc filefct("data/filefunction.txt", 2.0);
+    test_spectral_eval("GModelSpectralFunc", filefct);
+
+    // Test constant (uses base class implementation)
+    GModelSpectralConst constant(3.0);
+    test_spectral_eval("GModelSpectralConst", constant);
+
+    // Return
+    return;
+}
+
 
 /***********************************************************************//**
  * @brief Test model container handling
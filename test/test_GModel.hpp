@@ -57,6 +57,7 @@ public:
     void                test_radial_shell(void);
     void                test_elliptical_disk(void);
     void                test_spatial_model(void);
+    void                test_spatial_gradients(void);
     void                test_const(void);
     void                test_gauss(void);
     void                test_plaw(void);
@@ -67,6 +68,7 @@ public:
     void                test_nodes(void);
     void                test_filefct(void);
     void                test_spectral_model(void);
+    void                test_spectral_batch(void);
     void                test_temp_const(void);
     void                test_models(void);
     void                test_model_registry(void);
@@ -74,6 +76,9 @@ public:
 private:        
     // Private methods
     void test_xml_model(const std::string& name, const std::string& filename);
+    void test_spatial_grad(const std::string& name, GModelSpatial& model,
+                           const GPhoton& photon);
+    void test_spectral_eval(const std::string& name, GModelSpectral& model);
     
     // Private attributes
     std::string m_map_file;
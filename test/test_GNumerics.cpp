@@ -47,6 +47,9 @@ void TestGNumerics::set(void)
     // Append tests
     append(static_cast<pfunction>(&TestGNumerics::test_integral),"Test GIntegral");
     append(static_cast<pfunction>(&TestGNumerics::test_romberg_integration),"Test Romberg integration");
+    append(static_cast<pfunction>(&TestGNumerics::test_gauss_kronrod_integration),"Test Gauss-Kronrod integration");
+    append(static_cast<pfunction>(&TestGNumerics::test_gauss_legendre_integration),"Test Gauss-Legendre integration");
+    append(static_cast<pfunction>(&TestGNumerics::test_array_evaluation),"Test array evaluation of integration kernels");
     return;
 }
 
@@ -92,6 +95,122 @@ void TestGNumerics::test_romberg_integration(void)
 
     result = integral.romb(0.0, m_sigma);
     test_value(result,0.3413447460687748,1.0e-6,"","Gaussian integral is not 0.341345 (difference="+gammalib::str((result-0.3413447460687748))+")");
+
+    // Check that a direct trapezoidal sequence restarts the call counter
+    result = integral.trapzd(0.0, m_sigma, 1);
+    test_value(integral.calls(), 2, "Kernel calls for n=1 trapezoidal step");
+    result = integral.trapzd(0.0, m_sigma, 2, result);
+    test_value(integral.calls(), 3, "Kernel calls for n=2 trapezoidal step");
+}
+
+
+/***********************************************************************//**
+ * @brief Test Gauss-Kronrod integration.
+ *
+ * Also verifies that Gauss-Kronrod integration needs fewer kernel calls
+ * than Romberg integration for the same precision.
+ ***************************************************************************/
+void TestGNumerics::test_gauss_kronrod_integration(void)
+{
+    Gauss     integrand(m_sigma);
+    GIntegral integral(&integrand);
+    double    result = integral.gauss_kronrod(-10.0*m_sigma, 10.0*m_sigma);
+    test_value(result,1.0,1.0e-6,"","Gaussian integral is not 1.0 (integral="+gammalib::str(result)+")");
+    test_assert(integral.error() <= 1.0e-6, "Error estimate exceeds precision");
+
+    result = integral.gauss_kronrod(-m_sigma, m_sigma);
+    test_value(result,0.68268948130801355,1.0e-6,"","Gaussian integral is not 0.682689 (difference="+gammalib::str((result-0.68268948130801355))+")");
+
+    result = integral.gauss_kronrod(0.0, m_sigma);
+    test_value(result,0.3413447460687748,1.0e-6,"","Gaussian integral is not 0.341345 (difference="+gammalib::str((result-0.3413447460687748))+")");
+
+    // Compare number of kernel calls to Romberg integration for a power
+    // law over three decades
+    PowerLaw  plaw(-2.5);
+    GIntegral integral_plaw(&plaw);
+    double    ref       = (std::pow(0.1, -1.5) - std::pow(100.0, -1.5)) / 1.5;
+    double    result_gk = integral_plaw.gauss_kronrod(0.1, 100.0);
+    int       calls_gk  = integral_plaw.calls();
+    double    result_rb = integral_plaw.romb(0.1, 100.0);
+    int       calls_rb  = integral_plaw.calls();
+    test_value(result_gk, ref, 1.0e-6*ref, "Power law integral");
+    test_value(result_rb, ref, 1.0e-5*ref, "Power law integral");
+    test_assert(calls_gk < calls_rb,
+                "Gauss-Kronrod integration needs "+gammalib::str(calls_gk)+
+                " kernel calls, Romberg integration needs "+
+                gammalib::str(calls_rb)+" kernel calls");
+}
+
+
+/***********************************************************************//**
+ * @brief Test Gauss-Legendre integration.
+ ***************************************************************************/
+void TestGNumerics::test_gauss_legendre_integration(void)
+{
+    Gauss     integrand(m_sigma);
+    GIntegral integral(&integrand);
+    double    result = integral.gauss_legendre(-m_sigma, m_sigma, 16);
+    test_value(result,0.68268948130801355,1.0e-6,"","Gaussian integral is not 0.682689 (difference="+gammalib::str((result-0.68268948130801355))+")");
+    test_value(integral.calls(), 16, "Number of kernel calls is not 16");
+
+    result = integral.gauss_legendre(0.0, m_sigma, 8);
+    test_value(result,0.3413447460687748,1.0e-6,"","Gaussian integral is not 0.341345 (difference="+gammalib::str((result-0.3413447460687748))+")");
+
+    result = integral.gauss_legendre(-10.0*m_sigma, 10.0*m_sigma, 32);
+    test_value(result,1.0,1.0e-6,"","Gaussian integral is not 1.0 (integral="+gammalib::str(result)+")");
+
+    // Check that invalid order throws an exception
+    test_try("Invalid Gauss-Legendre order");
+    try {
+        integral.gauss_legendre(0.0, m_sigma, 5);
+        test_try_failure("Expected GException::invalid_argument exception.");
+    }
+    catch (GException::invalid_argument &e) {
+        test_try_success();
+    }
+    catch (std::exception &e) {
+        test_try_failure(e);
+    }
+}
+
+
+/***********************************************************************//**
+ * @brief Test array evaluation of integration kernels.
+ *
+ * Verifies that the integration methods use the array evaluation of the
+ * kernel and that the results are identical to those obtained by scalar
+ * evaluation.
+ ***************************************************************************/
+void TestGNumerics::test_array_evaluation(void)
+{
+    // Set kernels
+    Gauss      scalar(m_sigma);
+    GaussArray array(m_sigma);
+    GIntegral  integral_scalar(&scalar);
+    GIntegral  integral_array(&array);
+
+    // Romberg integration (the first step evaluates the boundaries)
+    double result_scalar = integral_scalar.romb(-m_sigma, m_sigma);
+    double result_array  = integral_array.romb(-m_sigma, m_sigma);
+    test_value(result_array, result_scalar, 1.0e-15, "Romberg integration");
+    test_value(array.m_values, integral_array.calls()-2,
+               "Romberg integration array evaluations");
+
+    // Gauss-Kronrod integration
+    array.m_values = 0;
+    result_scalar  = integral_scalar.gauss_kronrod(-m_sigma, m_sigma);
+    result_array   = integral_array.gauss_kronrod(-m_sigma, m_sigma);
+    test_value(result_array, result_scalar, 1.0e-15, "Gauss-Kronrod integration");
+    test_value(array.m_values, integral_array.calls(),
+               "Gauss-Kronrod integration array evaluations");
+
+    // Gauss-Legendre integration
+    array.m_values = 0;
+    result_scalar  = integral_scalar.gauss_legendre(-m_sigma, m_sigma);
+    result_array   = integral_array.gauss_legendre(-m_sigma, m_sigma);
+    test_value(result_array, result_scalar, 1.0e-15, "Gauss-Legendre integration");
+    test_value(array.m_values, integral_array.calls(),
+               "Gauss-Legendre integration array evaluations");
 }
 
 
@@ -51,6 +51,48 @@ protected:
     double m_sigma;
 };
 
+
+/***********************************************************************//**
+ * @class GaussArray
+ *
+ * @brief Gaussian function with array evaluation.
+ *
+ * Counts the number of function values that were computed by array
+ * evaluation.
+ ***************************************************************************/
+class GaussArray : public Gauss {
+public:
+    GaussArray(const double& sigma) : Gauss(sigma), m_values(0) { return; }
+    virtual ~GaussArray(void) { return; }
+    double eval(const double& x) {
+        return Gauss::eval(x);
+    }
+    void eval(const double* x, double* y, const int& n) {
+        for (int i = 0; i < n; ++i) {
+            y[i] = Gauss::eval(x[i]);
+        }
+        m_values += n;
+        return;
+    }
+    int m_values;
+};
+
+/***********************************************************************//**
+ * @class PowerLaw
+ *
+ * @brief Power law function.
+ ***************************************************************************/
+class PowerLaw : public GFunction {
+public:
+    PowerLaw(const double& index) : m_index(index) { return; }
+    virtual ~PowerLaw(void) { return; }
+    double eval(const double& x) {
+        return std::pow(x, m_index);
+    }
+protected:
+    double m_index;
+};
+
 class TestGNumerics : public GTestSuite
 {
 public:
@@ -63,6 +105,9 @@ public:
     virtual TestGNumerics* clone(void) const;
     void                   test_integral(void);
     void                   test_romberg_integration(void);
+    void                   test_gauss_kronrod_integration(void);
+    void                   test_gauss_legendre_integration(void);
+    void                   test_array_evaluation(void);
 
 private:
     // Private members
@@ -62,6 +62,10 @@ void TestGObservation::set(void)
     append(static_cast<pfunction>(&TestGObservation::test_times), "Test GTimes");
     append(static_cast<pfunction>(&TestGObservation::test_energies), "Test GEnergies");
     append(static_cast<pfunction>(&TestGObservation::test_photons), "Test GPhotons");
+    append(static_cast<pfunction>(&TestGObservation::test_npred_cache), "Test Npred cache");
+    append(static_cast<pfunction>(&TestGObservation::test_npred_gradients), "Test Npred gradients");
+    append(static_cast<pfunction>(&TestGObservation::test_likelihood_workspaces), "Test likelihood workspaces");
+    append(static_cast<pfunction>(&TestGObservation::test_likelihood_dense_curvature), "Test likelihood dense curvature");
 
     // Return
     return;
@@ -753,6 +757,362 @@ void TestGObservation::test_photons(void)
 }
 
 
+/***********************************************************************//**
+ * @brief Test Npred cache
+ *
+ * Checks that Npred and its gradients computed with the Npred cache agree
+ * with the values computed without the cache, also after a change of the
+ * model parameters. For a sky model with a power law spectrum, a change of
+ * the Prefactor rescales the cached Npred while a change of the Index
+ * invalidates the cache.
+ ***************************************************************************/
+void TestGObservation::test_npred_cache(void)
+{
+    // Create model container
+    GTestModelData model;
+    GModels        models;
+    models.append(model);
+
+    // Create event list
+    GTime tmin(0.0);
+    GTime tmax(1800.0);
+    GRan  ran;
+    ran.seed(0);
+    GEvents* events = model.generateList(RATE, tmin, tmax, ran);
+
+    // Create observations with and without Npred cache
+    GTestObservation ob;
+    ob.id("0");
+    ob.events(*events);
+    ob.ontime(tmax.secs()-tmin.secs());
+    GTestObservation ob_cache = ob;
+    ob_cache.use_npred_cache(true);
+    delete events;
+
+    // Check that the cache is not copied
+    GTestObservation ob_copy = ob_cache;
+    test_assert(ob_cache.use_npred_cache(), "Check that cache is used");
+    test_assert(!ob_copy.use_npred_cache(), "Check that cache is not copied");
+
+    // Compute Npred twice using the cache and compare to Npred without cache
+    GVector grad(models.npars());
+    GVector grad_cache(models.npars());
+    double npred        = ob.npred(models, &grad);
+    double npred_cache1 = ob_cache.npred(models, &grad_cache);
+    double npred_cache2 = ob_cache.npred(models, &grad_cache);
+    test_value(npred_cache1, npred, 1.0e-10, "Check Npred on cache fill");
+    test_value(npred_cache2, npred, 1.0e-10, "Check Npred on cache hit");
+    for (int i = 0; i < models.npars(); ++i) {
+        test_value(grad_cache[i], grad[i], 1.0e-10, "Check Npred gradient");
+    }
+
+    // Change model parameter and check that the cache is updated
+    (*models[0])[0].value(2.0*(*models[0])[0].value());
+    npred        = ob.npred(models, &grad);
+    npred_cache1 = ob_cache.npred(models, &grad_cache);
+    test_value(npred_cache1, npred, 1.0e-10, "Check Npred after change");
+    for (int i = 0; i < models.npars(); ++i) {
+        test_value(grad_cache[i], grad[i], 1.0e-10, "Check Npred gradient");
+    }
+
+    // Create sky model with power law spectrum
+    GSkyDir                  dir;
+    GModelSpatialPointSource point(dir);
+    GModelSpectralPlaw       plaw(2.0, -2.5, GEnergy(1.5, "MeV"));
+    GModelSky                sky(point, plaw);
+    GModels                  skymodels;
+    skymodels.append(sky);
+    GModel& skymodel = *skymodels[0];
+
+    // Fill cache for sky model
+    GTestObservation ob_sky = ob;
+    ob_sky.use_npred_cache(true);
+    GVector grad_sky(skymodels.npars());
+    GVector grad_ref(skymodels.npars());
+    double  npred_sky = ob_sky.npred(skymodels, &grad_sky);
+    double  npred_ref = ob.npred(skymodels, &grad_ref);
+    test_value(npred_sky, npred_ref, 1.0e-10*npred_ref,
+               "Check sky model Npred on cache fill");
+
+    // Change Prefactor and check that Npred is rescaled
+    skymodel["Prefactor"].value(3.0*skymodel["Prefactor"].value());
+    double npred_scaled = ob_sky.npred(skymodels, &grad_sky);
+    npred_ref           = ob.npred(skymodels, &grad_ref);
+    test_value(npred_scaled, 3.0*npred_sky, 1.0e-10*npred_scaled,
+               "Check Npred rescaling for Prefactor change");
+    test_value(npred_scaled, npred_ref, 1.0e-10*npred_ref,
+               "Check rescaled Npred");
+    for (int i = 0; i < skymodels.npars(); ++i) {
+        test_value(grad_sky[i], grad_ref[i], 1.0e-8*std::abs(grad_ref[i]),
+                   "Check gradient of rescaled Npred");
+    }
+
+    // Change Index and check that the cache is invalidated
+    skymodel["Index"].value(-2.0);
+    double npred_index = ob_sky.npred(skymodels, &grad_sky);
+    npred_ref          = ob.npred(skymodels, &grad_ref);
+    test_assert(std::abs(npred_index-npred_scaled) > 1.0e-6*npred_scaled,
+                "Check that Npred changes for Index change");
+    test_value(npred_index, npred_ref, 1.0e-10*npred_ref,
+               "Check Npred after Index change");
+    for (int i = 0; i < skymodels.npars(); ++i) {
+        test_value(grad_sky[i], grad_ref[i], 1.0e-8*std::abs(grad_ref[i]),
+                   "Check gradient after Index change");
+    }
+
+    // Return
+    return;
+}
+
+/***********************************************************************//**
+ * @brief Test Npred gradients
+ *
+ * Checks that the spectral Npred gradients of a sky model, which are
+ * computed analytically, agree with the numerical gradients.
+ ***************************************************************************/
+void TestGObservation::test_npred_gradients(void)
+{
+    // Create sky model
+    GSkyDir dir;
+    GModelSpatialPointSource point(dir);
+    GModelSpectralPlaw       plaw(2.0, -2.5, GEnergy(1.5, "MeV"));
+    GModelSky                sky(point, plaw);
+    GModels                  models;
+    models.append(sky);
+
+    // Create event list
+    GTestModelData model;
+    GTime tmin(0.0);
+    GTime tmax(1800.0);
+    GRan  ran;
+    ran.seed(0);
+    GEvents* events = model.generateList(RATE, tmin, tmax, ran);
+
+    // Create observation
+    GTestObservation ob;
+    ob.id("0");
+    ob.events(*events);
+    ob.ontime(tmax.secs()-tmin.secs());
+    delete events;
+
+    // Compute Npred and gradients
+    GVector grad(models.npars());
+    double  npred = ob.npred(models, &grad);
+    test_assert(npred > 0.0, "Check that Npred is positive");
+
+    // Compare gradients of free parameters to numerical gradients
+    for (int i = 0; i < models[0]->size(); ++i) {
+        if ((*models[0])[i].is_free()) {
+            double grad_num = ob.npred_grad(*models[0], i);
+            test_value(grad[i], grad_num, 1.0e-4*std::abs(grad_num),
+                       "Check gradient of parameter \""+
+                       (*models[0])[i].name()+"\"");
+        }
+    }
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Test likelihood workspaces
+ *
+ * Checks that a likelihood function that keeps its workspaces gives the
+ * same results as a likelihood function that allocates new workspaces for
+ * every evaluation, for repeated evaluations, after a change of the model
+ * parameters and after the models of the observation container were
+ * replaced by models with the same number of parameters. Also checks that
+ * keeping the chunk workspaces of the observations does not change the
+ * likelihood.
+ ***************************************************************************/
+void TestGObservation::test_likelihood_workspaces(void)
+{
+    // Create model container
+    GTestModelData model;
+    GModels        models;
+    models.append(model);
+
+    // Create observation container with two observations
+    GObservations obs;
+    GTime         tmin(0.0);
+    GTime         tmax(1800.0);
+    for (int i = 0; i < 2; ++i) {
+        GRan ran;
+        ran.seed(i);
+        GEvents* events = model.generateList(RATE, tmin, tmax, ran);
+        GTestObservation ob;
+        ob.id(gammalib::str(i));
+        ob.events(*events);
+        ob.ontime(tmax.secs()-tmin.secs());
+        obs.append(ob);
+        delete events;
+    }
+    obs.models(models);
+
+    // Setup likelihood functions with and without kept workspaces
+    GObservations::likelihood fct_keep(&obs);
+    GObservations::likelihood fct_ref(&obs);
+    fct_keep.keep_workspaces(true);
+
+    // Evaluate likelihood twice with kept workspaces. The optimizer
+    // parameters point to the parameters of the models in the container.
+    GOptimizerPars pars = const_cast<GModels&>(obs.models()).pars();
+    fct_ref.eval(pars);
+    fct_keep.eval(pars);
+    test_value(fct_keep.value(), fct_ref.value(), 1.0e-10,
+               "Check likelihood on workspace allocation");
+    fct_keep.eval(pars);
+    test_value(fct_keep.value(), fct_ref.value(), 1.0e-10,
+               "Check likelihood on workspace reuse");
+
+    // Change model parameter
+    pars[0]->factor_value(1.1 * pars[0]->factor_value());
+    fct_ref.eval(pars);
+    fct_keep.eval(pars);
+    test_value(fct_keep.value(), fct_ref.value(), 1.0e-10,
+               "Check likelihood after parameter change");
+    test_value((*fct_keep.gradient())[0], (*fct_ref.gradient())[0], 1.0e-10,
+               "Check gradient after parameter change");
+
+    // Replace model by a model that only applies to the first observation
+    double         value_all = fct_ref.value();
+    GTestModelData model_0   = model;
+    model_0.ids("0");
+    GModels models_0;
+    models_0.append(model_0);
+    obs.models(models_0);
+    GOptimizerPars pars_0 = const_cast<GModels&>(obs.models()).pars();
+    fct_ref.eval(pars_0);
+    fct_keep.eval(pars_0);
+    test_assert(std::abs(fct_ref.value()-value_all) > 1.0e-6,
+                "Check that likelihood changes for replaced model");
+    test_value(fct_keep.value(), fct_ref.value(), 1.0e-10,
+               "Check likelihood after model replacement");
+
+    // Evaluate likelihood with kept chunk workspaces of the observations
+    // and compare to the reference evaluated without them
+    double value_ref = fct_ref.value();
+    for (int i = 0; i < obs.size(); ++i) {
+        obs[i]->keep_workspaces(true);
+    }
+    fct_ref.eval(pars_0);
+    test_value(fct_ref.value(), value_ref, 1.0e-10,
+               "Check likelihood on chunk workspace allocation");
+    fct_ref.eval(pars_0);
+    test_value(fct_ref.value(), value_ref, 1.0e-10,
+               "Check likelihood on chunk workspace reuse");
+    pars_0[0]->factor_value(1.1 * pars_0[0]->factor_value());
+    fct_keep.eval(pars_0);
+    value_ref = fct_keep.value();
+    for (int i = 0; i < obs.size(); ++i) {
+        obs[i]->keep_workspaces(false);
+    }
+    fct_ref.eval(pars_0);
+    test_value(value_ref, fct_ref.value(), 1.0e-10,
+               "Check likelihood with chunk workspaces after parameter change");
+
+    // Return
+    return;
+}
+
+/***********************************************************************//**
+ * @brief Test dense curvature accumulation of likelihood
+ *
+ * Checks that the curvature matrix that is accumulated in the dense
+ * accumulator agrees with the curvature matrix that is directly accumulated
+ * in the sparse matrix. The sparse path is enforced by adding models with
+ * fixed parameters that do not apply to the observation, which reduces the
+ * fraction of free parameters below the threshold of the dense path. The
+ * evaluations are repeated with kept workspaces to check that the dense
+ * accumulator is properly zeroed for reuse.
+ ***************************************************************************/
+void TestGObservation::test_likelihood_dense_curvature(void)
+{
+    // Create model container with two models that apply to the observation
+    GModels        models;
+    GTestModelData model_a;
+    GTestModelData model_b;
+    model_a.name("A");
+    model_b.name("B");
+    models.append(model_a);
+    models.append(model_b);
+
+    // Create observation
+    GObservations obs;
+    GRan          ran;
+    GTime         tmin(0.0);
+    GTime         tmax(1800.0);
+    GEvents*      events = model_a.generateList(RATE, tmin, tmax, ran);
+    GTestObservation ob;
+    ob.id("0");
+    ob.events(*events);
+    ob.ontime(tmax.secs()-tmin.secs());
+    obs.append(ob);
+    delete events;
+
+    // Evaluate likelihood with dense curvature accumulator
+    obs.models(models);
+    GObservations::likelihood fct_dense(&obs);
+    GOptimizerPars pars_dense(const_cast<GModels&>(obs.models()).pars());
+    fct_dense.eval(pars_dense);
+    GMatrixSparse curvature_dense = *(fct_dense.curvature());
+    double        value_dense     = fct_dense.value();
+
+    // Add models with fixed parameters that do not apply to the observation
+    for (int i = 0; i < 25; ++i) {
+        GTestModelData fixed;
+        fixed.name("Fixed "+gammalib::str(i));
+        fixed.ids("none");
+        fixed[0].fix();
+        models.append(fixed);
+    }
+
+    // Evaluate likelihood with sparse curvature matrix
+    obs.models(models);
+    GObservations::likelihood fct_sparse(&obs);
+    GOptimizerPars pars_sparse(const_cast<GModels&>(obs.models()).pars());
+    fct_sparse.eval(pars_sparse);
+    GMatrixSparse curvature_sparse = *(fct_sparse.curvature());
+
+    // Check that likelihood and curvature agree
+    test_value(fct_sparse.value(), value_dense, 1.0e-10,
+               "Check likelihood of sparse path");
+    for (int row = 0; row < 2; ++row) {
+        for (int col = 0; col < 2; ++col) {
+            test_value(curvature_sparse(row,col), curvature_dense(row,col),
+                       1.0e-10*std::abs(curvature_sparse(row,col)),
+                       "Check curvature element ("+gammalib::str(row)+","+
+                       gammalib::str(col)+")");
+        }
+    }
+    test_assert(curvature_dense(0,1) != 0.0,
+                "Check that off-diagonal curvature element is non-zero");
+
+    // Repeat evaluation with dense curvature accumulator and kept
+    // workspaces
+    GModels models_keep;
+    models_keep.append(model_a);
+    models_keep.append(model_b);
+    obs.models(models_keep);
+    obs[0]->keep_workspaces(true);
+    GOptimizerPars pars_keep(const_cast<GModels&>(obs.models()).pars());
+    for (int i = 0; i < 2; ++i) {
+        fct_dense.eval(pars_keep);
+        test_value((*fct_dense.curvature())(0,1), curvature_dense(0,1),
+                   1.0e-10*std::abs(curvature_dense(0,1)),
+                   "Check curvature element (0,1) with kept accumulator");
+        test_value((*fct_dense.curvature())(1,1), curvature_dense(1,1),
+                   1.0e-10*std::abs(curvature_dense(1,1)),
+                   "Check curvature element (1,1) with kept accumulator");
+    }
+    obs[0]->keep_workspaces(false);
+
+    // Return
+    return;
+}
+
+
 #ifdef _OPENMP
 /***********************************************************************//**
 * @brief Set tests
@@ -770,6 +1130,9 @@ void TestOpenMP::set(void)
     append(static_cast<pfunction>(&TestOpenMP::test_observations_optimizer_binned_1), "Test binned optimization (1 thread)");
     append(static_cast<pfunction>(&TestOpenMP::test_observations_optimizer_binned_10), "Test binned optimisation (10 threads)");
 
+    // Append event parallel tests
+    append(static_cast<pfunction>(&TestOpenMP::test_event_parallel_likelihood), "Test event parallel likelihood");
+
     // Return
     return;
 }
@@ -927,6 +1290,84 @@ void TestOpenMP::test_observations_optimizer_binned_10(void)
     // Return
     return;
 }
+
+
+/***********************************************************************//**
+ * @brief Test event parallel likelihood computation
+ *
+ * Fits a single observation using 1 thread and 10 threads. For 10 threads
+ * the event loop is split over the threads. The test verifies that the
+ * results agree with the single thread result and that repeated fits with
+ * 10 threads give identical results.
+ ***************************************************************************/
+void TestOpenMP::test_event_parallel_likelihood(void)
+{
+    // Fit with 1 thread
+    omp_set_num_threads(1);
+    double value_1 = optimize_single_observation();
+
+    // Fit twice with 10 threads
+    omp_set_num_threads(10);
+    double value_10a = optimize_single_observation();
+    double value_10b = optimize_single_observation();
+
+    // Check results
+    test_value(value_10a, value_1, 1.0e-6, "Check 10 thread result");
+    test_assert(value_10a == value_10b, "Check reproducibility",
+                "Fit results differ from run to run: "+
+                gammalib::str(value_10a)+" != "+gammalib::str(value_10b));
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Optimize a single unbinned observation
+ *
+ * @return Fitted rate.
+ ***************************************************************************/
+double TestOpenMP::optimize_single_observation(void)
+{
+    // Create model container
+    GTestModelData model;
+    GModels        models;
+    models.append(model);
+
+    // Set time interval
+    GTime tmin(0.0);
+    GTime tmax(1800.0);
+
+    // Create event list
+    GRan ran;
+    ran.seed(0);
+    GEvents* events = model.generateList(RATE, tmin, tmax, ran);
+
+    // Create observation
+    GTestObservation ob;
+    ob.id("0");
+    ob.events(*events);
+    ob.ontime(tmax.secs()-tmin.secs());
+    delete events;
+
+    // Create observation container
+    GObservations obs;
+    obs.append(ob);
+    obs.models(models);
+
+    // Optimize
+    GLog         log;
+    GOptimizerLM opt(log);
+    opt.max_stalls(50);
+    obs.optimize(opt);
+
+    // Check if converged
+    test_assert(opt.status()==0, "Check if converged", 
+                                 "Optimizer did not converge"); 
+
+    // Return fitted rate
+    return ((*(obs.models()[0]))[0].factor_value());
+}
 #endif
 
 
@@ -53,6 +53,10 @@ public:
     void                      test_time(void);
     void                      test_times(void);
     void                      test_energies(void);
+    void                      test_npred_cache(void);
+    void                      test_npred_gradients(void);
+    void                      test_likelihood_workspaces(void);
+    void                      test_likelihood_dense_curvature(void);
 };
 
 
@@ -77,6 +81,8 @@ public:
     void                test_observations_optimizer_binned_1();
     void                test_observations_optimizer_binned_10();
     void                test_observations_optimizer(const int& mode=0);
+    void                test_event_parallel_likelihood(void);
+    double              optimize_single_observation(void);
 };
 #endif
 
@@ -31,6 +31,8 @@
 #include <iostream>                           // cout, cerr
 #include <stdexcept>                          // std::exception
 #include <stdlib.h>
+#include <cmath>                              // std::abs
+#include <algorithm>                          // std::find, std::includes
 #include "test_GSky.hpp"
 #include "GTools.hpp"
 
@@ -56,9 +58,14 @@ void TestGSky::set(void){
     append(static_cast<pfunction>(&TestGSky::test_GSkyPixel),"Test GSkyPixel");
     append(static_cast<pfunction>(&TestGSky::test_GSkymap_healpix_construct),"Test Healpix GSkymap constructors");
     append(static_cast<pfunction>(&TestGSky::test_GSkymap_healpix_io),"Test Healpix GSkymap I/O");
+    append(static_cast<pfunction>(&TestGSky::test_GSkymap_healpix_query),"Test Healpix pixel queries");
     append(static_cast<pfunction>(&TestGSky::test_GSkymap_wcs_construct),"Test WCS GSkymap constructors");
     append(static_cast<pfunction>(&TestGSky::test_GSkymap_wcs_io),"Test WCS GSkymap I/O");
+    append(static_cast<pfunction>(&TestGSky::test_GSkymap_batched),"Test batched GSkymap transformations");
+    append(static_cast<pfunction>(&TestGSky::test_GSkymap_lookup),"Test GSkymap pixel weights lookup");
+    append(static_cast<pfunction>(&TestGSky::test_GSkymap_storage),"Test GSkymap pixel storage");
     append(static_cast<pfunction>(&TestGSky::test_GSkyRegions_io),"Test GSkyRegions");
+    append(static_cast<pfunction>(&TestGSky::test_GSkyRegions_index),"Test GSkyRegions spatial index");
     append(static_cast<pfunction>(&TestGSky::test_GSkyRegionCircle_construct),"Test GSkyRegionCircle constructors");
     append(static_cast<pfunction>(&TestGSky::test_GSkyRegionCircle_logic),"Test GSkyRegionCircle logic");
 
@@ -694,6 +701,145 @@ void TestGSky::test_GSkymap_healpix_io(void)
 }
 
 
+/***********************************************************************//**
+ * @brief Test Healpix pixel queries
+ *
+ * Verifies the ring/nested pixel conversion, the neighbour and disc queries
+ * and the interpolation weights of the Healpix projection against brute
+ * force computations, for both pixel orderings.
+ ***************************************************************************/
+void TestGSky::test_GSkymap_healpix_query(void)
+{
+    // Loop over pixel orderings
+    for (int order = 0; order < 2; ++order) {
+
+        // Set up projections
+        std::string ordering = (order == 0) ? "RING" : "NESTED";
+        GHealpix    proj(8, ordering, "GAL");
+        GHealpix    ring(8, "RING", "GAL");
+        GHealpix    nest(8, "NESTED", "GAL");
+
+        // Test ring/nested conversion
+        test_try("Test "+ordering+" pixel conversion");
+        try {
+            int ndiff = 0;
+            for (int i = 0; i < nest.npix(); ++i) {
+                GSkyDir dir = nest.pix2dir(GSkyPixel(i));
+                if (ring.ring2nest(ring.nest2ring(i)) != i ||
+                    dir.dist_deg(ring.pix2dir(GSkyPixel(nest.nest2ring(i)))) > 1.0e-5) {
+                    ndiff++;
+                }
+            }
+            test_value(ndiff, 0, "Check ring/nested pixel conversion");
+            test_try_success();
+        }
+        catch (std::exception &e) {
+            test_try_failure(e);
+        }
+
+        // Test neighbours
+        test_try("Test "+ordering+" neighbours");
+        try {
+            int nmissing = 0;
+            int ndiff    = 0;
+            for (int i = 0; i < proj.npix(); ++i) {
+                std::vector<int> neighbours = proj.neighbours(GSkyPixel(i));
+                for (int k = 0; k < neighbours.size(); ++k) {
+                    if (neighbours[k] < 0) {
+                        nmissing++;
+                        continue;
+                    }
+                    std::vector<int> back = proj.neighbours(GSkyPixel(neighbours[k]));
+                    if (std::find(back.begin(), back.end(), i) == back.end()) {
+                        ndiff++;
+                    }
+                }
+            }
+            test_value(nmissing, 24, "Check number of missing neighbours");
+            test_value(ndiff, 0, "Check that neighbours are symmetric");
+            test_try_success();
+        }
+        catch (std::exception &e) {
+            test_try_failure(e);
+        }
+
+        // Test disc queries and interpolation
+        test_try("Test "+ordering+" disc queries and interpolation");
+        try {
+            int ndisc = 0;
+            int nincl = 0;
+            int nwgt  = 0;
+            for (int i = 0; i < 40; ++i) {
+                GSkyDir centre;
+                centre.lb_deg(37.3*i, -89.5 + 4.47*i);
+                double radius = 0.5 + 4.1*(i % 10);
+
+                // Compare disc query against brute force selection
+                std::vector<int> disc      = proj.query_disc(centre, radius);
+                std::vector<int> inclusive = proj.query_disc(centre, radius, true);
+                std::vector<int> brute;
+                for (int k = 0; k < proj.npix(); ++k) {
+                    if (centre.dist_deg(proj.pix2dir(GSkyPixel(k))) <= radius) {
+                        brute.push_back(k);
+                    }
+                }
+                if (disc != brute) {
+                    ndisc++;
+                }
+                if (!std::includes(inclusive.begin(), inclusive.end(),
+                                   disc.begin(), disc.end()) ||
+                    !std::binary_search(inclusive.begin(), inclusive.end(),
+                                        int(proj.dir2pix(centre)))) {
+                    nincl++;
+                }
+
+                // Check that interpolation weights sum up to one
+                int    index[4];
+                double weight[4];
+                double sum = 0.0;
+                proj.interpolator(centre, index, weight);
+                for (int k = 0; k < 4; ++k) {
+                    sum += weight[k];
+                }
+                if (std::abs(sum-1.0) > 1.0e-10) {
+                    nwgt++;
+                }
+            }
+            test_value(ndisc, 0, "Check disc query against brute force");
+            test_value(nincl, 0, "Check inclusive disc query");
+            test_value(nwgt, 0, "Check interpolation weights");
+            test_try_success();
+        }
+        catch (std::exception &e) {
+            test_try_failure(e);
+        }
+
+    } // endfor: looped over pixel orderings
+
+    // Test Healpix map interpolation
+    test_try("Test Healpix map interpolation");
+    try {
+        GSkymap map("GAL", 8, "NESTED", 1);
+        for (int i = 0; i < map.npix(); ++i) {
+            map(i) = 2.0;
+        }
+        GSkyDir centre = map.pix2dir(GSkyPixel(100));
+        GSkyDir dir;
+        dir.lb_deg(123.4, -56.7);
+        test_value(map(dir), 2.0, 1.0e-10, "Check interpolation of constant map");
+        map(100) = 3.0;
+        test_value(map(centre), 3.0, 1.0e-6, "Check interpolation at pixel centre");
+        test_try_success();
+    }
+    catch (std::exception &e) {
+        test_try_failure(e);
+    }
+
+    // Exit test
+    return;
+}
+
+
 /***************************************************************************
  * @brief GSkymap_wcs_construct
  ***************************************************************************/
@@ -825,6 +971,194 @@ void TestGSky::test_GSkymap_wcs_io(void)
 }
 
 
+/***************************************************************************
+ * @brief Test batched GSkymap transformations
+ *
+ * Verifies that the batched pixel to sky direction and sky direction to
+ * pixel transformations give the same results as the transformations of
+ * individual pixels and sky directions for all projections.
+ ***************************************************************************/
+void TestGSky::test_GSkymap_batched(void)
+{
+    // Set up sky maps for all WCS projections and for Healpix
+    std::vector<GSkymap> maps;
+    GWcsRegistry         registry;
+    for (int i = 0; i < registry.size(); ++i) {
+        maps.push_back(GSkymap(registry.code(i), "CEL", 83.63, 22.01,
+                               -0.1, 0.1, 40, 30));
+        maps.push_back(GSkymap(registry.code(i), "GAL", 184.56, -5.78,
+                               -0.1, 0.1, 40, 30));
+    }
+    maps.push_back(GSkymap("GAL", 8, "RING"));
+    maps.push_back(GSkymap("CEL", 8, "NESTED"));
+
+    // Loop over sky maps
+    for (int k = 0; k < maps.size(); ++k) {
+
+        // Get sky map
+        const GSkymap& map = maps[k];
+
+        // Set pixels
+        std::vector<GSkyPixel> pixels;
+        for (int i = 0; i < map.npix(); ++i) {
+            pixels.push_back(map.inx2pix(i));
+        }
+
+        // Test batched transformations
+        test_try("Test batched transformations for "+map.projection()->name());
+        try {
+            std::vector<GSkyDir> dirs    = map.pix2dir(pixels);
+            std::vector<int>     indices = map.dir2inx(dirs);
+            test_assert(dirs.size() == map.npix(),
+                        "Check number of sky directions");
+            test_assert(indices.size() == map.npix(),
+                        "Check number of pixel indices");
+            int ndiff = 0;
+            for (int i = 0; i < map.npix(); ++i) {
+                if (map.pix2dir(pixels[i]).dist_deg(dirs[i]) > 1.0e-5 ||
+                    indices[i] != i ||
+                    map.dir2inx(dirs[i]) != indices[i]) {
+                    ndiff++;
+                }
+            }
+            test_value(ndiff, 0, "Check batched against individual transformations");
+            test_try_success();
+        }
+        catch (std::exception &e) {
+            test_try_failure(e);
+        }
+
+    } // endfor: looped over sky maps
+
+    // Exit test
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Test GSkymap pixel weights lookup
+ *
+ * Verifies that applying the pixel weights returned by GSkymap::lookup()
+ * gives the same interpolated values as the sky direction access operator,
+ * for sky directions inside and outside the sky map.
+ ***************************************************************************/
+void TestGSky::test_GSkymap_lookup(void)
+{
+    // Set up sky map with two maps
+    GSkymap map("CAR", "CEL", 83.63, 22.01, -0.1, 0.1, 20, 10, 2);
+    for (int i = 0; i < map.npix(); ++i) {
+        map(i, 0) = double(i);
+        map(i, 1) = double(i*i);
+    }
+
+    // Test lookup
+    test_try("Test pixel weights lookup");
+    try {
+        int ndiff = 0;
+        for (int i = 0; i < 50; ++i) {
+            GSkyDir dir;
+            dir.radec_deg(82.0 + 0.07*i, 21.0 + 0.04*i);
+            GSkymap::weights wgt = map.lookup(dir);
+            for (int k = 0; k < map.nmaps(); ++k) {
+                if (map(wgt, k) != map(dir, k)) {
+                    ndiff++;
+                }
+            }
+        }
+        test_value(ndiff, 0, "Check lookup against sky direction access");
+        GSkyDir outside;
+        outside.radec_deg(0.0, -60.0);
+        test_value(map(map.lookup(outside), 1), 0.0,
+                   "Check lookup outside sky map");
+        test_try_success();
+    }
+    catch (std::exception &e) {
+        test_try_failure(e);
+    }
+
+    // Exit test
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Test GSkymap pixel storage
+ *
+ * Verifies single precision pixel storage and the sharing of pixels
+ * between sky map copies, including the copy-on-write of shared pixels.
+ ***************************************************************************/
+void TestGSky::test_GSkymap_storage(void)
+{
+    // Set up sky map
+    GSkymap map("CAR", "CEL", 83.63, 22.01, -0.1, 0.1, 20, 10, 2);
+    for (int i = 0; i < map.npix(); ++i) {
+        map(i, 0) = 1.0 + 0.1 * i;
+        map(i, 1) = 2.0 + 0.1 * i;
+    }
+    GSkyDir dir;
+    dir.radec_deg(83.5, 22.1);
+    double value = map(dir, 1);
+
+    // Test single precision storage. Pixels are read through a constant
+    // reference since modifiable access converts them to double precision.
+    GSkymap        fmap = map;
+    const GSkymap& cmap = fmap;
+    fmap.float_pixels(true);
+    test_assert(fmap.float_pixels(), "Check single precision storage");
+    test_value(cmap(7, 1), map(7, 1), 1.0e-6, "Check single precision pixel");
+    test_value(cmap(dir, 1), value, 1.0e-6, "Check single precision interpolation");
+    test_value(cmap(map.dir2pix(dir), 1), map(map.dir2pix(dir), 1), 1.0e-6,
+               "Check single precision pixel access");
+    test_assert(fmap.float_pixels(), "Check single precision after reading");
+    test_try("Check pixels() for single precision storage");
+    try {
+        cmap.pixels();
+        test_try_failure("pixels() should throw an exception for single"
+                         " precision storage.");
+    }
+    catch (GException::invalid_value &e) {
+        test_try_success();
+    }
+    catch (std::exception &e) {
+        test_try_failure(e);
+    }
+    fmap(7, 1) = 5.0;
+    test_assert(!fmap.float_pixels(), "Check double precision after modification");
+    test_value(fmap(7, 1), 5.0, "Check modified pixel");
+
+    // Test shared pixels
+    map.shared_pixels(true);
+    GSkymap        copy1 = map;
+    GSkymap        copy2(map);
+    const GSkymap& cmap1 = copy1;
+    const GSkymap& cmap2 = copy2;
+    test_assert(copy1.shared_pixels(), "Check shared pixels of copy");
+    test_assert(copy1.pixels() == map.pixels(), "Check that copy references pixels");
+    test_assert(copy2.pixels() == map.pixels(), "Check that copy references pixels");
+    copy1(7, 1) = 5.0;
+    test_assert(copy1.pixels() != map.pixels(), "Check that modified copy owns pixels");
+    test_value(cmap1(7, 1), 5.0, "Check modified pixel of copy");
+    test_value(cmap2(7, 1), 2.7, 1.0e-10, "Check other copy after modification of copy");
+    test_assert(cmap2.pixels() == map.pixels(), "Check that other copy references pixels");
+    map(8, 1) = 6.0;
+    test_value(cmap2(8, 1), 2.8, 1.0e-10, "Check copy after modification of original");
+    test_value(map(dir, 1), value, 1.0e-10, "Check interpolation after modification");
+
+    // Test shared single precision pixels
+    copy2.float_pixels(true);
+    GSkymap copy3 = copy2;
+    test_assert(copy3.float_pixels() && copy3.shared_pixels(),
+                "Check shared single precision pixels of copy");
+    copy2.shared_pixels(false);
+    test_assert(!copy2.shared_pixels(), "Check disabling of pixel sharing");
+    test_value(copy3(dir, 1), value, 1.0e-6, "Check shared single precision interpolation");
+    test_assert(copy3.float_pixels(), "Check that copy keeps single precision");
+
+    // Exit test
+    return;
+}
+
+
 /***************************************************************************
  * @brief GSkyRegionCircle_construct
  ***************************************************************************/
@@ -1036,3 +1370,82 @@ int main(void)
     // Return
     return was_successful ? 0:1;
 }
+
+
+/***********************************************************************//**
+ * @brief Test GSkyRegions spatial index
+ *
+ * Verifies that the containment tests using the spatial index agree with
+ * a brute force test of all regions, and that the index is updated after
+ * the region container has been modified.
+ ***************************************************************************/
+void TestGSky::test_GSkyRegions_index(void)
+{
+    // Set up region container with many circles of various radii
+    GSkyRegions regions;
+    for (int i = 0; i < 200; ++i) {
+        std::string line = "fk5;circle("+gammalib::str(17.3*i)+","+
+                           gammalib::str(-80.0+0.8*i)+","+
+                           gammalib::str(0.2+0.05*(i % 40))+
+                           ") # text=circle"+gammalib::str(i);
+        regions.append(GSkyRegionCircle(line));
+    }
+
+    // Set up sky directions
+    std::vector<GSkyDir> dirs;
+    for (int i = 0; i < 2000; ++i) {
+        GSkyDir dir;
+        dir.radec_deg(1.73*i, -85.0 + 0.085*i);
+        dirs.push_back(dir);
+    }
+
+    // Test containment
+    test_try("Test containment using spatial index");
+    try {
+        std::vector<bool> mask = regions.contains(dirs);
+        int nin   = 0;
+        int ndiff = 0;
+        for (int k = 0; k < dirs.size(); ++k) {
+            bool brute = false;
+            for (int i = 0; i < regions.size(); ++i) {
+                const GSkyRegions& cregions = regions;
+                if (cregions[i]->contains(dirs[k])) {
+                    brute = true;
+                    break;
+                }
+            }
+            if (brute) {
+                nin++;
+            }
+            if (mask[k] != brute || regions.contains(dirs[k]) != brute) {
+                ndiff++;
+            }
+        }
+        test_assert(nin > 0, "Check that some directions are in regions");
+        test_value(ndiff, 0, "Check containment against brute force");
+        test_try_success();
+    }
+    catch (std::exception &e) {
+        test_try_failure(e);
+    }
+
+    // Test that index is updated after modification
+    test_try("Test spatial index update");
+    try {
+        GSkyDir dir;
+        dir.radec_deg(0.0, -80.0);
+        test_assert(regions.contains(dir), "Check direction in first circle");
+        regions.remove(0);
+        test_assert(!regions.contains(dir), "Check direction after removal");
+        GSkyRegionCircle* circle = static_cast<GSkyRegionCircle*>(regions[0]);
+        circle->centre(0.0, -80.0);
+        test_assert(regions.contains(dir), "Check direction after moving circle");
+        test_try_success();
+    }
+    catch (std::exception &e) {
+        test_try_failure(e);
+    }
+
+    // Exit test
+    return;
+}
@@ -45,9 +45,14 @@ public:
     void              test_GSkyPixel(void);
     void              test_GSkymap_healpix_construct(void);
     void              test_GSkymap_healpix_io(void);
+    void              test_GSkymap_healpix_query(void);
     void              test_GSkymap_wcs_construct(void);
     void              test_GSkymap_wcs_io(void);
+    void              test_GSkymap_batched(void);
+    void              test_GSkymap_lookup(void);
+    void              test_GSkymap_storage(void);
     void              test_GSkyRegions_io(void);
+    void              test_GSkyRegions_index(void);
     void              test_GSkyRegionCircle_construct(void);
     void              test_GSkyRegionCircle_logic(void);
 
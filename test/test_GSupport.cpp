@@ -345,6 +345,31 @@ void TestGSupport::test_node_array_interpolation(const int&    num,
         test_value(result, expected);
     }
 
+    // Test lookup method
+    std::vector<double> args;
+    for (double value = -2.0; value <= +2.0; value += 0.2) {
+        GNodeArray::weights w = array.lookup(value);
+        double expected = value * slope + offset;
+        double result   = w.wgt_left  * values[w.inx_left] +
+                          w.wgt_right * values[w.inx_right];
+        test_value(result, expected);
+        test_value(w.inx_right, w.inx_left+1);
+        args.push_back(value);
+    }
+
+    // Test batched lookup method against single value lookup
+    int                 n = args.size();
+    std::vector<int>    inx(n);
+    std::vector<double> wgt_left(n);
+    std::vector<double> wgt_right(n);
+    array.lookup(n, &args[0], &inx[0], &wgt_left[0], &wgt_right[0]);
+    for (int i = 0; i < n; ++i) {
+        GNodeArray::weights w = array.lookup(args[i]);
+        test_value(inx[i], w.inx_left);
+        test_value(wgt_left[i], w.wgt_left);
+        test_value(wgt_right[i], w.wgt_right);
+    }
+
     // Return
     return;
 }